@@ -11,6 +11,7 @@ using namespace xero::misc ;
 namespace xero {
     namespace phaser {
         CargoIntake::CargoIntake(xero::base::Robot &robot, uint64_t id, bool victor) : SingleMotorSubsystem(robot, "CargoIntake", "hw:cargointake:motor", id, victor){
+            acceptCategory(ACTION_CATEGORY_CARGOINTAKE) ;
             solenoid_ = std::make_shared<frc::Solenoid>(robot.getSettingsParser().getInteger("hw:cargointake:solenoid"));
             solenoid_->Set(false) ;          
             sensor_ = std::make_shared<frc::DigitalInput>(robot.getSettingsParser().getInteger("hw:cargointake:sensor")) ;  
@@ -30,13 +31,6 @@ namespace xero {
             is_deployed_ = false ;
         }
 
-        bool CargoIntake::canAcceptAction(xero::base::ActionPtr act) {
-            if (SingleMotorSubsystem::canAcceptAction(act))
-                return true ;
-                
-            std::shared_ptr<CargoIntakeAction> cargoact = std::dynamic_pointer_cast<CargoIntakeAction>(act) ;
-            return cargoact != nullptr || SingleMotorSubsystem::canAcceptAction(act) ;
-        }
 
         void CargoIntake::computeState() {
             has_cargo_ = !sensor_->Get() ;
@@ -16,7 +16,6 @@ namespace xero {
             ~CargoIntake();
             void deployCollector();
             void retractCollector();
-            virtual bool canAcceptAction(xero::base::ActionPtr Action) ;
             virtual void computeState() ;
 
             bool isDeployed() const {
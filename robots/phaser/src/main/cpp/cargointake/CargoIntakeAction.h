@@ -2,6 +2,7 @@
 
 #include "Action.h"
 #include "basegroups.h"
+#include "phaserids.h"
 #include "CargoIntake.h"
 #include "Robot.h"
 
@@ -19,6 +20,7 @@ namespace xero {
             /// \brief Create a new SingleMotorSubsystemAction
             /// \param subsystem SingleMotor subsystem
             CargoIntakeAction(CargoIntake &subsystem, bool deploy) : subsystem_(subsystem) {
+                addCategory(ACTION_CATEGORY_CARGOINTAKE) ;
                 is_done_ = false ;
                 deploy_ = deploy ;
             }
@@ -12,6 +12,7 @@ using namespace xero::misc ;
 namespace xero {
     namespace phaser {
         CarlosHatch::CarlosHatch(xero::base::Robot &robot) : Subsystem(robot, "CarlosHatch") {
+            acceptCategory(ACTION_CATEGORY_CARLOSHATCH) ;
             arm_extend_ = std::make_shared<frc::Solenoid>(robot.getSettingsParser().getInteger("hw:carloshatch:arm:extend"));
             arm_retract_ = std::make_shared<frc::Solenoid>(robot.getSettingsParser().getInteger("hw:carloshatch:arm:retract"));
             holder_ =  std::make_shared<frc::Solenoid>(robot.getSettingsParser().getInteger("hw:carloshatch:holder"));
@@ -41,11 +42,6 @@ namespace xero {
         CarlosHatch::~CarlosHatch() {
         }   
 
-        bool CarlosHatch::canAcceptAction(xero::base::ActionPtr action) {
-            auto coll = std::dynamic_pointer_cast<CarlosHatchAction>(action) ;
-            return coll != nullptr ;            
-        }  
-
         void CarlosHatch::computeState() {
             double now = getRobot().getTime() ;
             bool hatchpres = false ;
@@ -17,7 +17,6 @@ namespace xero {
             CarlosHatch(xero::base::Robot &robot) ;
             virtual ~CarlosHatch() ;
             
-            virtual bool canAcceptAction(xero::base::ActionPtr Action) ;
             virtual void computeState() ;
             virtual void run() ;
 
@@ -2,6 +2,7 @@
 
 #include "Action.h"
 #include "basegroups.h"
+#include "phaserids.h"
 #include "CarlosHatch.h"
 
 /// \file
@@ -24,6 +25,7 @@ namespace xero {
             /// \brief Create a new SingleMotorSubsystemAction
             /// \param subsystem SingleMotor subsystem
             CarlosHatchAction(CarlosHatch &subsystem) : subsystem_(subsystem) {
+                addCategory(ACTION_CATEGORY_CARLOSHATCH) ;
             }
 
             virtual ~CarlosHatchAction(){
@@ -2,6 +2,7 @@
 #include "CarlosHatch.h"
 #include "phaserids.h"
 #include <Robot.h>
+#include <ActionPool.h>
 #include <oi/DriverGamepadRumbleAction.h>
 #include <oi/OISubsystem.h>
 
@@ -14,7 +15,7 @@ namespace xero {
             auto oi = subsystem.getRobot().getOI() ;
             push_arm_ = push ;
             wait_for_hooks_time_ = subsystem.getRobot().getSettingsParser().getDouble("carloshatch:waitforhooks") ;
-            rumble_ = std::make_shared<DriverGamepadRumbleAction>(*oi, true, 1.0, 1.0) ;
+            rumble_ = ActionPool::create<DriverGamepadRumbleAction>(*oi, true, 1.0, 1.0) ;
 
             push_arm_ = true ;
         }
@@ -1,5 +1,6 @@
 #include "Climber.h"
 #include "ClimberAction.h"
+#include "phaserids.h"
 #include <Robot.h>
 
 using namespace xero::base ;
@@ -7,6 +8,7 @@ using namespace xero::base ;
 namespace xero {
     namespace phaser {
         Climber::Climber(xero::base::Robot &robot) : xero::base::Subsystem(robot, "climber") {
+            acceptCategory(ACTION_CATEGORY_CLIMBER) ;
             int sol = robot.getSettingsParser().getInteger("hw:climber:solenoid") ;
             // added "hw:climber:solenoid" to phaser.dat as 6
             // solenoid 1,2,5 are already assigned
@@ -26,10 +28,5 @@ namespace xero {
             else
                 deployed_ = false ;
         }
-
-        bool Climber::canAcceptAction(xero::base::ActionPtr action) {
-            std::shared_ptr<ClimberAction> action_p = std::dynamic_pointer_cast<ClimberAction>(action) ;
-            return action_p != nullptr ;
-        }
     }
 }
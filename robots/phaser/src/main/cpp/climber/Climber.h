@@ -17,9 +17,6 @@ namespace xero {
 
             virtual void computeState() ;
 
-        protected:
-            virtual bool canAcceptAction(xero::base::ActionPtr Action) ;
-
         private:
             bool deployed_ ;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Action.h>
+#include "phaserids.h"
 
 namespace xero {
     namespace phaser {
@@ -9,6 +10,7 @@ namespace xero {
         class ClimberAction : public xero::base::Action {
         public:
             ClimberAction(Climber &climber) : climber_(climber) {                
+                addCategory(ACTION_CATEGORY_CLIMBER) ;
             }
             
             Climber &getClimber() {
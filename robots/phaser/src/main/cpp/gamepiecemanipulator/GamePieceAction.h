@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Action.h>
+#include "phaserids.h"
 
 namespace xero {
     namespace phaser {
@@ -9,6 +10,7 @@ namespace xero {
         class GamePieceAction : public xero::base::Action {
         public:
             GamePieceAction(GamePieceManipulator &game_piece) : game_piece_(game_piece) {                
+                addCategory(ACTION_CATEGORY_GAMEPIECE) ;
             }
             
             GamePieceManipulator &getGamePiece() {
@@ -11,6 +11,7 @@ namespace xero {
     namespace phaser {
         GamePieceManipulator::GamePieceManipulator(Robot &robot) : Subsystem(robot, "gamepiecemanipulator") 
         {
+            acceptCategory(ACTION_CATEGORY_GAMEPIECE) ;
             SettingsParser &settings = robot.getSettingsParser() ;            
             bool victor = true ;
 
@@ -51,11 +52,6 @@ namespace xero {
             Subsystem::run() ;
         }
 
-        bool GamePieceManipulator::canAcceptAction(ActionPtr action) {
-            std::shared_ptr<GamePieceAction> gact = std::dynamic_pointer_cast<GamePieceAction>(action) ;
-            return gact != nullptr ;
-        }
-
         GamePieceType GamePieceManipulator::getGamePieceType() {
             GamePieceType ret = GamePieceType::Invalid ;
             bool hatch = hatch_holder_->hasHatch() ;
@@ -38,7 +38,6 @@ namespace xero {
                 return turntable_ ;
             }
 
-            virtual bool canAcceptAction(xero::base::ActionPtr action) ;
             virtual void run() ;
             virtual void init(xero::base::LoopType ltype) ;
 
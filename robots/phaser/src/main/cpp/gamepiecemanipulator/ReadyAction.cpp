@@ -5,6 +5,7 @@
 #include "carloshatch/CarlosHatchArmAction.h"
 #include "phaserids.h"
 #include <Robot.h>
+#include <ActionPool.h>
 #include <xeromath.h>
 #include <MessageLogger.h>
 #include <cmath>
@@ -35,11 +36,11 @@ namespace xero {
             else
                 angle_value_ = subsystem.getRobot().getSettingsParser().getDouble(angle) ;
 
-            set_lifter_safe_height_ = std::make_shared<LifterGoToHeightAction>(*lifter, "turntable:safe_lifter_height") ;
-            set_lifter_final_height_ = std::make_shared<LifterGoToHeightAction>(*lifter, height_value_) ;
-            set_turntable_angle_ = std::make_shared<TurntableGoToAngleAction>(*turntable, angle_value_) ;
-            extend_hatch_holder_ = std::make_shared<CarlosHatchArmAction>(*hatch_holder, CarlosHatchArmAction::Operation::EXTEND) ;
-            retract_hatch_holder_ = std::make_shared<CarlosHatchArmAction>(*hatch_holder, CarlosHatchArmAction::Operation::RETRACT) ;
+            set_lifter_safe_height_ = ActionPool::create<LifterGoToHeightAction>(*lifter, "turntable:safe_lifter_height") ;
+            set_lifter_final_height_ = ActionPool::create<LifterGoToHeightAction>(*lifter, height_value_) ;
+            set_turntable_angle_ = ActionPool::create<TurntableGoToAngleAction>(*turntable, angle_value_) ;
+            extend_hatch_holder_ = ActionPool::create<CarlosHatchArmAction>(*hatch_holder, CarlosHatchArmAction::Operation::EXTEND) ;
+            retract_hatch_holder_ = ActionPool::create<CarlosHatchArmAction>(*hatch_holder, CarlosHatchArmAction::Operation::RETRACT) ;
 
             turntable_velocity_threshold_ = 5.0 ;
         }
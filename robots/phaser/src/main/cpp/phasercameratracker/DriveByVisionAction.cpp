@@ -14,13 +14,7 @@ namespace xero {
 
         DriveByVisionAction::DriveByVisionAction(TankDrive &tank_drive, PhaserCameraTracker &camera, bool reverse) : TankDriveAction(tank_drive), camera_(camera)
         {
-            yaw_base_power_ = tank_drive.getRobot().getSettingsParser().getDouble("drivebyvision:yaw_base_power") ;
-            yaw_p_ = tank_drive.getRobot().getSettingsParser().getDouble("drivebyvision:yaw_p") ;
-
             reverse_ = reverse ;
-            if (reverse) {
-                yaw_base_power_ = -yaw_base_power_ ;
-            }
         }
 
         std::string DriveByVisionAction::toString(DriveByVisionAction::State st) {
@@ -44,6 +38,15 @@ namespace xero {
         }
 
         void DriveByVisionAction::start() {
+            //
+            // Read the settings here rather than in the constructor so that values
+            // reloaded while the robot is running are used
+            //
+            yaw_base_power_ = camera_.getYawBasePower().get() ;
+            yaw_p_ = camera_.getYawP().get() ;
+            if (reverse_)
+                yaw_base_power_ = -yaw_base_power_ ;
+
             state_ = State::DriveYaw ;
             lost_count_ = 0 ;
 
@@ -102,13 +105,16 @@ namespace xero {
                     double right = yaw_base_power_ - yawadj ;
                     setMotorsToPercents(left, right) ;
 
-                    getTankDrive().getRobot().addPlotData(plotid_, index_, 0, elapsed) ;
-                    getTankDrive().getRobot().addPlotData(plotid_, index_, 1, desired_yaw) ;
-                    getTankDrive().getRobot().addPlotData(plotid_, index_, 2, yaw) ;
-                    getTankDrive().getRobot().addPlotData(plotid_, index_, 3, yawerror) ;
-                    getTankDrive().getRobot().addPlotData(plotid_, index_, 4, yawadj) ;
-                    getTankDrive().getRobot().addPlotData(plotid_, index_, 5, left) ;                    
-                    getTankDrive().getRobot().addPlotData(plotid_, index_, 6, right) ;  
+                    double data[] = {
+                        elapsed,
+                        desired_yaw,
+                        yaw,
+                        yawerror,
+                        yawadj,
+                        left,
+                        right
+                    } ;
+                    getTankDrive().getRobot().addPlotRow(plotid_, index_, data) ;
 
                     index_++ ;    
 
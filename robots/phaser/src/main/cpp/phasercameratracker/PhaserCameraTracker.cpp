@@ -10,24 +10,22 @@ namespace xero {
     namespace phaser {
 
         PhaserCameraTracker::PhaserCameraTracker(Robot &robot) : CameraTracker(robot), ITerminator("Vision") {
+            acceptCategory(ACTION_CATEGORY_SETTHRESHOLD) ;
             distance_threshold_ = robot.getSettingsParser().getDouble("cameratracker:distance_threshold") ;
             rect_ratio_min_ = robot.getSettingsParser().getDouble("cameratracker:rect_ratio_min") ;
             rect_ratio_max_ = robot.getSettingsParser().getDouble("cameratracker:rect_ratio_max") ;      
+
+            yaw_base_power_ref_ = robot.getSettingsParser().getRef<double>("drivebyvision:yaw_base_power") ;
+            yaw_p_ref_ = robot.getSettingsParser().getRef<double>("drivebyvision:yaw_p") ;
         }
 
         PhaserCameraTracker::~PhaserCameraTracker() {            
         }
 
-        bool PhaserCameraTracker::canAcceptAction(ActionPtr ptr) {
-            if (CameraTracker::canAcceptAction(ptr))
-                return true ;
-
-            auto act = std::dynamic_pointer_cast<SetThresholdAction>(ptr) ;
-            return act != nullptr ;
-        }
 
         void PhaserCameraTracker::computeState() {
-            rect_ratio_ = getNetworkTable()->GetNumber(TargetRectRatio, 0.0) ;
+            if (isTableChanged())
+                rect_ratio_ = getNetworkTable()->GetNumber(TargetRectRatio, 0.0) ;
             CameraTracker::computeState() ;
         }
 
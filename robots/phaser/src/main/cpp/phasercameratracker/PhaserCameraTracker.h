@@ -3,6 +3,7 @@
 #include <cameratracker/CameraTracker.h>
 #include <frc/Relay.h>
 #include <ITerminator.h>
+#include <SettingRef.h>
 
 namespace xero {
     namespace phaser {
@@ -25,7 +26,13 @@ namespace xero {
                 distance_threshold_ = d ;
             }
 
-            virtual bool canAcceptAction(xero::base::ActionPtr act) ;
+            const xero::misc::SettingRef<double> &getYawBasePower() const {
+                return yaw_base_power_ref_ ;
+            }
+
+            const xero::misc::SettingRef<double> &getYawP() const {
+                return yaw_p_ref_ ;
+            }
 
         private:
             constexpr static const char *TargetRectRatio = "rect_ratio" ;
@@ -35,6 +42,12 @@ namespace xero {
             double rect_ratio_min_ ;
             double rect_ratio_max_ ;         
             double rect_ratio_ ;   
+
+            //
+            // Handles to the settings for DriveByVisionAction
+            //
+            xero::misc::SettingRef<double> yaw_base_power_ref_ ;
+            xero::misc::SettingRef<double> yaw_p_ref_ ;
         } ;
     }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "PhaserCameraTracker.h"
 #include <Action.h>
+#include "phaserids.h"
 
 namespace xero {
     namespace phaser {
@@ -9,6 +10,7 @@ namespace xero {
         {
         public:
             SetThresholdAction(PhaserCameraTracker &subsystem, double dist) : camera_(subsystem) {
+                addCategory(ACTION_CATEGORY_SETTHRESHOLD) ;
                 dist_ =dist ;
             }
 
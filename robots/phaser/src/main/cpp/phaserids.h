@@ -1,6 +1,7 @@
 #pragma once
 
 #include <basegroups.h>
+#include <basecategories.h>
 
 //
 // This file contains the group numbers for message logging.  Group nubmers
@@ -34,4 +35,25 @@
 
 #define MSG_GROUP_STRAFE                            (1ull << 43)
 
-#define MSG_GROUP_HATCH_HOLDER_VERBOSE              (1ull << 44)
\ No newline at end of file
+#define MSG_GROUP_HATCH_HOLDER_VERBOSE              (1ull << 44)
+
+//
+// The action categories for the robot actions.  Categories with bits 16 to 31 set
+// are reserved for the robot, bits 0 to 15 are used by the xerobase library
+//
+
+#define ACTION_CATEGORY_TURNTABLE                   (1u << 16)
+
+#define ACTION_CATEGORY_GAMEPIECE                   (1u << 17)
+
+#define ACTION_CATEGORY_CARLOSHATCH                 (1u << 18)
+
+#define ACTION_CATEGORY_CARGOINTAKE                 (1u << 19)
+
+#define ACTION_CATEGORY_CLIMBER                     (1u << 20)
+
+#define ACTION_CATEGORY_CLIMB                       (1u << 21)
+
+#define ACTION_CATEGORY_STRAFE                      (1u << 22)
+
+#define ACTION_CATEGORY_SETTHRESHOLD                (1u << 23)
@@ -35,6 +35,7 @@
 #include <TerminateAction.h>
 #include <DelayAction.h>
 #include <frc/smartdashboard/SmartDashboard.h>
+#include <ActionPool.h>
 
 using namespace xero::base ;
 using namespace xero::misc ;
@@ -176,13 +177,13 @@ namespace xero {
             if ((mode_ == OperationMode::Manual || mode_ == OperationMode::SemiAuto || mode_ == OperationMode::Invalid) && newmode == OperationMode::Auto)
             {
                 // Switch camera to tracking mode
-                auto act = std::make_shared<CameraChangeAction>(*camera, camera->getCameraIndex(), CameraTracker::CameraMode::TargetTracking) ;
+                auto act = ActionPool::create<CameraChangeAction>(*camera, camera->getCameraIndex(), CameraTracker::CameraMode::TargetTracking) ;
                 camera->setAction(act) ;
             }
             else if (mode_ == OperationMode::Auto && (newmode == OperationMode::Manual || newmode == OperationMode::SemiAuto || mode_ == OperationMode::Invalid))
             {
                 // Switch camera to viewing mode
-                auto act = std::make_shared<CameraChangeAction>(*camera, camera->getCameraIndex(), CameraTracker::CameraMode::DriverViewing) ;
+                auto act = ActionPool::create<CameraChangeAction>(*camera, camera->getCameraIndex(), CameraTracker::CameraMode::DriverViewing) ;
                 camera->setAction(act) ;
             }
 
@@ -254,7 +255,7 @@ namespace xero {
                     log << "cargo" ;
                 log.endMessage() ;
 
-                ActionPtr ptr = std::make_shared<CameraChangeAction>(*camera, camerano, camera->getCameraMode()) ;
+                ActionPtr ptr = ActionPool::create<CameraChangeAction>(*camera, camerano, camera->getCameraMode()) ;
                 seq.pushSubActionPair(camera, ptr) ;
             }
         }
@@ -618,7 +619,7 @@ namespace xero {
 
             SettingsParser &parser = getSubsystem().getRobot().getSettingsParser() ;
             if ((height == "@" || parser.isDefined(height)) && (angle == "@" || parser.isDefined(angle))) {
-                act = std::make_shared<ReadyAction>(*game, height, angle, leave) ;
+                act = ActionPool::create<ReadyAction>(*game, height, angle, leave) ;
                 seq.pushSubActionPair(game, act, false) ;
             }
             else {
@@ -760,7 +761,7 @@ namespace xero {
                 std::shared_ptr<TeleopController> teleop = std::dynamic_pointer_cast<TeleopController>(ctrl) ;
                 teleop->clearDetectors() ;
 
-                ActionPtr act = std::make_shared<CarlosHatchImpactAction>(*hatchholder, push) ;
+                ActionPtr act = ActionPool::create<CarlosHatchImpactAction>(*hatchholder, push) ;
                 seq.pushSubActionPair(hatchholder, act) ;
 
                 setupVisionDetectors() ;
@@ -797,7 +798,7 @@ namespace xero {
                 std::shared_ptr<TeleopController> teleop = std::dynamic_pointer_cast<TeleopController>(ctrl) ;
                 teleop->clearDetectors() ;
 
-                ActionPtr act = std::make_shared<CarlosHatchImpactAction>(*hatchholder, push) ;
+                ActionPtr act = ActionPool::create<CarlosHatchImpactAction>(*hatchholder, push) ;
                 seq.pushSubActionPair(hatchholder, act) ;
 
                 setupLineFollowingDetectors() ;
@@ -811,7 +812,7 @@ namespace xero {
             bool push = true ;
             if (height_ == ActionHeight::LevelTwo || height_ == ActionHeight::LevelThree)
                 push = false ;
-            ActionPtr act = std::make_shared<CarlosHatchImpactAction>(*hatchholder, push) ;
+            ActionPtr act = ActionPool::create<CarlosHatchImpactAction>(*hatchholder, push) ;
             seq.pushSubActionPair(hatchholder, act) ;
         }
 
@@ -868,13 +869,13 @@ namespace xero {
                 case ActionHeight::CargoBay:
                     break ;
                 case ActionHeight::LevelOne:
-                    strafe_ = std::make_shared<StrafeAction>(*ph.getPhaserRobotSubsystem(), 1) ;
+                    strafe_ = ActionPool::create<StrafeAction>(*ph.getPhaserRobotSubsystem(), 1) ;
                     break ;
                 case ActionHeight::LevelTwo:
-                    strafe_ = std::make_shared<StrafeAction>(*ph.getPhaserRobotSubsystem(), 2) ;
+                    strafe_ = ActionPool::create<StrafeAction>(*ph.getPhaserRobotSubsystem(), 2) ;
                     break ;
                 case ActionHeight::LevelThree:
-                    strafe_ = std::make_shared<StrafeAction>(*ph.getPhaserRobotSubsystem(), 3) ;
+                    strafe_ = ActionPool::create<StrafeAction>(*ph.getPhaserRobotSubsystem(), 3) ;
                     break ;
                 }
                 ph.getPhaserRobotSubsystem()->setAction(strafe_) ;
@@ -883,7 +884,7 @@ namespace xero {
                 //
                 // Rocket ship, always do first line
                 //
-                strafe_ = std::make_shared<StrafeAction>(*ph.getPhaserRobotSubsystem()) ;
+                strafe_ = ActionPool::create<StrafeAction>(*ph.getPhaserRobotSubsystem()) ;
                 ph.getPhaserRobotSubsystem()->setAction(strafe_) ;
             }
         }
@@ -1155,7 +1156,7 @@ namespace xero {
                 // Dump a hatch if we are setup to place one.  This can also be used to 
                 // place a hatch at level three.
                 //
-                auto act = std::make_shared<DumpHatch>(*hatch_holder) ;
+                auto act = ActionPool::create<DumpHatch>(*hatch_holder) ;
                 seq.pushSubActionPair(hatch_holder, act) ;
             }
             else if (!finish_collect_cargo_->isDone() && getValue(go_)) {
@@ -1,4 +1,5 @@
 #include "ClimbAction.h"
+#include "phaserids.h"
 #include <tankdrive/TankDrive.h>
 #include <tankdrive/TankDriveDistanceAction.h>
 #include <tankdrive/TankDriveTimedPowerAction.h>
@@ -14,6 +15,7 @@ namespace xero {
     namespace phaser {
         ClimbAction::ClimbAction(PhaserRobotSubsystem &subsystem, bool complete): subsystem_(subsystem)
         {
+            addCategory(ACTION_CATEGORY_CLIMB) ;
             auto cargo_intake = subsystem_.getGameManipulator()->getCargoIntake() ;
             auto db = subsystem_.getTankDrive() ;
             auto climber = subsystem_.getClimber() ;
@@ -3,6 +3,7 @@
 #include "StrafeAction.h"
 #include "phaserids.h"
 #include <Robot.h>
+#include <tankdrive/TankDrive.h>
 #include <list>
 
 using namespace xero::base ;
@@ -11,18 +12,14 @@ using namespace xero::misc ;
 namespace xero {
     namespace phaser {
         PhaserRobotSubsystem::PhaserRobotSubsystem(Robot &robot) : RobotSubsystem(robot, "phaser") {
+            acceptCategory(ACTION_CATEGORY_CLIMB | ACTION_CATEGORY_STRAFE) ;
+
             //
             // Add the tank drive.  This is handled by the base class RobotSubsystem since all robots have a drivebase
             // and for now they are all tank drives
             //
             addTankDrive() ;
 
-            //
-            // Add the OI to the robot.  The OI is specific to this robot.
-            //
-            oi_ = std::make_shared<PhaserOISubsystem>(robot) ;
-            addChild(oi_) ;        
-
             front_line_sensor_ = std::make_shared<LightSensorSubsystem>(robot, "front", "hw:linesensor:front:", 3) ;    
             addChild(front_line_sensor_) ;
 
@@ -34,6 +31,24 @@ namespace xero {
             tracker_->setCameraIndex(0) ;
             addChild(tracker_) ;
 
+            //
+            // The tank drive computes its state first, so the tracker sees this loop's position.
+            // The line sensors compute their state at the same time as the tank drive when the
+            // robot has compute threads.
+            //
+            auto db = std::dynamic_pointer_cast<TankDrive>(getDriveBase()) ;
+            if (db != nullptr) {
+                tracker_->setPoseHistory(db->getPoseHistory()) ;
+                tracker_->computeAfter(db) ;
+            }
+
+            //
+            // Add the OI to the robot.  The OI is specific to this robot.  It is added after the
+            // sensors so they can all compute their state at the same time.
+            //
+            oi_ = std::make_shared<PhaserOISubsystem>(robot) ;
+            addChild(oi_) ;        
+
             game_piece_man_ = std::make_shared<GamePieceManipulator>(robot) ;
             addChild(game_piece_man_) ;
 
@@ -43,15 +58,6 @@ namespace xero {
 
         PhaserRobotSubsystem::~PhaserRobotSubsystem() {
         }
-
-        bool PhaserRobotSubsystem::canAcceptAction(ActionPtr act) {
-            std::shared_ptr<ClimbAction> climb = std::dynamic_pointer_cast<ClimbAction>(act) ;
-            if (climb != nullptr)
-                return true ;
-
-            std::shared_ptr<StrafeAction> strafe = std::dynamic_pointer_cast<StrafeAction>(act) ;
-            return strafe != nullptr ;
-        }
     }
 }
 
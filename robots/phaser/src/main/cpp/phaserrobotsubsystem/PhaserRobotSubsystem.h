@@ -48,7 +48,6 @@ namespace xero {
                 return game_piece_man_ ;
             }
 
-            virtual bool canAcceptAction(xero::base::ActionPtr action) ;
             
         private:
             std::shared_ptr<PhaserOISubsystem> oi_ ;
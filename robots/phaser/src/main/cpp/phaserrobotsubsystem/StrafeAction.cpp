@@ -7,6 +7,7 @@
 #include <tankdrive/TankDriveTimedPowerAction.h>
 #include <oi/DriverGamepadRumbleAction.h>
 #include <MessageLogger.h>
+#include <ActionPool.h>
 
 using namespace xero::base ;
 using namespace xero::misc ;
@@ -15,6 +16,7 @@ namespace xero {
     namespace phaser {
         StrafeAction::StrafeAction(PhaserRobotSubsystem &subsystem): subsystem_(subsystem)
         {
+            addCategory(ACTION_CATEGORY_STRAFE) ;
             auto db = subsystem_.getTankDrive() ;
             auto game = subsystem_.getGameManipulator() ;
             auto oi = subsystem_.getOI() ;
@@ -26,11 +28,12 @@ namespace xero {
             shoot_dist_ = subsystem.getRobot().getSettingsParser().getDouble("strafe:rocket:shoot_distance") ;
             vel_factor_ = subsystem.getRobot().getSettingsParser().getDouble("strafe:rocket:velocity_factor") ;    
 
-            shoot_ = std::make_shared<ScoreCargo>(*game) ;
+            shoot_ = ActionPool::create<ScoreCargo>(*game) ;
         }
 
         StrafeAction::StrafeAction(PhaserRobotSubsystem &subsystem, int count): subsystem_(subsystem)
         {
+            addCategory(ACTION_CATEGORY_STRAFE) ;
             auto db = subsystem_.getTankDrive() ;
             auto game = subsystem_.getGameManipulator() ;
             auto oi = subsystem_.getOI() ;
@@ -42,7 +45,7 @@ namespace xero {
             shoot_dist_ = subsystem.getRobot().getSettingsParser().getDouble("strafe:ship:shoot_distance") ;
             vel_factor_ = subsystem.getRobot().getSettingsParser().getDouble("strafe:ship:velocity_factor") ;
 
-            shoot_ = std::make_shared<ScoreCargo>(*game) ;
+            shoot_ = ActionPool::create<ScoreCargo>(*game) ;
         }
 
         StrafeAction::~StrafeAction() {
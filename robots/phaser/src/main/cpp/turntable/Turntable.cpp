@@ -13,11 +13,22 @@ using namespace xero::misc ;
 
 namespace xero{
     namespace phaser{
-        Turntable::Turntable(Robot &robot, Lifter &lifter, uint64_t id, uint64_t verboseid) : Subsystem(robot, "turntable"), lifter_(lifter) {
+        Turntable::Turntable(Robot &robot, Lifter &lifter, uint64_t id, uint64_t verboseid) : Subsystem(robot, "turntable"), 
+                        hold_refs_(robot.getSettingsParser(), "turntable:hold", true), lifter_(lifter) {
 
             SettingsParser &parser = robot.getSettingsParser() ;
+
+            threshold_ref_ = parser.getRef<double>("turntable:threshold") ;
+            maxv_ref_ = parser.getRef<double>("turntable:maxv") ;
+            maxa_ref_ = parser.getRef<double>("turntable:maxa") ;
+            maxd_ref_ = parser.getRef<double>("turntable:maxd") ;
+            follower_kv_ref_ = parser.getRef<double>("turntable:follower:kv") ;
+            follower_ka_ref_ = parser.getRef<double>("turntable:follower:ka") ;
+            follower_kp_ref_ = parser.getRef<double>("turntable:follower:kp") ;
+            follower_kd_ref_ = parser.getRef<double>("turntable:follower:kd") ;
             msg_id_ = id ;
             msg_verbose_id_ = verboseid ;
+            setParallelCompute(true) ;
             
             getMotors(robot) ;
             assert(motors_.size() > 0) ;
@@ -102,7 +113,7 @@ namespace xero{
                 motors_.front()->Set(ctre::phoenix::motorcontrol::ControlMode::PercentOutput, v);
         }
 
-        bool Turntable::canAcceptAction(ActionPtr action) {
+        bool Turntable::canAcceptAction(const ActionPtr &action) {
             return true ;
             
             auto dir_p = std::dynamic_pointer_cast<TurntableAction>(action) ;
@@ -5,6 +5,8 @@
 #include <ctre/Phoenix.h>
 #include <frc/Encoder.h>
 #include <frc/DigitalInput.h>
+#include <PIDCtrl.h>
+#include <SettingRef.h>
 typedef ctre::phoenix::motorcontrol::can::TalonSRX TalonSRX;
 
 namespace xero {
@@ -20,7 +22,7 @@ namespace xero {
              Turntable(xero::base::Robot &robot, xero::base::Lifter &lifter, uint64_t id, uint64_t verboseid) ;
              virtual ~Turntable() ;
 
-             virtual bool canAcceptAction(xero::base::ActionPtr action) ;
+             virtual bool canAcceptAction(const xero::base::ActionPtr &action) ;
              virtual void computeState() ;    
 
              int getEncoderValue() const {
@@ -110,6 +112,20 @@ namespace xero {
             //
             double last_angle_;
 
+            //
+            // Handles to the settings used by TurntableGoToAngleAction, resolved once here
+            // so that creating an action does not look each one up by name.
+            //
+            xero::misc::SettingRef<double> threshold_ref_ ;
+            xero::misc::SettingRef<double> maxv_ref_ ;
+            xero::misc::SettingRef<double> maxa_ref_ ;
+            xero::misc::SettingRef<double> maxd_ref_ ;
+            xero::misc::SettingRef<double> follower_kv_ref_ ;
+            xero::misc::SettingRef<double> follower_ka_ref_ ;
+            xero::misc::SettingRef<double> follower_kp_ref_ ;
+            xero::misc::SettingRef<double> follower_kd_ref_ ;
+            xero::misc::PIDCtrl::SettingRefs hold_refs_ ;
+
             uint64_t msg_id_ ;
             uint64_t msg_verbose_id_ ;
 
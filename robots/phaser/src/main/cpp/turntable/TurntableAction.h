@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Action.h>
+#include "phaserids.h"
 
 namespace xero {
     namespace phaser {
@@ -9,6 +10,7 @@ namespace xero {
         class TurntableAction : public xero::base::Action {
         public:
             TurntableAction(Turntable &turntable) : turntable_(turntable) {
+                addCategory(ACTION_CATEGORY_TURNTABLE) ;
             }
 
         protected:
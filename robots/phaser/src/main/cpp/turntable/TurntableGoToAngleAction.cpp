@@ -17,30 +17,30 @@ namespace xero {
 
         TurntableGoToAngleAction::TurntableGoToAngleAction(Turntable &turntable, double target) : TurntableAction(turntable) {
             target_ = target ;
-            threshold_ = getTurntable().getRobot().getSettingsParser().getDouble("turntable:threshold") ;
-            ctrl_ = std::make_shared<PIDACtrl>(turntable.getRobot().getSettingsParser(), "turntable:follower:kv", 
-                                "turntable:follower:ka", "turntable:follower:kp", "turntable:follower:kd", true) ;
-
-            double maxv = getTurntable().getRobot().getSettingsParser().getDouble("turntable:maxv")  ;
-            double maxa = getTurntable().getRobot().getSettingsParser().getDouble("turntable:maxa")  ;
-            double maxd = getTurntable().getRobot().getSettingsParser().getDouble("turntable:maxd")  ;                        
-            profile_ = std::make_shared<TrapezoidalProfile>(maxa, maxd, maxv) ;
-
-            pidctrl_.initFromSettingsExtended(getTurntable().getRobot().getSettingsParser(), "turntable:hold", true) ;       
+            readSettings() ;
         }
 
         TurntableGoToAngleAction::TurntableGoToAngleAction(Turntable &turntable, const std::string &name) : TurntableAction(turntable) {
-            target_ = getTurntable().getRobot().getSettingsParser().getDouble(name) ;
-            threshold_ = getTurntable().getRobot().getSettingsParser().getDouble("turntable:threshold") ;
-            ctrl_ = std::make_shared<PIDACtrl>(turntable.getRobot().getSettingsParser(), "turntable:follower:kv", 
-                                "turntable:follower:ka", "turntable:follower:kp", "turntable:follower:kd", true) ;  
-                                  
-            double maxv = getTurntable().getRobot().getSettingsParser().getDouble("turntable:maxv")  ;
-            double maxa = getTurntable().getRobot().getSettingsParser().getDouble("turntable:maxa")  ;
-            double maxd = getTurntable().getRobot().getSettingsParser().getDouble("turntable:maxd")  ;                        
-            profile_ = std::make_shared<TrapezoidalProfile>(maxa, maxd, maxv) ;   
-
-            pidctrl_.initFromSettingsExtended(getTurntable().getRobot().getSettingsParser(), "turntable:hold", true) ;              
+            target_ref_ = getTurntable().getRobot().getSettingsParser().getRef<double>(name) ;
+            readSettings() ;
+        }
+
+        void TurntableGoToAngleAction::readSettings() {
+            Turntable &turntable = getTurntable() ;
+
+            //
+            // The settings are read again each time the action starts so that values
+            // reloaded while the robot is running are used
+            //
+            if (target_ref_.isDefined())
+                target_ = target_ref_.get() ;
+
+            threshold_ = turntable.threshold_ref_.get() ;
+            ctrl_ = std::make_shared<PIDACtrl>(turntable.follower_kv_ref_.get(), turntable.follower_ka_ref_.get(),
+                                turntable.follower_kp_ref_.get(), turntable.follower_kd_ref_.get(), true) ;
+
+            profile_ = std::make_shared<TrapezoidalProfile>(turntable.maxa_ref_.get(), turntable.maxd_ref_.get(), turntable.maxv_ref_.get()) ;
+            pidctrl_.initFromSettings(turntable.hold_refs_, true) ;
         }
 
         TurntableGoToAngleAction::~TurntableGoToAngleAction() {
@@ -81,6 +81,8 @@ namespace xero {
         }
 
         void TurntableGoToAngleAction::start() {
+            readSettings() ;
+
             lost_encoders_ = false ;
             start_time_ = getTurntable().getRobot().getTime() ;
 
@@ -180,13 +182,16 @@ namespace xero {
                         double out = ctrl_->getOutput(tacc, tvel, tdist, traveled, dt) ;
                         turntable.setMotorPower(out) ;
 
-                        turntable.getRobot().addPlotData(plotid_, index_, 0, elapsed) ;
-                        turntable.getRobot().addPlotData(plotid_, index_, 1, tdist + start_angle_) ;
-                        turntable.getRobot().addPlotData(plotid_, index_, 2, traveled + start_angle_) ;
-                        turntable.getRobot().addPlotData(plotid_, index_, 3, tvel) ;
-                        turntable.getRobot().addPlotData(plotid_, index_, 4, speed) ;
-                        turntable.getRobot().addPlotData(plotid_, index_, 5, out) ;
-                        turntable.getRobot().addPlotData(plotid_, index_, 6, error) ;
+                        double data[] = {
+                            elapsed,
+                            tdist + start_angle_,
+                            traveled + start_angle_,
+                            tvel,
+                            speed,
+                            out,
+                            error
+                        } ;
+                        turntable.getRobot().addPlotRow(plotid_, index_, data) ;
 
                         index_++ ;
                     }
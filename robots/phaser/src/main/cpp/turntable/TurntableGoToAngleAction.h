@@ -5,6 +5,7 @@
 #include <PIDACtrl.h>
 #include <PIDCtrl.h>
 #include <TrapezoidalProfile.h>
+#include <SettingRef.h>
 
 namespace xero {
     namespace phaser {
@@ -25,12 +26,14 @@ namespace xero {
             }
 
         private:
+            void readSettings() ;
             double getAngleDifference(double start, double end) ;
 
         private:
             bool is_done_ ;
             bool lost_encoders_ ;
             double target_ ;
+            xero::misc::SettingRef<double> target_ref_ ;
             double output_ ;
             double start_time_ ;
             double last_pos_ ;
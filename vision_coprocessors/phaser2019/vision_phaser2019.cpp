@@ -133,6 +133,8 @@ namespace {
     // Network table entries where results from tracking will be posted.
     nt::NetworkTableEntry nt_pipe_fps;
     nt::NetworkTableEntry nt_pipe_runtime_ms;
+    nt::NetworkTableEntry nt_frame;
+    nt::NetworkTableEntry nt_latency_ms;
     nt::NetworkTableEntry nt_target_dist_pixels;
     nt::NetworkTableEntry nt_target_dist_inch;
     nt::NetworkTableEntry nt_target_dist2_inch;
@@ -1340,6 +1342,7 @@ namespace {
         const int frames_to_sample_per_report = 20;
         int frames_processed = 0;
         double total_processing_time = 0;
+        double frame_number = 0;
 
         XeroPipeline() {
             pipe_elements_.push_back(new XeroPipelineElementHsvThreshold("HSV Threshold"));
@@ -1380,6 +1383,14 @@ namespace {
             const double end_time = frc::Timer::GetFPGATimestamp();
             total_processing_time += (end_time - start_time);
 
+            // Report the frame number and how old the results are when they are sent, so the
+            // robot can work out where it was when the frame was captured.  The two clocks are
+            // not the same, so only the difference is sent.
+            ++frame_number;
+            nt_frame.SetDouble(frame_number);
+            nt_latency_ms.SetDouble(1000.0 * (frc::Timer::GetFPGATimestamp() - start_time));
+            ntinst.Flush();
+
             // Report average processing time every X calls,
             // then reset metrics for next window to measure and report
             if (frames_processed == frames_to_sample_per_report) {
@@ -1598,6 +1609,10 @@ int main(int argc, char* argv[]) {
     nt_pipe_fps.SetDefaultDouble(0);
     nt_pipe_runtime_ms = nt_table->GetEntry("pipe_runtime_ms");
     nt_pipe_runtime_ms.SetDefaultDouble(0);
+    nt_frame = nt_table->GetEntry("frame");
+    nt_frame.SetDefaultDouble(-1);
+    nt_latency_ms = nt_table->GetEntry("latency_ms");
+    nt_latency_ms.SetDefaultDouble(0);
     nt_target_dist_pixels = nt_table->GetEntry("dist_pixels");
     nt_target_dist_pixels.SetDefaultDouble(0);
     nt_target_dist_inch = nt_table->GetEntry("dist_inch");
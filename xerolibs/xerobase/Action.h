@@ -1,5 +1,6 @@
 #pragma once
 #include <frc/Timer.h>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
@@ -20,6 +21,19 @@ namespace xero {
         /// \sa ActionSequence
         class Action {
         public:
+            /// \brief create an action that belongs to no category
+            Action() {
+                categories_ = 0 ;
+            }
+
+            /// \brief return the categories of the action, see basecategories.h
+            /// A subsystem accepts an action if the action is in one of the categories the
+            /// subsystem accepts, which is a single test of the two masks.
+            /// \returns the categories of the action
+            uint32_t getCategories() const {
+                return categories_ ;
+            }
+
             /// \brief Start the action; called once per action when it starts
             virtual void start() = 0 ;
 
@@ -49,7 +63,17 @@ namespace xero {
             /// \brief return a human readable string representing the action
             /// \returns a human readable string representing the action
             virtual std::string toString() = 0 ;
+
+        protected:
+            /// \brief add the action to a category
+            /// The base class for the actions of a subsystem calls this in its constructor.
+            /// \param category the category to add, see basecategories.h
+            void addCategory(uint32_t category) {
+                categories_ |= category ;
+            }
+
         private:
+            uint32_t categories_ ;
         };
 
         /// \brief a shared pointer to an action
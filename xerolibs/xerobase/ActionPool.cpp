@@ -0,0 +1,60 @@
+#include "ActionPool.h"
+
+using namespace xero::misc ;
+
+namespace xero {
+    namespace base {
+
+        constexpr size_t ActionPool::Capacity ;
+
+        namespace {
+            std::mutex pools_lock ;
+
+            std::vector<BlockPool *> &pools() {
+                static std::vector<BlockPool *> *pools = new std::vector<BlockPool *>() ;
+                return *pools ;
+            }
+        }
+
+        PoolCounters &ActionPool::totals() {
+            static PoolCounters *totals = new PoolCounters() ;
+            return *totals ;
+        }
+
+        BlockPool *ActionPool::addPool(BlockPool *pool) {
+            std::lock_guard<std::mutex> lock(pools_lock) ;
+            pools().push_back(pool) ;
+            return pool ;
+        }
+
+        size_t ActionPool::getPoolCount() {
+            std::lock_guard<std::mutex> lock(pools_lock) ;
+            return pools().size() ;
+        }
+
+        void ActionPool::log(MessageLogger &logger) {
+            size_t full = 0 ;
+            size_t count ;
+
+            {
+                std::lock_guard<std::mutex> lock(pools_lock) ;
+                count = pools().size() ;
+                for(BlockPool *pool : pools()) {
+                    if (pool->getCounters().getHeapAllocations() > 0)
+                        full++ ;
+                }
+            }
+
+            const PoolCounters &t = totals() ;
+            logger.startMessage(MessageLogger::MessageType::info) ;
+            logger << "ActionPool: " << static_cast<uint32_t>(count) << " action types" ;
+            logger << ", live " << static_cast<uint32_t>(t.getLive()) ;
+            logger << ", peak " << static_cast<uint32_t>(t.getPeak()) ;
+            logger << ", created " << static_cast<uint32_t>(t.getAllocations()) ;
+            logger << ", from heap " << static_cast<uint32_t>(t.getHeapAllocations()) ;
+            if (full > 0)
+                logger << ", " << static_cast<uint32_t>(full) << " pools too small" ;
+            logger.endMessage() ;
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Action.h"
+#include <BlockPool.h>
+#include <MessageLogger.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// \file
+
+namespace xero {
+    namespace base {
+        /// \brief creates actions from per type pools of memory
+        ///
+        /// Actions created while the robot is running, for example by the OI in response to
+        /// the driver, should be created with ActionPool::create() rather than std::make_shared().
+        /// Each action type has its own fixed size pool, so once the pool has been used the
+        /// action and its shared pointer control block are created without going to the heap.
+        /// If more actions of one type are alive than the pool holds, the extras come from the
+        /// heap and are counted so the pool size can be raised.
+        class ActionPool {
+        public:
+            /// \brief the number of actions of each type held by a pool
+            static constexpr size_t Capacity = 16 ;
+
+            /// \brief create a new action
+            /// \param args the arguments to the constructor of the action
+            /// \returns the new action
+            template <typename T, typename... Args>
+            static std::shared_ptr<T> create(Args&&... args) {
+                return std::allocate_shared<T>(xero::misc::PoolAllocator<T>(getPool<T>()), std::forward<Args>(args)...) ;
+            }
+
+            /// \brief return the counters for all of the pools together
+            /// \returns the counters for all of the pools together
+            static const xero::misc::PoolCounters &getTotals() {
+                return totals() ;
+            }
+
+            /// \brief return the number of action types that have a pool
+            /// \returns the number of action types that have a pool
+            static size_t getPoolCount() ;
+
+            /// \brief log the live and peak action counts
+            /// \param logger the message logger to use
+            static void log(xero::misc::MessageLogger &logger) ;
+
+        private:
+            //
+            // The pools are never destroyed, as actions held by static objects may be freed
+            // after the pools would have been destroyed when the program exits
+            //
+            template <typename T>
+            static xero::misc::BlockPool *getPool() {
+                static xero::misc::BlockPool *pool = addPool(new xero::misc::BlockPool(Capacity, &totals())) ;
+                return pool ;
+            }
+
+            static xero::misc::BlockPool *addPool(xero::misc::BlockPool *pool) ;
+            static xero::misc::PoolCounters &totals() ;
+        } ;
+    }
+}
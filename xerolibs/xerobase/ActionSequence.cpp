@@ -1,4 +1,5 @@
 #include "ActionSequence.h"
+#include "ActionPool.h"
 #include "basegroups.h"
 #include <frc/smartdashboard/SmartDashboard.h>
 #include <cassert>
@@ -14,6 +15,8 @@ ActionSequence::ActionSequence(xero::misc::MessageLogger &logger) : logger_(logg
 {
     isDone_ = false;
     group_ = MSG_GROUP_ACTIONS ;
+    dispatch_used_ = 0 ;
+    publish_steps_ = true ;
 }
 
 void ActionSequence::pushAction(ActionPtr action)
@@ -32,12 +35,11 @@ void ActionSequence::startNextAction()
     if (static_cast<size_t>(index_) < actionSequence_.size())
     {
         assert(group_ != 0) ;
-        logger_.startMessage(MessageLogger::MessageType::debug, group_) ;
-        logger_ << "Actions: starting " << index_ << " of " << actionSequence_.size() - 1 ;
-        logger_ << " '" << actionSequence_[index_]->toString() << "'" ;
-        logger_.endMessage() ;
+        XERO_LOG(logger_, MessageLogger::MessageType::debug, group_,
+            "Actions: starting " << index_ << " of " << actionSequence_.size() - 1 << " '" << actionSequence_[index_]->toString() << "'") ;
         actionSequence_[index_]->start();
-        frc::SmartDashboard::PutString("Step", actionSequence_[index_]->toString()) ;
+        if (publish_steps_)
+            frc::SmartDashboard::PutString("Step", actionSequence_[index_]->toString()) ;
     }
     else {
         //
@@ -57,10 +59,8 @@ void ActionSequence::run()
         if (index_ == -1 || actionSequence_[index_]->isDone())
         {
             if (index_ != -1) {
-                logger_.startMessage(MessageLogger::MessageType::debug, group_) ;
-                logger_ << "Actions: completed " << index_ << " of " << actionSequence_.size() - 1 ;
-                logger_ << " '" << actionSequence_[index_]->toString() << "'" ;
-                logger_.endMessage() ;
+                XERO_LOG(logger_, MessageLogger::MessageType::debug, group_,
+                    "Actions: completed " << index_ << " of " << actionSequence_.size() - 1 << " '" << actionSequence_[index_]->toString() << "'") ;
             }
             
             startNextAction();
@@ -103,8 +103,20 @@ std::string ActionSequence::toString()
 
 void ActionSequence::pushSubActionPair(SubsystemPtr subsystem, ActionPtr action, bool block)
 {
-    auto p = std::make_shared<DispatchAction>(subsystem, action, block);
-    pushAction(p);
+    //
+    // Use a wrapper from an earlier fill of the sequence if nothing else is holding on to it
+    //
+    if (dispatch_used_ < dispatch_slots_.size() && dispatch_slots_[dispatch_used_].use_count() == 1)
+        dispatch_slots_[dispatch_used_]->assign(subsystem, action, block) ;
+    else {
+        auto p = ActionPool::create<DispatchAction>(subsystem, action, block);
+        if (dispatch_used_ < dispatch_slots_.size())
+            dispatch_slots_[dispatch_used_] = p ;
+        else
+            dispatch_slots_.push_back(p) ;
+    }
+
+    pushAction(dispatch_slots_[dispatch_used_++]);
 }
 
 } // namespace base
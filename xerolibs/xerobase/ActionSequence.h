@@ -63,8 +63,20 @@ namespace xero {
             std::string toString();
             
             /// \brief clear the list of actions
+            /// The wrappers created by pushSubActionPair() are kept and used again as the
+            /// sequence is refilled, so a sequence that is rebuilt every robot loop does not
+            /// allocate memory once it has reached its largest size.
             void clear() {
                 actionSequence_.clear() ;
+                dispatch_used_ = 0 ;
+            }
+
+            /// \brief set whether the action being started is shown on the smart dashboard
+            /// This is useful for long sequences like the automodes, but a sequence rebuilt every
+            /// robot loop should turn it off to avoid building the strings.
+            /// \param publish if true, the action started is shown as the Step value
+            void setPublishSteps(bool publish) {
+                publish_steps_ = publish ;
             }
 
             /// \brief return the number of actions in the sequence
@@ -83,6 +95,13 @@ namespace xero {
             // the seqeuence of actions
             std::vector<ActionPtr> actionSequence_;
 
+            // the dispatch wrappers created so far, the first dispatch_used_ are in the sequence
+            std::vector<std::shared_ptr<DispatchAction>> dispatch_slots_ ;
+            size_t dispatch_used_ ;
+
+            // if true, the action started is shown on the smart dashboard
+            bool publish_steps_ ;
+
             // the index of the current action
             int index_;
 
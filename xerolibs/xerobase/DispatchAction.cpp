@@ -13,6 +13,13 @@ DispatchAction::DispatchAction(SubsystemPtr subsystem, ActionPtr action, bool bl
     denied_ = false;
 }
 
+void DispatchAction::assign(SubsystemPtr subsystem, ActionPtr action, bool block) {
+    subsystem_ = subsystem ;
+    action_ = action ;
+    block_ = block ;
+    denied_ = false ;
+}
+
 void DispatchAction::start() {
     if (!subsystem_->setAction(action_)) {
         MessageLogger &logger = subsystem_->getRobot().getMessageLogger() ;
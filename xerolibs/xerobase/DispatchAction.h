@@ -16,6 +16,14 @@ namespace xero {
             /// \param block if true, wait for the subsystem to complete the action before returning isDone() true
             DispatchAction(SubsystemPtr subsystem, ActionPtr action, bool block = true);
 
+            /// \brief point this wrapper at a new subsystem and action so it can be used again
+            /// This lets an action sequence that is cleared and refilled every robot loop keep
+            /// its wrappers rather than allocating new ones.
+            /// \param subsystem the subsystem to assign an action to
+            /// \param action the action to assign to the subsystem
+            /// \param block if true, wait for the subsystem to complete the action before returning isDone() true
+            void assign(SubsystemPtr subsystem, ActionPtr action, bool block = true);
+
             /// \brief start this wrapper action which just assigns the stored action to the subsystem
             void start();
 
@@ -0,0 +1,168 @@
+#include "LoopScheduler.h"
+#include <frc/Timer.h>
+#include <algorithm>
+#include <cassert>
+
+using namespace xero::misc ;
+
+namespace xero {
+    namespace base {
+
+        LoopScheduler::LoopStats::LoopStats(double period) :
+                jitter_(0.0, period, BucketCount), overrun_(0.0, period * 4.0, BucketCount) {
+            for(int i = 0 ; i < static_cast<int>(LoopPhase::MaxValue) ; i++)
+                phases_.push_back(Histogram(0.0, period, BucketCount)) ;
+
+            over_budget_.resize(static_cast<int>(LoopPhase::MaxValue)) ;
+            std::fill(over_budget_.begin(), over_budget_.end(), 0) ;
+        }
+
+        LoopScheduler::LoopScheduler(double period) {
+            period_ = period ;
+            restart_ = true ;
+            deadline_ = 0.0 ;
+            type_ = 0 ;
+            loop_start_ = 0.0 ;
+            phase_start_ = 0.0 ;
+            phase_ = LoopPhase::MaxValue ;
+            jitter_ = 0.0 ;
+            loop_time_ = 0.0 ;
+
+            phase_times_.resize(static_cast<int>(LoopPhase::MaxValue)) ;
+            std::fill(phase_times_.begin(), phase_times_.end(), 0.0) ;
+
+            //
+            // By default, every phase may use the whole loop.  The robot sets
+            // tighter budgets from the settings file.
+            //
+            budgets_.resize(static_cast<int>(LoopPhase::MaxValue)) ;
+            std::fill(budgets_.begin(), budgets_.end(), period) ;
+
+            for(int i = 0 ; i < static_cast<int>(LoopType::MaxValue) ; i++)
+                stats_.push_back(LoopStats(period)) ;
+        }
+
+        LoopScheduler::~LoopScheduler() {
+        }
+
+        void LoopScheduler::restart() {
+            restart_ = true ;
+        }
+
+        void LoopScheduler::clearStatistics() {
+            for(LoopStats &stats : stats_) {
+                stats.jitter_.clear() ;
+                stats.overrun_.clear() ;
+                for(Histogram &hist : stats.phases_)
+                    hist.clear() ;
+                std::fill(stats.over_budget_.begin(), stats.over_budget_.end(), 0) ;
+            }
+        }
+
+        double LoopScheduler::startLoop(LoopType type) {
+            loop_start_ = frc::Timer::GetFPGATimestamp() ;
+            type_ = static_cast<int>(type) ;
+
+            if (restart_) {
+                deadline_ = loop_start_ ;
+                restart_ = false ;
+            }
+
+            jitter_ = loop_start_ - deadline_ ;
+            stats_[type_].jitter_.add(jitter_) ;
+
+            std::fill(phase_times_.begin(), phase_times_.end(), 0.0) ;
+            loop_time_ = 0.0 ;
+            phase_ = LoopPhase::MaxValue ;
+
+            return loop_start_ ;
+        }
+
+        void LoopScheduler::startPhase(LoopPhase phase) {
+            assert(phase_ == LoopPhase::MaxValue) ;
+            phase_ = phase ;
+            phase_start_ = frc::Timer::GetFPGATimestamp() ;
+        }
+
+        void LoopScheduler::endPhase(LoopPhase phase) {
+            assert(phase == phase_) ;
+            phase_ = LoopPhase::MaxValue ;
+
+            int index = static_cast<int>(phase) ;
+            double elapsed = frc::Timer::GetFPGATimestamp() - phase_start_ ;
+
+            phase_times_[index] = elapsed ;
+            stats_[type_].phases_[index].add(elapsed) ;
+            if (elapsed > budgets_[index])
+                stats_[type_].over_budget_[index]++ ;
+        }
+
+        bool LoopScheduler::endLoop() {
+            loop_time_ = frc::Timer::GetFPGATimestamp() - loop_start_ ;
+            if (loop_time_ <= period_)
+                return false ;
+
+            stats_[type_].overrun_.add(loop_time_ - period_) ;
+            return true ;
+        }
+
+        double LoopScheduler::waitForDeadline() {
+            double now = frc::Timer::GetFPGATimestamp() ;
+            double sleep = 0.0 ;
+
+            deadline_ += period_ ;
+            if (now < deadline_) {
+                sleep = deadline_ - now ;
+                frc::Wait(sleep) ;
+            }
+            else if (now - deadline_ > period_) {
+                //
+                // We have missed at least one whole loop.  Rather than running a burst of
+                // back to back loops to catch up, move the schedule to start now.
+                //
+                deadline_ = now ;
+            }
+
+            return sleep ;
+        }
+
+        LoopPhase LoopScheduler::getWorstPhase() const {
+            LoopPhase worst = LoopPhase::MaxValue ;
+            double over = 0.0 ;
+
+            for(int i = 0 ; i < static_cast<int>(LoopPhase::MaxValue) ; i++) {
+                double diff = phase_times_[i] - budgets_[i] ;
+                if (diff > over) {
+                    over = diff ;
+                    worst = static_cast<LoopPhase>(i) ;
+                }
+            }
+
+            return worst ;
+        }
+
+        const char *LoopScheduler::toString(LoopPhase phase) {
+            const char *ret = "????" ;
+
+            switch(phase) {
+            case LoopPhase::ComputeState:
+                ret = "computeState" ;
+                break ;
+            case LoopPhase::Controller:
+                ret = "controller" ;
+                break ;
+            case LoopPhase::SubsystemRun:
+                ret = "run" ;
+                break ;
+            case LoopPhase::Logging:
+                ret = "logging" ;
+                break ;
+            case LoopPhase::MaxValue:
+                ret = "none" ;
+                break ;
+            }
+
+            return ret ;
+        }
+    }
+}
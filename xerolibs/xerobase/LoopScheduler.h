@@ -0,0 +1,197 @@
+#pragma once
+
+#include "LoopType.h"
+#include <Histogram.h>
+#include <vector>
+
+/// \file
+
+
+namespace xero {
+    namespace base {
+        /// \brief The phases of a single robot loop
+        enum class LoopPhase : int {
+            ComputeState = 0,                   ///< Subsystems computing their state
+            Controller = 1,                     ///< The controller for the current mode running
+            SubsystemRun = 2,                   ///< Subsystems running their actions
+            Logging = 3,                        ///< End of loop logging and reporting
+            MaxValue = 4,                       ///< Total number of loop phases
+        } ;
+
+        /// \brief This class schedules the robot loop at a fixed rate.
+        /// The start of every robot loop is scheduled at an absolute time that is a whole
+        /// number of loop periods from the time the schedule was restarted.  Sleeping until
+        /// this absolute deadline, rather than for the time left over in the current loop,
+        /// keeps the loop from drifting when individual loops run long.
+        /// <br>
+        /// Each phase of the robot loop is timed separately and compared against a budget
+        /// for the phase.  Histograms of the loop start jitter, the loop overrun, and of the
+        /// time spent in each phase are kept for each type of robot loop.
+        class LoopScheduler {
+        public:
+            /// \brief create a new loop scheduler
+            /// \param period the robot loop period in seconds
+            LoopScheduler(double period) ;
+
+            /// \brief destroy the loop scheduler
+            virtual ~LoopScheduler() ;
+
+            /// \brief return the loop period
+            /// \returns the loop period in seconds
+            double getPeriod() const {
+                return period_ ;
+            }
+
+            /// \brief set the time budget for a phase of the robot loop
+            /// \param phase the phase of interest
+            /// \param budget the budget for the phase in seconds
+            void setBudget(LoopPhase phase, double budget) {
+                budgets_[static_cast<int>(phase)] = budget ;
+            }
+
+            /// \brief return the time budget for a phase of the robot loop
+            /// \param phase the phase of interest
+            /// \returns the budget for the phase in seconds
+            double getBudget(LoopPhase phase) const {
+                return budgets_[static_cast<int>(phase)] ;
+            }
+
+            /// \brief restart the schedule so that the next loop is due immediately
+            void restart() ;
+
+            /// \brief mark the start of a robot loop
+            /// \param type the type of the robot loop being run
+            /// \returns the time the loop started in seconds
+            double startLoop(LoopType type) ;
+
+            /// \brief mark the start of a phase within the current loop
+            /// Phases do not nest, each phase must be ended before the next is started.
+            /// \param phase the phase being started
+            void startPhase(LoopPhase phase) ;
+
+            /// \brief mark the end of a phase within the current loop
+            /// \param phase the phase being ended, this must be the phase last started
+            void endPhase(LoopPhase phase) ;
+
+            /// \brief return the phase that has been started but not yet ended
+            /// \returns the phase being run, or LoopPhase::MaxValue if no phase is being run
+            LoopPhase getCurrentPhase() const {
+                return phase_ ;
+            }
+
+            /// \brief mark the end of the work for the current loop
+            /// This records the statistics for the loop but does not sleep
+            /// \returns true if the loop overran its period
+            bool endLoop() ;
+
+            /// \brief sleep until the start of the next loop is due
+            /// \returns the time slept in seconds
+            double waitForDeadline() ;
+
+            /// \brief return the time spent in a phase in the current loop
+            /// \param phase the phase of interest
+            /// \returns the time spent in the phase in seconds
+            double getPhaseTime(LoopPhase phase) const {
+                return phase_times_[static_cast<int>(phase)] ;
+            }
+
+            /// \brief return the time spent in the current loop, as of the call to endLoop()
+            /// \returns the time spent in the loop in seconds
+            double getLoopTime() const {
+                return loop_time_ ;
+            }
+
+            /// \brief return the jitter in the start of the current loop
+            /// \returns the time between when the loop was scheduled and when it started in seconds
+            double getJitter() const {
+                return jitter_ ;
+            }
+
+            /// \brief return the phase that was furthest over its budget in the current loop
+            /// \returns the phase furthest over budget, or LoopPhase::MaxValue if no phase was over budget
+            LoopPhase getWorstPhase() const ;
+
+            /// \brief return the histogram of loop start jitter for a loop type
+            /// \param type the loop type of interest
+            /// \returns the histogram of loop start jitter
+            const xero::misc::Histogram &getJitterHistogram(LoopType type) const {
+                return stats_[static_cast<int>(type)].jitter_ ;
+            }
+
+            /// \brief return the histogram of loop overruns for a loop type
+            /// Only loops that overran their period are added to this histogram
+            /// \param type the loop type of interest
+            /// \returns the histogram of loop overruns
+            const xero::misc::Histogram &getOverrunHistogram(LoopType type) const {
+                return stats_[static_cast<int>(type)].overrun_ ;
+            }
+
+            /// \brief return the histogram of the time spent in a phase for a loop type
+            /// \param type the loop type of interest
+            /// \param phase the phase of interest
+            /// \returns the histogram of the time spent in the phase
+            const xero::misc::Histogram &getPhaseHistogram(LoopType type, LoopPhase phase) const {
+                return stats_[static_cast<int>(type)].phases_[static_cast<int>(phase)] ;
+            }
+
+            /// \brief return the number of loops where a phase exceeded its budget
+            /// \param type the loop type of interest
+            /// \param phase the phase of interest
+            /// \returns the number of loops where the phase exceeded its budget
+            size_t getOverBudgetCount(LoopType type, LoopPhase phase) const {
+                return stats_[static_cast<int>(type)].over_budget_[static_cast<int>(phase)] ;
+            }
+
+            /// \brief clear all of the loop statistics
+            void clearStatistics() ;
+
+            /// \brief return a human readable name for a phase
+            /// \param phase the phase of interest
+            /// \returns a human readable name for the phase
+            static const char *toString(LoopPhase phase) ;
+
+        private:
+            struct LoopStats {
+                LoopStats(double period) ;
+
+                xero::misc::Histogram jitter_ ;
+                xero::misc::Histogram overrun_ ;
+                std::vector<xero::misc::Histogram> phases_ ;
+                std::vector<size_t> over_budget_ ;
+            } ;
+
+            static constexpr size_t BucketCount = 40 ;
+
+        private:
+            // The loop period in seconds
+            double period_ ;
+
+            // The absolute time the current loop was scheduled to start
+            double deadline_ ;
+
+            // True if the next call to startLoop() should restart the schedule
+            bool restart_ ;
+
+            // The type of the current loop
+            int type_ ;
+
+            // The start time of the current loop and the current phase
+            double loop_start_ ;
+            double phase_start_ ;
+
+            // The phase being run, MaxValue between phases
+            LoopPhase phase_ ;
+
+            // The timing for the current loop
+            double jitter_ ;
+            double loop_time_ ;
+            std::vector<double> phase_times_ ;
+
+            // The budget for each phase
+            std::vector<double> budgets_ ;
+
+            // The statistics for each loop type
+            std::vector<LoopStats> stats_ ;
+        } ;
+    }
+}
@@ -15,6 +15,8 @@ namespace xero {
                 throw ex;
             }
 
+            m_event = robot.watchSocket(m_server_in_p->getDescriptor(), "messagelistener");
+            m_data.resize(128);
         }
 
         MessageListener::~MessageListener() {
@@ -22,9 +24,14 @@ namespace xero {
         }
 
         void MessageListener::computeState() {
-            std::vector<uint8_t> data(128);
-            int ret = m_server_in_p->receive(data);
-            if (ret != -1) {
+            if (!getRobot().getEventQueue().hasEvent(m_event))
+                return;
+
+            //
+            // The socket is only watched for new data, so read everything that arrived
+            //
+            int ret;
+            while ((ret = m_server_in_p->receive(m_data)) != -1) {
                 std::cout << "MESSAGE RECEIVED  " << ret << "\n";
                 exit(0);
             }
@@ -23,6 +23,7 @@ namespace xero {
 
 
             /// \brief Check for pending messages. If any found, add them to the list of message.
+            /// The socket is only read when it has data, see Robot::watchSocket().
             virtual void computeState();
 
             /// \brief Run the subsystem. Nothing to do for this subsystem.
@@ -38,6 +39,12 @@ namespace xero {
             /// \brief Pointer to UDP baordcast receiver.
             xero::misc::UdpReceiver* m_server_in_p;
 
+            /// \brief The event source that has an event when the socket has data.
+            size_t m_event;
+
+            /// \brief The buffer packets are received into.
+            std::vector<uint8_t> m_data;
+
             /// \brief Messages received and not processed yet.
             std::list<std::string> messages;
         };
@@ -5,8 +5,10 @@
 #include "basegroups.h"
 #include "oi/OISubsystem.h"
 #include "TeleopController.h"
+#include "ActionPool.h"
 #include <MessageDestStream.h>
-#include <MessageDestSeqFile.h>
+#include <MessageDestMappedFile.h>
+#include <MessageDestBinaryFile.h>
 #include <MessageDestDS.h>
 #include <frc/DriverStation.h>
 #include <frc/Filesystem.h>
@@ -34,6 +36,7 @@ namespace xero {
             name_ = name ;
 
             target_loop_time_ = looptime ;
+            scheduler_ = std::make_shared<LoopScheduler>(looptime) ;
 
             last_time_ = frc::Timer::GetFPGATimestamp() ;
 
@@ -51,15 +54,24 @@ namespace xero {
             srand(time(NULL)) ;
 
             sender_ = nullptr ;
+            defer_rows_ = 0 ;
+            defer_rows_per_loop_ = 0 ;
+            defer_to_file_ = false ;
 
             message_logger_.setTimeFunction(getTimeFunc) ;
 
             switch_to_teleop_ = false ;
+
+            profile_plot_ = false ;
+            profile_plot_id_ = -1 ;
+            profile_plot_row_ = 0 ;
         }
 #pragma GCC diagnostic pop
 
         Robot::~Robot() {
+            message_logger_.stopAsync() ;
             theOne = nullptr ;
+            settings_watcher_ = nullptr ;
             delete parser_ ;
             message_logger_.clear() ;
             if (output_stream_ != nullptr)
@@ -118,8 +130,12 @@ namespace xero {
             // actually mounted at /media/sd*, and a symbolic link is created
             // to /U.
             //
+            // The log file is preallocated and memory mapped so that a slow flash
+            // drive never stalls the robot loop, and synced every half second so
+            // that a power cut at the end of a match loses very little.
+            //
             std::string logname("logfile_");
-            dest_p = std::make_shared<MessageDestSeqFile>(log_dir_, logname);
+            dest_p = std::make_shared<MessageDestMappedFile>(log_dir_, logname);
             logger.addDestination(dest_p);
         }       
 
@@ -158,7 +174,13 @@ namespace xero {
                 message_logger_ << " " << def ;
             message_logger_.endMessage() ;
 
-            return parser_->readFile(filename) ;
+            //
+            // The compiled cache of the settings file is used when it is current, which
+            // makes startup faster, for instance after a brown out reboot on the field
+            //
+            params_file_ = filename ;
+            std::string cachefile = filename.substr(0, filename.find_last_of('.')) + ".datc" ;
+            return parser_->readCachedFile(filename, cachefile) ;
         }
 
         bool Robot::readParamsFile() {
@@ -177,11 +199,271 @@ namespace xero {
             return true ;
         }
         
+        void Robot::setupLoopScheduler() {
+            static const char *budgets[] = {
+                "robot:loop:budget:computestate",
+                "robot:loop:budget:controller",
+                "robot:loop:budget:run",
+                "robot:loop:budget:logging",
+            } ;
+
+            for(int i = 0 ; i < static_cast<int>(LoopPhase::MaxValue) ; i++) {
+                if (getSettingsParser().isDefined(budgets[i]))
+                    scheduler_->setBudget(static_cast<LoopPhase>(i), getSettingsParser().getDouble(budgets[i])) ;
+            }
+        }
+
+        void Robot::setupBinaryLogging() {
+            static const char *binaryprop = "robot:log:binary" ;
+
+            if (!getSettingsParser().getBoolean(binaryprop, false))
+                return ;
+
+            //
+            // Structured records are written to this file in binary form, the text log
+            // files get the text form.  Use xerologdump to convert the file to text or CSV.
+            //
+            auto dest = std::make_shared<MessageDestBinaryFile>(log_dir_, "binlog_") ;
+            message_logger_.addDestination(dest) ;
+
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            message_logger_ << "Binary logging enabled, file '" << dest->getFileName() << "'" ;
+            message_logger_.endMessage() ;
+        }
+
+        void Robot::setupAsyncLogging() {
+            static const char *asyncprop = "robot:log:async" ;
+            static const char *slotsprop = "robot:log:async:slots" ;
+            static const char *flushprop = "robot:log:async:flush" ;
+
+            if (!getSettingsParser().getBoolean(asyncprop, false))
+                return ;
+
+            //
+            // Move the log file I/O off of the robot loop.  Messages are queued and written
+            // by a background thread, which flushes the log files every flush interval.
+            //
+            int slots = getSettingsParser().getInteger(slotsprop, 1024) ;
+            double flush = getSettingsParser().getDouble(flushprop, 0.25) ;
+            message_logger_.startAsync(static_cast<size_t>(slots), flush) ;
+
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            message_logger_ << "Asynchronous logging enabled, " << slots << " slots, flush interval " << flush ;
+            message_logger_.endMessage() ;
+        }
+
+        void Robot::setupSettingsWatch() {
+            static const char *watchprop = "robot:settings:watch" ;
+            static const char *portprop = "robot:settings:watch:port" ;
+
+            if (!getSettingsParser().getBoolean(watchprop, false))
+                return ;
+
+            //
+            // The settings file is re-read by a background thread when it changes, or when
+            // a packet arrives on the port.  New values are applied at the start of a robot
+            // loop and actions see them the next time they start.
+            //
+            int port = getSettingsParser().getInteger(portprop, 0) ;
+            settings_watcher_ = std::make_shared<SettingsWatcher>(getSettingsParser(), params_file_) ;
+            if (!settings_watcher_->start(static_cast<uint16_t>(port))) {
+                settings_watcher_ = nullptr ;
+
+                message_logger_.startMessage(MessageLogger::MessageType::warning) ;
+                message_logger_ << "Settings watch could not be started for file '" << params_file_ << "'" ;
+                message_logger_.endMessage() ;
+                return ;
+            }
+
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            message_logger_ << "Watching settings file '" << params_file_ << "'" ;
+            if (port != 0)
+                message_logger_ << ", updates accepted on port " << port ;
+            message_logger_.endMessage() ;
+        }
+
+        void Robot::setupComputePool() {
+            static const char *threadsprop = "robot:compute:threads" ;
+
+            int threads = getSettingsParser().getInteger(threadsprop, 0) ;
+            if (threads <= 0)
+                return ;
+
+            //
+            // Subsystems that allow it compute their state on these threads and the robot
+            // loop thread at the same time.  The robot loop waits for all of them before
+            // the controller runs.
+            //
+            compute_pool_ = std::make_shared<TaskPool>(static_cast<size_t>(threads)) ;
+
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            message_logger_ << "Parallel compute state enabled, " << threads << " compute threads" ;
+            message_logger_.endMessage() ;
+        }
+
+        void Robot::setupEvents() {
+            static const char *eventsprop = "robot:events" ;
+
+            //
+            // Without events every subsystem reads all of its inputs every robot loop
+            //
+            bool enabled = getSettingsParser().getBoolean(eventsprop, false) ;
+            events_.setPolling(!enabled) ;
+
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            if (enabled)
+                message_logger_ << "Subsystems read their inputs when an event says they changed" ;
+            else
+                message_logger_ << "Subsystems read their inputs every robot loop" ;
+            message_logger_.endMessage() ;
+        }
+
+        size_t Robot::watchSocket(int fd, const std::string &name) {
+            size_t id = events_.addSource(name) ;
+            if (events_.isPolling() || id == EventQueue::AlwaysSource)
+                return id ;
+
+            if (socket_watcher_ == nullptr)
+                socket_watcher_ = std::make_shared<SocketWatcher>(events_) ;
+
+            if (!socket_watcher_->add(fd, id)) {
+                message_logger_.startMessage(MessageLogger::MessageType::warning) ;
+                message_logger_ << "Socket for event source '" << name << "' could not be watched, it is read every robot loop" ;
+                message_logger_.endMessage() ;
+                return EventQueue::AlwaysSource ;
+            }
+
+            return id ;
+        }
+
+        void Robot::logLoopOverrun() {
+            message_logger_.startMessage(MessageLogger::MessageType::warning) ;
+            message_logger_ << "Robot loop exceeded target loop time" ;
+            message_logger_ << ", loop time " << scheduler_->getLoopTime() ;
+            for(int i = 0 ; i < static_cast<int>(LoopPhase::MaxValue) ; i++) {
+                LoopPhase phase = static_cast<LoopPhase>(i) ;
+                message_logger_ << ", " << LoopScheduler::toString(phase) << " " << scheduler_->getPhaseTime(phase) ;
+                message_logger_ << " (budget " << scheduler_->getBudget(phase) << ")" ;
+            }
+            message_logger_ << ", worst " << LoopScheduler::toString(scheduler_->getWorstPhase()) ;
+            message_logger_.endMessage() ;
+        }
+
+        void Robot::setupProfiling() {
+            static const char *enableprop = "robot:profile" ;
+            static const char *plotprop = "robot:profile:plot" ;
+
+            if (!getSettingsParser().getBoolean(enableprop, false))
+                return ;
+
+            robot_subsystem_->enableProfiling(true) ;
+            robot_subsystem_->collectProfiles(profiles_) ;
+            profile_plot_ = getSettingsParser().getBoolean(plotprop, false) ;
+
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            message_logger_ << "Subsystem profiling enabled for " << static_cast<uint32_t>(profiles_.size()) << " subsystems" ;
+            message_logger_.endMessage() ;
+        }
+
+        void Robot::startProfilePlot(const char *mode) {
+            if (!profile_plot_)
+                return ;
+
+            std::list<std::string> cols ;
+            cols.push_back("time") ;
+            for(auto profile : profiles_) {
+                cols.push_back(profile->getName() + ":compute") ;
+                cols.push_back(profile->getName() + ":run") ;
+            }
+
+            profile_plot_id_ = startPlot(std::string("profile-") + mode, cols) ;
+            profile_plot_row_ = 0 ;
+            profile_plot_values_.resize(cols.size()) ;
+        }
+
+        void Robot::addProfilePlotData() {
+            if (profile_plot_id_ == -1)
+                return ;
+
+            //
+            // The times are sent in milliseconds, which is easier to read on the plotter
+            //
+            size_t col = 0 ;
+            profile_plot_values_[col++] = getTime() ;
+            for(auto profile : profiles_) {
+                profile_plot_values_[col++] = profile->getLastComputeStateTime() * 1000.0 ;
+                profile_plot_values_[col++] = profile->getLastRunTime() * 1000.0 ;
+            }
+            addPlotRow(profile_plot_id_, profile_plot_row_, profile_plot_values_.data(), col) ;
+            profile_plot_row_++ ;
+        }
+
+        void Robot::endProfilePlot() {
+            if (profile_plot_id_ == -1)
+                return ;
+
+            endPlot(profile_plot_id_) ;
+            profile_plot_id_ = -1 ;
+        }
+
+        void Robot::logProfile() {
+            if (profiles_.size() == 0)
+                return ;
+
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            message_logger_ << "Profile: subsystem times include their children and actions" ;
+            message_logger_.endMessage() ;
+
+            for(auto profile : profiles_) {
+                profile->log(message_logger_) ;
+                profile->clear() ;
+            }
+        }
+
+        void Robot::logLoopStatistics(LoopType type) {
+            int index = static_cast<int>(type) ;
+            double avg = sleep_time_[index] / iterations_[index] ;
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            message_logger_ << "RobotLoop:" ;
+            message_logger_ << " iterations " << iterations_[index] ;
+            message_logger_ << ", average sleep time " << avg ;
+            message_logger_.endMessage() ;
+
+            //
+            // All of the timing statistics are printed in milliseconds
+            //
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            message_logger_ << "RobotLoop: jitter ms: " << scheduler_->getJitterHistogram(type).toString(1000.0) ;
+            message_logger_.endMessage() ;
+
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            message_logger_ << "RobotLoop: overrun ms: " << scheduler_->getOverrunHistogram(type).toString(1000.0) ;
+            message_logger_.endMessage() ;
+
+            for(int i = 0 ; i < static_cast<int>(LoopPhase::MaxValue) ; i++) {
+                LoopPhase phase = static_cast<LoopPhase>(i) ;
+                message_logger_.startMessage(MessageLogger::MessageType::info) ;
+                message_logger_ << "RobotLoop: " << LoopScheduler::toString(phase) << " ms: " ;
+                message_logger_ << scheduler_->getPhaseHistogram(type, phase).toString(1000.0) ;
+                message_logger_ << ", over budget " << scheduler_->getOverBudgetCount(type, phase) ;
+                message_logger_.endMessage() ;
+            }
+
+            if (!events_.isPolling()) {
+                for(size_t i = 0 ; i < events_.getSourceCount() ; i++) {
+                    message_logger_.startMessage(MessageLogger::MessageType::info) ;
+                    message_logger_ << "RobotLoop: events '" << events_.getSourceName(i) << "' in " ;
+                    message_logger_ << events_.getActiveLoops(i) << " of " << events_.getLoopCount() << " loops" ;
+                    message_logger_.endMessage() ;
+                }
+            }
+        }
+        
         void Robot::robotLoop(LoopType type) {
             frc::DriverStation &ds = frc::DriverStation::GetInstance() ;
             voltage_ = ds.GetBatteryVoltage() ;
             int index = static_cast<int>(type) ;
-            double initial_time = frc::Timer::GetFPGATimestamp();
+            double initial_time = scheduler_->startLoop(type) ;
 
             message_logger_.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ROBOTLOOP) ;
             message_logger_ << "Entering robot loop" ;
@@ -189,52 +471,62 @@ namespace xero {
 
             delta_time_ = initial_time - last_time_ ;
 
-            robot_subsystem_->computeState() ;
+            //
+            // Settings reloaded since the last loop take effect here, so everything that
+            // runs in this loop sees the same values
+            //
+            parser_->applyPending() ;
+
+            //
+            // Take the events that arrived since the last loop, subsystems only read
+            // the inputs that changed
+            //
+            events_.collect() ;
+
+            scheduler_->startPhase(LoopPhase::ComputeState) ;
+            robot_subsystem_->profiledComputeState() ;
+            scheduler_->endPhase(LoopPhase::ComputeState) ;
 
             message_logger_.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ROBOTLOOP) ;
             message_logger_ << "RobotLoop: completed compute state" ;
             message_logger_.endMessage() ;
 
+            scheduler_->startPhase(LoopPhase::Controller) ;
             if (controller_ != nullptr)
                 controller_->run();
+            scheduler_->endPhase(LoopPhase::Controller) ;
 
             message_logger_.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ROBOTLOOP) ;
             message_logger_ << "RobotLoop: completed controller run" ;
             message_logger_.endMessage() ;
 
-            robot_subsystem_->run() ;
+            scheduler_->startPhase(LoopPhase::SubsystemRun) ;
+            robot_subsystem_->profiledRun() ;
+            scheduler_->endPhase(LoopPhase::SubsystemRun) ;
 
             message_logger_.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ROBOTLOOP) ;
             message_logger_ << "RobotLoop: completed subsystem run" ;
             message_logger_.endMessage() ;            
 
+            scheduler_->startPhase(LoopPhase::Logging) ;
             iterations_[index]++ ;
+            if ((iterations_[index] % 500) == 0)
+                logLoopStatistics(type) ;
+            addProfilePlotData() ;
+            if (plotter_ != nullptr)
+                plotter_->flush() ;
+            scheduler_->endPhase(LoopPhase::Logging) ;
 
-            double elapsed_time = frc::Timer::GetFPGATimestamp() - initial_time > target_loop_time_;
-            if (elapsed_time < target_loop_time_) {
-                sleep_time_[index] += target_loop_time_ - elapsed_time ;
-                frc::Wait(target_loop_time_ - elapsed_time);
-            } else if (elapsed_time > target_loop_time_) {
-                message_logger_.startMessage(MessageLogger::MessageType::warning) ;
-                message_logger_ << "Robot loop exceeded target loop time\n";
-                message_logger_ << "Loop time: " << elapsed_time << "\n";
-                message_logger_.endMessage() ;
-            }
+            if (scheduler_->endLoop())
+                logLoopOverrun() ;
+
+            sleep_time_[index] += scheduler_->waitForDeadline() ;
 
             message_logger_.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ROBOTLOOP) ;
             message_logger_ << "    completed delay" ;
             message_logger_.endMessage() ;               
 
             last_time_ = initial_time ;
-
-            if ((iterations_[index] % 500) == 0) {
-                double avg = sleep_time_[index] / iterations_[index] ;
-                message_logger_.startMessage(MessageLogger::MessageType::info) ;
-                message_logger_ << "RobotLoop:" ;
-                message_logger_ << " iterations " << iterations_[index] ;
-                message_logger_ << ", average sleep time " << avg ;
-                message_logger_.endMessage() ;
-            }
         }
 
         void Robot::RobotInit() {
@@ -257,6 +549,12 @@ namespace xero {
             message_logger_ << ".... reading parameter file" ;
             message_logger_.endMessage() ;            
             readParamsFile() ;
+            setupLoopScheduler() ;
+            setupBinaryLogging() ;
+            setupAsyncLogging() ;
+            setupSettingsWatch() ;
+            setupComputePool() ;
+            setupEvents() ;
 
             //
             // Setup the data plotting
@@ -273,6 +571,12 @@ namespace xero {
             message_logger_ << ".... loading path files" ;
             message_logger_.endMessage() ;     
             paths_ = std::make_shared<XeroPathManager>(deploy_dir_ + "/output") ;
+            message_logger_.startMessage(MessageLogger::MessageType::info) ;
+            if (paths_->hasCompiledFile())
+                message_logger_ << ".... using compiled path file, paths are read when first used" ;
+            else
+                message_logger_ << ".... compiled path file not used, paths are read in the background, " << paths_->getCompiledFileError() ;
+            message_logger_.endMessage() ;
             loadPaths() ;
 
             //
@@ -291,6 +595,12 @@ namespace xero {
             //
             robot_subsystem_->postHWInit() ;
 
+            //
+            // Profiling is setup after the subsystem tree is complete so that every
+            // subsystem is given a profile
+            //
+            setupProfiling() ;
+
             //
             // Create the auto mode controller.  Its around for the complete lifecycle of the
             // robot object as it is needed while the robot is disabled to ready any long running
@@ -457,6 +767,8 @@ namespace xero {
 
             controller_ = auto_controller_ ;
             robot_subsystem_->init(type) ;
+            scheduler_->restart() ;
+            startProfilePlot("auto") ;
 
             while (IsAutonomous() && IsEnabled()) {
                 robotLoop(type) ;
@@ -468,10 +780,12 @@ namespace xero {
             }
 
             controller_ = nullptr ;
+            endProfilePlot() ;
 
             message_logger_.startMessage(MessageLogger::MessageType::info) ;
             message_logger_ << "Leaving Autonomous mode" ;
             message_logger_.endMessage() ;
+            ActionPool::log(message_logger_) ;
 
             robot_subsystem_->reset() ;
         }
@@ -483,14 +797,18 @@ namespace xero {
 
             controller_ = teleop_controller_ ;
             robot_subsystem_->init(LoopType::OperatorControl) ;
+            scheduler_->restart() ;
+            startProfilePlot("teleop") ;
             while (IsOperatorControl() && IsEnabled())
                 robotLoop(LoopType::OperatorControl) ;
 
             controller_ = nullptr ;
+            endProfilePlot() ;
 
             message_logger_.startMessage(MessageLogger::MessageType::info) ;
             message_logger_ << "Leaving Teleop mode" ;
             message_logger_.endMessage() ;  
+            ActionPool::log(message_logger_) ;
 
             robot_subsystem_->reset() ;                 
         }
@@ -502,11 +820,14 @@ namespace xero {
 
             controller_ = createTestController() ;
             robot_subsystem_->init(LoopType::Test) ;
+            scheduler_->restart() ;
+            startProfilePlot("test") ;
 
             while (IsTest() && IsEnabled())
                 robotLoop(LoopType::Test) ;
 
             controller_ = nullptr ;
+            endProfilePlot() ;
 
             message_logger_.startMessage(MessageLogger::MessageType::info) ;
             message_logger_ << "Leaving Test mode" ;
@@ -521,12 +842,21 @@ namespace xero {
             message_logger_ << "Robot Disabled" ;
             message_logger_.endMessage() ;
 
+            //
+            // Report the subsystem profile for the mode that just ended
+            //
+            logProfile() ;
+            deferOpenPlots() ;
+
             automode_ = -1 ;
             robot_subsystem_->init(LoopType::Disabled) ;
 
             while (IsDisabled()) {
+                parser_->applyPending() ;
                 updateAutoMode() ;
+                events_.collect() ;
                 robot_subsystem_->computeState() ;
+                drainDeferredPlots() ;
                 frc::Wait(target_loop_time_) ;              
             }
             
@@ -537,62 +867,113 @@ namespace xero {
 
         void Robot::startPlotSubsystem() {
             static const char *propname = "plotter:port" ;
+            static const char *rowsprop = "plotter:defer:rows" ;
+            static const char *perloopprop = "plotter:defer:rowsperloop" ;
+            static const char *fileprop = "plotter:defer:file" ;
+
+            defer_rows_ = static_cast<size_t>(getSettingsParser().getInteger(rowsprop, 1000)) ;
+            defer_rows_per_loop_ = static_cast<size_t>(getSettingsParser().getInteger(perloopprop, 100)) ;
+            defer_to_file_ = getSettingsParser().getBoolean(fileprop, false) ;
+
             if (getSettingsParser().isDefined(propname)) {
                 int port = getSettingsParser().getInteger(propname) ;
                 sender_ = std::make_shared<UdpSender>() ;
-                if (!sender_->open(port))
+                if (!sender_->open(port)) {
                     sender_ = nullptr ;
+                }
+                else {
+                    auto sender = sender_ ;
+                    plotter_ = std::make_shared<PlotBatcher>([sender](const uint8_t *data, size_t size) {
+                        return sender->send(data, size) ;
+                    }) ;
+                }
             }
         }
 
+        bool Robot::isPlotDeferred(const std::string &name) {
+            //
+            // A plot is deferred if plotter:defer:NAME is true, where NAME is the plot
+            // name up to the first '-' (e.g. plotter:defer:TankDriveFollowPathAction).  Most
+            // plots have no key, so check first, getting a missing key logs an error.
+            //
+            std::string key = "plotter:defer:" + name.substr(0, name.find('-')) ;
+            if (!getSettingsParser().isDefined(key))
+                return false ;
+
+            return getSettingsParser().getBoolean(key, false) ;
+        }
+
         int Robot::startPlot(const std::string &name, const std::list<std::string> &cols) {
             int id = rand() ;            
-            if (sender_ != nullptr) {
-                columns_ = cols.size() ;
-                std::string data("$start,") ;
-                data += name ;
-                data += "," ;
-                data += std::to_string(id) ;
-                for(const std::string &col: cols)
-                {
-                    data +="," ;
-                    data += col ;
-                }
-                data += "$" ;
-                for(int i = 0 ; i < 2 ; i++)
-                    sender_->send(data) ;
+            if ((plotter_ != nullptr || defer_to_file_) && isPlotDeferred(name)) {
+                deferred_plots_[id] = std::make_shared<PlotRing>(static_cast<uint32_t>(id), name, cols, defer_rows_) ;
+            }
+            else if (plotter_ != nullptr) {
+                plotter_->startPlot(static_cast<uint32_t>(id), name, cols) ;
             }
             return id ;
         }
 
-        void Robot::addPlotData(int id, size_t row, size_t col, double value) {
-            if (sender_ != nullptr) {
-                std::vector<uint8_t> data ;
-                data.push_back(0xFF) ;
-                data.push_back(static_cast<uint8_t>(id >> 24)) ;
-                data.push_back(static_cast<uint8_t>(id >> 16)) ;                
-                data.push_back(static_cast<uint8_t>(id >> 8)) ;                
-                data.push_back(static_cast<uint8_t>(id)) ;
-                data.push_back(static_cast<uint8_t>(row>> 24)) ;
-                data.push_back(static_cast<uint8_t>(row >> 16)) ;                
-                data.push_back(static_cast<uint8_t>(row >> 8)) ;                
-                data.push_back(static_cast<uint8_t>(row)) ;                
-                data.push_back(static_cast<uint8_t>(col)) ;
-                size_t current = data.size() ;
-                data.resize(current + sizeof(double)) ;
-                memcpy(&data[current], reinterpret_cast<void *>(&value), sizeof(value)) ;
-                data.push_back(0xFE) ;
-                sender_->send(data) ;
+        void Robot::addPlotRow(int id, size_t row, const double *values, size_t count) {
+            if (deferred_plots_.size() > 0) {
+                auto it = deferred_plots_.find(id) ;
+                if (it != deferred_plots_.end()) {
+                    it->second->addRow(static_cast<uint32_t>(row), values, count) ;
+                    return ;
+                }
             }
+
+            if (plotter_ != nullptr)
+                plotter_->addRow(static_cast<uint32_t>(id), static_cast<uint32_t>(row), values, count) ;
         }        
 
         void Robot::endPlot(int id) {
-            if (sender_ != nullptr) {
-                std::string data("$end,") ;
-                data += std::to_string(id) ;                
-                data += "$" ;
-                for(int i = 0 ; i < 2 ; i++)
-                    sender_->send(data) ;
+            auto it = deferred_plots_.find(id) ;
+            if (it != deferred_plots_.end()) {
+                if (it->second->getDropped() > 0) {
+                    message_logger_.startMessage(MessageLogger::MessageType::warning) ;
+                    message_logger_ << "deferred plot '" << it->second->getName() << "' dropped " ;
+                    message_logger_ << it->second->getDropped() << " rows, increase plotter:defer:rows" ;
+                    message_logger_.endMessage() ;
+                }
+
+                it->second->end() ;
+                drain_plots_.push_back(it->second) ;
+                deferred_plots_.erase(it) ;
+            }
+            else if (plotter_ != nullptr) {
+                plotter_->endPlot(static_cast<uint32_t>(id)) ;
+            }
+        }
+
+        void Robot::deferOpenPlots() {
+            //
+            // Plots still open when the robot is disabled (e.g. autonomous ended during
+            // a path) are ended here so they are drained with the others
+            //
+            while (deferred_plots_.size() > 0)
+                endPlot(deferred_plots_.begin()->first) ;
+        }
+
+        void Robot::drainDeferredPlots() {
+            if (drain_plots_.size() == 0)
+                return ;
+
+            auto ring = drain_plots_.front() ;
+            if (defer_to_file_) {
+                std::string filename = log_dir_ + "plot-" + ring->getName() + "-" + std::to_string(ring->getID()) + ".csv" ;
+                std::ofstream out(filename) ;
+                ring->writeCSV(out) ;
+                drain_plots_.pop_front() ;
+            }
+            else {
+                //
+                // Send a limited number of rows per loop so the plots trickle out
+                // rather than flooding the network
+                //
+                if (ring->send(*plotter_, defer_rows_per_loop_))
+                    drain_plots_.pop_front() ;
+                plotter_->flush() ;
             }
         }
     }
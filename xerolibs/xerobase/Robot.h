@@ -3,9 +3,16 @@
 #include "Subsystem.h"
 #include "MessageLogger.h"
 #include "SettingsParser.h"
+#include "SettingsWatcher.h"
 #include "LoopType.h"
+#include "LoopScheduler.h"
 #include "basegroups.h"
 #include <UdpSender.h>
+#include <PlotBatcher.h>
+#include <PlotRing.h>
+#include <TaskPool.h>
+#include <EventQueue.h>
+#include <SocketWatcher.h>
 #include <XeroPathManager.h>
 #include <frc/SampleRobot.h>
 #include <frc/PowerDistributionPanel.h>
@@ -99,6 +106,34 @@ namespace xero {
                 return target_loop_time_ ;
             }
 
+            /// \brief Return the scheduler that runs the robot loop
+            /// \returns the scheduler that runs the robot loop
+            LoopScheduler &getLoopScheduler() {
+                return *scheduler_ ;
+            }
+
+            /// \brief Return the threads used to compute the state of subsystems at the same time
+            /// \returns the compute threads, or nullptr if subsystems compute their state one at a time
+            xero::misc::TaskPool *getComputePool() {
+                return compute_pool_.get() ;
+            }
+
+            /// \brief Return the queue of events that wake subsystems
+            /// Subsystems add a source for each input at creation, and in computeState() only read
+            /// the inputs whose source had an event since the last robot loop.
+            /// \returns the queue of events that wake subsystems
+            xero::misc::EventQueue &getEventQueue() {
+                return events_ ;
+            }
+
+            /// \brief add an event source that has an event each time a socket has data to read
+            /// The socket must be non-blocking and must be read until it has no more data each time
+            /// its source has an event.
+            /// \param fd the socket to watch
+            /// \param name the name of the event source
+            /// \returns the id of the event source in the event queue
+            size_t watchSocket(int fd, const std::string &name) ;
+
             /// \brief Return the time difference between the last robot loop and the current one in seconds
             /// \returns the time difference between the last robot loop and the current one in seconds
             double getDeltaTime()  {
@@ -142,9 +177,25 @@ namespace xero {
 
             void startPlotSubsystem() ;
             int startPlot(const std::string &name, const std::list<std::string> &cols) ;
-            void addPlotData(int id, size_t row, size_t col, double value) ;
             void endPlot(int id) ;
 
+            /// \brief add a row of data to a plot
+            /// The rows are sent to the plotter in batches, once per robot loop.
+            /// \param id the id of the plot returned by startPlot()
+            /// \param row the index of the row
+            /// \param values the values for the row, one per column
+            /// \param count the number of values
+            void addPlotRow(int id, size_t row, const double *values, size_t count) ;
+
+            /// \brief add a row of data to a plot
+            /// \param id the id of the plot returned by startPlot()
+            /// \param row the index of the row
+            /// \param values the values for the row, one per column
+            template <size_t N>
+            void addPlotRow(int id, size_t row, const double (&values)[N]) {
+                addPlotRow(id, row, values, N) ;
+            }
+
             /// \brief return the current controller
             std::shared_ptr<ControllerBase> getCurrentController() {
                 return controller_ ;
@@ -235,6 +286,22 @@ namespace xero {
             void displayAutoModeState() ;
             void updateAutoMode() ;
             void setupPaths() ;
+            void setupLoopScheduler() ;
+            void setupBinaryLogging() ;
+            void setupAsyncLogging() ;
+            void setupSettingsWatch() ;
+            void setupComputePool() ;
+            void setupEvents() ;
+            void logLoopStatistics(LoopType type) ;
+            void logLoopOverrun() ;
+            void setupProfiling() ;
+            bool isPlotDeferred(const std::string &name) ;
+            void deferOpenPlots() ;
+            void drainDeferredPlots() ;
+            void startProfilePlot(const char *mode) ;
+            void addProfilePlotData() ;
+            void endProfilePlot() ;
+            void logProfile() ;
 
         private:
             // The time per robot loop in seconds
@@ -249,6 +316,11 @@ namespace xero {
 
             std::shared_ptr<ControllerBase> teleop_controller_ ;
 
+            // The events that wake subsystems, and the thread that watches sockets for them.  These
+            // are destroyed after the subsystems, which may have interrupts that post events.
+            xero::misc::EventQueue events_ ;
+            std::shared_ptr<xero::misc::SocketWatcher> socket_watcher_ ;
+
             // The list of subsystem that belong to the robot
             SubsystemPtr robot_subsystem_ ;
             std::shared_ptr<DriveBase> drivebase_subsystem_ ;
@@ -266,6 +338,12 @@ namespace xero {
             // The settings parser
             xero::misc::SettingsParser *parser_ ;
 
+            // The settings file that was read
+            std::string params_file_ ;
+
+            // Reloads the settings file when it changes, if enabled
+            std::shared_ptr<xero::misc::SettingsWatcher> settings_watcher_ ;
+
             // The name of an output file for the robot output
             std::string output_file_name_ ;
 
@@ -278,6 +356,23 @@ namespace xero {
             // The game specific message data
             std::string gamedata_ ;
 
+            // Schedules the robot loop and keeps its timing statistics
+            std::shared_ptr<LoopScheduler> scheduler_ ;
+
+            // Computes the state of independent subsystems at the same time, if enabled
+            std::shared_ptr<xero::misc::TaskPool> compute_pool_ ;
+
+            // The subsystem profiles, in subsystem tree order, empty if profiling is disabled
+            std::vector<std::shared_ptr<SubsystemProfile>> profiles_ ;
+
+            // If true, the subsystem profile times are sent to the plotter each robot loop
+            bool profile_plot_ ;
+
+            // The plot id and current row for the subsystem profile plot, id is -1 if no plot is active
+            int profile_plot_id_ ;
+            size_t profile_plot_row_ ;
+            std::vector<double> profile_plot_values_ ;
+
             // Used to keep track of sleep time in the robot loop
             std::vector<double> sleep_time_ ;
             std::vector<size_t> iterations_ ;
@@ -300,8 +395,21 @@ namespace xero {
             // The UDP sender for plot data
             std::shared_ptr<xero::misc::UdpSender> sender_ ;    
 
-            // The total number of columns for plot data
-            int columns_ ;        
+            // Collects plot rows into packets, sent once per robot loop
+            std::shared_ptr<xero::misc::PlotBatcher> plotter_ ;
+
+            // Plots held in memory until the robot is disabled, by plot id
+            std::map<int, std::shared_ptr<xero::misc::PlotRing>> deferred_plots_ ;
+
+            // Deferred plots waiting to be sent or written while the robot is disabled
+            std::list<std::shared_ptr<xero::misc::PlotRing>> drain_plots_ ;
+
+            // The rows held for each deferred plot, and the rows sent per disabled loop
+            size_t defer_rows_ ;
+            size_t defer_rows_per_loop_ ;
+
+            // If true, deferred plots are written to CSV files in the log directory instead of sent
+            bool defer_to_file_ ;
 
             // If true, switch from automode to teleop
             bool switch_to_teleop_ ;
@@ -4,6 +4,7 @@
 #include "basegroups.h"
 #include <MessageLogger.h>
 #include <cassert>
+#include <algorithm>
 
 using namespace xero::misc ;
 
@@ -12,6 +13,10 @@ namespace xero {
 
         Subsystem::Subsystem(Robot &robot, const std::string &name) : robot_(robot) , name_(name) {
             action_ = nullptr ;
+            accepted_ = 0 ;
+            parent_ = nullptr ;
+            parallel_compute_ = false ;
+            waves_valid_ = false ;
         }
 
         Subsystem::~Subsystem() {
@@ -19,17 +24,22 @@ namespace xero {
 
         void Subsystem::run() {
             for(auto sub: children_) {
-                sub->run() ;
+                sub->profiledRun() ;
             }
             
             if (action_ != nullptr){
-                action_->run() ;
+                if (profile_ != nullptr) {
+                    profile_->startAction() ;
+                    action_->run() ;
+                    profile_->endAction(*action_) ;
+                }
+                else {
+                    action_->run() ;
+                }
                 if (pending_ != nullptr && action_->isDone()) {
                     MessageLogger &logger = getRobot().getMessageLogger() ;
-                    logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS) ;
-                    logger << "Actions: subsystem '" << getName() << "' pending action '" << pending_->toString() ;
-                    logger << "' was started" ;
-                    logger.endMessage() ;
+                    XERO_LOG(logger, MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS,
+                        "Actions: subsystem '" << getName() << "' pending action '" << pending_->toString() << "' was started") ;
 
                     action_ = pending_ ;
                     pending_ = nullptr ;
@@ -39,8 +49,162 @@ namespace xero {
         }
         
         void Subsystem::computeState() {
-            for(auto sub: children_)
-                sub->computeState() ;     
+            //
+            // Without compute threads, or when this is already running on one, the
+            // children compute their state one at a time in the order they were added
+            //
+            TaskPool *pool = getRobot().getComputePool() ;
+            if (pool == nullptr || pool->isBusy()) {
+                for(auto sub: children_)
+                    sub->profiledComputeState() ;
+                return ;
+            }
+
+            if (!waves_valid_)
+                buildComputeWaves() ;
+
+            MessageLogger &logger = getRobot().getMessageLogger() ;
+            size_t start = 0 ;
+            for(size_t end : wave_ends_) {
+                if (end - start == 1) {
+                    compute_order_[start]->profiledComputeState() ;
+                }
+                else {
+                    compute_task_.first_ = &compute_order_[start] ;
+                    pool->run(compute_task_, end - start) ;
+
+                    //
+                    // The messages are written in the same order every loop, whichever
+                    // thread finished first
+                    //
+                    for(size_t i = start ; i < end ; i++)
+                        logger.writeCapture(compute_order_[i]->compute_log_) ;
+                }
+                start = end ;
+            }
+        }
+
+        void Subsystem::ComputeTask::runTask(size_t index) {
+            first_[index]->capturedComputeState() ;
+        }
+
+        void Subsystem::capturedComputeState() {
+            MessageLogger &logger = getRobot().getMessageLogger() ;
+            logger.beginCapture(compute_log_) ;
+            profiledComputeState() ;
+            logger.endCapture() ;
+        }
+
+        void Subsystem::computeAfter(SubsystemPtr other) {
+            compute_after_.push_back(other.get()) ;
+            if (parent_ != nullptr)
+                parent_->waves_valid_ = false ;
+        }
+
+        void Subsystem::setParallelCompute(bool parallel) {
+            parallel_compute_ = parallel ;
+            if (parent_ != nullptr)
+                parent_->waves_valid_ = false ;
+        }
+
+        void Subsystem::buildComputeWaves() {
+            std::vector<Subsystem *> children ;
+            std::vector<size_t> waves ;
+            size_t first = 0 ;
+            size_t next = 0 ;
+
+            //
+            // Each child is given a wave number.  A child that does not allow a parallel compute
+            // is a wave of its own, after every child added before it.  A child that does is
+            // placed in the wave after the last of its dependencies, but never before the wave
+            // of the last child that does not allow a parallel compute.
+            //
+            for(auto sub : children_) {
+                size_t wave = first ;
+                if (sub->parallel_compute_) {
+                    for(Subsystem *dep : sub->compute_after_) {
+                        auto it = std::find(children.begin(), children.end(), dep) ;
+                        if (it != children.end()) {
+                            wave = std::max(wave, waves[it - children.begin()] + 1) ;
+                        }
+                        else {
+                            MessageLogger &logger = getRobot().getMessageLogger() ;
+                            logger.startMessage(MessageLogger::MessageType::warning) ;
+                            logger << "Subsystem '" << sub->getName() << "' computes after '" << dep->getName() ;
+                            logger << "', which is not a child of '" << getName() << "' added before it" ;
+                            logger.endMessage() ;
+                        }
+                    }
+                    next = std::max(next, wave + 1) ;
+                }
+                else {
+                    wave = next ;
+                    next = wave + 1 ;
+                    first = next ;
+                }
+                children.push_back(sub.get()) ;
+                waves.push_back(wave) ;
+            }
+
+            //
+            // Within a wave the children stay in the order they were added
+            //
+            compute_order_.clear() ;
+            wave_ends_.clear() ;
+            for(size_t wave = 0 ; wave < next ; wave++) {
+                for(size_t i = 0 ; i < children.size() ; i++) {
+                    if (waves[i] == wave)
+                        compute_order_.push_back(children[i]) ;
+                }
+                size_t last = (wave_ends_.size() == 0) ? 0 : wave_ends_.back() ;
+                if (compute_order_.size() > last)
+                    wave_ends_.push_back(compute_order_.size()) ;
+            }
+
+            waves_valid_ = true ;
+        }
+
+        void Subsystem::profiledComputeState() {
+            if (profile_ == nullptr) {
+                computeState() ;
+            }
+            else {
+                profile_->startComputeState() ;
+                computeState() ;
+                profile_->endComputeState() ;
+            }
+        }
+
+        void Subsystem::profiledRun() {
+            if (profile_ == nullptr) {
+                run() ;
+            }
+            else {
+                profile_->startRun() ;
+                run() ;
+                profile_->endRun() ;
+            }
+        }
+
+        void Subsystem::enableProfiling(bool enable, int depth) {
+            if (enable) {
+                if (profile_ == nullptr)
+                    profile_ = std::make_shared<SubsystemProfile>(getName(), depth, getRobot().getTargetLoopTime()) ;
+            }
+            else {
+                profile_ = nullptr ;
+            }
+
+            for(auto child: children_)
+                child->enableProfiling(enable, depth + 1) ;
+        }
+
+        void Subsystem::collectProfiles(std::vector<std::shared_ptr<SubsystemProfile>> &profiles) {
+            if (profile_ != nullptr)
+                profiles.push_back(profile_) ;
+
+            for(auto child: children_)
+                child->collectProfiles(profiles) ;
         }
 
         void Subsystem::cancelAction() {
@@ -55,26 +219,27 @@ namespace xero {
             // and do nothing else.  Any existing action remains attached to the subsystem and
             // continue to perform its function.
             //
+            MessageLogger &logger = getRobot().getMessageLogger() ;
             if (action != nullptr && !canAcceptAction(action)) {
-                MessageLogger &logger = getRobot().getMessageLogger() ;
-                logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS) ;
-                logger << "Actions: subsystem '" << getName() << "' rejected action '" << action->toString() << "'" ;
-                logger.endMessage() ;
+                XERO_LOG(logger, MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS,
+                    "Actions: subsystem '" << getName() << "' rejected action '" << action->toString() << "'") ;
                 return false ;
             }
 
             //
-            // Print information about what is being requested
+            // Print information about what is being requested.  The action names are only
+            // built if the verbose action messages are enabled.
             //
-            MessageLogger &logger = getRobot().getMessageLogger() ;
-            logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE) ;
-            if (action == nullptr)
-                logger << "Actions: subsystem '" << getName() << "' was assigned NULL action" ;
-            else
-                logger << "Actions: subsystem '" << getName() << "' was assigned action '" << action->toString() << "'" ;    
-            if (force)
-                logger << " - FORCED" ;
-            logger.endMessage() ;            
+            if (XERO_LOG_ENABLED(logger, MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE)) {
+                logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE) ;
+                if (action == nullptr)
+                    logger << "Actions: subsystem '" << getName() << "' was assigned NULL action" ;
+                else
+                    logger << "Actions: subsystem '" << getName() << "' was assigned action '" << action->toString() << "'" ;    
+                if (force)
+                    logger << " - FORCED" ;
+                logger.endMessage() ;
+            }
 
             if (action_ != nullptr && !action_->isDone()) {
                 //
@@ -83,10 +248,8 @@ namespace xero {
 
                 if (force) {
 
-                    MessageLogger &logger = getRobot().getMessageLogger() ;
-                    logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE) ;
-                    logger << "Actions: subsystem '" << getName() << "' action '" << action_->toString() << "' was aborted" ;
-                    logger.endMessage() ;                    
+                    XERO_LOG(logger, MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE,
+                        "Actions: subsystem '" << getName() << "' action '" << action_->toString() << "' was aborted") ;
 
                     //
                     // We want to force the action here, so abort the current action
@@ -97,10 +260,8 @@ namespace xero {
                     assert(action_->isDone()) ;
                 }
                 else {
-                    MessageLogger &logger = getRobot().getMessageLogger() ;
-                    logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE) ;
-                    logger << "Actions: subsystem '" << getName() << "' action '" << action_->toString() << "' was canceled" ;
-                    logger.endMessage() ; 
+                    XERO_LOG(logger, MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE,
+                        "Actions: subsystem '" << getName() << "' action '" << action_->toString() << "' was canceled") ;
 
                     //
                     // We are not forcing the issue (e.g. force was false) so cancel the action and
@@ -116,15 +277,14 @@ namespace xero {
                         //
                         pending_ = action ;
 
-                        MessageLogger &logger = getRobot().getMessageLogger() ;
-                        logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE) ;
                         if (action == nullptr) {
-                            logger << "Actions: subsystem '" << getName() << "' action NULL was pended" ;
+                            XERO_LOG(logger, MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE,
+                                "Actions: subsystem '" << getName() << "' action NULL was pended") ;
                         }
                         else {
-                            logger << "Actions: subsystem '" << getName() << "' action '" << action->toString() << "' was pended" ;                            
+                            XERO_LOG(logger, MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS_VERBOSE,
+                                "Actions: subsystem '" << getName() << "' action '" << action->toString() << "' was pended") ;
                         }
-                        logger.endMessage() ;                    
                     }
                 }
             }
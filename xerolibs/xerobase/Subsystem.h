@@ -2,7 +2,11 @@
 
 #include "Action.h"
 #include "LoopType.h"
+#include "SubsystemProfile.h"
+#include <MessageLogger.h>
+#include <TaskPool.h>
 #include <memory>
+#include <vector>
 #include <map>
 #include <list>
 #include <string>
@@ -42,6 +46,31 @@ namespace xero {
             /// \param child the subsystem to add as a child to the current subsystem
             void addChild(SubsystemPtr child) {
                 children_.push_back(child) ;
+                child->parent_ = this ;
+                waves_valid_ = false ;
+            }
+
+            /// \brief declare that the state computed by this subsystem depends on another subsystem
+            /// The computeState() method of this subsystem is not started until the computeState()
+            /// method of the other subsystem is finished.  The other subsystem must be a child of the
+            /// same parent, added before this subsystem.  This only matters for subsystems that
+            /// allow a parallel compute, see setParallelCompute().
+            /// \param other the subsystem whose state is read by this subsystem
+            void computeAfter(SubsystemPtr other) ;
+
+            /// \brief allow computeState() to run at the same time as that of sibling subsystems
+            /// Neighboring children of a subsystem that allow it, and that do not depend on each other
+            /// through computeAfter(), compute their state on the robot compute threads at the same time.
+            /// A subsystem should only allow this if its computeState() reads its own hardware and the
+            /// subsystems given to computeAfter(), and changes nothing but its own state.  Messages it
+            /// logs are held and written in a fixed order once all of the subsystems are done.
+            /// \param parallel if true, allow a parallel compute
+            void setParallelCompute(bool parallel) ;
+
+            /// \brief returns true if computeState() may run at the same time as that of sibling subsystems
+            /// \returns true if computeState() may run at the same time as that of sibling subsystems
+            bool isParallelCompute() const {
+                return parallel_compute_ ;
             }
 
             /// \brief compute the current state of the robot.
@@ -49,6 +78,30 @@ namespace xero {
             /// computes a state that is meaningful to users of the subsystem.
             virtual void computeState() ;
 
+            /// \brief compute the state of the subsystem, recording the time taken if profiling is enabled
+            /// This is the method the parent subsystem and the robot loop call.  It calls computeState().
+            void profiledComputeState() ;
+
+            /// \brief run the subsystem, recording the time taken if profiling is enabled
+            /// This is the method the parent subsystem and the robot loop call.  It calls run().
+            void profiledRun() ;
+
+            /// \brief enable or disable profiling for this subsystem and all of its children
+            /// \param enable if true, enable profiling, otherwise disable it
+            /// \param depth the depth of this subsystem in the subsystem tree
+            void enableProfiling(bool enable, int depth = 0) ;
+
+            /// \brief return the profile for this subsystem
+            /// \returns the profile for this subsystem, or nullptr if profiling is not enabled
+            std::shared_ptr<SubsystemProfile> getProfile() {
+                return profile_ ;
+            }
+
+            /// \brief add the profiles for this subsystem and its children to a list
+            /// The profiles are added in the order of a depth first traversal of the subsystem tree
+            /// \param profiles the list to add the profiles to
+            void collectProfiles(std::vector<std::shared_ptr<SubsystemProfile>> &profiles) ;
+
             /// \brief set the current Action for the subsystem
             /// \param action the new Action for the subsystem
             /// \param force if true abort the current action and force this action immediately
@@ -112,12 +165,37 @@ namespace xero {
 
         protected:
             /// \brief check that a Action is valid for a subsystem
-            /// \param Action the Action to check for a subsystem
+            /// The default accepts actions in any of the categories given to acceptCategory().
+            /// \param action the Action to check for a subsystem
             /// \return true if the action is valid for a subsystem
-            virtual bool canAcceptAction(ActionPtr action) {
-                return false ;
+            virtual bool canAcceptAction(const ActionPtr &action) {
+                return (action->getCategories() & accepted_) != 0 ;
             }
 
+            /// \brief accept actions in a category, see basecategories.h
+            /// \param category the category of action to accept
+            void acceptCategory(uint32_t category) {
+                accepted_ |= category ;
+            }
+
+        private:
+            //
+            // Computes the state of a set of children on the robot compute threads
+            //
+            class ComputeTask : public xero::misc::TaskPool::Task {
+            public:
+                ComputeTask() {
+                    first_ = nullptr ;
+                }
+
+                virtual void runTask(size_t index) ;
+
+                Subsystem **first_ ;
+            } ;
+
+            void buildComputeWaves() ;
+            void capturedComputeState() ;
+
         private:
             //
             // A reference to the robot object that contains this subsystem
@@ -136,10 +214,47 @@ namespace xero {
 
             ActionPtr pending_ ;
 
+            //
+            // The categories of action accepted by this subsystem
+            //
+            uint32_t accepted_ ;
+
             //
             // The set of child subsystems
             //
             std::list<SubsystemPtr> children_ ;
+
+            //
+            // The parent subsystem, or nullptr for the robot subsystem
+            //
+            Subsystem *parent_ ;
+
+            //
+            // If true, computeState() may run at the same time as that of siblings, and the
+            // siblings whose state must be computed first
+            //
+            bool parallel_compute_ ;
+            std::vector<Subsystem *> compute_after_ ;
+
+            //
+            // The children in the order their state is computed, and the end of each group
+            // of children whose state is computed at the same time.  These are built the first
+            // time they are needed and again after the children or their dependencies change.
+            //
+            bool waves_valid_ ;
+            std::vector<Subsystem *> compute_order_ ;
+            std::vector<size_t> wave_ends_ ;
+            ComputeTask compute_task_ ;
+
+            //
+            // Holds the messages logged while the state is computed on a compute thread
+            //
+            xero::misc::MessageLogger::Capture compute_log_ ;
+
+            //
+            // The timing profile for this subsystem, only present if profiling is enabled
+            //
+            std::shared_ptr<SubsystemProfile> profile_ ;
         } ;
 
         typedef std::shared_ptr<Subsystem> SubsystemPtr ;
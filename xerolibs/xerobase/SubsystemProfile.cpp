@@ -0,0 +1,119 @@
+#include "SubsystemProfile.h"
+#include <AllocationCounter.h>
+#include <frc/Timer.h>
+#include <cxxabi.h>
+#include <cstdlib>
+
+using namespace xero::misc ;
+
+namespace xero {
+    namespace base {
+
+        SubsystemProfile::SubsystemProfile(const std::string &name, int depth, double looptime) :
+                        compute_(0.0, looptime, BucketCount), run_(0.0, looptime, BucketCount) {
+            name_ = name ;
+            depth_ = depth ;
+            looptime_ = looptime ;
+
+            compute_start_ = 0.0 ;
+            run_start_ = 0.0 ;
+            action_start_ = 0.0 ;
+            compute_allocs_start_ = 0 ;
+            run_allocs_start_ = 0 ;
+            last_compute_ = 0.0 ;
+            last_run_ = 0.0 ;
+            compute_allocs_ = 0 ;
+            run_allocs_ = 0 ;
+        }
+
+        SubsystemProfile::~SubsystemProfile() {
+        }
+
+        void SubsystemProfile::clear() {
+            compute_.clear() ;
+            run_.clear() ;
+            compute_allocs_ = 0 ;
+            run_allocs_ = 0 ;
+
+            //
+            // Keep the per action histograms so that actions seen before are not
+            // allocated again while the robot is running
+            //
+            for(auto &pair : actions_)
+                pair.second.clear() ;
+        }
+
+        void SubsystemProfile::startComputeState() {
+            compute_allocs_start_ = AllocationCounter::getCount() ;
+            compute_start_ = frc::Timer::GetFPGATimestamp() ;
+        }
+
+        void SubsystemProfile::endComputeState() {
+            last_compute_ = frc::Timer::GetFPGATimestamp() - compute_start_ ;
+            compute_allocs_ += AllocationCounter::getCount() - compute_allocs_start_ ;
+            compute_.add(last_compute_) ;
+        }
+
+        void SubsystemProfile::startRun() {
+            run_allocs_start_ = AllocationCounter::getCount() ;
+            run_start_ = frc::Timer::GetFPGATimestamp() ;
+        }
+
+        void SubsystemProfile::endRun() {
+            last_run_ = frc::Timer::GetFPGATimestamp() - run_start_ ;
+            run_allocs_ += AllocationCounter::getCount() - run_allocs_start_ ;
+            run_.add(last_run_) ;
+        }
+
+        void SubsystemProfile::startAction() {
+            action_start_ = frc::Timer::GetFPGATimestamp() ;
+        }
+
+        void SubsystemProfile::endAction(const Action &action) {
+            double elapsed = frc::Timer::GetFPGATimestamp() - action_start_ ;
+            std::type_index index(typeid(action)) ;
+
+            auto it = actions_.find(index) ;
+            if (it == actions_.end())
+                it = actions_.insert(std::make_pair(index, Histogram(0.0, looptime_, BucketCount))).first ;
+
+            it->second.add(elapsed) ;
+        }
+
+        void SubsystemProfile::log(MessageLogger &logger) const {
+            std::string indent(depth_ * 2, ' ') ;
+
+            logger.startMessage(MessageLogger::MessageType::info) ;
+            logger << "Profile: " << indent << name_ << " (ms)" ;
+            logger.endMessage() ;
+
+            logger.startMessage(MessageLogger::MessageType::info) ;
+            logger << "Profile: " << indent << "  computeState: " << compute_.toString(1000.0) ;
+            if (compute_.getCount() > 0)
+                logger << ", allocs/loop " << static_cast<double>(compute_allocs_) / compute_.getCount() ;
+            logger.endMessage() ;
+
+            logger.startMessage(MessageLogger::MessageType::info) ;
+            logger << "Profile: " << indent << "  run: " << run_.toString(1000.0) ;
+            if (run_.getCount() > 0)
+                logger << ", allocs/loop " << static_cast<double>(run_allocs_) / run_.getCount() ;
+            logger.endMessage() ;
+
+            for(const auto &pair : actions_) {
+                if (pair.second.getCount() == 0)
+                    continue ;
+
+                int status ;
+                const char *mangled = pair.first.name() ;
+                char *demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status) ;
+
+                logger.startMessage(MessageLogger::MessageType::info) ;
+                logger << "Profile: " << indent << "  action " << (status == 0 ? demangled : mangled) ;
+                logger << ": " << pair.second.toString(1000.0) ;
+                logger.endMessage() ;
+
+                std::free(demangled) ;
+            }
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Action.h"
+#include <Histogram.h>
+#include <MessageLogger.h>
+#include <typeindex>
+#include <map>
+#include <string>
+
+/// \file
+
+
+namespace xero {
+    namespace base {
+        /// \brief This class holds the timing profile for a single subsystem.
+        /// When profiling is enabled on the robot, each subsystem owns one of these objects.
+        /// The wall time of every call to computeState() and run() is recorded, along with
+        /// the wall time of the run() method of each type of action assigned to the subsystem.
+        /// The number of heap allocations made during computeState() and run() is also counted.
+        /// Only allocations made by the thread running the subsystem are counted.
+        /// <br>
+        /// Times are inclusive.  The computeState() and run() times of a subsystem include the
+        /// time spent in its children, and the run() time includes the time spent in the action.
+        class SubsystemProfile {
+        public:
+            /// \brief create a new profile
+            /// \param name the name of the subsystem being profiled
+            /// \param depth the depth of the subsystem in the subsystem tree
+            /// \param looptime the robot loop time, used to size the histograms
+            SubsystemProfile(const std::string &name, int depth, double looptime) ;
+
+            /// \brief destroy the profile
+            virtual ~SubsystemProfile() ;
+
+            /// \brief return the name of the subsystem being profiled
+            /// \returns the name of the subsystem being profiled
+            const std::string &getName() const {
+                return name_ ;
+            }
+
+            /// \brief return the depth of the subsystem in the subsystem tree
+            /// \returns the depth of the subsystem in the subsystem tree
+            int getDepth() const {
+                return depth_ ;
+            }
+
+            /// \brief called just before the subsystem computes its state
+            void startComputeState() ;
+
+            /// \brief called just after the subsystem computes its state
+            void endComputeState() ;
+
+            /// \brief called just before the subsystem runs
+            void startRun() ;
+
+            /// \brief called just after the subsystem runs
+            void endRun() ;
+
+            /// \brief called just before the subsystem runs its action
+            void startAction() ;
+
+            /// \brief called just after the subsystem runs its action
+            /// \param action the action that was run
+            void endAction(const Action &action) ;
+
+            /// \brief return the time of the last call to computeState()
+            /// \returns the time of the last call to computeState() in seconds
+            double getLastComputeStateTime() const {
+                return last_compute_ ;
+            }
+
+            /// \brief return the time of the last call to run()
+            /// \returns the time of the last call to run() in seconds
+            double getLastRunTime() const {
+                return last_run_ ;
+            }
+
+            /// \brief return the histogram of computeState() times
+            /// \returns the histogram of computeState() times
+            const xero::misc::Histogram &getComputeStateHistogram() const {
+                return compute_ ;
+            }
+
+            /// \brief return the histogram of run() times
+            /// \returns the histogram of run() times
+            const xero::misc::Histogram &getRunHistogram() const {
+                return run_ ;
+            }
+
+            /// \brief clear the profile data
+            void clear() ;
+
+            /// \brief log the profile data to the message logger
+            /// \param logger the message logger
+            void log(xero::misc::MessageLogger &logger) const ;
+
+        private:
+            static constexpr size_t BucketCount = 50 ;
+
+        private:
+            std::string name_ ;
+            int depth_ ;
+            double looptime_ ;
+
+            double compute_start_ ;
+            double run_start_ ;
+            double action_start_ ;
+
+            size_t compute_allocs_start_ ;
+            size_t run_allocs_start_ ;
+
+            double last_compute_ ;
+            double last_run_ ;
+
+            // Total allocations made in computeState() and run() since the last clear
+            size_t compute_allocs_ ;
+            size_t run_allocs_ ;
+
+            xero::misc::Histogram compute_ ;
+            xero::misc::Histogram run_ ;
+            std::map<std::type_index, xero::misc::Histogram> actions_ ;
+        } ;
+    }
+}
@@ -10,6 +10,7 @@ namespace xero {
     namespace base {
         TeleopController::TeleopController(Robot &robot) : ControllerBase(robot) {
             seq_ = std::make_shared<AutoMode>(robot, "teleop", "Teleop actions") ;
+            seq_->setPublishSteps(false) ;
         }
 
         TeleopController::~TeleopController() {            
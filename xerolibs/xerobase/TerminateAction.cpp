@@ -1,4 +1,5 @@
 #include "TerminateAction.h"
+#include "ActionPool.h"
 #include "DispatchAction.h"
 #include "basegroups.h"
 #include <iostream>
@@ -15,7 +16,7 @@ namespace xero {
 
         TerminateAction::TerminateAction(std::shared_ptr<Subsystem> sub, ActionPtr a, Robot &robot, double delay) : robot_(robot)
         {
-            action_ = std::make_shared<DispatchAction>(sub, a, true) ;
+            action_ = ActionPool::create<DispatchAction>(sub, a, true) ;
             delay_ = delay ;
         }        
 
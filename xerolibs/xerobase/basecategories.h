@@ -0,0 +1,25 @@
+#pragma once
+
+/// \file
+
+
+//
+// This file defines the action categories for actions in the base library.  Each
+// category is a single bit in a 32 bit mask.  The first 16 bits are reserved for the
+// base library, the upper 16 bits can be used by a robot for its own actions.
+//
+
+/// \brief category for actions assigned to the TankDrive subsystem
+#define ACTION_CATEGORY_TANKDRIVE           (1u << 0)
+
+/// \brief category for actions assigned to a SingleMotorSubsystem
+#define ACTION_CATEGORY_SINGLEMOTOR         (1u << 1)
+
+/// \brief category for actions assigned to the Lifter subsystem
+#define ACTION_CATEGORY_LIFTER              (1u << 2)
+
+/// \brief category for actions that change the camera of a CameraTracker
+#define ACTION_CATEGORY_CAMERACHANGE        (1u << 3)
+
+/// \brief category for actions that rumble the driver gamepad
+#define ACTION_CATEGORY_RUMBLE              (1u << 4)
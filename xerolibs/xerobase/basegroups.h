@@ -52,5 +52,9 @@
 
 #define MSG_GROUP_LINE_FOLLOWER_VERBOSE     (1ull << 15)
 
+/// \brief the verbose groups, whose debug messages are compiled out of competition builds
+#define MSG_GROUP_VERBOSE_MASK              (MSG_GROUP_TANKDRIVE_VERBOSE | MSG_GROUP_ACTIONS_VERBOSE | \
+                                             MSG_GROUP_CAMERA_TRACKER_VERBOSE | MSG_GROUP_LINE_FOLLOWER_VERBOSE)
+
 /// \brief ID to get all messages
 #define MSG_GROUP_ALL                   (0xffffffffffffffffull)
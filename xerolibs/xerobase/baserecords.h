@@ -0,0 +1,16 @@
+#pragma once
+
+/// \file
+
+
+//
+// This file defines the ids of the structured log records written by the base library
+// (see MessageLogger::defineRecord()).  Ids below 1000 are reserved for the base library,
+// robot specific records should start at 1000.
+//
+
+/// \brief ID for the per loop record of the tank drive path follower
+#define MSG_RECORD_TANKDRIVE_FOLLOW_PATH    (1)
+
+/// \brief ID for the per loop record of the lifter go to height action
+#define MSG_RECORD_LIFTER_GOTO_HEIGHT       (2)
@@ -2,6 +2,7 @@
 
 #include "Action.h"
 #include "basegroups.h"
+#include "basecategories.h"
 #include "CameraTracker.h"
 
 /// \file
@@ -19,6 +20,7 @@ namespace xero {
             CameraChangeAction(CameraTracker &subsystem, size_t which, CameraTracker::CameraMode mode) : subsystem_(subsystem) {
                 camera_ = which ;
                 mode_ = mode ;
+                addCategory(ACTION_CATEGORY_CAMERACHANGE) ;
             }
 
             ~CameraChangeAction(){
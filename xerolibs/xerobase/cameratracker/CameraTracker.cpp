@@ -2,6 +2,7 @@
 #include "CameraChangeAction.h"
 #include "Robot.h"
 #include "basegroups.h"
+#include "basecategories.h"
 #include <networktables/NetworkTableInstance.h>
 #include <iostream>
 
@@ -11,27 +12,101 @@ namespace xero {
     namespace base {
         CameraTracker::CameraTracker(Robot &robot) : Subsystem(robot, "CameraTracker")
         {
+            acceptCategory(ACTION_CATEGORY_CAMERACHANGE) ;
+            setParallelCompute(true) ;
             nt::NetworkTableInstance ntinst = nt::NetworkTableInstance::GetDefault() ;
             table_ = ntinst.GetTable(NetworkTableName) ;
 
+            //
+            // The listener is called on the network tables thread when the coprocessor
+            // changes an entry, changes made by the robot do not call it
+            //
+            EventQueue &events = robot.getEventQueue() ;
+            event_ = events.addSource("cameratracker") ;
+            listener_ = 0 ;
+            if (!events.isPolling() && event_ != EventQueue::AlwaysSource) {
+                size_t id = event_ ;
+                listener_ = table_->AddEntryListener(
+                    [&events, id](nt::NetworkTable *table, wpi::StringRef name, nt::NetworkTableEntry entry, std::shared_ptr<nt::Value> value, int flags) {
+                        events.post(id) ;
+                    },
+                    nt::EntryListenerFlags::kNew | nt::EntryListenerFlags::kUpdate) ;
+            }
+
             relay_ = std::make_shared<frc::Relay>(0) ;
             relay_->Set(frc::Relay::Value::kOff) ;   
             relay_state_ = frc::Relay::Value::kOff ;      
 
             camera_ = -1 ;
             mode_ = CameraMode::Invalid ;
+
+            is_valid_ = false ;
+            dist_inch_ = 0.0 ;
+            yaw_deg_ = 0.0 ;
+            frame_dist_inch_ = 0.0 ;
+            frame_yaw_deg_ = 0.0 ;
+            frame_ = -1.0 ;
+            capture_time_ = 0.0 ;
+            frame_latency_ = 0.0 ;
+
+            //
+            // The time between the camera capturing a frame and the pipeline getting it,
+            // which the vision coprocessor cannot measure
+            //
+            auto &settings = robot.getSettingsParser() ;
+            camera_latency_ = 0.0 ;
+            if (settings.isDefined("cameratracker:camera_latency"))
+                camera_latency_ = settings.getDouble("cameratracker:camera_latency") ;
         }
 
         CameraTracker::~CameraTracker()
         {            
+            if (listener_ != 0)
+                table_->RemoveEntryListener(listener_) ;
+        }
+
+        bool CameraTracker::isTableChanged()
+        {
+            return getRobot().getEventQueue().hasEvent(event_) ;
         }
 
         void CameraTracker::computeState()
         {            
-            is_valid_ = table_->GetBoolean(TargetDetected, false) ;
-            if (is_valid_) {
-                dist_inch_ = table_->GetNumber(TargetDistance, 0.0) * 0.71 ;
-                yaw_deg_ = table_->GetNumber(TargetAngle, 0.0) ;
+            //
+            // The coprocessor counts frames and reports how long each frame took to get
+            // from the pipeline to the network table.  A coprocessor that does not report
+            // these gives a capture time of now, which turns off the correction below.
+            //
+            if (isTableChanged()) {
+                is_valid_ = table_->GetBoolean(TargetDetected, false) ;
+                if (is_valid_) {
+                    frame_dist_inch_ = table_->GetNumber(TargetDistance, 0.0) * 0.71 ;
+                    frame_yaw_deg_ = table_->GetNumber(TargetAngle, 0.0) ;
+                }
+
+                double frame = table_->GetNumber(FrameNumber, -1.0) ;
+                if (frame != frame_ || frame < 0.0) {
+                    frame_ = frame ;
+                    frame_latency_ = table_->GetNumber(FrameLatency, 0.0) / 1000.0 ;
+                    capture_time_ = getRobot().getTime() - frame_latency_ ;
+                    if (frame >= 0.0)
+                        capture_time_ -= camera_latency_ ;
+                }
+            }
+            else if (frame_ < 0.0) {
+                //
+                // Nothing changed, but without frame numbers the data is always taken
+                // to be as old as the latency it was reported with
+                //
+                capture_time_ = getRobot().getTime() - frame_latency_ ;
+            }
+
+            dist_inch_ = frame_dist_inch_ ;
+            yaw_deg_ = frame_yaw_deg_ ;
+            if (is_valid_ && pose_history_ != nullptr) {
+                xero::misc::PoseSample then, now ;
+                if (pose_history_->getPoseAt(capture_time_, then) && pose_history_->getLatest(now))
+                    xero::misc::PoseHistory::project(then, now, frame_dist_inch_, frame_yaw_deg_, dist_inch_, yaw_deg_) ;
             }
 
             bool is_enabled = getRobot().IsEnabled() ;
@@ -44,6 +119,9 @@ namespace xero {
             logger << " enabled " << is_enabled ;
             logger << " dist_inch " << dist_inch_ ;
             logger << " yaw_deg " << yaw_deg_ ;
+            logger << " frame_dist_inch " << frame_dist_inch_ ;
+            logger << " frame_yaw_deg " << frame_yaw_deg_ ;
+            logger << " age " << getRobot().getTime() - capture_time_ ;
             logger.endMessage() ;
         }
 
@@ -51,11 +129,6 @@ namespace xero {
         {            
         }
 
-        bool CameraTracker::canAcceptAction(ActionPtr action)
-        {            
-            std::shared_ptr<CameraChangeAction> camact = std::dynamic_pointer_cast<CameraChangeAction>(action) ;
-            return camact != nullptr ;
-        }
 
         void CameraTracker::setCameraIndex(size_t which)
         {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Subsystem.h"
+#include <PoseHistory.h>
 #include <networktables/NetworkTable.h>
 #include <frc/Relay.h>
 
@@ -22,7 +23,6 @@ namespace xero {
 
             virtual void computeState() ;
             virtual void run() ;
-            virtual bool canAcceptAction(ActionPtr action) ;
 
             void setCameraIndex(size_t which)  ;
             size_t getCameraIndex() {
@@ -39,14 +39,44 @@ namespace xero {
                 return is_valid_ ;
             }
 
+            /// \brief use the positions of the robot to correct for the age of the vision data
+            /// With a history, getDistance() and getYaw() are moved from where the robot was when
+            /// the frame was captured to where the robot is now.
+            /// \param history the positions of the robot, usually from the drive base
+            void setPoseHistory(std::shared_ptr<xero::misc::PoseHistory> history) {
+                pose_history_ = history ;
+            }
+
+            /// \brief return the distance to the target from where the robot is now
+            /// \returns the distance to the target from where the robot is now
             virtual double getDistance() const {
                 return dist_inch_ ;
             }
 
+            /// \brief return the angle to the target from where the robot is now
+            /// \returns the angle to the target from where the robot is now
             virtual double getYaw() const {
                 return yaw_deg_ ;
             }
 
+            /// \brief return the distance to the target as seen in the frame
+            /// \returns the distance to the target as seen in the frame
+            double getFrameDistance() const {
+                return frame_dist_inch_ ;
+            }
+
+            /// \brief return the angle to the target as seen in the frame
+            /// \returns the angle to the target as seen in the frame
+            double getFrameYaw() const {
+                return frame_yaw_deg_ ;
+            }
+
+            /// \brief return the robot time when the latest frame was captured
+            /// \returns the robot time when the latest frame was captured
+            double getCaptureTime() const {
+                return capture_time_ ;
+            }
+
             static std::string toString(CameraMode mode) {
                 std::string ret = "????" ;
 
@@ -70,6 +100,10 @@ namespace xero {
                 return table_ ;
             }
 
+            /// \brief returns true if the coprocessor changed the network table since the last robot loop
+            /// \returns true if the coprocessor changed the network table since the last robot loop
+            bool isTableChanged() ;
+
         private:
             void setLEDRing() ;
             std::string toString(frc::Relay::Value v) ;
@@ -81,12 +115,27 @@ namespace xero {
             constexpr static const char *TargetAngle = "yaw_deg" ;
             constexpr static const char *CameraNumber ="camera_number";
             constexpr static const char *CameraModeName = "camera_mode" ;
+            constexpr static const char *FrameNumber = "frame" ;
+            constexpr static const char *FrameLatency = "latency_ms" ;
 
         private:
             std::shared_ptr<nt::NetworkTable> table_ ;
+
+            //
+            // The event source for changes to the network table, and the listener that posts to it
+            //
+            size_t event_ ;
+            NT_EntryListener listener_ ;
             bool is_valid_ ;
             double dist_inch_ ;
             double yaw_deg_ ;
+            double frame_dist_inch_ ;
+            double frame_yaw_deg_ ;
+            double frame_ ;
+            double capture_time_ ;
+            double frame_latency_ ;
+            double camera_latency_ ;
+            std::shared_ptr<xero::misc::PoseHistory> pose_history_ ;
             size_t camera_ ;
             CameraMode mode_ ;
             frc::Relay::Value relay_state_ ;
@@ -1,6 +1,7 @@
 #include "Lifter.h"
 #include "LifterAction.h"
 #include <Robot.h>
+#include <basecategories.h>
 #include <MessageLogger.h>
 #include <frc/smartdashboard/SmartDashboard.h>
 #include <iostream>
@@ -11,8 +12,15 @@ using namespace ctre::phoenix::motorcontrol ;
 
 namespace xero {
     namespace base {
-        Lifter::Lifter(Robot &robot, uint64_t id) : Subsystem(robot, "lifter") {
+        Lifter::Lifter(Robot &robot, uint64_t id) : Subsystem(robot, "lifter"), hold_refs_(robot.getSettingsParser(), "lifter:hold", true) {
             SettingsParser &parser = robot.getSettingsParser() ;
+            acceptCategory(ACTION_CATEGORY_LIFTER) ;
+            setParallelCompute(true) ;
+
+            threshold_ref_ = parser.getRef<double>("lifter:threshold") ;
+            maxv_ref_ = parser.getRef<double>("lifter:maxv") ;
+            maxa_ref_ = parser.getRef<double>("lifter:maxa") ;
+            maxd_ref_ = parser.getRef<double>("lifter:maxd") ;
 
             msg_id_ = id ;
             
@@ -123,13 +131,6 @@ namespace xero {
             }
         }
 
-        bool Lifter::canAcceptAction(ActionPtr action) {
-            auto dir_p = std::dynamic_pointer_cast<LifterAction>(action) ;
-            if (dir_p == nullptr)
-                return false ;
-
-            return true ;
-        }
 
         void Lifter::setMotorPower(double v) {
             if (is_calibrated_) {
@@ -5,6 +5,8 @@
 #include <frc/DigitalInput.h>
 #include <frc/Solenoid.h>
 #include <ctre/Phoenix.h>
+#include <PIDCtrl.h>
+#include <SettingRef.h>
 
 namespace xero {
     namespace base {
@@ -20,8 +22,6 @@ namespace xero {
         public:
             Lifter(xero::base::Robot &robot, uint64_t id) ;
             virtual ~Lifter() ;
-
-            virtual bool canAcceptAction(xero::base::ActionPtr action) ;
             virtual void computeState() ;
 
             double getHeight() const {
@@ -87,6 +87,16 @@ namespace xero {
 
             double expected_height_ ;
 
+            //
+            // Handles to the settings used by the lifter actions.  These are resolved once
+            // here so that creating an action does not look each one up by name.
+            //
+            xero::misc::SettingRef<double> threshold_ref_ ;
+            xero::misc::SettingRef<double> maxv_ref_ ;
+            xero::misc::SettingRef<double> maxa_ref_ ;
+            xero::misc::SettingRef<double> maxd_ref_ ;
+            xero::misc::PIDCtrl::SettingRefs hold_refs_ ;
+
             uint64_t msg_id_ ;
         } ;
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Action.h>
+#include <basecategories.h>
 
 namespace xero {
     namespace base {
@@ -9,6 +10,7 @@ namespace xero {
         class LifterAction : public xero::base::Action {
         public:
             LifterAction(Lifter &lifter) : lifter_(lifter) {                
+                addCategory(ACTION_CATEGORY_LIFTER) ;
             }
 
             Lifter &getLifter() {
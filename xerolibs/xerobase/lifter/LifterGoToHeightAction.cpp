@@ -2,6 +2,7 @@
 #include "Lifter.h"
 #include <Robot.h>
 #include <MessageLogger.h>
+#include <baserecords.h>
 #include <cmath>
 
 using namespace xero::misc ;
@@ -17,39 +18,46 @@ namespace xero {
             relative_ = relative ;
             target_ = target ;
             offset_ = target ;
-            threshold_ = getLifter().getRobot().getSettingsParser().getDouble("lifter:threshold") ;
-
-
-            double maxv = getLifter().getRobot().getSettingsParser().getDouble("lifter:maxv") ;
-            double maxa = getLifter().getRobot().getSettingsParser().getDouble("lifter:maxa") ;
-            double maxd = getLifter().getRobot().getSettingsParser().getDouble("lifter:maxd") ;                        
-            profile_ = std::make_shared<TrapezoidalProfile>(maxa, maxd, maxv) ;
-
-            pid_ctrl_.initFromSettingsExtended(lifter.getRobot().getSettingsParser(), "lifter:hold") ;             
+            readSettings() ;
         }
 
         LifterGoToHeightAction::LifterGoToHeightAction(Lifter &lifter, const std::string &name, bool relative) : LifterAction(lifter) {
             relative_ = relative ;            
-            target_ = getLifter().getRobot().getSettingsParser().getDouble(name) ;
-            offset_ = target_ ;
-
-            threshold_ = getLifter().getRobot().getSettingsParser().getDouble("lifter:threshold") ;
-  
-                                
-            double maxv = getLifter().getRobot().getSettingsParser().getDouble("lifter:maxv") ;
-            double maxa = getLifter().getRobot().getSettingsParser().getDouble("lifter:maxa") ;
-            double maxd = getLifter().getRobot().getSettingsParser().getDouble("lifter:maxd") ;                        
-            profile_ = std::make_shared<TrapezoidalProfile>(maxa, maxd, maxv) ;     
-
-            pid_ctrl_.initFromSettingsExtended(lifter.getRobot().getSettingsParser(), "lifter:hold") ;                                             
+            target_ref_ = getLifter().getRobot().getSettingsParser().getRef<double>(name) ;
+            readSettings() ;
         }
 
         LifterGoToHeightAction::~LifterGoToHeightAction() {
         }
 
+        void LifterGoToHeightAction::readSettings() {
+            Lifter &lifter = getLifter() ;
+
+            //
+            // The settings are read again each time the action starts so that values
+            // reloaded while the robot is running are used
+            //
+            if (target_ref_.isDefined()) {
+                target_ = target_ref_.get() ;
+                offset_ = target_ ;
+            }
+
+            threshold_ = lifter.threshold_ref_.get() ;
+
+            TrapezoidalProfile profile(lifter.maxa_ref_.get(), lifter.maxd_ref_.get(), lifter.maxv_ref_.get()) ;
+            if (profile_ == nullptr)
+                profile_ = std::make_shared<TrapezoidalProfile>(profile) ;
+            else
+                *profile_ = profile ;
+
+            pid_ctrl_.initFromSettings(lifter.hold_refs_) ;
+        }
+
         void LifterGoToHeightAction::start() {
             Lifter &lifter = getLifter() ;
 
+            readSettings() ;
+
             if (relative_)
                 target_ = lifter.expected_height_ + offset_ ;
 
@@ -89,6 +97,10 @@ namespace xero {
                     index_ = 0 ;
 
                     MessageLogger &logger = lifter.getRobot().getMessageLogger() ;
+                    logger.defineRecord(MSG_RECORD_LIFTER_GOTO_HEIGHT, "liftergotoheight", {
+                        "elapsed", "tdist", "traveled", "tvel", "speed", "out"
+                    }) ;
+
                     logger.startMessage(MessageLogger::MessageType::debug, getLifter().getMsgID()) ;
                     logger << "Lifter Target Distance: " << dist ;
                     logger.endMessage() ;
@@ -167,12 +179,23 @@ namespace xero {
                     double out = ctrl_->getOutput(tacc, tvel, tdist, traveled, dt) ;
                     lifter.setMotorPower(out) ;
 
-                    lifter.getRobot().addPlotData(plotid_, index_, 0, elapsed) ;
-                    lifter.getRobot().addPlotData(plotid_, index_, 1, tdist + start_height_) ;
-                    lifter.getRobot().addPlotData(plotid_, index_, 2, traveled + start_height_) ;
-                    lifter.getRobot().addPlotData(plotid_, index_, 3, tvel) ;
-                    lifter.getRobot().addPlotData(plotid_, index_, 4, speed) ;
-                    lifter.getRobot().addPlotData(plotid_, index_, 5, out) ;
+                    double data[] = {
+                        elapsed,
+                        tdist + start_height_,
+                        traveled + start_height_,
+                        tvel,
+                        speed,
+                        out
+                    } ;
+                    lifter.getRobot().addPlotRow(plotid_, index_, data) ;
+
+                    MessageLogger &logger = lifter.getRobot().getMessageLogger() ;
+                    if (XERO_LOG_ENABLED(logger, MessageLogger::MessageType::debug, getLifter().getMsgID())) {
+                        logger.startRecord(MessageLogger::MessageType::debug, getLifter().getMsgID(), MSG_RECORD_LIFTER_GOTO_HEIGHT) ;
+                        logger.addField(elapsed).addField(tdist).addField(traveled) ;
+                        logger.addField(tvel).addField(speed).addField(out) ;
+                        logger.endRecord() ;
+                    }
 
                     index_++ ;
                 }
@@ -5,6 +5,7 @@
 #include <PIDACtrl.h>
 #include <PIDCtrl.h>
 #include <TrapezoidalProfile.h>
+#include <SettingRef.h>
 
 namespace xero {
     namespace base {
@@ -20,9 +21,13 @@ namespace xero {
             virtual void cancel() ;
             virtual std::string toString() ;
 
+        private:
+            void readSettings() ;
+
         private:
             bool is_done_ ;
             double target_ ;
+            xero::misc::SettingRef<double> target_ref_ ;
             double threshold_ ;
             double offset_ ;
             double delay_start_ ;
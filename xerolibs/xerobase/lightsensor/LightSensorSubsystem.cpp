@@ -10,7 +10,7 @@ using namespace xero::misc;
 namespace xero {
     namespace base {
         LightSensorSubsystem::LightSensorSubsystem(Robot &robot, const std::string &name, const std::string &base, int sensor_count) : Subsystem(robot,name), ITerminator("LineFollower") {
-            SettingsParser settings_parser = robot.getSettingsParser() ;
+            SettingsParser &settings_parser = robot.getSettingsParser() ;
             for(int i=0; i<sensor_count; i++ ){
                 int sensor_address = settings_parser.getInteger(base + std::to_string(i)) ;
                 std::shared_ptr <frc::DigitalInput> sensor = std::make_shared <frc::DigitalInput>(sensor_address) ;
@@ -18,6 +18,8 @@ namespace xero {
             }
 
             is_detected_ = false ;
+            setParallelCompute(true) ;
+            setupEvents() ;
         }
 
         LightSensorSubsystem::LightSensorSubsystem(Robot &robot, const std::string &name, std::vector<int> sensor_numbers) : Subsystem(robot,name), ITerminator("LineFollower") {
@@ -27,9 +29,38 @@ namespace xero {
             }
 
             is_detected_ = false ;
+            setParallelCompute(true) ;
+            setupEvents() ;
         }        
 
+        void LightSensorSubsystem::setupEvents() {
+            EventQueue &events = getRobot().getEventQueue() ;
+            event_ = events.addSource("linesensor:" + getName()) ;
+            if (events.isPolling() || event_ == EventQueue::AlwaysSource)
+                return ;
+
+            //
+            // An edge on any of the sensors wakes the subsystem
+            //
+            for(auto sensor : light_sensors_) {
+                sensor->RequestInterrupts(&LightSensorSubsystem::sensorChanged, this) ;
+                sensor->SetUpSourceEdge(true, true) ;
+                sensor->EnableInterrupts() ;
+            }
+        }
+
+        void LightSensorSubsystem::sensorChanged(uint32_t mask, void *param) {
+            LightSensorSubsystem *sub = static_cast<LightSensorSubsystem *>(param) ;
+            sub->getRobot().getEventQueue().post(sub->event_) ;
+        }
+
         void LightSensorSubsystem::computeState() { 
+            //
+            // The sensors only change with an edge, without one the last state stands
+            //
+            if (!getRobot().getEventQueue().hasEvent(event_))
+                return ;
+
             angle_ = 0 ;
             int sensors_on = 0;
 
@@ -42,10 +42,6 @@ namespace xero {
             
             }
 
-            virtual bool canAcceptAction(ActionPtr action) {
-                return false ;
-            }
-
             double guidanceAngle() {
                 return angle_;
             }
@@ -80,8 +76,13 @@ namespace xero {
                 return is_detected_ ;
             }
 
+        private:
+            void setupEvents() ;
+            static void sensorChanged(uint32_t mask, void *param) ;
+
         private:
             std::vector <std::shared_ptr<frc::DigitalInput>> light_sensors_ ;
+            size_t event_ ;
             double angle_ ;
             std::list<uint32_t> sensor_data_ ;
             int detect_count_ ;
@@ -89,6 +89,8 @@ namespace xero {
             nudge_backward_high_ = std::make_shared<TankDriveTimedPowerAction>(*db_, -nudge_straight, -nudge_straight, nudge_time, false) ;
             nudge_clockwise_high_ = std::make_shared<TankDriveTimedPowerAction>(*db_, -nudge_rotate, nudge_rotate, nudge_time, false) ;
             nudge_counter_clockwise_high_ = std::make_shared<TankDriveTimedPowerAction>(*db_, nudge_rotate, -nudge_rotate, nudge_time, false) ;            
+
+            power_ = std::make_shared<TankDrivePowerAction>(*db_, 0.0, 0.0, true) ;
         }
 
         double DriverGamepad::scalePower(double axis, double boost, bool slow) {
@@ -223,8 +225,12 @@ namespace xero {
                 }
                 
                 if (std::fabs(left - left_) > tolerance_ || std::fabs(right - right_) > tolerance_) {
-                    auto dir = std::make_shared<TankDrivePowerAction>(*db_, left, right, high_gear_) ;
-                    seq.pushSubActionPair(db_, dir) ;
+                    //
+                    // The power action sets the motors when it starts and is then done, so the
+                    // same action is updated and assigned again rather than creating a new one
+                    //
+                    power_->setPower(left, right, high_gear_) ;
+                    seq.pushSubActionPair(db_, power_) ;
                     left_ = left ;
                     right_ = right ;
                 }
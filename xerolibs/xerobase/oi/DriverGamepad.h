@@ -9,6 +9,7 @@
 namespace xero {
     namespace base {
         class TankDrive ;
+        class TankDrivePowerAction ;
 
         /// \brief A DriveGamepad used to control the drivebase
         class DriverGamepad : public HIDDevice {
@@ -110,6 +111,8 @@ namespace xero {
             ActionPtr nudge_clockwise_high_ ;
             ActionPtr nudge_counter_clockwise_high_ ;            
 
+            std::shared_ptr<TankDrivePowerAction> power_ ;
+
             bool reverse_ ;
             bool high_gear_ ;
 
@@ -1,4 +1,5 @@
 #include "DriverGamepadRumbleAction.h"
+#include "basecategories.h"
 
 using namespace xero::misc ;
 
@@ -9,6 +10,7 @@ namespace xero {
             value_ = value ;
             left_ = left ;
             duration_ = duration ;
+            addCategory(ACTION_CATEGORY_RUMBLE) ;
         }
 
         void DriverGamepadRumbleAction::start() {
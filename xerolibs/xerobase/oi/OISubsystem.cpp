@@ -3,6 +3,7 @@
 #include "ActionSequence.h"
 #include "tankdrive/TankDrive.h"
 #include "basegroups.h"
+#include "basecategories.h"
 #include "DriverGamepadRumbleAction.h"
 #include <MessageLogger.h>
 
@@ -13,6 +14,7 @@ namespace xero {
         OISubsystem::OISubsystem(Robot &robot, const std::string &name, bool adddriver) 
                                 : Subsystem(robot, name) {
             inited_ = false ;
+            acceptCategory(ACTION_CATEGORY_RUMBLE) ;
             if (adddriver) {
                 int driver = robot.getSettingsParser().getInteger("hw:driverstation:hid:driver") ;                
                 driver_ = std::make_shared<DriverGamepad>(*this, driver);
@@ -64,10 +66,5 @@ namespace xero {
 
         void OISubsystem::run() {
         }
-
-        bool OISubsystem::canAcceptAction(ActionPtr act) {
-            std::shared_ptr<DriverGamepadRumbleAction> dact = std::dynamic_pointer_cast<DriverGamepadRumbleAction>(act) ;
-            return dact != nullptr ;
-        }
     }
 }
@@ -37,8 +37,6 @@ namespace xero {
             /// \brief run the action generated in the computeState above
             virtual void run() ;
 
-            virtual bool canAcceptAction(ActionPtr act) ;
-
             /// \brief return the value of the automode selctor.
             /// This method iterates through each of the HID devices and the first HID device that
             /// returns an automode selection that is not -1, this value is returned.
@@ -1,11 +1,13 @@
 #include "SingleMotorSubsystem.h"
 #include "Robot.h"
+#include "basecategories.h"
 
 using namespace xero::misc;
 
 namespace xero {
     namespace base {
         SingleMotorSubsystem::SingleMotorSubsystem(Robot & robot, const std::string &name, const std::string &motor, uint64_t mid, bool victor) : Subsystem(robot,name) {
+            acceptCategory(ACTION_CATEGORY_SINGLEMOTOR) ;
             int m = robot.getSettingsParser().getInteger(motor) ;
 
             index_ = m ;
@@ -23,6 +25,7 @@ namespace xero {
         }
 
         SingleMotorSubsystem::SingleMotorSubsystem(Robot & robot, const std::string &name, int m, uint64_t mid, bool victor) : Subsystem(robot,name) {
+            acceptCategory(ACTION_CATEGORY_SINGLEMOTOR) ;
 
             index_ = m ;
             msg_id_ = mid ;
@@ -42,10 +45,5 @@ namespace xero {
         SingleMotorSubsystem::~SingleMotorSubsystem(){
         }
 
-        bool SingleMotorSubsystem::canAcceptAction(ActionPtr action) {
-          
-            auto coll = std::dynamic_pointer_cast<SingleMotorSubsystemAction>(action) ;
-            return coll != nullptr ;
-        }
     }
 }
\ No newline at end of file
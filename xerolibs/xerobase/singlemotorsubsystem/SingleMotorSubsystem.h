@@ -57,8 +57,6 @@ namespace xero {
             /// \brief destroy the subsystem, freeing up the motor controllers
             virtual ~SingleMotorSubsystem();
 
-            virtual bool canAcceptAction(ActionPtr action) ;
-
             /// \brief returns true if the motor is running
             /// \returns true if the motor is running
             bool isRunning() const {
@@ -2,6 +2,7 @@
 
 #include "Action.h"
 #include "basegroups.h"
+#include "basecategories.h"
 
 
 /// \file
@@ -18,6 +19,7 @@ namespace xero {
             /// \brief Create a new SingleMotorSubsystemAction
             /// \param subsystem SingleMotor subsystem
             SingleMotorSubsystemAction(SingleMotorSubsystem &subsystem) : subsystem_(subsystem) {
+                addCategory(ACTION_CATEGORY_SINGLEMOTOR) ;
             }
 
         protected:
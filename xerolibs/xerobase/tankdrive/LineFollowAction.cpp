@@ -12,7 +12,7 @@ namespace xero {
 
         LineFollowAction::LineFollowAction(LightSensorSubsystem &ls_subsystem, TankDrive &db_subsystem, const std::string &power_name, const std::string &distance_name, const std::string &power_adjust_name) 
                         : TankDriveAction(db_subsystem), ls_subsystem_(ls_subsystem) {
-            SettingsParser settings_parser = ls_subsystem.getRobot().getSettingsParser() ;
+            SettingsParser &settings_parser = ls_subsystem.getRobot().getSettingsParser() ;
             power_ = settings_parser.getDouble(power_name) ;
             distance_ = settings_parser.getDouble(distance_name) ;
             power_adjust_ = settings_parser.getDouble(power_adjust_name) ;
@@ -1,20 +1,27 @@
 #include "TankDrive.h"
 #include "TankDriveAction.h"
 #include "Robot.h"
+#include "basecategories.h"
 #include "LoopType.h"
 #include <frc/smartdashboard/SmartDashboard.h>
+#include <frc/Timer.h>
 #include <cassert>
 #include <cmath>
+#include <chrono>
 
 using namespace xero::misc ;
 
 namespace xero {
     namespace base {
 
+        constexpr size_t TankDrive::PoseHistorySize ;
+
         TankDrive::TankDrive(Robot& robot, const std::list<int> &left_motor_ids, const std::list<int> &right_motor_ids) : 
                         DriveBase(robot, "tankdrive"), angular_(2, true), left_linear_(2), right_linear_(2) {
             //The two sides should always have the same number of motors and at least one motor each
             assert((left_motor_ids.size() == right_motor_ids.size()) && (left_motor_ids.size() > 0));
+            acceptCategory(ACTION_CATEGORY_TANKDRIVE) ;
+            setParallelCompute(true) ;
 
             SettingsParser &settings = robot.getSettingsParser() ;
             if (settings.isDefined("hw:tankdrive:motortype") && settings.getString("hw:tankdrive:motortype") == "victor")
@@ -30,8 +37,6 @@ namespace xero {
 
             dist_l_ = 0.0 ;
             dist_r_ = 0.0 ;
-            last_dist_l_ = 0.0 ;
-            last_dist_r_ = 0.0 ;
 
 #ifdef GOPIGO
             navx_ = std::make_shared<AHRS>(frc::SerialPort::Port::Port_0) ;
@@ -53,12 +58,64 @@ namespace xero {
             double width = settings.getDouble("tankdrive:width") ;
             double scrub = settings.getDouble("tankdrive:scrub") ;
             kin_ = std::make_shared<xero::misc::Kinematics>(width, scrub) ;
+            kin_left_ = 0.0 ;
+            kin_right_ = 0.0 ;
+
+            pose_history_ = std::make_shared<PoseHistory>(PoseHistorySize) ;
+            pose_ = PoseSample{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } ;
+            odometry_running_ = false ;
+
+            if (settings.isDefined("tankdrive:estimator:distance_noise")) {
+                PoseEstimator::Noise noise ;
+                noise.distance_ = settings.getDouble("tankdrive:estimator:distance_noise") ;
+                noise.turn_ = settings.getDouble("tankdrive:estimator:turn_noise") ;
+                noise.gyro_ = settings.getDouble("tankdrive:estimator:gyro_noise") ;
+                estimator_ = std::make_shared<PoseEstimator>(width, scrub, noise) ;
+                estimator_pose_ = pose_ ;
+            }
         }
 
         TankDrive::~TankDrive() {   
+            stopOdometry() ;
             setMotorsToPercents(0, 0);   // Turn motors off     
         }
 
+        TankDrive::FollowerSettings::FollowerSettings(SettingsParser &parser) :
+                        left(parser, "tankdrive:follower:left:"), right(parser, "tankdrive:follower:right:") {
+            turn_correction = parser.getRef<double>("tankdrive:follower:turn_correction") ;
+            angle_correction = parser.getRef<double>("tankdrive:follower:angle_correction") ;
+        }
+
+        const TankDrive::FollowerSettings &TankDrive::getFollowerSettings() {
+            //
+            // Resolved on first use so that robots that never follow a path do not need
+            // the follower settings
+            //
+            if (follower_settings_ == nullptr)
+                follower_settings_ = std::make_shared<FollowerSettings>(getRobot().getSettingsParser()) ;
+
+            return *follower_settings_ ;
+        }
+
+        std::shared_ptr<XeroPathGenerator> TankDrive::getPathGenerator() {
+            if (path_generator_ == nullptr) {
+                double width = getRobot().getSettingsParser().getDouble("tankdrive:width") ;
+                path_generator_ = std::make_shared<XeroPathGenerator>(width) ;
+            }
+
+            return path_generator_ ;
+        }
+
+        XeroPathGenerator::Constraints TankDrive::getPathConstraints() {
+            auto &settings = getRobot().getSettingsParser() ;
+            XeroPathGenerator::Constraints limits ;
+
+            limits.maxv_ = settings.getDouble("tankdrive:generator:maxv") ;
+            limits.maxa_ = settings.getDouble("tankdrive:generator:maxa") ;
+            limits.maxcentripetal_ = settings.getDouble("tankdrive:generator:maxcentripetal") ;
+            return limits ;
+        }
+
         void TankDrive::reset() {
             Subsystem::reset() ;
 
@@ -118,10 +175,6 @@ namespace xero {
             }
         }       
 
-        bool TankDrive::canAcceptAction(ActionPtr ptr) {
-            auto act = std::dynamic_pointer_cast<TankDriveAction>(ptr) ;
-            return act != nullptr ;
-        }
 
         void TankDrive::run() {
             Subsystem::run() ;
@@ -191,6 +244,76 @@ namespace xero {
             }
         }       
 
+        void TankDrive::postHWInit() {
+            DriveBase::postHWInit() ;
+
+            auto &settings = getRobot().getSettingsParser() ;
+            if (left_enc_ == nullptr || !settings.isDefined("tankdrive:odometry:rate"))
+                return ;
+
+            double rate = settings.getDouble("tankdrive:odometry:rate") ;
+            if (rate <= 0.0)
+                return ;
+
+            odometry_running_ = true ;
+            odometry_thread_ = std::thread(&TankDrive::odometryThread, this, 1.0 / rate) ;
+
+            auto &logger = getRobot().getMessageLogger() ;
+            logger.startMessage(MessageLogger::MessageType::info) ;
+            logger << "TankDrive: odometry thread running at " << rate << " Hz" ;
+            logger.endMessage() ;
+        }
+
+        void TankDrive::stopOdometry() {
+            if (odometry_thread_.joinable()) {
+                odometry_running_ = false ;
+                odometry_thread_.join() ;
+            }
+        }
+
+        void TankDrive::updatePose(double now, double left, double right, double angle) {
+            if (navx_ != nullptr) {
+                kin_->move(right - kin_right_, left - kin_left_, xero::math::deg2rad(angle)) ;
+            }
+            else {
+                kin_->move(right - kin_right_, left - kin_left_) ;
+                angle = xero::math::rad2deg(kin_->getAngle()) ;
+            }
+
+            kin_left_ = left ;
+            kin_right_ = right ;
+            pose_history_->add(PoseSample{ now, kin_->getX(), kin_->getY(), angle, left, right }) ;
+        }
+
+        void TankDrive::odometryThread(double period) {
+            //
+            // This thread only reads the encoders and the NavX, which are safe to read from any
+            // thread, and is the only writer of kin_ and the pose history while it runs.  The
+            // robot loop picks up the newest pose in computeState().
+            //
+            auto step = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(period)) ;
+            auto next = std::chrono::steady_clock::now() ;
+
+            while (odometry_running_) {
+                double now = frc::Timer::GetFPGATimestamp() ;
+                double left = left_enc_->Get() * left_inches_per_tick_ ;
+                double right = right_enc_->Get() * right_inches_per_tick_ ;
+                double angle = (navx_ != nullptr) ? navx_->GetYaw() : 0.0 ;
+
+                updatePose(now, left, right, angle) ;
+
+                next += step ;
+                auto current = std::chrono::steady_clock::now() ;
+                if (next < current) {
+                    //
+                    // Fell behind, do not try to catch up with a burst of samples
+                    //
+                    next = current ;
+                }
+                std::this_thread::sleep_until(next) ;
+            }
+        }
+
         void TankDrive::computeState() {
             double angle = 0.0 ;
 
@@ -214,22 +337,33 @@ namespace xero {
             right_linear_.update(getRobot().getDeltaTime(), getRightDistance()) ;
 
             auto &logger = getRobot().getMessageLogger() ;
-            logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_TANKDRIVE_VERBOSE);
-            logger << "TankDrive: " ;
-            logger << " linear dist " << getDist() ;
-            logger << ", velocity " << getVelocity() ;
-            logger << ", accel " << getAcceleration() ;
-            logger << ", angle dist " << getAngle() ;
-            logger << ", velocity " << getAngularVelocity() ;
-            logger << ", accel " << getAngularAcceleration() ;
-            logger << ", ticks " << ticks_left_ << " " << ticks_right_ ;
-            logger << ", dist " << dist_l_ << " " << dist_r_ ;
-            logger.endMessage();    
-
-            kin_->move(dist_r_ - last_dist_r_, dist_l_ - last_dist_l_, angle) ;
-
-            last_dist_l_ = dist_l_ ;
-            last_dist_r_ = dist_r_ ;
+            if (XERO_LOG_ENABLED(logger, MessageLogger::MessageType::debug, MSG_GROUP_TANKDRIVE_VERBOSE)) {
+                logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_TANKDRIVE_VERBOSE);
+                logger << "TankDrive: " ;
+                logger << " linear dist " << getDist() ;
+                logger << ", velocity " << getVelocity() ;
+                logger << ", accel " << getAcceleration() ;
+                logger << ", angle dist " << getAngle() ;
+                logger << ", velocity " << getAngularVelocity() ;
+                logger << ", accel " << getAngularAcceleration() ;
+                logger << ", ticks " << ticks_left_ << " " << ticks_right_ ;
+                logger << ", dist " << dist_l_ << " " << dist_r_ ;
+                logger.endMessage();
+            }
+
+            if (!hasOdometryThread())
+                updatePose(getRobot().getTime(), dist_l_, dist_r_, angle) ;
+            pose_history_->getLatest(pose_) ;
+
+            if (estimator_ != nullptr) {
+                double dl = pose_.left_ - estimator_pose_.left_ ;
+                double dr = pose_.right_ - estimator_pose_.right_ ;
+                if (navx_ != nullptr)
+                    estimator_->predict(dl, dr, xero::math::normalizeAngleDegrees(pose_.angle_ - estimator_pose_.angle_)) ;
+                else
+                    estimator_->predict(dl, dr) ;
+                estimator_pose_ = pose_ ;
+            }
 
 
             if (navx_ != nullptr) {
@@ -9,7 +9,13 @@
 #include <frc/Encoder.h>
 #include <frc/VictorSP.h>
 #include <ctre/Phoenix.h>
+#include <PIDACtrl.h>
+#include <XeroPathGenerator.h>
+#include <PoseHistory.h>
+#include <PoseEstimator.h>
 #include <list>
+#include <thread>
+#include <atomic>
 
 /// \file
 
@@ -162,11 +168,6 @@ namespace xero {
             /// \brief Run the subsystem
             virtual void run() ;
 
-            /// \brief This method returns true if the tankdrive subsystem can execute the given action
-            /// \param action the section to test to see if it can be executed
-            /// \returns true if the action can be executed, false otherwise
-            virtual bool canAcceptAction(xero::base::ActionPtr action) ;
-
             /// \brief set the drive base to low gear
             void lowGear() ;
 
@@ -180,24 +181,93 @@ namespace xero {
             /// \param ltype the type of loop being enabled (e.g. teleop, auto, test)
             virtual void init(LoopType ltype) ;
 
+            /// \brief start the odometry thread once the encoders are created
+            /// The thread runs if tankdrive:odometry:rate is defined and greater than zero.
+            virtual void postHWInit() ;
+
+            /// \brief return true if the position of the robot is tracked by the odometry thread
+            /// \returns true if the position of the robot is tracked by the odometry thread
+            bool hasOdometryThread() const {
+                return odometry_thread_.joinable() ;
+            }
+
+            /// \brief return the position of the robot as of the start of this robot loop
+            /// \returns the position of the robot as of the start of this robot loop
+            const xero::misc::PoseSample &getPose() const {
+                return pose_ ;
+            }
+
+            /// \brief return the recent positions of the robot
+            /// With the odometry thread running this holds a sample for each time the thread ran,
+            /// otherwise it holds a sample for each robot loop.
+            /// \returns the recent positions of the robot
+            std::shared_ptr<xero::misc::PoseHistory> getPoseHistory() const {
+                return pose_history_ ;
+            }
+
+            /// \brief return the filter that estimates the position of the robot on the field
+            /// The filter is moved each robot loop by the odometry.  Callers that see vision
+            /// targets at known field positions correct it with PoseEstimator::updateTarget().
+            /// \returns the filter, or nullptr if tankdrive:estimator is not configured
+            std::shared_ptr<xero::misc::PoseEstimator> getPoseEstimator() {
+                return estimator_ ;
+            }
+
             double getX() const {
-                return kin_->getX() ;
+                return pose_.x_ ;
             }
 
             double getY() const {
-                return kin_->getY() ;
+                return pose_.y_ ;
             }
 
             double getXYZVelocity() {
                 return xyz_velocity_ ;
             }
 
+            /// \brief handles to the settings used by the path follower
+            struct FollowerSettings {
+                /// \brief resolve the handles
+                /// \param parser the settings parser
+                FollowerSettings(xero::misc::SettingsParser &parser) ;
+
+                xero::misc::PIDACtrl::SettingRefs left ;                ///< the left side follower constants
+                xero::misc::PIDACtrl::SettingRefs right ;               ///< the right side follower constants
+                xero::misc::SettingRef<double> turn_correction ;        ///< the heading correction gain
+                xero::misc::SettingRef<double> angle_correction ;       ///< the angle correction gain
+            } ;
+
+            /// \brief return the handles to the settings used by the path follower
+            /// The handles are resolved the first time this is called.
+            /// \returns the handles to the settings used by the path follower
+            const FollowerSettings &getFollowerSettings() ;
+
+            /// \brief return the generator for paths built while the robot is running
+            /// The generator is created on first use, with the width of the drive base.
+            /// \returns the path generator
+            std::shared_ptr<xero::misc::XeroPathGenerator> getPathGenerator() ;
+
+            /// \brief return the limits for generated paths
+            /// The limits are read from the settings each time so that reloaded values are used.
+            /// \returns the limits for generated paths
+            xero::misc::XeroPathGenerator::Constraints getPathConstraints() ;
+
+        private:
+            //
+            // About a second and a quarter of samples at 200 Hz
+            //
+            static constexpr size_t PoseHistorySize = 256 ;
+
         private:
             /// \brief Set the motors to output at the given percentages
             /// \param left_percent the percent output for the left motors
             /// \param right_percent the percent output for the right motors
             void setMotorsToPercents(double left_percent, double right_percent);
 
+            void odometryThread(double period) ;
+            void updatePose(double now, double left, double right, double angle) ;
+            void stopOdometry() ;
+
             static void initTalonList(const std::list<int>& ids, std::list<TalonPtr>& talons) ;
             static void initVictorList(const std::list<int> &ids, std::list<VictorPtr> &victors) ;
 
@@ -213,6 +283,9 @@ namespace xero {
 
             std::shared_ptr<frc::Solenoid> gear_ ;
 
+            std::shared_ptr<FollowerSettings> follower_settings_ ;
+            std::shared_ptr<xero::misc::XeroPathGenerator> path_generator_ ;
+
             std::shared_ptr<AHRS> navx_ ;
 
             double total_angle_ ;
@@ -225,12 +298,22 @@ namespace xero {
             int ticks_right_ ;
             
             double dist_l_, dist_r_;
-            double last_dist_l_, last_dist_r_ ;
 
             double left_inches_per_tick_ ;
             double right_inches_per_tick_ ;
 
+            //
+            // Owned by the odometry thread while it is running, otherwise updated in computeState()
+            //
             std::shared_ptr<xero::misc::Kinematics> kin_ ;
+            double kin_left_, kin_right_ ;
+
+            std::shared_ptr<xero::misc::PoseHistory> pose_history_ ;
+            xero::misc::PoseSample pose_ ;
+            std::shared_ptr<xero::misc::PoseEstimator> estimator_ ;
+            xero::misc::PoseSample estimator_pose_ ;
+            std::thread odometry_thread_ ;
+            std::atomic<bool> odometry_running_ ;
 
             double xyz_velocity_ ;
         };
@@ -2,6 +2,7 @@
 
 #include "Action.h"
 #include "basegroups.h"
+#include "basecategories.h"
 #include "TankDrive.h"
 
 
@@ -19,6 +20,7 @@ namespace xero {
             /// \brief Create a new TankDriveAction
             /// \param tank_drive the tank drive subsystem
             TankDriveAction(TankDrive &tank_drive) : tank_drive_(tank_drive) {
+                addCategory(ACTION_CATEGORY_TANKDRIVE) ;
             }
 
         protected:
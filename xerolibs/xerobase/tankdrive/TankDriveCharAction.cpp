@@ -65,13 +65,16 @@ namespace xero {
                     logger << ", " << voltage_ ;
                     logger.endMessage() ;
 
-                    rb.addPlotData(plotid_, index_, 0, now - start_time_) ;
-                    rb.addPlotData(plotid_, index_, 1, getTankDrive().getDist()) ;
-                    rb.addPlotData(plotid_, index_, 2, getTankDrive().getVelocity()) ;
-                    rb.addPlotData(plotid_, index_, 3, getTankDrive().getAcceleration()) ;
-                    rb.addPlotData(plotid_, index_, 4, getTankDrive().getLeftTickCount()) ;
-                    rb.addPlotData(plotid_, index_, 5, getTankDrive().getRightTickCount()) ;
-                    rb.addPlotData(plotid_, index_, 6, voltage_) ;
+                    double data[] = {
+                        now - start_time_,
+                        getTankDrive().getDist(),
+                        getTankDrive().getVelocity(),
+                        getTankDrive().getAcceleration(),
+                        static_cast<double>(getTankDrive().getLeftTickCount()),
+                        static_cast<double>(getTankDrive().getRightTickCount()),
+                        voltage_
+                    } ;
+                    rb.addPlotRow(plotid_, index_, data) ;
 
                     index_++ ;
 
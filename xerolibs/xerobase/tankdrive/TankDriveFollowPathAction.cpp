@@ -1,6 +1,7 @@
 #include "TankDriveFollowPathAction.h"
 #include "TankDrive.h"
 #include "Robot.h"
+#include "baserecords.h"
 #include <frc/smartdashboard/SmartDashboard.h>
 #include <cassert>
 
@@ -17,53 +18,97 @@ namespace xero {
 
         TankDriveFollowPathAction::TankDriveFollowPathAction(TankDrive &db, const std::string &name, bool reverse) : TankDriveAction(db)  {
             reverse_ = reverse;
-            path_ = db.getRobot().getPathManager()->getPath(name) ;
-            assert(path_ != nullptr) ;
-
-            std::string pname = "tankdrive:follower:";
-            
-            left_follower_ = std::make_shared<PIDACtrl>(db.getRobot().getSettingsParser(), pname + "left:kv", 
-                                pname + "left:ka", pname + "left:kp", pname + "left:kd") ;
-            right_follower_ = std::make_shared<PIDACtrl>(db.getRobot().getSettingsParser(), pname + "right:kv", 
-                                pname + "right:ka", pname + "right:kp", pname + "right:kd") ;
+            path_name_ = name ;
+            path_future_ = db.getRobot().getPathManager()->loadPathAsync(name, true) ;
+            driving_ = false ;
+            done_ = false ;
+            plotid_ = -1 ;
+
+            const TankDrive::FollowerSettings &settings = db.getFollowerSettings() ;
+            left_follower_ = std::make_shared<PIDACtrl>(settings.left) ;
+            right_follower_ = std::make_shared<PIDACtrl>(settings.right) ;
+        }
 
-            turn_correction_ = db.getRobot().getSettingsParser().getDouble("tankdrive:follower:turn_correction") ;
-            angle_correction_ = db.getRobot().getSettingsParser().getDouble("tankdrive:follower:angle_correction") ;
+        TankDriveFollowPathAction::TankDriveFollowPathAction(TankDrive &db, std::shared_ptr<XeroPath> path, bool reverse) : TankDriveAction(db)  {
+            reverse_ = reverse;
+            path_ = path ;
+            assert(path_ != nullptr) ;
+            path_name_ = path_->getName() ;
+            driving_ = false ;
+            done_ = false ;
+            plotid_ = -1 ;
+
+            const TankDrive::FollowerSettings &settings = db.getFollowerSettings() ;
+            left_follower_ = std::make_shared<PIDACtrl>(settings.left) ;
+            right_follower_ = std::make_shared<PIDACtrl>(settings.right) ;
         }
 
         TankDriveFollowPathAction::~TankDriveFollowPathAction() {                
         }
 
         void TankDriveFollowPathAction::start() {
+            driving_ = false ;
+            done_ = false ;
+            index_ = 0 ;
+
+            //
+            // The robot loop never waits for the path to be read, if it is not ready the
+            // robot holds still and run() checks again each loop
+            //
+            if (path_ == nullptr && path_future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                auto &logger = getTankDrive().getRobot().getMessageLogger() ;
+                logger.startMessage(MessageLogger::MessageType::warning) ;
+                logger << "TankDriveFollowPathAction: waiting for path '" << path_name_ << "' to be read" ;
+                logger.endMessage() ;
+
+                setMotorsToPercents(0.0, 0.0) ;
+                return ;
+            }
+
+            startPath() ;
+        }
+
+        void TankDriveFollowPathAction::startPath() {
+            if (path_ == nullptr) {
+                path_ = path_future_.get() ;
+                if (path_ == nullptr) {
+                    auto &logger = getTankDrive().getRobot().getMessageLogger() ;
+                    logger.startMessage(MessageLogger::MessageType::error) ;
+                    logger << "TankDriveFollowPathAction: path '" << path_name_ << "' could not be read, action skipped" ;
+                    logger.endMessage() ;
+
+                    setMotorsToPercents(0.0, 0.0) ;
+                    done_ = true ;
+                    return ;
+                }
+            }
+
+            //
+            // Read the settings here rather than in the constructor so that values
+            // reloaded while the robot is running are used
+            //
+            const TankDrive::FollowerSettings &settings = getTankDrive().getFollowerSettings() ;
+            left_follower_->init(settings.left) ;
+            right_follower_->init(settings.right) ;
+            turn_correction_ = settings.turn_correction.get() ;
+            angle_correction_ = settings.angle_correction.get() ;
+
             left_start_ = getTankDrive().getLeftDistance() ;
             right_start_ = getTankDrive().getRightDistance() ;
             
-            index_ = 0 ;         
+            driving_ = true ;
             start_time_ = getTankDrive().getRobot().getTime() ;
             start_angle_ = getTankDrive().getAngle() ;
-            target_start_angle_ = path_->getLeftSegment(0).getHeading() ;
+            target_start_angle_ = path_->getColumn(XeroPath::Side::Left, XeroPath::Column::Heading)[0] ;
 
             if (getTankDrive().hasGearShifter())
                 getTankDrive().highGear() ;
 
             auto &logger = getTankDrive().getRobot().getMessageLogger() ;
-            logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_TANKDRIVE) ;
-            logger << "runtime" ;
-            logger << ",ltpos" ;
-            logger << ",lapos" ;
-            logger << ",ltvel" ;
-            logger << ",lout" ;
-            logger << "," ;
-            logger << ",rtpos" ;
-            logger << ",rapos" ;
-            logger << ",rtvel" ;
-            logger << ",rout" ;
-            logger << "," ;
-            logger << ",thead" ;
-            logger << ",ahead" ;
-            logger << ",angerr" ;
-            logger << ",turn" ;
-            logger.endMessage() ;
+            logger.defineRecord(MSG_RECORD_TANKDRIVE_FOLLOW_PATH, "followpath", {
+                "runtime", "ltpos", "lapos", "ltvel", "lout", "rtpos", "rapos", "rtvel", "rout",
+                "thead", "ahead", "angerr", "turn"
+            }) ;
             plotid_ = getTankDrive().getRobot().startPlot(toString(), plot_columns_) ;
         }
 
@@ -71,35 +116,49 @@ namespace xero {
             auto &td = getTankDrive() ;
             auto &rb = td.getRobot() ;
 
-            if (index_ < path_->size()) {
+            if (!done_ && !driving_) {
+                if (path_future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                    return ;
+
+                startPath() ;
+                if (done_)
+                    return ;
+            }
+
+            if (!done_) {
                 auto &logger = td.getRobot().getMessageLogger() ;
 
+                //
+                // Sample the path at the time since the action started rather than stepping
+                // one row per loop, so a late robot loop does not put the path behind
+                //
                 double dt = td.getRobot().getDeltaTime() ;
-                const XeroSegment lseg = path_->getLeftSegment(index_) ;
-                const XeroSegment rseg = path_->getRightSegment(index_) ;
+                double elapsed = rb.getTime() - start_time_ ;
+                const XeroPathSample lseg = path_->sample(XeroPath::Side::Left, elapsed) ;
+                const XeroPathSample rseg = path_->sample(XeroPath::Side::Right, elapsed) ;
 
                 double laccel, lvel, lpos ;
                 double raccel, rvel, rpos ;
                 double thead , ahead ;
 
                 if (reverse_) {
-                    laccel = -rseg.getAccel() ;
-                    lvel = -rseg.getVelocity() ;
-                    lpos = -rseg.getPOS() ;
-                    raccel = -lseg.getAccel() ;
-                    rvel = -lseg.getVelocity() ;
-                    rpos = -lseg.getPOS() ;
-                    thead = xero::math::normalizeAngleDegrees(lseg.getHeading() - target_start_angle_) ;
+                    laccel = -rseg.accel_ ;
+                    lvel = -rseg.vel_ ;
+                    lpos = -rseg.pos_ ;
+                    raccel = -lseg.accel_ ;
+                    rvel = -lseg.vel_ ;
+                    rpos = -lseg.pos_ ;
+                    thead = xero::math::normalizeAngleDegrees(lseg.heading_ - target_start_angle_) ;
                     ahead = xero::math::normalizeAngleDegrees(getTankDrive().getAngle() - start_angle_) ;                       
                 }
                 else {
-                    laccel = lseg.getAccel() ;
-                    lvel = lseg.getVelocity() ;
-                    lpos = lseg.getPOS() ;
-                    raccel = rseg.getAccel() ;
-                    rvel = rseg.getVelocity() ;
-                    rpos = rseg.getPOS() ;
-                    thead = xero::math::normalizeAngleDegrees(lseg.getHeading() - target_start_angle_) ;  
+                    laccel = lseg.accel_ ;
+                    lvel = lseg.vel_ ;
+                    lpos = lseg.pos_ ;
+                    raccel = rseg.accel_ ;
+                    rvel = rseg.vel_ ;
+                    rpos = rseg.pos_ ;
+                    thead = xero::math::normalizeAngleDegrees(lseg.heading_ - target_start_angle_) ;  
                     ahead = xero::math::normalizeAngleDegrees(getTankDrive().getAngle() - start_angle_) ;                                      
                 }
 
@@ -114,7 +173,7 @@ namespace xero {
                 //
                 // This has not been tested yet
                 //
-                double dv = lseg.getVelocity() - rseg.getVelocity() ;
+                double dv = lseg.vel_ - rseg.vel_ ;
                 double correct = dv * turn_correction_ ;
                 lout += correct ;
                 rout += correct ;
@@ -126,64 +185,51 @@ namespace xero {
 
                 setMotorsToPercents(lout, rout) ;
 
-                logger.startMessage(MessageLogger::MessageType::debug, MSG_GROUP_TANKDRIVE) ;
-                logger << td.getRobot().getTime() - start_time_ ;
-                logger << "," << lpos ;
-                logger << "," << ldist ;
-                logger << "," << lvel ;                
-                logger << "," << lout ;
-                logger << "," ;
-                logger << "," << rpos ;
-                logger << "," << rdist ;
-                logger << "," << rvel ;                
-                logger << "," << rout ;
-                logger << "," ;
-                logger << "," << thead ;
-                logger << "," << ahead ;
-                logger << "," << angerr ;
-                logger << "," << turn ;
-                logger.endMessage() ;
+                if (XERO_LOG_ENABLED(logger, MessageLogger::MessageType::debug, MSG_GROUP_TANKDRIVE)) {
+                    logger.startRecord(MessageLogger::MessageType::debug, MSG_GROUP_TANKDRIVE, MSG_RECORD_TANKDRIVE_FOLLOW_PATH) ;
+                    logger.addField(elapsed) ;
+                    logger.addField(lpos).addField(ldist).addField(lvel).addField(lout) ;
+                    logger.addField(rpos).addField(rdist).addField(rvel).addField(rout) ;
+                    logger.addField(thead).addField(ahead).addField(angerr).addField(turn) ;
+                    logger.endRecord() ;
+                }
+
+                double data[] = {
+                    elapsed,
+
+                    // Left side
+                    lpos, td.getLeftDistance() - left_start_, lvel, td.getLeftVelocity(), laccel, lout,
+                    static_cast<double>(td.getLeftTickCount()),
 
-                rb.addPlotData(plotid_, index_, 0, rb.getTime() - start_time_) ;
-
-                // Left side
-                rb.addPlotData(plotid_, index_, 1, lpos) ;
-                rb.addPlotData(plotid_, index_, 2, td.getLeftDistance() - left_start_) ;
-                rb.addPlotData(plotid_, index_, 3, lvel) ;
-                rb.addPlotData(plotid_, index_, 4, td.getLeftVelocity()) ;
-                rb.addPlotData(plotid_, index_, 5, laccel) ;
-                rb.addPlotData(plotid_, index_, 6, lout) ;
-                rb.addPlotData(plotid_, index_, 7, td.getLeftTickCount()) ;
-
-                // Right side
-                rb.addPlotData(plotid_, index_, 8, rpos) ;
-                rb.addPlotData(plotid_, index_, 9, td.getRightDistance()- right_start_) ;
-                rb.addPlotData(plotid_, index_, 10, rvel) ;
-                rb.addPlotData(plotid_, index_, 11, td.getRightVelocity()) ;
-                rb.addPlotData(plotid_, index_, 12, raccel) ;
-                rb.addPlotData(plotid_, index_, 13, rout) ;
-                rb.addPlotData(plotid_, index_, 14, td.getRightTickCount()) ;
-
-                // Angle data
-                rb.addPlotData(plotid_, index_, 15, thead) ;
-                rb.addPlotData(plotid_, index_, 16, ahead) ;
+                    // Right side
+                    rpos, td.getRightDistance() - right_start_, rvel, td.getRightVelocity(), raccel, rout,
+                    static_cast<double>(td.getRightTickCount()),
+
+                    // Angle data
+                    thead, ahead
+                } ;
+                rb.addPlotRow(plotid_, index_, data) ;
+                index_++ ;
+
+                if (elapsed >= path_->getDuration()) {
+                    done_ = true ;
+                    rb.endPlot(plotid_) ;
+                }
             }
-            index_++ ;     
-            if (index_ == path_->size())
-                rb.endPlot(plotid_) ;                   
         }
 
         bool TankDriveFollowPathAction::isDone() {
-            return index_ >= path_->size() ;
+            return done_ ;
         }
 
         void TankDriveFollowPathAction::cancel()  {
-            index_ = path_->size() ;
-            getTankDrive().getRobot().endPlot(plotid_) ;            
+            if (driving_ && !done_)
+                getTankDrive().getRobot().endPlot(plotid_) ;
+            done_ = true ;
         }
 
         std::string TankDriveFollowPathAction::toString() {
-            return "TankDriveFollowPathAction-" + path_->getName() ;
+            return "TankDriveFollowPathAction-" + path_name_ ;
         }
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "TankDriveAction.h"
 #include "PIDACtrl.h"
 #include <XeroPath.h>
+#include <XeroPathManager.h>
 /// \file
 
 
@@ -12,10 +13,21 @@ namespace xero {
         class TankDriveFollowPathAction : public TankDriveAction {
         public:
             /// \brief this action applies power to the left and right side of the robot
+            /// The path is read in the background, ahead of other paths waiting to be read, so
+            /// creating the action while the auto mode is selected does not wait for the path.
+            /// If the path is not read when the action starts, the robot holds still until it
+            /// is.  If the path cannot be read, an error is logged and the action finishes.
             /// \param db the drivebase this action applies to
             /// \param path the name of the path to follow
             TankDriveFollowPathAction(TankDrive &db, const std::string &path, bool reverse = false) ;
 
+            /// \brief this action follows a path that is not in the path manager
+            /// This is used for paths built while the robot is running, see TankDrive::getPathGenerator().
+            /// \param db the drivebase this action applies to
+            /// \param path the path to follow
+            /// \param reverse if true, drive the path backwards
+            TankDriveFollowPathAction(TankDrive &db, std::shared_ptr<xero::misc::XeroPath> path, bool reverse = false) ;
+
             /// \brief destroy the action object
             virtual ~TankDriveFollowPathAction() ;
 
@@ -36,13 +48,24 @@ namespace xero {
             /// \returns a human readable string representing the action
             virtual std::string toString() ;
                         
+        private:
+            void startPath() ;
+
         private:
             size_t index_ ;
+            bool done_ ;
+
+            //
+            // True once the path is read and the robot has started driving it
+            //
+            bool driving_ ;
             double left_start_ ;
             double right_start_ ;
             double start_time_ ;
             double turn_correction_ ;
             double angle_correction_ ;
+            std::string path_name_ ;
+            xero::misc::XeroPathManager::PathFuture path_future_ ;
             std::shared_ptr<xero::misc::XeroPath> path_ ;
             std::shared_ptr<xero::misc::PIDACtrl> left_follower_ ;
             std::shared_ptr<xero::misc::PIDACtrl> right_follower_ ;
@@ -25,6 +25,18 @@ namespace xero {
             /// \brief destroy the action object
             virtual ~TankDrivePowerAction() ;
 
+            /// \brief change the power applied the next time the action is started
+            /// This lets a driver control keep a single action and assign it again as the
+            /// joysticks move.
+            /// \param left the power to apply to the left side
+            /// \param right the power to apply to the right side
+            /// \param highgear if true, shift into high gear when the action starts
+            void setPower(double left, double right, bool highgear) {
+                left_ = left ;
+                right_ = right ;
+                highgear_ = highgear ;
+            }
+
             /// \brief Start the action; called once per action when it starts
             virtual void start() ;
 
@@ -54,14 +54,17 @@ namespace xero {
                     std::cout << "Right " << getTankDrive().getRightDistance() - start_right_ << std::endl ;
 
                 } else {
-                    rb.addPlotData(plotid_, index_, 0, now - start_time_) ;
-                    rb.addPlotData(plotid_, index_, 1, getTankDrive().getLeftDistance()) ;
-                    rb.addPlotData(plotid_, index_, 2, getTankDrive().getRightDistance()) ;
-                    rb.addPlotData(plotid_, index_, 3, getTankDrive().getLeftVelocity()) ;
-                    rb.addPlotData(plotid_, index_, 4, getTankDrive().getRightVelocity()) ;
-                    rb.addPlotData(plotid_, index_, 5, getTankDrive().getAngle()) ;
-                    rb.addPlotData(plotid_, index_, 6, lvoltage_) ;
-                    rb.addPlotData(plotid_, index_, 7, rvoltage_) ;                    
+                    double data[] = {
+                        now - start_time_,
+                        getTankDrive().getLeftDistance(),
+                        getTankDrive().getRightDistance(),
+                        getTankDrive().getLeftVelocity(),
+                        getTankDrive().getRightVelocity(),
+                        getTankDrive().getAngle(),
+                        lvoltage_,
+                        rvoltage_
+                    } ;
+                    rb.addPlotRow(plotid_, index_, data) ;
                     index_++ ;
                 }
             }
@@ -17,7 +17,7 @@ TankDriveVelocityAction::TankDriveVelocityAction(TankDrive &tank_drive, double t
 void TankDriveVelocityAction::start() {
     initial_velocity_ = getTankDrive().getVelocity();
 
-    xero::misc::SettingsParser parser = getTankDrive().getRobot().getSettingsParser();
+    xero::misc::SettingsParser &parser = getTankDrive().getRobot().getSettingsParser();
 
     velocity_pid_.initFromSettingsExtended(parser, "tankdrive:distance_action:velocity_pid");
     angle_pid_.initFromSettingsExtended(parser, "tankdrive:distance_action:angle_pid", true);
@@ -0,0 +1,144 @@
+//
+// xerologdump - convert a binary robot log (see BinaryLog.h) to text or CSV
+//
+// usage: xerologdump [--csv RECORD] [--output FILE] LOGFILE
+//
+// Without --csv, every record is printed as text, one per line.  With --csv, only the
+// data records with the given name are printed, as a CSV file with a time column and one
+// column per field.
+//
+
+#include <BinaryLog.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace xero::misc ;
+
+static void usage()
+{
+    std::cerr << "usage: xerologdump [--csv RECORD] [--output FILE] LOGFILE" << std::endl ;
+}
+
+static void printText(std::ostream &out, const BinaryLogEntry &entry)
+{
+    switch(entry.kind_) {
+    case BinaryLogFormat::RecordKind::Schema:
+        out << "schema " << entry.id_ << ": " << entry.text_ ;
+        for(const std::string &name : *entry.names_)
+            out << " " << name ;
+        out << std::endl ;
+        break ;
+
+    case BinaryLogFormat::RecordKind::String:
+        break ;
+
+    case BinaryLogFormat::RecordKind::Text:
+        out << entry.text_ << std::endl ;
+        break ;
+
+    case BinaryLogFormat::RecordKind::Data:
+        out << entry.time_ << ": " << BinaryLogDecoder::toText(entry) << std::endl ;
+        break ;
+    }
+}
+
+static void printCSV(std::ostream &out, const BinaryLogEntry &entry, const std::string &record, bool &header)
+{
+    if (entry.kind_ != BinaryLogFormat::RecordKind::Data || entry.text_ != record)
+        return ;
+
+    if (!header) {
+        out << "time" ;
+        for(const std::string &name : *entry.names_)
+            out << "," << name ;
+        out << std::endl ;
+        header = true ;
+    }
+
+    out << entry.time_ ;
+    for(const BinaryLogField &field : entry.fields_)
+        out << "," << BinaryLogDecoder::toText(field) ;
+    out << std::endl ;
+}
+
+int main(int ac, char **av)
+{
+    std::string csv, output, filename ;
+
+    ac-- ;
+    av++ ;
+    while (ac > 0) {
+        std::string arg = *av ;
+        if ((arg == "--csv" || arg == "--output") && ac > 1) {
+            if (arg == "--csv")
+                csv = av[1] ;
+            else
+                output = av[1] ;
+            ac -= 2 ;
+            av += 2 ;
+        }
+        else if (arg.length() > 0 && arg[0] == '-') {
+            usage() ;
+            return 1 ;
+        }
+        else {
+            filename = arg ;
+            ac-- ;
+            av++ ;
+        }
+    }
+
+    if (filename.length() == 0) {
+        usage() ;
+        return 1 ;
+    }
+
+    std::ifstream in(filename, std::ios::in | std::ios::binary) ;
+    if (!in.is_open()) {
+        std::cerr << "xerologdump: cannot open file '" << filename << "'" << std::endl ;
+        return 1 ;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()) ;
+    const uint8_t *p = data.data() ;
+    const uint8_t *end = p + data.size() ;
+
+    if (!BinaryLogDecoder::header(p, end)) {
+        std::cerr << "xerologdump: file '" << filename << "' is not a binary log file" << std::endl ;
+        return 1 ;
+    }
+
+    std::ofstream outfile ;
+    if (output.length() > 0) {
+        outfile.open(output) ;
+        if (!outfile.is_open()) {
+            std::cerr << "xerologdump: cannot open output file '" << output << "'" << std::endl ;
+            return 1 ;
+        }
+    }
+    std::ostream &out = output.length() > 0 ? outfile : std::cout ;
+
+    BinaryLogDecoder decoder ;
+    BinaryLogEntry entry ;
+    bool header = false ;
+
+    while (p < end) {
+        if (!decoder.decode(p, end, entry)) {
+            //
+            // The last record may be cut short if the robot lost power
+            //
+            std::cerr << "xerologdump: bad or truncated record at offset " << (p - data.data()) << std::endl ;
+            return 1 ;
+        }
+
+        if (csv.length() > 0)
+            printCSV(out, entry, csv, header) ;
+        else
+            printText(out, entry) ;
+    }
+
+    return 0 ;
+}
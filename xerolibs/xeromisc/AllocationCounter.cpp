@@ -0,0 +1,46 @@
+#include "AllocationCounter.h"
+#include <new>
+
+namespace xero {
+    namespace misc {
+        thread_local size_t AllocationCounter::count_ = 0 ;
+        std::atomic<size_t> AllocationCounter::total_(0) ;
+    }
+}
+
+//
+// Replacements for the global allocation functions.  These behave exactly like the
+// default versions except that every allocation is counted.  The array and nothrow
+// forms of operator new call these forms in the standard library, so they are counted
+// as well.  The sized forms of operator delete, used by C++14 sized deallocation, are
+// replaced too so that every delete pairs with one of these news.
+//
+void *operator new(size_t size) {
+    xero::misc::AllocationCounter::increment() ;
+
+    void *ptr = std::malloc(size == 0 ? 1 : size) ;
+    if (ptr == nullptr)
+        throw std::bad_alloc() ;
+
+    return ptr ;
+}
+
+void *operator new[](size_t size) {
+    return ::operator new(size) ;
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr) ;
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr) ;
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr) ;
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    std::free(ptr) ;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief counts the heap allocations made by the program
+        ///
+        /// The global operator new is replaced (see AllocationCounter.cpp) so that each
+        /// allocation is counted.  Each thread has its own count, so the difference between
+        /// two readings of getCount() taken around a block of code is the number of
+        /// allocations made by that block, no matter what the other threads (the log writer,
+        /// the odometry thread, the compute pool, ...) are doing.  The total for all threads
+        /// is also kept for checking work that is spread across threads.
+        class AllocationCounter {
+        public:
+            /// \brief return the number of allocations made by the calling thread
+            /// \returns the number of allocations made by the calling thread since it started
+            static size_t getCount() {
+                return count_ ;
+            }
+
+            /// \brief return the number of allocations made by all threads
+            /// \returns the number of allocations made by all threads since the program started
+            static size_t getTotalCount() {
+                return total_.load(std::memory_order_relaxed) ;
+            }
+
+            /// \brief count a single allocation by the calling thread
+            static void increment() {
+                count_++ ;
+                total_.fetch_add(1, std::memory_order_relaxed) ;
+            }
+
+        private:
+            static thread_local size_t count_ ;
+            static std::atomic<size_t> total_ ;
+        } ;
+    }
+}
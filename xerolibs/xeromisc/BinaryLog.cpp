@@ -0,0 +1,325 @@
+#include "BinaryLog.h"
+#include <cstring>
+#include <algorithm>
+
+namespace xero {
+    namespace misc {
+
+        constexpr uint32_t BinaryLogFormat::Magic ;
+        constexpr uint16_t BinaryLogFormat::Version ;
+        constexpr size_t BinaryLogFormat::HeaderSize ;
+
+        ////////////////////////////////////////////////////////////////////////////////////
+        //
+        // BinaryLogEncoder
+        //
+        ////////////////////////////////////////////////////////////////////////////////////
+
+        void BinaryLogEncoder::putBytes(const void *data, size_t size) {
+            if (overflow_ || length_ + size > size_) {
+                overflow_ = true ;
+                return ;
+            }
+
+            std::memcpy(buffer_ + length_, data, size) ;
+            length_ += size ;
+        }
+
+        void BinaryLogEncoder::putU8(uint8_t value) {
+            putBytes(&value, sizeof(value)) ;
+        }
+
+        void BinaryLogEncoder::putU16(uint16_t value) {
+            putBytes(&value, sizeof(value)) ;
+        }
+
+        void BinaryLogEncoder::putString(const std::string &value) {
+            uint16_t len = static_cast<uint16_t>(std::min(value.length(), static_cast<size_t>(UINT16_MAX))) ;
+            putU16(len) ;
+            putBytes(value.data(), len) ;
+        }
+
+        void BinaryLogEncoder::header() {
+            uint32_t magic = BinaryLogFormat::Magic ;
+            putBytes(&magic, sizeof(magic)) ;
+            putU16(BinaryLogFormat::Version) ;
+        }
+
+        void BinaryLogEncoder::schema(uint16_t id, const std::string &name, const std::vector<std::string> &fields) {
+            putU8(static_cast<uint8_t>(BinaryLogFormat::RecordKind::Schema)) ;
+            putU16(id) ;
+            putString(name) ;
+            putU8(static_cast<uint8_t>(fields.size())) ;
+            for(const std::string &field : fields)
+                putString(field) ;
+        }
+
+        void BinaryLogEncoder::string(uint16_t index, const std::string &value) {
+            putU8(static_cast<uint8_t>(BinaryLogFormat::RecordKind::String)) ;
+            putU16(index) ;
+            putString(value) ;
+        }
+
+        void BinaryLogEncoder::text(uint8_t type, uint64_t group, const std::string &msg) {
+            putU8(static_cast<uint8_t>(BinaryLogFormat::RecordKind::Text)) ;
+            putU8(type) ;
+            putBytes(&group, sizeof(group)) ;
+            putString(msg) ;
+        }
+
+        void BinaryLogEncoder::startData(double time, uint8_t type, uint64_t group, uint16_t id) {
+            putU8(static_cast<uint8_t>(BinaryLogFormat::RecordKind::Data)) ;
+            putBytes(&time, sizeof(time)) ;
+            putU8(type) ;
+            putBytes(&group, sizeof(group)) ;
+            putU16(id) ;
+
+            //
+            // The field count is filled in as fields are added
+            //
+            count_pos_ = length_ ;
+            putU8(0) ;
+        }
+
+        void BinaryLogEncoder::addField(BinaryLogFormat::FieldTag tag, const void *data, size_t size) {
+            putU8(static_cast<uint8_t>(tag)) ;
+            putBytes(data, size) ;
+            if (!overflow_)
+                buffer_[count_pos_]++ ;
+        }
+
+        void BinaryLogEncoder::field(double value) {
+            addField(BinaryLogFormat::FieldTag::Double, &value, sizeof(value)) ;
+        }
+
+        void BinaryLogEncoder::field(int32_t value) {
+            addField(BinaryLogFormat::FieldTag::Integer, &value, sizeof(value)) ;
+        }
+
+        void BinaryLogEncoder::field(bool value) {
+            uint8_t b = value ? 1 : 0 ;
+            addField(BinaryLogFormat::FieldTag::Boolean, &b, sizeof(b)) ;
+        }
+
+        void BinaryLogEncoder::stringField(uint16_t index) {
+            addField(BinaryLogFormat::FieldTag::String, &index, sizeof(index)) ;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////
+        //
+        // BinaryLogDecoder
+        //
+        ////////////////////////////////////////////////////////////////////////////////////
+
+        namespace {
+            template <typename T>
+            bool get(const uint8_t *&data, const uint8_t *end, T &value) {
+                if (static_cast<size_t>(end - data) < sizeof(T))
+                    return false ;
+
+                std::memcpy(&value, data, sizeof(T)) ;
+                data += sizeof(T) ;
+                return true ;
+            }
+
+            bool getString(const uint8_t *&data, const uint8_t *end, std::string &value) {
+                uint16_t len ;
+                if (!get(data, end, len) || static_cast<size_t>(end - data) < len)
+                    return false ;
+
+                value.assign(reinterpret_cast<const char *>(data), len) ;
+                data += len ;
+                return true ;
+            }
+        }
+
+        BinaryLogDecoder::BinaryLogDecoder() {
+        }
+
+        bool BinaryLogDecoder::header(const uint8_t *&data, const uint8_t *end) {
+            uint32_t magic ;
+            uint16_t version ;
+            const uint8_t *p = data ;
+
+            if (!get(p, end, magic) || !get(p, end, version))
+                return false ;
+
+            if (magic != BinaryLogFormat::Magic || version != BinaryLogFormat::Version)
+                return false ;
+
+            data = p ;
+            return true ;
+        }
+
+        bool BinaryLogDecoder::decode(const uint8_t *&data, const uint8_t *end, BinaryLogEntry &entry) {
+            const uint8_t *p = data ;
+            uint8_t kind, count ;
+
+            if (!get(p, end, kind))
+                return false ;
+
+            entry.kind_ = static_cast<BinaryLogFormat::RecordKind>(kind) ;
+            entry.time_ = 0.0 ;
+            entry.type_ = 0 ;
+            entry.group_ = 0 ;
+            entry.id_ = 0 ;
+            entry.text_.clear() ;
+            entry.names_ = &empty_ ;
+            entry.fields_.clear() ;
+
+            switch(entry.kind_) {
+            case BinaryLogFormat::RecordKind::Schema:
+                {
+                    Schema schema ;
+                    if (!get(p, end, entry.id_) || !getString(p, end, schema.name_) || !get(p, end, count))
+                        return false ;
+
+                    schema.fields_.resize(count) ;
+                    for(uint8_t i = 0 ; i < count ; i++) {
+                        if (!getString(p, end, schema.fields_[i]))
+                            return false ;
+                    }
+
+                    entry.text_ = schema.name_ ;
+                    schemas_[entry.id_] = schema ;
+                    entry.names_ = &schemas_[entry.id_].fields_ ;
+                }
+                break ;
+
+            case BinaryLogFormat::RecordKind::String:
+                if (!get(p, end, entry.id_) || !getString(p, end, entry.text_))
+                    return false ;
+
+                strings_[entry.id_] = entry.text_ ;
+                break ;
+
+            case BinaryLogFormat::RecordKind::Text:
+                if (!get(p, end, entry.type_) || !get(p, end, entry.group_) || !getString(p, end, entry.text_))
+                    return false ;
+                break ;
+
+            case BinaryLogFormat::RecordKind::Data:
+                if (!get(p, end, entry.time_) || !get(p, end, entry.type_) || !get(p, end, entry.group_))
+                    return false ;
+
+                if (!get(p, end, entry.id_) || !get(p, end, count))
+                    return false ;
+
+                entry.fields_.resize(count) ;
+                for(uint8_t i = 0 ; i < count ; i++) {
+                    BinaryLogField &field = entry.fields_[i] ;
+                    uint8_t tag ;
+
+                    if (!get(p, end, tag))
+                        return false ;
+
+                    field.tag_ = static_cast<BinaryLogFormat::FieldTag>(tag) ;
+                    field.number_ = 0.0 ;
+                    field.string_.clear() ;
+
+                    switch(field.tag_) {
+                    case BinaryLogFormat::FieldTag::Double:
+                        if (!get(p, end, field.number_))
+                            return false ;
+                        break ;
+                    case BinaryLogFormat::FieldTag::Integer:
+                        {
+                            int32_t value ;
+                            if (!get(p, end, value))
+                                return false ;
+                            field.number_ = value ;
+                        }
+                        break ;
+                    case BinaryLogFormat::FieldTag::Boolean:
+                        {
+                            uint8_t value ;
+                            if (!get(p, end, value))
+                                return false ;
+                            field.number_ = value ? 1.0 : 0.0 ;
+                        }
+                        break ;
+                    case BinaryLogFormat::FieldTag::String:
+                        {
+                            uint16_t index ;
+                            if (!get(p, end, index))
+                                return false ;
+
+                            auto it = strings_.find(index) ;
+                            if (it != strings_.end())
+                                field.string_ = it->second ;
+                            else
+                                field.string_ = "?" + std::to_string(index) ;
+                        }
+                        break ;
+                    default:
+                        return false ;
+                    }
+                }
+
+                {
+                    auto it = schemas_.find(entry.id_) ;
+                    if (it != schemas_.end()) {
+                        entry.text_ = it->second.name_ ;
+                        entry.names_ = &it->second.fields_ ;
+                    }
+                    else {
+                        entry.text_ = "record" + std::to_string(entry.id_) ;
+                    }
+                }
+                break ;
+
+            default:
+                return false ;
+            }
+
+            data = p ;
+            return true ;
+        }
+
+        std::string BinaryLogDecoder::getName(uint16_t id) const {
+            auto it = schemas_.find(id) ;
+            if (it == schemas_.end())
+                return "" ;
+
+            return it->second.name_ ;
+        }
+
+        std::string BinaryLogDecoder::toText(const BinaryLogField &field) {
+            std::string ret ;
+
+            switch(field.tag_) {
+            case BinaryLogFormat::FieldTag::Double:
+                ret = std::to_string(field.number_) ;
+                break ;
+            case BinaryLogFormat::FieldTag::Integer:
+                ret = std::to_string(static_cast<int32_t>(field.number_)) ;
+                break ;
+            case BinaryLogFormat::FieldTag::Boolean:
+                ret = field.number_ != 0.0 ? "true" : "false" ;
+                break ;
+            case BinaryLogFormat::FieldTag::String:
+                ret = field.string_ ;
+                break ;
+            }
+
+            return ret ;
+        }
+
+        std::string BinaryLogDecoder::toText(const BinaryLogEntry &entry) {
+            std::string ret = entry.text_ + ":" ;
+
+            for(size_t i = 0 ; i < entry.fields_.size() ; i++) {
+                if (i != 0)
+                    ret += "," ;
+
+                ret += " " ;
+                if (i < entry.names_->size())
+                    ret += (*entry.names_)[i] + "=" ;
+
+                ret += toText(entry.fields_[i]) ;
+            }
+
+            return ret ;
+        }
+    }
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstdlib>
+#include <climits>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+
+        /// \brief constants that describe the binary log format
+        ///
+        /// A binary log is a file header followed by a sequence of records.  Each record
+        /// starts with a one byte kind.  All values are stored in the byte order of the
+        /// machine that wrote the log (little endian on the roborio and on a PC).
+        ///
+        /// - Schema: uint16 id, string name, uint8 count, count strings (field names)
+        /// - String: uint16 index, string value
+        /// - Data: double time, uint8 type, uint64 group, uint16 id, uint8 count, count fields
+        /// - Text: uint8 type, uint64 group, string message
+        ///
+        /// A string is a uint16 length followed by the characters.  A field is a one byte tag
+        /// followed by a double, an int32, a one byte bool, or a uint16 index of a string record.
+        class BinaryLogFormat {
+        public:
+            /// \brief the bytes at the start of a binary log file
+            static constexpr uint32_t Magic = 0x474f4c58 ;
+
+            /// \brief the version of the format
+            static constexpr uint16_t Version = 1 ;
+
+            /// \brief the size of the file header
+            static constexpr size_t HeaderSize = 6 ;
+
+            /// \brief the kind of a record
+            enum class RecordKind : uint8_t {
+                Schema = 1,         ///< the names of a record and its fields
+                String = 2,         ///< an interned string
+                Data = 3,           ///< a record with typed fields
+                Text = 4,           ///< a plain text message
+            } ;
+
+            /// \brief the type of a field in a data record
+            enum class FieldTag : uint8_t {
+                Double = 'D',       ///< a double
+                Integer = 'I',      ///< a 32 bit signed integer
+                Boolean = 'B',      ///< a boolean
+                String = 'S',       ///< the index of an interned string
+            } ;
+        } ;
+
+        /// \brief writes binary log records into a fixed size buffer
+        ///
+        /// The encoder never allocates.  If a record does not fit in the buffer the encoder
+        /// marks itself as overflowed and stops writing.
+        class BinaryLogEncoder {
+        public:
+            /// \brief create an encoder that writes into the given buffer
+            /// \param buffer the buffer to write into
+            /// \param size the size of the buffer in bytes
+            BinaryLogEncoder(uint8_t *buffer, size_t size) {
+                buffer_ = buffer ;
+                size_ = size ;
+                reset() ;
+            }
+
+            /// \brief start writing at the start of the buffer again
+            void reset() {
+                length_ = 0 ;
+                count_pos_ = 0 ;
+                overflow_ = false ;
+            }
+
+            /// \brief return the number of bytes written
+            /// \returns the number of bytes written
+            size_t getLength() const {
+                return length_ ;
+            }
+
+            /// \brief return the buffer
+            /// \returns the buffer
+            const uint8_t *getData() const {
+                return buffer_ ;
+            }
+
+            /// \brief return true if something did not fit in the buffer
+            /// \returns true if something did not fit in the buffer
+            bool isOverflow() const {
+                return overflow_ ;
+            }
+
+            /// \brief write the file header
+            void header() ;
+
+            /// \brief write a schema record
+            /// \param id the id of the data record being described
+            /// \param name the name of the data record
+            /// \param fields the names of the fields in the data record
+            void schema(uint16_t id, const std::string &name, const std::vector<std::string> &fields) ;
+
+            /// \brief write a string record
+            /// \param index the index of the string
+            /// \param value the string
+            void string(uint16_t index, const std::string &value) ;
+
+            /// \brief write a text record
+            /// \param type the message type
+            /// \param group the message group
+            /// \param msg the message text
+            void text(uint8_t type, uint64_t group, const std::string &msg) ;
+
+            /// \brief start a data record, the fields are added with the field methods
+            /// \param time the time of the record
+            /// \param type the message type
+            /// \param group the message group
+            /// \param id the id of the record
+            void startData(double time, uint8_t type, uint64_t group, uint16_t id) ;
+
+            /// \brief add a double field to the current data record
+            /// \param value the value of the field
+            void field(double value) ;
+
+            /// \brief add an integer field to the current data record
+            /// \param value the value of the field
+            void field(int32_t value) ;
+
+            /// \brief add a boolean field to the current data record
+            /// \param value the value of the field
+            void field(bool value) ;
+
+            /// \brief add an interned string field to the current data record
+            /// \param index the index of the string
+            void stringField(uint16_t index) ;
+
+        private:
+            void putBytes(const void *data, size_t size) ;
+            void putU8(uint8_t value) ;
+            void putU16(uint16_t value) ;
+            void putString(const std::string &value) ;
+            void addField(BinaryLogFormat::FieldTag tag, const void *data, size_t size) ;
+
+        private:
+            uint8_t *buffer_ ;
+            size_t size_ ;
+            size_t length_ ;
+            size_t count_pos_ ;
+            bool overflow_ ;
+        } ;
+
+        /// \brief one field of a decoded data record
+        struct BinaryLogField {
+            /// \brief the type of the field
+            BinaryLogFormat::FieldTag tag_ ;
+
+            /// \brief the value of a double, integer or boolean field
+            double number_ ;
+
+            /// \brief the value of a string field
+            std::string string_ ;
+        } ;
+
+        /// \brief a decoded record
+        struct BinaryLogEntry {
+            /// \brief the kind of the record
+            BinaryLogFormat::RecordKind kind_ ;
+
+            /// \brief the time of a data record
+            double time_ ;
+
+            /// \brief the message type of a data or text record
+            uint8_t type_ ;
+
+            /// \brief the message group of a data or text record
+            uint64_t group_ ;
+
+            /// \brief the id of a data or schema record
+            uint16_t id_ ;
+
+            /// \brief the record name for a data or schema record, the text for a text record
+            std::string text_ ;
+
+            /// \brief the field names of a data or schema record
+            const std::vector<std::string> *names_ ;
+
+            /// \brief the fields of a data record
+            std::vector<BinaryLogField> fields_ ;
+        } ;
+
+        /// \brief decodes binary log records
+        ///
+        /// The decoder remembers the schema and string records it has seen so that it
+        /// can name the fields of data records.
+        class BinaryLogDecoder {
+        public:
+            /// \brief create a new decoder
+            BinaryLogDecoder() ;
+
+            /// \brief check for and skip a file header
+            /// \param data the pointer to the data, advanced past the header
+            /// \param end the end of the data
+            /// \returns true if the data started with a valid header
+            static bool header(const uint8_t *&data, const uint8_t *end) ;
+
+            /// \brief decode one record
+            /// \param data the pointer to the record, advanced past the record
+            /// \param end the end of the data
+            /// \param entry the decoded record
+            /// \returns false if the data does not hold a complete valid record
+            bool decode(const uint8_t *&data, const uint8_t *end, BinaryLogEntry &entry) ;
+
+            /// \brief return the name of a data record
+            /// \param id the id of the data record
+            /// \returns the name of the data record, or an empty string if it has not been defined
+            std::string getName(uint16_t id) const ;
+
+            /// \brief format a data record as text
+            /// The text is the record name followed by name=value for each field.
+            /// \param entry the data record
+            /// \returns the text for the data record
+            static std::string toText(const BinaryLogEntry &entry) ;
+
+            /// \brief format the value of a field as text
+            /// \param field the field
+            /// \returns the text for the field
+            static std::string toText(const BinaryLogField &field) ;
+
+        private:
+            struct Schema {
+                std::string name_ ;
+                std::vector<std::string> fields_ ;
+            } ;
+
+        private:
+            std::map<uint16_t, Schema> schemas_ ;
+            std::map<uint16_t, std::string> strings_ ;
+            std::vector<std::string> empty_ ;
+        } ;
+    }
+}
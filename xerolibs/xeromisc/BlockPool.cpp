@@ -0,0 +1,100 @@
+#include "BlockPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+namespace xero {
+    namespace misc {
+
+        PoolCounters::PoolCounters() {
+            live_.store(0, std::memory_order_relaxed) ;
+            peak_.store(0, std::memory_order_relaxed) ;
+            allocations_.store(0, std::memory_order_relaxed) ;
+            heap_.store(0, std::memory_order_relaxed) ;
+        }
+
+        void PoolCounters::allocated(bool heap) {
+            size_t live = live_.fetch_add(1, std::memory_order_relaxed) + 1 ;
+            allocations_.fetch_add(1, std::memory_order_relaxed) ;
+            if (heap)
+                heap_.fetch_add(1, std::memory_order_relaxed) ;
+
+            size_t peak = peak_.load(std::memory_order_relaxed) ;
+            while (live > peak && !peak_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+            }
+        }
+
+        BlockPool::BlockPool(size_t capacity, PoolCounters *totals) {
+            capacity_ = capacity ;
+            block_size_ = 0 ;
+            free_ = nullptr ;
+            totals_ = totals ;
+        }
+
+        BlockPool::~BlockPool() {
+            assert(counters_.getLive() == 0) ;
+        }
+
+        void *BlockPool::allocate(size_t size) {
+            void *ret = nullptr ;
+
+            {
+                std::lock_guard<std::mutex> lock(lock_) ;
+
+                if (block_size_ == 0 && capacity_ > 0) {
+                    //
+                    // Round the blocks up so that each one is aligned like the storage
+                    //
+                    const size_t align = alignof(std::max_align_t) ;
+                    block_size_ = (std::max(size, sizeof(FreeBlock)) + align - 1) / align * align ;
+                    storage_ = std::unique_ptr<char[]>(new char[capacity_ * block_size_]) ;
+
+                    for(size_t i = capacity_ ; i > 0 ; i--) {
+                        FreeBlock *block = reinterpret_cast<FreeBlock *>(storage_.get() + (i - 1) * block_size_) ;
+                        block->next_ = free_ ;
+                        free_ = block ;
+                    }
+                }
+
+                if (free_ != nullptr && size <= block_size_) {
+                    ret = free_ ;
+                    free_ = free_->next_ ;
+                }
+            }
+
+            bool heap = (ret == nullptr) ;
+            if (heap)
+                ret = ::operator new(size) ;
+
+            counters_.allocated(heap) ;
+            if (totals_ != nullptr)
+                totals_->allocated(heap) ;
+
+            return ret ;
+        }
+
+        void BlockPool::deallocate(void *p, size_t size) {
+            if (p == nullptr)
+                return ;
+
+            counters_.freed() ;
+            if (totals_ != nullptr)
+                totals_->freed() ;
+
+            if (!owns(p)) {
+                ::operator delete(p, size) ;
+                return ;
+            }
+
+            //
+            // Only requests that fit in a block are given one, see allocate()
+            //
+            assert(size <= block_size_) ;
+
+            std::lock_guard<std::mutex> lock(lock_) ;
+            FreeBlock *block = static_cast<FreeBlock *>(p) ;
+            block->next_ = free_ ;
+            free_ = block ;
+        }
+    }
+}
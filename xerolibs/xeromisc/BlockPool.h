@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief counts the objects allocated from one or more pools
+        ///
+        /// A live object has been allocated and not yet freed.  The peak is the largest number
+        /// of live objects seen so far.  Allocations the pool could not satisfy come from the
+        /// heap and are counted separately, a non-zero heap count means the pool is too small.
+        class PoolCounters {
+        public:
+            /// \brief create a new set of counters, all zero
+            PoolCounters() ;
+
+            /// \brief count an allocation
+            /// \param heap if true, the allocation came from the heap rather than the pool
+            void allocated(bool heap) ;
+
+            /// \brief count an object being freed
+            void freed() {
+                live_.fetch_sub(1, std::memory_order_relaxed) ;
+            }
+
+            /// \brief return the number of objects allocated and not yet freed
+            /// \returns the number of live objects
+            size_t getLive() const {
+                return live_.load(std::memory_order_relaxed) ;
+            }
+
+            /// \brief return the largest number of live objects seen
+            /// \returns the largest number of live objects seen
+            size_t getPeak() const {
+                return peak_.load(std::memory_order_relaxed) ;
+            }
+
+            /// \brief return the total number of allocations
+            /// \returns the total number of allocations
+            size_t getAllocations() const {
+                return allocations_.load(std::memory_order_relaxed) ;
+            }
+
+            /// \brief return the number of allocations that came from the heap
+            /// \returns the number of allocations that came from the heap
+            size_t getHeapAllocations() const {
+                return heap_.load(std::memory_order_relaxed) ;
+            }
+
+        private:
+            std::atomic<size_t> live_ ;
+            std::atomic<size_t> peak_ ;
+            std::atomic<size_t> allocations_ ;
+            std::atomic<size_t> heap_ ;
+        } ;
+
+        /// \brief a fixed number of equal sized blocks of memory
+        ///
+        /// The blocks are allocated together the first time the pool is used and are then
+        /// handed out and returned through a free list, so a pool that is large enough never
+        /// goes back to the heap.  The block size is set by the first allocation.  A request
+        /// of a different size, or one made when every block is in use, is passed on to the
+        /// heap.  The pool may be used from more than one thread.
+        class BlockPool {
+        public:
+            /// \brief create a new pool
+            /// \param capacity the number of blocks in the pool
+            /// \param totals if not null, counters shared with other pools that are also updated
+            BlockPool(size_t capacity, PoolCounters *totals = nullptr) ;
+
+            /// \brief destroy the pool, no blocks may still be in use
+            virtual ~BlockPool() ;
+
+            /// \brief allocate memory
+            /// \param size the number of bytes needed
+            /// \returns the memory allocated
+            void *allocate(size_t size) ;
+
+            /// \brief return memory to the pool
+            /// \param p the memory returned by allocate()
+            /// \param size the size passed to allocate()
+            void deallocate(void *p, size_t size) ;
+
+            /// \brief return the number of blocks in the pool
+            /// \returns the number of blocks in the pool
+            size_t getCapacity() const {
+                return capacity_ ;
+            }
+
+            /// \brief return the size of each block, zero until the first allocation
+            /// \returns the size of each block
+            size_t getBlockSize() const {
+                return block_size_ ;
+            }
+
+            /// \brief return the counters for this pool
+            /// \returns the counters for this pool
+            const PoolCounters &getCounters() const {
+                return counters_ ;
+            }
+
+        private:
+            struct FreeBlock {
+                FreeBlock *next_ ;
+            } ;
+
+            bool owns(void *p) const {
+                char *c = static_cast<char *>(p) ;
+                return storage_ != nullptr && c >= storage_.get() && c < storage_.get() + capacity_ * block_size_ ;
+            }
+
+        private:
+            std::mutex lock_ ;
+            size_t capacity_ ;
+            size_t block_size_ ;
+            std::unique_ptr<char[]> storage_ ;
+            FreeBlock *free_ ;
+            PoolCounters counters_ ;
+            PoolCounters *totals_ ;
+        } ;
+
+        /// \brief a standard allocator that takes single objects from a BlockPool
+        ///
+        /// This is meant for std::allocate_shared(), which makes a single allocation holding
+        /// both the object and the shared pointer control block.  Arrays go to the heap.
+        template <typename T>
+        class PoolAllocator {
+        public:
+            /// \brief the type allocated
+            typedef T value_type ;
+
+            /// \brief create an allocator for a pool
+            /// \param pool the pool to allocate from
+            explicit PoolAllocator(BlockPool *pool) : pool_(pool) {
+            }
+
+            /// \brief create an allocator for another type that uses the same pool
+            /// \param other the allocator to copy
+            template <typename U>
+            PoolAllocator(const PoolAllocator<U> &other) : pool_(other.getPool()) {
+            }
+
+            /// \brief allocate memory for objects
+            /// \param n the number of objects
+            /// \returns the memory allocated
+            T *allocate(size_t n) {
+                if (n == 1)
+                    return static_cast<T *>(pool_->allocate(sizeof(T))) ;
+
+                return static_cast<T *>(::operator new(n * sizeof(T))) ;
+            }
+
+            /// \brief free memory returned by allocate()
+            /// \param p the memory to free
+            /// \param n the number of objects
+            void deallocate(T *p, size_t n) {
+                if (n == 1)
+                    pool_->deallocate(p, sizeof(T)) ;
+                else
+                    ::operator delete(p) ;
+            }
+
+            /// \brief return the pool used by this allocator
+            /// \returns the pool used by this allocator
+            BlockPool *getPool() const {
+                return pool_ ;
+            }
+
+        private:
+            BlockPool *pool_ ;
+        } ;
+
+        /// \brief allocators are equal if they use the same pool
+        template <typename T, typename U>
+        bool operator==(const PoolAllocator<T> &a, const PoolAllocator<U> &b) {
+            return a.getPool() == b.getPool() ;
+        }
+
+        /// \brief allocators are equal if they use the same pool
+        template <typename T, typename U>
+        bool operator!=(const PoolAllocator<T> &a, const PoolAllocator<U> &b) {
+            return a.getPool() != b.getPool() ;
+        }
+    }
+}
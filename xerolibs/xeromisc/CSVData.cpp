@@ -3,6 +3,7 @@
 namespace xero {
     namespace misc {
         CSVData::CSVData(const std::string & fileName) : fileName_(fileName) {
+            dt_ = 0.0 ;
             file_ = std::ifstream(fileName, std::ios::binary);
             didLoad_ = !file_.fail();
             if (didLoad_)
@@ -27,6 +28,8 @@ namespace xero {
                         if (line[i] == ',') {
                             if (dataIdx != 0 && dataIdx <= HEADER_COUNT)
                                 newdata[dataIdx - 1] = std::stod(word) ;
+                            else if (dataIdx == 0 && lineno == 2)
+                                dt_ = std::stod(word) ;
                             word.clear() ;
                             dataIdx++ ;
                         }
@@ -40,10 +40,17 @@ namespace xero {
 
             auto size() {
                 return data_.size() ;
+            }
+
+            /// \brief return the time step from the first column of the first row
+            /// \returns the time step, or zero if there are no rows
+            double getTimeStep() const {
+                return dt_ ;
             }            
 
         private:
             bool didLoad_ ;
+            double dt_ ;
             size_t rowIdx_, colIdx_ ;
             std::string fileName_ ;
             std::ifstream file_ ;
@@ -0,0 +1,46 @@
+#include "EventQueue.h"
+
+namespace xero {
+    namespace misc {
+
+        constexpr size_t EventQueue::MaxSources ;
+        constexpr size_t EventQueue::AlwaysSource ;
+
+        EventQueue::EventQueue() {
+            for(size_t i = 0 ; i < MaxSources ; i++) {
+                pending_[i] = 0 ;
+                loop_[i] = 0 ;
+                active_[i] = 0 ;
+            }
+
+            loops_ = 0 ;
+            polling_ = false ;
+        }
+
+        EventQueue::~EventQueue() {
+        }
+
+        size_t EventQueue::addSource(const std::string &name) {
+            if (names_.size() == MaxSources)
+                return AlwaysSource ;
+
+            size_t id = names_.size() ;
+            names_.push_back(name) ;
+
+            //
+            // Nothing has been read from a new source, so it starts with an event
+            //
+            post(id) ;
+            return id ;
+        }
+
+        void EventQueue::collect() {
+            for(size_t i = 0 ; i < names_.size() ; i++) {
+                loop_[i] = pending_[i].exchange(0, std::memory_order_acquire) ;
+                if (loop_[i] != 0)
+                    active_[i]++ ;
+            }
+            loops_++ ;
+        }
+    }
+}
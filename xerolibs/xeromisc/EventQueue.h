@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief collects the events that arrive between robot loops
+        ///
+        /// A subsystem adds a source for each input it wants to be woken for, such as a network
+        /// table, a socket or a set of digital inputs.  Whatever notices the input change (a
+        /// network table listener, an interrupt handler, a socket watcher thread) posts to the
+        /// source from its own thread.  At the start of each robot loop, collect() takes the
+        /// events posted since the last loop, and for the rest of the loop hasEvent() tells a
+        /// subsystem whether its inputs changed, so it can skip reading inputs that did not.
+        ///
+        /// Posting takes no lock and does not allocate, so it is safe from interrupt handlers.
+        /// A new source starts with an event so the inputs are read in the first loop.
+        ///
+        /// When the queue is polling, every source has an event every loop.  This is the way
+        /// to run the robot the way it ran before events, and a source that could not be set
+        /// up to post should be treated the same way.
+        class EventQueue {
+        public:
+            /// \brief the most sources a queue can hold
+            static constexpr size_t MaxSources = 64 ;
+
+            /// \brief the id returned when no more sources can be added, it always has an event
+            static constexpr size_t AlwaysSource = MaxSources ;
+
+        public:
+            /// \brief create a new event queue
+            EventQueue() ;
+
+            /// \brief destroy the event queue
+            virtual ~EventQueue() ;
+
+            /// \brief set whether every source has an event every loop
+            /// \param polling if true, every source has an event every loop
+            void setPolling(bool polling) {
+                polling_ = polling ;
+            }
+
+            /// \brief returns true if every source has an event every loop
+            /// \returns true if every source has an event every loop
+            bool isPolling() const {
+                return polling_ ;
+            }
+
+            /// \brief add a new source of events
+            /// This should be called while the robot is being created, not from the robot loop.
+            /// \param name the name of the source, for the log
+            /// \returns the id of the source, or AlwaysSource if the queue is full
+            size_t addSource(const std::string &name) ;
+
+            /// \brief return the number of sources added
+            /// \returns the number of sources added
+            size_t getSourceCount() const {
+                return names_.size() ;
+            }
+
+            /// \brief return the name of a source
+            /// \param id the id of the source
+            /// \returns the name of the source
+            const std::string &getSourceName(size_t id) const {
+                return names_[id] ;
+            }
+
+            /// \brief post an event to a source, this can be called from any thread
+            /// \param id the id of the source
+            void post(size_t id) {
+                if (id < MaxSources)
+                    pending_[id].fetch_add(1, std::memory_order_release) ;
+            }
+
+            /// \brief take the events posted since the last call, called once at the start of each robot loop
+            void collect() ;
+
+            /// \brief returns true if a source had an event before the start of this loop
+            /// \param id the id of the source
+            /// \returns true if the source had an event before the start of this loop
+            bool hasEvent(size_t id) const {
+                if (polling_ || id >= MaxSources)
+                    return true ;
+
+                return loop_[id] != 0 ;
+            }
+
+            /// \brief return the number of events a source had before the start of this loop
+            /// \param id the id of the source
+            /// \returns the number of events the source had before the start of this loop
+            uint32_t getEventCount(size_t id) const {
+                if (id >= MaxSources)
+                    return 0 ;
+
+                return loop_[id] ;
+            }
+
+            /// \brief return the number of loops in which a source had an event
+            /// \param id the id of the source
+            /// \returns the number of loops in which a source had an event
+            uint64_t getActiveLoops(size_t id) const {
+                if (id >= MaxSources)
+                    return loops_ ;
+
+                return active_[id] ;
+            }
+
+            /// \brief return the number of times collect() was called
+            /// \returns the number of times collect() was called
+            uint64_t getLoopCount() const {
+                return loops_ ;
+            }
+
+        private:
+            //
+            // Events posted since the last collect(), written by any thread
+            //
+            std::atomic<uint32_t> pending_[MaxSources] ;
+
+            //
+            // Events taken by the last collect(), only used by the robot loop
+            //
+            uint32_t loop_[MaxSources] ;
+
+            //
+            // The number of loops each source had an event, and the number of loops
+            //
+            uint64_t active_[MaxSources] ;
+            uint64_t loops_ ;
+
+            std::vector<std::string> names_ ;
+            bool polling_ ;
+        } ;
+    }
+}
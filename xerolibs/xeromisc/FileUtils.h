@@ -3,6 +3,8 @@
 /// \file
 
 #include <sys/stat.h>
+#include <sys/types.h>
+#include <dirent.h>
 #include <unistd.h>
 #include <string>
 #include <fstream>
@@ -67,6 +69,49 @@ namespace xero {
             return (ret == 0);
         }
 
+        /// \brief Find the next unused number in a sequence of numbered files.
+        ///        The number is one more than the largest number in use.
+        /// \param dir the directory containing the files
+        /// \param prefix the prefix of the file names
+        /// \returns the next number, or -1 if the directory cannot be read
+        inline int next_sequence_number(const std::string &dir, const std::string &prefix) {
+            DIR *dir_p = opendir(dir.c_str());
+            if (dir_p == nullptr)
+                return -1;
+
+            int index = 0;
+            struct dirent *dirent_p;
+            while ((dirent_p = readdir(dir_p)) != nullptr) {
+                std::string entname(dirent_p->d_name);
+                if (entname.length() <= prefix.length() || entname.compare(0, prefix.length(), prefix) != 0)
+                    continue;
+
+                std::string endpart = entname.substr(prefix.length());
+                if (endpart.find_first_not_of("0123456789") != std::string::npos)
+                    continue;
+
+                int num = std::stoi(endpart);
+                if (num > index)
+                    index = num;
+            }
+            closedir(dir_p);
+
+            return index + 1;
+        }
+
+        /// \brief Find the next unused name in a sequence of numbered files.
+        ///        The name is the prefix followed by one more than the largest number in use.
+        /// \param dir the directory containing the files
+        /// \param prefix the prefix of the file names
+        /// \returns the next file name, without the directory, or an empty string if the directory cannot be read
+        inline std::string next_sequence_name(const std::string &dir, const std::string &prefix) {
+            int index = next_sequence_number(dir, prefix);
+            if (index < 0)
+                return "";
+
+            return prefix + std::to_string(index);
+        }
+
     }
     
 }
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace math {
+        /// \brief a matrix with a size fixed at compile time
+        ///
+        /// The elements are stored in the object, in row order, so matrices can be created
+        /// and combined without allocating memory.  Only the operations needed by the small
+        /// filters in this library are provided.
+        template <size_t R, size_t C>
+        class FixedMatrix {
+        public:
+            /// \brief create a matrix with all elements zero
+            FixedMatrix() {
+                for(size_t i = 0 ; i < R * C ; i++)
+                    data_[i] = 0.0 ;
+            }
+
+            /// \brief return the identity matrix
+            /// \returns the identity matrix
+            static FixedMatrix identity() {
+                static_assert(R == C, "identity matrix must be square") ;
+                FixedMatrix ret ;
+                for(size_t i = 0 ; i < R ; i++)
+                    ret(i, i) = 1.0 ;
+                return ret ;
+            }
+
+            /// \brief return an element
+            /// \param r the row
+            /// \param c the column
+            /// \returns the element
+            double &operator()(size_t r, size_t c) {
+                return data_[r * C + c] ;
+            }
+
+            /// \brief return an element
+            /// \param r the row
+            /// \param c the column
+            /// \returns the element
+            double operator()(size_t r, size_t c) const {
+                return data_[r * C + c] ;
+            }
+
+            /// \brief return the transpose of the matrix
+            /// \returns the transpose of the matrix
+            FixedMatrix<C, R> transpose() const {
+                FixedMatrix<C, R> ret ;
+                for(size_t r = 0 ; r < R ; r++) {
+                    for(size_t c = 0 ; c < C ; c++)
+                        ret(c, r) = (*this)(r, c) ;
+                }
+                return ret ;
+            }
+
+            /// \brief add another matrix to this one
+            /// \param other the matrix to add
+            /// \returns this matrix
+            FixedMatrix &operator+=(const FixedMatrix &other) {
+                for(size_t i = 0 ; i < R * C ; i++)
+                    data_[i] += other.data_[i] ;
+                return *this ;
+            }
+
+            /// \brief return the sum of two matrices
+            /// \param other the matrix to add
+            /// \returns the sum of the two matrices
+            FixedMatrix operator+(const FixedMatrix &other) const {
+                FixedMatrix ret = *this ;
+                ret += other ;
+                return ret ;
+            }
+
+            /// \brief return the difference of two matrices
+            /// \param other the matrix to subtract
+            /// \returns the difference of the two matrices
+            FixedMatrix operator-(const FixedMatrix &other) const {
+                FixedMatrix ret = *this ;
+                for(size_t i = 0 ; i < R * C ; i++)
+                    ret.data_[i] -= other.data_[i] ;
+                return ret ;
+            }
+
+            /// \brief return the product of two matrices
+            /// \param other the matrix to multiply by
+            /// \returns the product of the two matrices
+            template <size_t N>
+            FixedMatrix<R, N> operator*(const FixedMatrix<C, N> &other) const {
+                FixedMatrix<R, N> ret ;
+                for(size_t r = 0 ; r < R ; r++) {
+                    for(size_t n = 0 ; n < N ; n++) {
+                        double sum = 0.0 ;
+                        for(size_t c = 0 ; c < C ; c++)
+                            sum += (*this)(r, c) * other(c, n) ;
+                        ret(r, n) = sum ;
+                    }
+                }
+                return ret ;
+            }
+
+            /// \brief make the matrix exactly symmetric by averaging it with its transpose
+            void symmetrize() {
+                static_assert(R == C, "only a square matrix can be symmetric") ;
+                for(size_t r = 0 ; r < R ; r++) {
+                    for(size_t c = r + 1 ; c < C ; c++) {
+                        double v = ((*this)(r, c) + (*this)(c, r)) / 2.0 ;
+                        (*this)(r, c) = v ;
+                        (*this)(c, r) = v ;
+                    }
+                }
+            }
+
+        private:
+            double data_[R * C] ;
+        } ;
+
+        /// \brief invert a two by two matrix
+        /// \param m the matrix to invert
+        /// \param inv the inverse of the matrix
+        /// \returns false if the matrix cannot be inverted
+        inline bool invert(const FixedMatrix<2, 2> &m, FixedMatrix<2, 2> &inv) {
+            double det = m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0) ;
+            if (det == 0.0)
+                return false ;
+
+            inv(0, 0) = m(1, 1) / det ;
+            inv(0, 1) = -m(0, 1) / det ;
+            inv(1, 0) = -m(1, 0) / det ;
+            inv(1, 1) = m(0, 0) / det ;
+            return true ;
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include "Histogram.h"
+#include <algorithm>
+#include <cassert>
+
+namespace xero {
+    namespace misc {
+        Histogram::Histogram(double minv, double maxv, size_t buckets) {
+            assert(maxv > minv) ;
+            assert(buckets > 0) ;
+
+            minv_ = minv ;
+            width_ = (maxv - minv) / buckets ;
+            buckets_.resize(buckets) ;
+            clear() ;
+        }
+
+        Histogram::~Histogram() {
+        }
+
+        void Histogram::clear() {
+            std::fill(buckets_.begin(), buckets_.end(), 0) ;
+            count_ = 0 ;
+            sum_ = 0.0 ;
+            min_ = 0.0 ;
+            max_ = 0.0 ;
+        }
+
+        void Histogram::add(double value) {
+            size_t index = 0 ;
+
+            if (value > minv_) {
+                index = static_cast<size_t>((value - minv_) / width_) ;
+                if (index >= buckets_.size())
+                    index = buckets_.size() - 1 ;
+            }
+            buckets_[index]++ ;
+
+            if (count_ == 0) {
+                min_ = value ;
+                max_ = value ;
+            }
+            else {
+                min_ = std::min(min_, value) ;
+                max_ = std::max(max_, value) ;
+            }
+
+            sum_ += value ;
+            count_++ ;
+        }
+
+        double Histogram::getPercentile(double pct) const {
+            if (count_ == 0)
+                return 0.0 ;
+
+            size_t target = static_cast<size_t>(pct / 100.0 * count_ + 0.5) ;
+            if (target == 0)
+                target = 1 ;
+
+            size_t total = 0 ;
+            for(size_t i = 0 ; i < buckets_.size() ; i++) {
+                total += buckets_[i] ;
+                if (total >= target)
+                    return std::max(min_, std::min(max_, getBucketStart(i + 1))) ;
+            }
+
+            return max_ ;
+        }
+
+        std::string Histogram::toString(double scale) const {
+            std::string ret ;
+
+            ret += "count " + std::to_string(count_) ;
+            ret += ", min " + std::to_string(getMinimum() * scale) ;
+            ret += ", mean " + std::to_string(getMean() * scale) ;
+            ret += ", p99 " + std::to_string(getPercentile(99.0) * scale) ;
+            ret += ", max " + std::to_string(getMaximum() * scale) ;
+
+            return ret ;
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief a fixed range, fixed bucket count histogram
+        ///
+        /// The histogram is sized once when it is created and never allocates memory
+        /// when samples are added, so it is safe to use from within the robot loop.
+        /// Samples below the minimum are counted in the first bucket and samples
+        /// above the maximum are counted in the last bucket.  The exact minimum, maximum
+        /// and mean are tracked separately from the buckets.
+        class Histogram {
+        public:
+            /// \brief create a new histogram
+            /// \param minv the lowest value covered by the buckets
+            /// \param maxv the highest value covered by the buckets
+            /// \param buckets the number of buckets between minv and maxv
+            Histogram(double minv, double maxv, size_t buckets) ;
+
+            /// \brief destroy the histogram
+            virtual ~Histogram() ;
+
+            /// \brief add a sample to the histogram
+            /// \param value the sample to add
+            void add(double value) ;
+
+            /// \brief remove all samples from the histogram
+            void clear() ;
+
+            /// \brief return the number of samples added
+            /// \returns the number of samples added
+            size_t getCount() const {
+                return count_ ;
+            }
+
+            /// \brief return the smallest sample added
+            /// \returns the smallest sample added, or zero if there are no samples
+            double getMinimum() const {
+                return count_ == 0 ? 0.0 : min_ ;
+            }
+
+            /// \brief return the largest sample added
+            /// \returns the largest sample added, or zero if there are no samples
+            double getMaximum() const {
+                return count_ == 0 ? 0.0 : max_ ;
+            }
+
+            /// \brief return the average of the samples added
+            /// \returns the average of the samples, or zero if there are no samples
+            double getMean() const {
+                return count_ == 0 ? 0.0 : sum_ / count_ ;
+            }
+
+            /// \brief return an estimate of the given percentile
+            /// The value returned is the upper edge of the bucket containing the percentile
+            /// clamped to the largest sample seen.
+            /// \param pct the percentile of interest (0 - 100)
+            /// \returns the estimated value at the given percentile
+            double getPercentile(double pct) const ;
+
+            /// \brief return the number of buckets
+            /// \returns the number of buckets
+            size_t getBucketCount() const {
+                return buckets_.size() ;
+            }
+
+            /// \brief return the number of samples in a bucket
+            /// \param index the index of the bucket
+            /// \returns the number of samples in the bucket
+            size_t getBucket(size_t index) const {
+                return buckets_[index] ;
+            }
+
+            /// \brief return the lower edge of a bucket
+            /// \param index the index of the bucket
+            /// \returns the lower edge of the bucket
+            double getBucketStart(size_t index) const {
+                return minv_ + index * width_ ;
+            }
+
+            /// \brief return a human readable summary of the histogram
+            /// \param scale a multiplier applied to each value printed (e.g. 1000 to print seconds as ms)
+            /// \returns a human readable summary of the histogram
+            std::string toString(double scale = 1.0) const ;
+
+        private:
+            double minv_ ;
+            double width_ ;
+            std::vector<size_t> buckets_ ;
+
+            size_t count_ ;
+            double sum_ ;
+            double min_ ;
+            double max_ ;
+        } ;
+    }
+}
@@ -0,0 +1,64 @@
+#include "MessageDestBinaryFile.h"
+#include "BinaryLog.h"
+#include "FileUtils.h"
+#include <iostream>
+
+namespace xero
+{
+namespace misc
+{
+
+MessageDestBinaryFile::MessageDestBinaryFile(const std::string &dir, const std::string &prefix)
+{
+    std::string name = xero::file::next_sequence_name(dir, prefix);
+    if (name.length() == 0)
+    {
+        std::cout << "Open of binary log file in '" << dir << "' failed" << std::endl;
+        return;
+    }
+
+    filename_ = dir + name;
+    strm_.open(filename_, std::ios::out | std::ios::binary);
+    if (!strm_.is_open())
+    {
+        std::cout << "Open of binary log file '" << filename_ << "' failed" << std::endl;
+        filename_.clear();
+        return;
+    }
+
+    uint8_t header[BinaryLogFormat::HeaderSize];
+    BinaryLogEncoder encoder(header, sizeof(header));
+    encoder.header();
+    displayRecord(encoder.getData(), encoder.getLength());
+}
+
+MessageDestBinaryFile::~MessageDestBinaryFile()
+{
+    flush();
+}
+
+void MessageDestBinaryFile::displayMessage(const MessageLogger::MessageType &type, uint64_t subs, const std::string &msg)
+{
+    //
+    // A text record is the message plus a small fixed header
+    //
+    buffer_.resize(msg.length() + 16);
+    BinaryLogEncoder encoder(&buffer_[0], buffer_.size());
+    encoder.text(static_cast<uint8_t>(type), subs, msg);
+    displayRecord(encoder.getData(), encoder.getLength());
+}
+
+void MessageDestBinaryFile::displayRecord(const uint8_t *data, size_t length)
+{
+    if (strm_.is_open())
+        strm_.write(reinterpret_cast<const char *>(data), length);
+}
+
+void MessageDestBinaryFile::flush()
+{
+    if (strm_.is_open())
+        strm_.flush();
+}
+
+} // namespace misc
+} // namespace xero
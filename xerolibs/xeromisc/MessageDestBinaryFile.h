@@ -0,0 +1,67 @@
+#pragma once
+
+#include "MessageLoggerDest.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+/// \file
+
+namespace xero
+{
+namespace misc
+{
+
+/// \brief A binary file destination for a message logger
+///
+/// Structured records are stored as they were encoded (see BinaryLog.h), and text messages
+/// are stored as text records.  The file is named with the given prefix and an increasing
+/// index, and can be converted back to text or CSV with the xerologdump tool.
+class MessageDestBinaryFile : public MessageLoggerDest
+{
+public:
+    /// \brief create a new binary file destination
+    /// \param dir the directory for the file, including the trailing separator
+    /// \param prefix the prefix of the file name
+    MessageDestBinaryFile(const std::string &dir, const std::string &prefix);
+
+    /// \brief destroy the binary file destination
+    virtual ~MessageDestBinaryFile();
+
+    /// \brief return the name of the file being written
+    /// \returns the name of the file being written, or an empty string if the open failed
+    const std::string &getFileName() const
+    {
+        return filename_;
+    }
+
+    /// \brief write the given message to the file as a text record
+    /// \param type the type of the message
+    /// \param subs the subsystems the message belongs to
+    /// \param msg the message to write
+    virtual void displayMessage(const MessageLogger::MessageType &type, uint64_t subs, const std::string &msg);
+
+    /// \brief returns true since structured records are stored in binary form
+    /// \returns true
+    virtual bool isBinary() const
+    {
+        return true;
+    }
+
+    /// \brief write an encoded structured record to the file
+    /// \param data the encoded record
+    /// \param length the length of the encoded record
+    virtual void displayRecord(const uint8_t *data, size_t length);
+
+    /// \brief write any buffered records to the file
+    virtual void flush();
+
+private:
+    std::ofstream strm_;
+    std::string filename_;
+    std::vector<uint8_t> buffer_;
+};
+
+} // namespace misc
+} // namespace xero
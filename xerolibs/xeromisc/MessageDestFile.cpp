@@ -66,7 +66,7 @@ void MessageDestFile::displayMessage(const MessageLogger::MessageType &type, uin
     std::string appended_msg = prefix + msg;
     if (strm_p_ != nullptr)
     {
-        (*strm_p_) << (appended_msg) << std::endl;
+        (*strm_p_) << (appended_msg) << '\n';
     }
     else
     {
@@ -75,10 +75,10 @@ void MessageDestFile::displayMessage(const MessageLogger::MessageType &type, uin
             std::cout << "Succeeded in opening log file." << std::endl;
             for (auto const &m : msg_q_)
             {
-                (*strm_p_) << m << std::endl;
+                (*strm_p_) << m << '\n';
             }
             msg_q_.clear();
-            (*strm_p_) << (appended_msg) << std::endl;
+            (*strm_p_) << (appended_msg) << '\n';
         }
         else
         {
@@ -93,5 +93,11 @@ void MessageDestFile::displayMessage(const MessageLogger::MessageType &type, uin
     }
 }
 
+void MessageDestFile::flush()
+{
+    if (strm_p_ != nullptr)
+        strm_p_->flush();
+}
+
 } // namespace misc
 } // namespace xero
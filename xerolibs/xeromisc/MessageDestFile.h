@@ -42,6 +42,9 @@ public:
     /// \param msg the message to write
     virtual void displayMessage(const MessageLogger::MessageType &type, uint64_t subs, const std::string &msg);
 
+    /// \brief write any buffered messages to the file
+    virtual void flush();
+
 private:
     void initialize();
     std::ofstream *strm_p_;
@@ -0,0 +1,226 @@
+#include "MessageDestMappedFile.h"
+#include "FileUtils.h"
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+namespace xero
+{
+namespace misc
+{
+
+constexpr size_t MessageDestMappedFile::DefaultFileSize;
+
+MessageDestMappedFile::MessageDestMappedFile(const std::string &dir, const std::string &prefix, size_t size,
+                                             double interval, unsigned long int timeout)
+{
+    dirname_ = dir;
+    if (dirname_.length() > 0 && dirname_.back() != '/')
+        dirname_ += '/';
+    prefix_ = prefix;
+    size_ = size;
+    interval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(interval));
+    fd_ = -1;
+    base_ = nullptr;
+    used_ = 0;
+    synced_ = 0;
+    index_ = -1;
+    file_count_ = 0;
+    enabled_ = true;
+    ref_established_ = false;
+    timeout_limit_ = timeout;
+    background_ = false;
+
+    //
+    // The destination is created before the robot loop starts, so the first file can be
+    // allocated now
+    //
+    openfile(true);
+}
+
+MessageDestMappedFile::~MessageDestMappedFile()
+{
+    closefile(true);
+}
+
+bool MessageDestMappedFile::openfile(bool wait)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    //
+    // Establish a time base to know when to give up
+    //
+    if (!ref_established_)
+    {
+        start_ = now;
+        ref_established_ = true;
+    }
+    last_open_ = now;
+
+    //
+    // The directory is only scanned for the first file, after that the index just
+    // goes up by one for each file
+    //
+    if (index_ < 0)
+    {
+        index_ = xero::file::next_sequence_number(dirname_, prefix_);
+        if (index_ < 0)
+            return false;
+    }
+
+    std::string filename = dirname_ + prefix_ + std::to_string(index_++);
+    fd_ = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+    {
+        std::cout << "Open of log file '" << filename << "' failed" << std::endl;
+        return false;
+    }
+
+    //
+    // If this thread may wait, allocate all of the blocks for the file now so that writing
+    // a message never has to wait for the file system to find space.  Otherwise only set
+    // the size of the file, and the blocks are allocated as the pages are written back.
+    //
+    int err = wait ? posix_fallocate(fd_, 0, static_cast<off_t>(size_)) : ftruncate(fd_, static_cast<off_t>(size_));
+    if (err != 0)
+    {
+        std::cout << "Preallocation of log file '" << filename << "' failed" << std::endl;
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    void *addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED)
+    {
+        std::cout << "Mapping of log file '" << filename << "' failed" << std::endl;
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    base_ = static_cast<char *>(addr);
+    used_ = 0;
+    synced_ = 0;
+    last_sync_ = now;
+    filename_ = filename;
+    file_count_++;
+
+    //
+    // For convenience, always create a symlink point to the latest log file
+    //
+    xero::file::create_symlink(filename_, dirname_ + "latest");
+
+    return true;
+}
+
+void MessageDestMappedFile::closefile(bool wait)
+{
+    if (fd_ < 0)
+        return;
+
+    msync(base_, size_, wait ? MS_SYNC : MS_ASYNC);
+    munmap(base_, size_);
+
+    //
+    // Drop the unused part of the preallocated file
+    //
+    if (ftruncate(fd_, static_cast<off_t>(used_)) != 0)
+        std::cout << "Truncate of log file '" << filename_ << "' failed" << std::endl;
+
+    close(fd_);
+    fd_ = -1;
+    base_ = nullptr;
+    filename_.clear();
+}
+
+void MessageDestMappedFile::sync()
+{
+    if (used_ == synced_)
+        return;
+
+    //
+    // msync() needs a page aligned address, so start at the page holding the first
+    // byte not yet synced
+    //
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t start = synced_ - (synced_ % page);
+    msync(base_ + start, used_ - start, background_ ? MS_SYNC : MS_ASYNC);
+    synced_ = used_;
+}
+
+void MessageDestMappedFile::write(const std::string &msg)
+{
+    size_t length = std::min(msg.length() + 1, size_);
+
+    if (used_ + length > size_)
+    {
+        closefile(background_);
+        if (!openfile(background_))
+        {
+            enabled_ = false;
+            return;
+        }
+    }
+
+    std::memcpy(base_ + used_, msg.data(), length - 1);
+    base_[used_ + length - 1] = '\n';
+    used_ += length;
+}
+
+void MessageDestMappedFile::displayMessage(const MessageLogger::MessageType &type, uint64_t subs, const std::string &msg)
+{
+    if (!enabled_)
+        return;
+
+    std::string prefix;
+    if (type == MessageLogger::MessageType::warning)
+        prefix = "WARNING: ";
+    else if (type == MessageLogger::MessageType::error)
+        prefix = "ERROR: ";
+
+    if (fd_ >= 0)
+    {
+        write(prefix + msg);
+        return;
+    }
+
+    //
+    // The flash drive may not be mounted yet.  Hold the messages and try again at
+    // most once a second until the timeout.
+    //
+    msg_q_.push_back(prefix + msg);
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_open_ >= std::chrono::seconds(1) && openfile(background_))
+    {
+        std::cout << "Succeeded in opening log file." << std::endl;
+        for (auto const &m : msg_q_)
+            write(m);
+        msg_q_.clear();
+    }
+    else if (std::chrono::duration_cast<std::chrono::milliseconds>(now - start_).count() > static_cast<long>(timeout_limit_))
+    {
+        std::cout << "Logging disabled. Timeout reached and log file still not successfully opened." << std::endl;
+        enabled_ = false;
+        msg_q_.clear();
+    }
+}
+
+void MessageDestMappedFile::flush()
+{
+    if (fd_ < 0)
+        return;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_sync_ >= interval_)
+    {
+        sync();
+        last_sync_ = now;
+    }
+}
+
+} // namespace misc
+} // namespace xero
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "MessageLoggerDest.h"
+#include <string>
+#include <list>
+#include <chrono>
+
+
+/// \file
+
+namespace xero
+{
+namespace misc
+{
+
+/// \brief A memory mapped, preallocated file destination for a message logger
+///
+/// Each log file is mapped into memory, so writing a message is a copy into memory.  The
+/// mapped pages are synced to the file at most once per sync interval, from flush().
+///
+/// When the message logger runs asynchronously, all of the work is done by its writer
+/// thread, so each file is preallocated to its full size and each sync waits for the disk.
+/// At most one sync interval of messages is lost if power is cut.  When the logger is
+/// synchronous, the destination is called from the robot loop, so nothing it does waits
+/// for the disk: a sync only starts the write, and a new file is sized without allocating
+/// its blocks.
+///
+/// When a file is full, the destination moves on to the next file in the sequence.  The
+/// files are named with the prefix and an increasing index, and the "latest" symlink in the
+/// directory always points to the file being written.  The directory is only scanned once,
+/// to find the first index.  A file that was not closed (because power was cut) is padded
+/// with zero bytes after the last message.
+class MessageDestMappedFile : public MessageLoggerDest
+{
+public:
+    /// \brief the default size of each log file
+    static constexpr size_t DefaultFileSize = 32 * 1024 * 1024;
+
+    /// \brief create a new memory mapped file destination
+    /// \param dir the directory for the log files
+    /// \param prefix the prefix of the log file names
+    /// \param size the size of each log file in bytes
+    /// \param interval the time in seconds between syncs of the file
+    /// \param timeout the time in milliseconds after which to stop trying to open the file
+    MessageDestMappedFile(const std::string &dir, const std::string &prefix, size_t size = DefaultFileSize,
+                          double interval = 0.5, unsigned long int timeout = 15000);
+
+    /// \brief destroy the destination, syncing and closing the current file
+    virtual ~MessageDestMappedFile();
+
+    /// \brief return the name of the file being written
+    /// \returns the name of the file being written, or an empty string if no file is open
+    const std::string &getFileName() const
+    {
+        return filename_;
+    }
+
+    /// \brief return the number of files opened so far
+    /// \returns the number of files opened so far
+    int getFileCount() const
+    {
+        return file_count_;
+    }
+
+    /// \brief write the given message to the file
+    /// \param type the type of the message
+    /// \param subs the subsystems the message belongs to
+    /// \param msg the message to write
+    virtual void displayMessage(const MessageLogger::MessageType &type, uint64_t subs, const std::string &msg);
+
+    /// \brief sync the messages written since the last sync, if the sync interval has passed
+    virtual void flush();
+
+    /// \brief set whether the destination is only used from the logger's writer thread
+    /// \param background if true, syncs and new files may wait for the disk
+    virtual void setBackground(bool background)
+    {
+        background_ = background;
+    }
+
+private:
+    bool openfile(bool wait);
+    void closefile(bool wait);
+    void write(const std::string &msg);
+    void sync();
+
+private:
+    std::string dirname_;
+    std::string prefix_;
+    std::string filename_;
+    size_t size_;
+    std::chrono::steady_clock::duration interval_;
+
+    // True if the destination is only used from the logger's writer thread, so it may block
+    bool background_;
+
+    // The file and its mapping, fd_ is -1 if no file is open
+    int fd_;
+    char *base_;
+    size_t used_;
+    size_t synced_;
+    std::chrono::steady_clock::time_point last_sync_;
+
+    // The index of the next file, -1 until the directory has been scanned
+    int index_;
+    int file_count_;
+
+    // Messages held until the directory is available
+    std::list<std::string> msg_q_;
+    bool enabled_;
+    bool ref_established_;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_open_;
+    unsigned long int timeout_limit_;
+};
+
+} // namespace misc
+} // namespace xero
@@ -116,7 +116,7 @@ void MessageDestSeqFile::displayMessage(const MessageLogger::MessageType &type,
     std::string appended_msg = prefix + msg;
     if (strm_p_ != nullptr)
     {
-        (*strm_p_) << (appended_msg) << std::endl;
+        (*strm_p_) << (appended_msg) << '\n';
     }
     else
     {
@@ -125,10 +125,10 @@ void MessageDestSeqFile::displayMessage(const MessageLogger::MessageType &type,
             std::cout << "Succeeded in opening log file." << std::endl;
             for (auto const &m : msg_q_)
             {
-                (*strm_p_) << m << std::endl;
+                (*strm_p_) << m << '\n';
             }
             msg_q_.clear();
-            (*strm_p_) << (appended_msg) << std::endl;
+            (*strm_p_) << (appended_msg) << '\n';
         }
         else
         {
@@ -144,5 +144,11 @@ void MessageDestSeqFile::displayMessage(const MessageLogger::MessageType &type,
     }
 }
 
+void MessageDestSeqFile::flush()
+{
+    if (strm_p_ != nullptr)
+        strm_p_->flush();
+}
+
 } // namespace misc
 } // namespace xero
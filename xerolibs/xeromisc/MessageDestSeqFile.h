@@ -36,6 +36,9 @@ public:
     /// \param msg the message to write
     virtual void displayMessage(const MessageLogger::MessageType &type, uint64_t subs, const std::string &msg);
 
+    /// \brief write any buffered messages to the file
+    virtual void flush();
+
 private:
     bool openfile();
     std::string getFileName(DIR *dir_p);
@@ -34,7 +34,13 @@ public:
     /// \param msg the message to write
     virtual void displayMessage(const MessageLogger::MessageType &type, uint64_t subs, const std::string &msg)
     {
-        stream_ << msg << std::endl;
+        stream_ << msg << '\n';
+    }
+
+    /// \brief write any buffered messages to the stream
+    virtual void flush()
+    {
+        stream_ << std::flush;
     }
 
 private:
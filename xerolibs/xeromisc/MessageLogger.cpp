@@ -2,36 +2,310 @@
 #include "MessageLoggerDest.h"
 #include <sstream>
 #include <iostream>
+#include <chrono>
+#include <cstring>
+#include <limits>
 
 namespace xero
 {
 namespace misc
 {
 
-MessageLogger::MessageLogger()
+constexpr size_t MessageLogger::MaxRecordText;
+
+//
+// The capture messages logged by this thread are kept in, if any
+//
+static thread_local MessageLogger::Capture *active_capture = nullptr;
+
+MessageLogger::MessageLogger() : encoder_(record_buffer_, sizeof(record_buffer_))
 {
     //Initialize maps
-    current_message_ = "";
-    in_message_ = false;
+    types_enabled_ = 0;
     subsystems_enabled_ = 0;
     time_func_ = nullptr ;
+    running_ = false;
+    flush_interval_ = 0.0;
+    dropped_ = 0;
+    dropped_reported_ = 0;
+    record_enabled_ = false;
+}
+
+MessageLogger::~MessageLogger()
+{
+    stopAsync();
 }
 
 void MessageLogger::clear() 
 {
+    std::lock_guard<std::mutex> lock(dest_lock_);
     destinations_.clear() ;
 }
 
+void MessageLogger::startAsync(size_t slots, double flush_interval)
+{
+    if (ring_ != nullptr)
+        return;
+
+    flush_interval_ = flush_interval;
+    ring_ = std::unique_ptr<SpscRing<LogRecord>>(new SpscRing<LogRecord>(slots));
+    writer_message_.reserve(MaxRecordText + 32);
+    setBackground(true);
+    running_ = true;
+    writer_ = std::thread(&MessageLogger::writerThread, this);
+}
+
+void MessageLogger::stopAsync()
+{
+    if (ring_ == nullptr)
+        return;
+
+    running_ = false;
+    writer_.join();
+    ring_ = nullptr;
+    setBackground(false);
+}
+
+void MessageLogger::addDestination(std::shared_ptr<MessageLoggerDest> dest_p)
+{
+    std::lock_guard<std::mutex> lock(dest_lock_);
+    dest_p->setBackground(isAsync());
+    destinations_.push_back(dest_p);
+}
+
+void MessageLogger::setBackground(bool background)
+{
+    std::lock_guard<std::mutex> lock(dest_lock_);
+    for (auto dest_p : destinations_)
+        dest_p->setBackground(background);
+}
+
+void MessageLogger::writeMessage(const MessageType &type, uint64_t subsystem, bool has_time, double now, const std::string &msg)
+{
+    const std::string *out_p = &msg;
+    std::string stamped;
+
+    if (has_time)
+    {
+        stamped = std::to_string(now) + ": " + msg;
+        out_p = &stamped;
+    }
+
+    std::lock_guard<std::mutex> lock(dest_lock_);
+    for (auto dest_p : destinations_)
+        dest_p->displayMessage(type, subsystem, *out_p);
+}
+
+void MessageLogger::flushDestinations()
+{
+    std::lock_guard<std::mutex> lock(dest_lock_);
+    for (auto dest_p : destinations_)
+        dest_p->flush();
+}
+
+void MessageLogger::writeRecord(const uint8_t *data, size_t length)
+{
+    const uint8_t *p = data;
+    if (!decoder_.decode(p, data + length, entry_))
+        return;
+
+    std::lock_guard<std::mutex> lock(dest_lock_);
+    for (auto dest_p : destinations_)
+    {
+        if (dest_p->isBinary())
+            dest_p->displayRecord(data, length);
+    }
+
+    //
+    // The text destinations only see data records, as text.  The schema and string
+    // records are only needed to decode the binary form.
+    //
+    if (entry_.kind_ == BinaryLogFormat::RecordKind::Data)
+    {
+        MessageType type = static_cast<MessageType>(entry_.type_);
+        std::string msg = BinaryLogDecoder::toText(entry_);
+        if (time_func_ != nullptr)
+            msg = std::to_string(entry_.time_) + ": " + msg;
+
+        for (auto dest_p : destinations_)
+        {
+            if (!dest_p->isBinary())
+                dest_p->displayMessage(type, entry_.group_, msg);
+        }
+    }
+}
+
+bool MessageLogger::queueRecord(const MessageType &type, uint64_t subsystem, const uint8_t *data, size_t length)
+{
+    if (ring_ != nullptr)
+    {
+        LogRecord *rec_p = ring_->acquire();
+        if (rec_p == nullptr)
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        rec_p->type_ = type;
+        rec_p->subsystem_ = subsystem;
+        rec_p->binary_ = true;
+        rec_p->length_ = length;
+        std::memcpy(rec_p->text_, data, length);
+        ring_->commit();
+    }
+    else
+    {
+        writeRecord(data, length);
+        flushDestinations();
+    }
+
+    return true;
+}
+
+void MessageLogger::defineRecord(uint16_t id, const std::string &name, const std::vector<std::string> &fields)
+{
+    if (defined_records_.find(id) != defined_records_.end())
+        return;
+
+    //
+    // The id is only marked as defined once the schema is queued, so a schema dropped
+    // because the ring buffer was full is sent again the next time the record is defined
+    //
+    encoder_.reset();
+    encoder_.schema(id, name, fields);
+    if (encoder_.isOverflow())
+        return;
+
+    if (queueRecord(MessageType::info, 0, encoder_.getData(), encoder_.getLength()))
+        defined_records_.insert(id);
+}
+
+uint16_t MessageLogger::internString(const std::string &value)
+{
+    auto it = strings_.find(value);
+    if (it != strings_.end())
+        return it->second;
+
+    //
+    // The string is only interned once it is queued.  Until then the next index stays
+    // free, so a string dropped because the ring buffer was full is sent again with the
+    // same index the next time it is interned.
+    //
+    uint16_t index = static_cast<uint16_t>(strings_.size());
+
+    encoder_.reset();
+    encoder_.string(index, value);
+    if (!encoder_.isOverflow() && queueRecord(MessageType::info, 0, encoder_.getData(), encoder_.getLength()))
+        strings_[value] = index;
+
+    return index;
+}
+
+void MessageLogger::startRecord(const MessageType &type, uint64_t subsystem, uint16_t id)
+{
+    record_enabled_ = isEnabled(type, subsystem);
+    if (!record_enabled_)
+        return;
+
+    record_type_ = type;
+
+    double now = 0.0;
+    if (time_func_ != nullptr)
+        now = (*time_func_)();
+
+    encoder_.reset();
+    encoder_.startData(now, static_cast<uint8_t>(type), subsystem, id);
+}
+
+void MessageLogger::endRecord()
+{
+    if (!record_enabled_)
+        return;
+
+    record_enabled_ = false;
+    if (encoder_.isOverflow())
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    queueRecord(record_type_, 0, encoder_.getData(), encoder_.getLength());
+}
+
+size_t MessageLogger::drainRing()
+{
+    size_t count = 0;
+    LogRecord *rec_p;
+
+    while ((rec_p = ring_->front()) != nullptr)
+    {
+        if (rec_p->binary_)
+        {
+            writeRecord(reinterpret_cast<const uint8_t *>(rec_p->text_), rec_p->length_);
+        }
+        else
+        {
+            writer_message_.assign(rec_p->text_, rec_p->length_);
+            writeMessage(rec_p->type_, rec_p->subsystem_, rec_p->has_time_, rec_p->time_, writer_message_);
+        }
+        ring_->pop();
+        count++;
+    }
+
+    return count;
+}
+
+void MessageLogger::writerThread()
+{
+    auto interval = std::chrono::duration<double>(flush_interval_);
+    auto poll = std::chrono::duration<double>(flush_interval_ / 10.0);
+    auto last_flush = std::chrono::steady_clock::now();
+    bool dirty = false;
+    bool running = true;
+
+    while (running)
+    {
+        //
+        // Read the flag before draining so that everything queued before stopAsync()
+        // was called is written by the last pass through the loop
+        //
+        running = running_;
+
+        size_t count = drainRing();
+        if (count > 0)
+            dirty = true;
+
+        uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != dropped_reported_)
+        {
+            std::string msg = "MessageLogger: ring buffer full, " + std::to_string(dropped - dropped_reported_);
+            msg += " messages dropped (" + std::to_string(dropped) + " total)";
+            writeMessage(MessageType::warning, 0, false, 0.0, msg);
+            dropped_reported_ = dropped;
+            dirty = true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (dirty && (!running || now - last_flush >= interval))
+        {
+            flushDestinations();
+            last_flush = now;
+            dirty = false;
+        }
+
+        if (running && count == 0)
+            std::this_thread::sleep_for(poll);
+    }
+}
+
 void MessageLogger::enableType(const MessageType &type)
 {
-    enabled_modes_.push_back(type);
+    types_enabled_ |= typeMask(type);
 }
 
 void MessageLogger::disableType(const MessageType &type)
 {
-    auto it = std::find(enabled_modes_.begin(), enabled_modes_.end(), type);
-    if (it != enabled_modes_.end())
-        enabled_modes_.erase(it);
+    types_enabled_ &= ~typeMask(type);
 }
 
 void MessageLogger::enableSubsystem(uint64_t sys)
@@ -44,115 +318,195 @@ void MessageLogger::disableSubsystem(uint64_t sys)
     subsystems_enabled_ &= ~sys;
 }
 
-bool MessageLogger::isMessageTypeEnabled(const MessageType &type)
-{
-    auto it = std::find(enabled_modes_.begin(), enabled_modes_.end(), type);
-    return it != enabled_modes_.end();
-}
-
-bool MessageLogger::isSubsystemEnabled(uint64_t subs)
+MessageLogger::MessageState &MessageLogger::currentState()
 {
-    if (subs == 0)
-        return true;
+    Capture *cap_p = active_capture;
+    if (cap_p != nullptr && cap_p->logger_ == this)
+        return cap_p->state_;
 
-    return (subsystems_enabled_ & subs) != 0ull;
+    return state_;
 }
 
 void MessageLogger::startMessage(const MessageType &type)
 {
-    if (in_message_)
+    MessageState &st = currentState();
+    if (st.in_message_)
     {
-        current_message_ += "FAILED TO CALL ENDMESSAGE";
+        st.text_ += "FAILED TO CALL ENDMESSAGE";
         endMessage();
     }
-    current_type_ = type;
-    in_message_ = true;
-    current_subsystem_ = 0;
+    st.type_ = type;
+    st.in_message_ = true;
+    st.subsystem_ = 0;
+    st.enabled_ = isMessageTypeEnabled(type);
 }
 
 void MessageLogger::startMessage(const MessageType &type, uint64_t sub)
 {
-    if (in_message_)
+    MessageState &st = currentState();
+    if (st.in_message_)
     {
-        current_message_ += "FAILED TO CALL ENDMESSAGE - ";
+        st.text_ += "FAILED TO CALL ENDMESSAGE - ";
         endMessage();
     }
 
-    current_type_ = type;
-    in_message_ = true;
-    current_subsystem_ = sub;
+    st.type_ = type;
+    st.in_message_ = true;
+    st.subsystem_ = sub;
+    st.enabled_ = isEnabled(type, sub);
 }
 
 void MessageLogger::endMessage()
 {
-    in_message_ = false;
-    if (current_message_.length() > 0) {
-        if (isMessageTypeEnabled(current_type_) && isSubsystemEnabled(current_subsystem_))
+    MessageState &st = currentState();
+    st.in_message_ = false;
+    if (st.text_.length() > 0 && st.enabled_)
+    {
+        double now = std::numeric_limits<double>::infinity() ;
+        if (time_func_ != nullptr)
+            now = (*time_func_)() ;
+
+        Capture *cap_p = active_capture;
+        if (cap_p != nullptr && cap_p->logger_ == this)
+        {
+            //
+            // Keep the message, swapping the strings so the capture keeps the
+            // storage of both
+            //
+            if (cap_p->count_ == cap_p->held_.size())
+                cap_p->held_.emplace_back();
+
+            Capture::Held &held = cap_p->held_[cap_p->count_++];
+            held.type_ = st.type_;
+            held.subsystem_ = st.subsystem_;
+            held.time_ = now;
+            held.text_.swap(st.text_);
+        }
+        else
+        {
+            outputMessage(st.type_, st.subsystem_, now, st.text_);
+        }
+    }
+    st.text_.clear();
+}
+
+void MessageLogger::outputMessage(const MessageType &type, uint64_t subsystem, double now, const std::string &msg)
+{
+    if (ring_ != nullptr)
+    {
+        //
+        // Hand the message to the writer thread.  The time is formatted by
+        // the writer so the robot loop only pays for a copy.
+        //
+        LogRecord *rec_p = ring_->acquire();
+        if (rec_p == nullptr)
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            rec_p->type_ = type;
+            rec_p->subsystem_ = subsystem;
+            rec_p->time_ = now;
+            rec_p->has_time_ = (time_func_ != nullptr);
+            rec_p->binary_ = false;
+            rec_p->length_ = std::min(msg.length(), MaxRecordText);
+            std::memcpy(rec_p->text_, msg.data(), rec_p->length_);
+            ring_->commit();
+        }
+    }
+    else
+    {
+        writeMessage(type, subsystem, time_func_ != nullptr, now, msg);
+        flushDestinations();
+    }
+}
+
+void MessageLogger::beginCapture(Capture &cap)
+{
+    assert(!currentState().in_message_);
+    cap.logger_ = this;
+    active_capture = &cap;
+}
+
+void MessageLogger::endCapture()
+{
+    Capture *cap_p = active_capture;
+    if (cap_p != nullptr && cap_p->logger_ == this)
+    {
+        if (cap_p->state_.in_message_)
         {
-            double now = std::numeric_limits<double>::infinity() ;
-            std::string msg = current_message_ ;
-            if (time_func_ != nullptr) {
-                now = (*time_func_)() ;
-
-                msg = std::to_string(now) + ": " + msg ;
-            }
-                
-            for (auto dest_p : destinations_)
-                dest_p->displayMessage(current_type_, current_subsystem_, msg);
+            cap_p->state_.text_ += " - FAILED TO CALL ENDMESSAGE";
+            endMessage();
         }
+        active_capture = nullptr;
     }
-    current_message_ = "";
+}
+
+void MessageLogger::writeCapture(Capture &cap)
+{
+    for(size_t i = 0; i < cap.count_; i++)
+    {
+        Capture::Held &held = cap.held_[i];
+        outputMessage(held.type_, held.subsystem_, held.time_, held.text_);
+        held.text_.clear();
+    }
+    cap.count_ = 0;
 }
 
 MessageLogger &MessageLogger::operator<<(const std::string &value)
 {
-    if (isMessageTypeEnabled(current_type_) && isSubsystemEnabled(current_subsystem_))
-        current_message_.append(value);
+    MessageState &st = currentState();
+    if (st.enabled_)
+        st.text_.append(value);
     return *this;
 }
 
 MessageLogger &MessageLogger::operator<<(const char *value_p)
 {
-    if (isMessageTypeEnabled(current_type_) && isSubsystemEnabled(current_subsystem_))
-        current_message_.append(std::string(value_p));
+    MessageState &st = currentState();
+    if (st.enabled_)
+        st.text_.append(value_p);
     return *this;
 }
 
 MessageLogger &MessageLogger::operator<<(int32_t value)
 {
-    if (isMessageTypeEnabled(current_type_) && isSubsystemEnabled(current_subsystem_))
-        current_message_.append(std::to_string(value));
+    MessageState &st = currentState();
+    if (st.enabled_)
+        st.text_.append(std::to_string(value));
     return *this;
 }
 
-
 MessageLogger &MessageLogger::operator<<(int64_t value)
 {
-    if (isMessageTypeEnabled(current_type_) && isSubsystemEnabled(current_subsystem_))
-        current_message_.append(std::to_string(value));
+    MessageState &st = currentState();
+    if (st.enabled_)
+        st.text_.append(std::to_string(value));
     return *this;
 }
 
-
 MessageLogger &MessageLogger::operator<<(uint32_t value)
 {
-    if (isMessageTypeEnabled(current_type_) && isSubsystemEnabled(current_subsystem_))
-        current_message_.append(std::to_string(value));
+    MessageState &st = currentState();
+    if (st.enabled_)
+        st.text_.append(std::to_string(value));
     return *this;
 }
 
-
 MessageLogger &MessageLogger::operator<<(uint64_t value)
 {
-    if (isMessageTypeEnabled(current_type_) && isSubsystemEnabled(current_subsystem_))
-        current_message_.append(std::to_string(value));
+    MessageState &st = currentState();
+    if (st.enabled_)
+        st.text_.append(std::to_string(value));
     return *this;
 }
 
 MessageLogger &MessageLogger::operator<<(double value)
 {
-    if (isMessageTypeEnabled(current_type_) && isSubsystemEnabled(current_subsystem_))
-        current_message_.append(std::to_string(value));
+    MessageState &st = currentState();
+    if (st.enabled_)
+        st.text_.append(std::to_string(value));
     return *this;
 }
 
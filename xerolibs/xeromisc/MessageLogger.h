@@ -7,8 +7,16 @@
 #include <cassert>
 #include <memory>
 #include <cstdint>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 #include "MessageLoggerData.h"
+#include "SpscRing.h"
+#include "BinaryLog.h"
+#include <set>
+#include <map>
+#include <vector>
 
 
 /// \file
@@ -33,10 +41,83 @@ class MessageLogger
         error    ///< the message is an error message
     };
 
+  private:
+    // A message being built with startMessage(), operator<<() and endMessage()
+    struct MessageState
+    {
+        // If true, we have seen a startMessage() call but not an endMessage() call
+        bool in_message_;
+
+        // If true, the message will be logged.  This is decided once in
+        // startMessage() so the insert operators do not check it again.
+        bool enabled_;
+
+        // The message type and subsystem
+        MessageType type_;
+        uint64_t subsystem_;
+
+        // The text of the message
+        std::string text_;
+
+        MessageState()
+        {
+            in_message_ = false;
+            enabled_ = false;
+            type_ = MessageType::debug;
+            subsystem_ = 0;
+        }
+    };
+
+  public:
+    /// \brief holds the messages logged by one thread so they can be written later
+    ///
+    /// While a capture is active on a thread, messages that thread logs are kept in the
+    /// capture rather than written.  The thread that owns the logger writes them with
+    /// writeCapture().  This lets several threads log at once, and by writing the captures
+    /// in a fixed order the log reads the same as if the work had been done in that order.
+    /// Only text messages are captured, structured records and data blocks are not.
+    /// The strings are reused, so once a capture has held its largest set of messages
+    /// capturing does not allocate memory.
+    class Capture
+    {
+        friend class MessageLogger;
+
+      public:
+        Capture()
+        {
+            logger_ = nullptr;
+            count_ = 0;
+        }
+
+        /// \brief returns the number of messages held
+        /// \returns the number of messages held
+        size_t size() const {
+            return count_;
+        }
+
+      private:
+        struct Held
+        {
+            MessageType type_;
+            uint64_t subsystem_;
+            double time_;
+            std::string text_;
+        };
+
+        MessageLogger *logger_;
+        MessageState state_;
+        std::vector<Held> held_;
+        size_t count_;
+    };
+
   public:
     /// \brief create a new message logger object
     MessageLogger();
 
+    /// \brief destroy the message logger object
+    /// If the logger is asynchronous, any queued messages are written first
+    virtual ~MessageLogger();
+
     void setTimeFunction(double (* timefun)()) {
         time_func_ = timefun ;
     }
@@ -44,15 +125,54 @@ class MessageLogger
     /// \brief clear all message destinations
     void clear() ;
 
+    /// \brief write messages to the destinations from a background thread
+    /// Once started, endMessage() copies each message into a fixed size ring buffer and returns
+    /// without doing any I/O.  A writer thread empties the ring buffer into the destinations and
+    /// flushes the destinations at least every flush interval.  If the ring buffer is full
+    /// the message is dropped and counted, and the writer thread reports the count.  The
+    /// messages must all come from a single thread while the logger is asynchronous.
+    /// \param slots the number of messages the ring buffer can hold
+    /// \param flush_interval the longest time in seconds a message waits before being flushed
+    void startAsync(size_t slots, double flush_interval) ;
+
+    /// \brief stop the background writer thread and write any queued messages
+    void stopAsync() ;
+
+    /// \brief returns true if messages are written by a background thread
+    /// \returns true if messages are written by a background thread
+    bool isAsync() const {
+        return ring_ != nullptr ;
+    }
+
+    /// \brief returns the number of messages dropped because the ring buffer was full
+    /// \returns the number of messages dropped because the ring buffer was full
+    uint64_t getDroppedCount() const {
+        return dropped_.load(std::memory_order_relaxed) ;
+    }
+
     /// \brief returns true if a given message type is active
     /// \param type the type of message to check for active
     /// \returns true if the message type is active, otherwise false
-    bool isMessageTypeEnabled(const MessageType &type);
+    bool isMessageTypeEnabled(const MessageType &type) const {
+        return (types_enabled_ & typeMask(type)) != 0;
+    }
 
     /// \brief returns true if a given subsystem is enabled
     /// \param sub the subsystem to check on
     /// \returns true if a sbusystem is enabled
-    bool isSubsystemEnabled(uint64_t sub);
+    bool isSubsystemEnabled(uint64_t sub) const {
+        return sub == 0 || (subsystems_enabled_ & sub) != 0;
+    }
+
+    /// \brief returns true if a message of the given type and subsystem would be logged
+    /// Use this (or the XERO_LOG macros below) to skip building the contents of a message
+    /// that would be thrown away.
+    /// \param type the type of the message
+    /// \param sub the subsystem the message is about
+    /// \returns true if a message of the given type and subsystem would be logged
+    bool isEnabled(const MessageType &type, uint64_t sub) const {
+        return isMessageTypeEnabled(type) && isSubsystemEnabled(sub);
+    }
 
     /// \brief enable a given message type
     /// \param type the type of message to enable
@@ -82,6 +202,20 @@ class MessageLogger
     /// \brief end the current message
     void endMessage();
 
+    /// \brief keep the messages logged by the calling thread in a capture
+    /// Messages logged by other threads are not affected.  The calling thread must not be
+    /// in the middle of a message.
+    /// \param cap the capture to keep the messages in
+    void beginCapture(Capture &cap);
+
+    /// \brief stop keeping the messages logged by the calling thread
+    void endCapture();
+
+    /// \brief write the messages held by a capture and empty it
+    /// This must be called by the thread that logs the messages that are not captured.
+    /// \param cap the capture to write
+    void writeCapture(Capture &cap);
+
     /// \brief operator overload the output a string value
     /// \param value_p the string to output
     /// \returns a copy of the message logger
@@ -184,39 +318,123 @@ class MessageLogger
         *this << current_data_.toString();
     }
 
+    /// \brief define the names of a structured record and its fields
+    /// Binary destinations store the definition so that the log can be decoded.  Defining a
+    /// record id that is already defined does nothing, so this can be called each time an
+    /// action starts.  Binary destinations must be added before records are defined.  A
+    /// definition that could not be queued (the ring buffer was full) is sent again the
+    /// next time the record is defined.
+    /// \param id the id of the record
+    /// \param name the name of the record
+    /// \param fields the names of the fields in the record
+    void defineRecord(uint16_t id, const std::string &name, const std::vector<std::string> &fields);
+
+    /// \brief return the index for a string that is logged often, defining it if needed
+    /// Interned strings are stored once in a binary log and referred to by index.  A string
+    /// that could not be queued (the ring buffer was full) is sent again the next time it is
+    /// interned, with the same index.
+    /// \param value the string to intern
+    /// \returns the index of the string
+    uint16_t internString(const std::string &value);
+
+    /// \brief start a structured record
+    /// The fields are added in the order given to defineRecord().
+    /// \param type the type of the record
+    /// \param subsystem the subsystem the record is about
+    /// \param id the id of the record
+    void startRecord(const MessageType &type, uint64_t subsystem, uint16_t id);
+
+    /// \brief add a double field to the current record
+    /// \param value the value of the field
+    /// \returns a reference to the MessageLogger object
+    MessageLogger &addField(double value) {
+        if (record_enabled_)
+            encoder_.field(value);
+        return *this;
+    }
+
+    /// \brief add an integer field to the current record
+    /// \param value the value of the field
+    /// \returns a reference to the MessageLogger object
+    MessageLogger &addField(int32_t value) {
+        if (record_enabled_)
+            encoder_.field(value);
+        return *this;
+    }
+
+    /// \brief add a boolean field to the current record
+    /// \param value the value of the field
+    /// \returns a reference to the MessageLogger object
+    MessageLogger &addField(bool value) {
+        if (record_enabled_)
+            encoder_.field(value);
+        return *this;
+    }
+
+    /// \brief add an interned string field to the current record
+    /// \param index the index returned by internString()
+    /// \returns a reference to the MessageLogger object
+    MessageLogger &addStringField(uint16_t index) {
+        if (record_enabled_)
+            encoder_.stringField(index);
+        return *this;
+    }
+
+    /// \brief end the current record
+    void endRecord();
+
     /// \brief add a new destiation for messages
     /// \param dest_p the new destination to add
-    void addDestination(std::shared_ptr<MessageLoggerDest> dest_p)
-    {
-        destinations_.push_back(dest_p);
-    }
+    void addDestination(std::shared_ptr<MessageLoggerDest> dest_p);
 
     /// \brief Remove matching destinations.
     /// \param dest_p the destination to remove
     void removeDestination(std::shared_ptr<MessageLoggerDest> dest_p)
     {
+        std::lock_guard<std::mutex> lock(dest_lock_);
         destinations_.remove(dest_p);
     }
 
   private:
-    // The modes currently enabled
-    std::list<MessageType> enabled_modes_;
+    static uint32_t typeMask(const MessageType &type) {
+        return 1u << static_cast<int>(type);
+    }
 
-    // The subsystems enabled, or zero if all are enabled
-    uint64_t subsystems_enabled_;
+  private:
+    // The longest message the asynchronous logger will queue, longer messages are truncated
+    static constexpr size_t MaxRecordText = 480;
+
+    // A message queued for the writer thread
+    struct LogRecord
+    {
+        MessageType type_;
+        uint64_t subsystem_;
+        double time_;
+        bool has_time_;
+        bool binary_;
+        size_t length_;
+        char text_[MaxRecordText];
+    };
 
-    // If true, we have seen a startMessage() call but not an
-    // endMessage() call
-    bool in_message_;
+    MessageState &currentState();
+    void outputMessage(const MessageType &type, uint64_t subsystem, double now, const std::string &msg);
+    void writeMessage(const MessageType &type, uint64_t subsystem, bool has_time, double now, const std::string &msg);
+    void writeRecord(const uint8_t *data, size_t length);
+    bool queueRecord(const MessageType &type, uint64_t subsystem, const uint8_t *data, size_t length);
+    void flushDestinations();
+    void setBackground(bool background);
+    void writerThread();
+    size_t drainRing();
 
-    // The current message type
-    MessageType current_type_;
+  private:
+    // The message types currently enabled, one bit per type
+    uint32_t types_enabled_;
 
-    // The current message subsystem
-    uint64_t current_subsystem_;
+    // The subsystems enabled, or zero if all are enabled
+    uint64_t subsystems_enabled_;
 
-    // The current message
-    std::string current_message_;
+    // The message being built by threads that are not capturing messages
+    MessageState state_;
 
     MessageLoggerData current_data_;
 
@@ -225,7 +443,72 @@ class MessageLogger
 
     // Function to return the current time
     double (* time_func_)() ;
+
+    // Protects the list of destinations, which the writer thread walks
+    std::mutex dest_lock_;
+
+    // The messages waiting for the writer thread, null if the logger is synchronous
+    std::unique_ptr<SpscRing<LogRecord>> ring_;
+
+    // The writer thread, and the flag that keeps it running
+    std::thread writer_;
+    std::atomic<bool> running_;
+
+    // The longest time a message waits before the destinations are flushed
+    double flush_interval_;
+
+    // The number of messages dropped because the ring was full, and the
+    // number the writer thread has already reported
+    std::atomic<uint64_t> dropped_;
+    uint64_t dropped_reported_;
+
+    // Reused by the writer thread to format messages
+    std::string writer_message_;
+
+    // The buffer and encoder for structured records built by the robot loop
+    uint8_t record_buffer_[MaxRecordText];
+    BinaryLogEncoder encoder_;
+
+    // If true, the current structured record will be logged
+    bool record_enabled_;
+    MessageType record_type_;
+
+    // The record ids defined and the strings interned so far
+    std::set<uint16_t> defined_records_;
+    std::map<std::string, uint16_t> strings_;
+
+    // Decodes structured records for the text destinations, used by the thread that writes messages
+    BinaryLogDecoder decoder_;
+    BinaryLogEntry entry_;
 };
 
 } // namespace misc
 } // namespace xero
+
+//
+// Competition builds can define XERO_LOG_STRIP_GROUPS to a mask of message groups.  Debug
+// messages in those groups written with the macros below are removed by the compiler.
+//
+#ifdef XERO_LOG_STRIP_GROUPS
+#define XERO_LOG_STRIPPED(type, group) \
+    ((type) == xero::misc::MessageLogger::MessageType::debug && ((group) & (XERO_LOG_STRIP_GROUPS)) != 0)
+#else
+#define XERO_LOG_STRIPPED(type, group) (false)
+#endif
+
+/// \brief evaluates to true if a message of the given type and group would be logged
+/// This is meant to guard a block that builds a message over several statements.
+#define XERO_LOG_ENABLED(logger, type, group) \
+    (!XERO_LOG_STRIPPED(type, group) && (logger).isEnabled(type, group))
+
+/// \brief log a message, only evaluating the message arguments if the message is logged
+/// The args are a chain of values separated by <<, for example
+/// XERO_LOG(logger, MessageLogger::MessageType::debug, MSG_GROUP_ACTIONS, "action " << action->toString())
+#define XERO_LOG(logger, type, group, args) \
+    do { \
+        if (XERO_LOG_ENABLED(logger, type, group)) { \
+            (logger).startMessage(type, group) ; \
+            (logger) << args ; \
+            (logger).endMessage() ; \
+        } \
+    } while (0)
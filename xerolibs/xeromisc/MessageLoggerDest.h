@@ -21,6 +21,40 @@ public:
     /// \param subs the subsystems the message belongs to
     /// \param msg the message to write
     virtual void displayMessage(const MessageLogger::MessageType &type, uint64_t subs, const std::string &msg) = 0;
+
+    /// \brief write any messages the destination has buffered
+    /// Destinations may buffer messages written by displayMessage().  The logger calls this
+    /// after each message when it is synchronous, and periodically from its writer thread
+    /// when it is asynchronous.
+    virtual void flush()
+    {
+    }
+
+    /// \brief tell the destination whether it is only used from the logger's writer thread
+    /// The logger calls this with true when it starts its writer thread, and with false once
+    /// the thread has stopped.  A destination should only do work that can block, such as
+    /// waiting for the disk, while it is used from the writer thread, otherwise the work
+    /// stalls the thread that logged the message.
+    /// \param background true if the destination is only used from the writer thread
+    virtual void setBackground(bool background)
+    {
+    }
+
+    /// \brief returns true if the destination stores structured records in binary form
+    /// Binary destinations are given every structured record through displayRecord().  All
+    /// other destinations are given the text form of data records through displayMessage().
+    /// \returns true if the destination stores structured records in binary form
+    virtual bool isBinary() const
+    {
+        return false;
+    }
+
+    /// \brief write a structured record in the binary log format (see BinaryLog.h)
+    /// \param data the encoded record
+    /// \param length the length of the encoded record
+    virtual void displayRecord(const uint8_t *data, size_t length)
+    {
+    }
 };
 
 } // namespace misc
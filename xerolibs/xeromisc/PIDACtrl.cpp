@@ -19,6 +19,29 @@ namespace xero{
             angle_ = angle ;
         }
 
+        PIDACtrl::SettingRefs::SettingRefs(SettingsParser &parser, const std::string &prefix) {
+            std::string key = prefix ;
+            size_t len = key.length() ;
+
+            kv = parser.getRef<double>(key.append("kv")) ;
+            ka = parser.getRef<double>(key.replace(len, std::string::npos, "ka")) ;
+            kp = parser.getRef<double>(key.replace(len, std::string::npos, "kp")) ;
+            kd = parser.getRef<double>(key.replace(len, std::string::npos, "kd")) ;
+        }
+
+        PIDACtrl::PIDACtrl(const SettingRefs &refs, bool angle) {
+            angle_ = angle ;
+            init(refs) ;
+        }
+
+        void PIDACtrl::init(const SettingRefs &refs) {
+            kv_ = refs.kv.get() ;
+            ka_ = refs.ka.get() ;
+            kp_ = refs.kp.get() ;
+            kd_ = refs.kd.get() ;
+            last_error_ = 0 ;
+        }
+
         double PIDACtrl::getOutput(double a, double v, double dtarget, double dactual, double dt){
             double current_error ;
             
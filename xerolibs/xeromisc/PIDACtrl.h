@@ -11,6 +11,15 @@ namespace xero {
         /// desired position, velocity and acceleration.
         class PIDACtrl{
         public:
+            /// \brief handles to the settings that hold the follower constants
+            struct SettingRefs {
+                /// \brief resolve the handles for the kv, ka, kp and kd constants under the given prefix
+                /// \param parser the settings parser
+                /// \param prefix the prefix of the constants, the names are prefix + "kv" and so on
+                SettingRefs(SettingsParser &parser, const std::string &prefix) ;
+
+                SettingRef<double> kv, ka, kp, kd ;         ///< the handles to the constants
+            } ;
 
             /// \brief Create the follower with constants from the settings file
             /// \param parser the settings parser
@@ -27,6 +36,15 @@ namespace xero {
             /// \param kd the kd constant
             PIDACtrl(double kv, double ka, double kp, double kd, bool angle = false);
 
+            /// \brief Create the follower with constants from resolved setting handles
+            /// \param refs the handles to the constants
+            /// \param angle if true the values are angles that wrap at +/- 180
+            PIDACtrl(const SettingRefs &refs, bool angle = false);
+
+            /// \brief read the constants again from resolved setting handles and reset the follower
+            /// \param refs the handles to the constants
+            void init(const SettingRefs &refs) ;
+
             /// \brief returns the output given the follower values
             /// \param a the desired acceleration
             /// \param v the desired velocity
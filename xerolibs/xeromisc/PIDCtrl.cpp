@@ -45,24 +45,53 @@ void PIDCtrl::init(double p, double i, double d, double f, bool is_angle)
     integral_ = 0;
 }
 
-void PIDCtrl::initFromSettings(SettingsParser &parser, const std::string &prefix, bool is_angle) {
-    pid_consts_.p = parser.getDouble(prefix + ":p");
-    pid_consts_.i = parser.getDouble(prefix + ":i");
-    pid_consts_.d = parser.getDouble(prefix + ":d");
-    pid_consts_.f = parser.getDouble(prefix + ":f");
-    pid_consts_.floor = std::numeric_limits<double>::min() ;
-    pid_consts_.ceil = std::numeric_limits<double>::max() ;
-    pid_consts_.integralCeil = std::numeric_limits<double>::max() ;
+PIDCtrl::SettingRefs::SettingRefs(SettingsParser &parser, const std::string &prefix, bool ext) {
+    std::string key = prefix ;
+    size_t len = key.length() ;
+
+    //
+    // Reuse one key buffer rather than building a new string for every constant
+    //
+    p = parser.getRef<double>(key.append(":p")) ;
+    i = parser.getRef<double>(key.replace(len, std::string::npos, ":i")) ;
+    d = parser.getRef<double>(key.replace(len, std::string::npos, ":d")) ;
+    f = parser.getRef<double>(key.replace(len, std::string::npos, ":f")) ;
+
+    extended = ext ;
+    if (extended) {
+        min = parser.getRef<double>(key.replace(len, std::string::npos, ":min")) ;
+        max = parser.getRef<double>(key.replace(len, std::string::npos, ":max")) ;
+        imax = parser.getRef<double>(key.replace(len, std::string::npos, ":imax")) ;
+    }
+}
+
+void PIDCtrl::initFromSettings(const SettingRefs &refs, bool is_angle) {
+    pid_consts_.p = refs.p.get() ;
+    pid_consts_.i = refs.i.get() ;
+    pid_consts_.d = refs.d.get() ;
+    pid_consts_.f = refs.f.get() ;
+
+    if (refs.extended) {
+        pid_consts_.floor = refs.min.get() ;
+        pid_consts_.ceil = refs.max.get() ;
+        pid_consts_.integralCeil = refs.imax.get() ;
+    }
+    else {
+        pid_consts_.floor = std::numeric_limits<double>::min() ;
+        pid_consts_.ceil = std::numeric_limits<double>::max() ;
+        pid_consts_.integralCeil = std::numeric_limits<double>::max() ;
+    }
+
     is_angle_ = is_angle ;
     integral_ = 0;
 }
 
-void PIDCtrl::initFromSettingsExtended(SettingsParser &parser, const std::string &prefix, bool is_angle) {
-    initFromSettings(parser, prefix, is_angle);
+void PIDCtrl::initFromSettings(SettingsParser &parser, const std::string &prefix, bool is_angle) {
+    initFromSettings(SettingRefs(parser, prefix), is_angle) ;
+}
 
-    pid_consts_.floor = parser.getDouble(prefix + ":min");
-    pid_consts_.ceil = parser.getDouble(prefix + ":max");
-    pid_consts_.integralCeil = parser.getDouble(prefix + ":imax");
+void PIDCtrl::initFromSettingsExtended(SettingsParser &parser, const std::string &prefix, bool is_angle) {
+    initFromSettings(SettingRefs(parser, prefix, true), is_angle) ;
 }
 
 double PIDCtrl::getOutput(double target, double current, double timeDifference)
@@ -12,6 +12,23 @@ namespace misc {
 class PIDCtrl
 {
 public:
+    /// \brief handles to the settings that hold the PID constants
+    ///
+    /// The handles are resolved once, usually when a subsystem is created, so that
+    /// actions can initialize their controllers without building key strings.
+    struct SettingRefs
+    {
+        /// \brief resolve the handles for the constants under the given prefix
+        /// \param parser the settings parser
+        /// \param prefix the prefix under which to find the PID constants in the settings file
+        /// \param extended if true also resolve the :min, :max, and :imax settings
+        SettingRefs(SettingsParser &parser, const std::string &prefix, bool extended = false);
+
+        SettingRef<double> p, i, d, f ;         ///< the :p, :i, :d and :f settings
+        SettingRef<double> min, max, imax ;     ///< the :min, :max and :imax settings, if extended
+        bool extended ;                         ///< true if the extended settings were resolved
+    };
+
     /// \brief create a new pid controller with all zero constants
     PIDCtrl(bool is_angle = false);
 
@@ -61,6 +78,13 @@ public:
     /// \param is_angle if true the values are angles that wrap at +/- 180
     void initFromSettingsExtended(SettingsParser &parser, const std::string &prefix, bool is_angle = false);
 
+    /// \brief Initialize the PID controller from resolved setting handles
+    ///
+    /// The floor, ceiling and integral ceiling are set if the handles are extended.
+    /// \param refs the handles to the PID constants
+    /// \param is_angle if true the values are angles that wrap at +/- 180
+    void initFromSettings(const SettingRefs &refs, bool is_angle = false);
+
     /// \brief Return the output given a target, the current value, and the time that has passed
     /// \param target the target value we are trying to reach
     /// \param current the current value for system
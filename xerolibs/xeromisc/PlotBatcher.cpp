@@ -0,0 +1,121 @@
+#include "PlotBatcher.h"
+#include <cstring>
+#include <algorithm>
+
+namespace xero {
+    namespace misc {
+
+        constexpr uint8_t PlotProtocol::Version ;
+        constexpr size_t PlotProtocol::HeaderSize ;
+        constexpr size_t PlotProtocol::MaxPacketSize ;
+
+        PlotBatcher::PlotBatcher(SendFunction sender) : sender_(sender) {
+            packet_.resize(PlotProtocol::MaxPacketSize) ;
+            length_ = 0 ;
+            rows_ = 0 ;
+            sequence_ = 0 ;
+            packets_ = 0 ;
+        }
+
+        void PlotBatcher::putU8(uint8_t value) {
+            packet_[length_++] = value ;
+        }
+
+        void PlotBatcher::putU16(uint16_t value) {
+            putU8(static_cast<uint8_t>(value >> 8)) ;
+            putU8(static_cast<uint8_t>(value)) ;
+        }
+
+        void PlotBatcher::putU32(uint32_t value) {
+            putU16(static_cast<uint16_t>(value >> 16)) ;
+            putU16(static_cast<uint16_t>(value)) ;
+        }
+
+        void PlotBatcher::putString(const std::string &value) {
+            size_t len = std::min(value.length(), packet_.size() - length_ - sizeof(uint16_t)) ;
+            putU16(static_cast<uint16_t>(len)) ;
+            std::memcpy(&packet_[length_], value.data(), len) ;
+            length_ += len ;
+        }
+
+        void PlotBatcher::startPacket(PlotProtocol::PacketKind kind) {
+            length_ = 0 ;
+            rows_ = 0 ;
+            putU8('X') ;
+            putU8('P') ;
+            putU8(PlotProtocol::Version) ;
+            putU8(static_cast<uint8_t>(kind)) ;
+            putU32(sequence_) ;
+        }
+
+        void PlotBatcher::sendPacket(int copies) {
+            for(int i = 0 ; i < copies ; i++) {
+                sender_(&packet_[0], length_) ;
+                packets_++ ;
+            }
+
+            sequence_++ ;
+            length_ = 0 ;
+            rows_ = 0 ;
+        }
+
+        void PlotBatcher::startPlot(uint32_t id, const std::string &name, const std::list<std::string> &cols) {
+            flush() ;
+
+            //
+            // Column names are cut short rather than split across packets, the start
+            // packet has to arrive in one piece
+            //
+            startPacket(PlotProtocol::PacketKind::Start) ;
+            putU32(id) ;
+            putString(name) ;
+
+            size_t count_pos = length_ ;
+            putU8(0) ;
+            for(const std::string &col : cols) {
+                if (packet_.size() - length_ < sizeof(uint16_t) + col.length() || packet_[count_pos] == UINT8_MAX)
+                    break ;
+
+                putString(col) ;
+                packet_[count_pos]++ ;
+            }
+
+            sendPacket(2) ;
+        }
+
+        void PlotBatcher::addRow(uint32_t id, uint32_t row, const double *values, size_t count) {
+            size_t maxcount = (PlotProtocol::MaxPacketSize - PlotProtocol::HeaderSize - 10) / sizeof(double) ;
+            count = std::min(count, std::min(maxcount, static_cast<size_t>(UINT8_MAX))) ;
+
+            size_t size = 2 * sizeof(uint32_t) + 1 + count * sizeof(double) ;
+            if (length_ != 0 && (length_ + size > packet_.size() || rows_ == UINT8_MAX))
+                flush() ;
+
+            if (length_ == 0) {
+                startPacket(PlotProtocol::PacketKind::Data) ;
+                putU8(0) ;
+            }
+
+            putU32(id) ;
+            putU32(row) ;
+            putU8(static_cast<uint8_t>(count)) ;
+            std::memcpy(&packet_[length_], values, count * sizeof(double)) ;
+            length_ += count * sizeof(double) ;
+
+            rows_++ ;
+            packet_[PlotProtocol::HeaderSize] = static_cast<uint8_t>(rows_) ;
+        }
+
+        void PlotBatcher::endPlot(uint32_t id) {
+            flush() ;
+            startPacket(PlotProtocol::PacketKind::End) ;
+            putU32(id) ;
+            sendPacket(2) ;
+        }
+
+        void PlotBatcher::flush() {
+            if (rows_ > 0)
+                sendPacket(1) ;
+        }
+    }
+}
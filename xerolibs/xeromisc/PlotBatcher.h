@@ -0,0 +1,111 @@
+#pragma once
+
+#include <string>
+#include <list>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+
+        /// \brief constants that describe the plot protocol
+        ///
+        /// Every packet starts with a header: the two bytes 'X' 'P', a version byte, a
+        /// kind byte and a uint32 sequence number.  The sequence number goes up by one for
+        /// each packet so the receiver can count lost packets.  Start and end packets are
+        /// sent twice with the same sequence number, and the receiver drops the copy.
+        ///
+        /// - Start: uint32 plot id, string name, uint8 count, count strings (column names)
+        /// - Data: uint8 count, count rows, each row is uint32 plot id, uint32 row,
+        ///   uint8 count, count doubles
+        /// - End: uint32 plot id
+        ///
+        /// A string is a uint16 length followed by the characters.  Integers are sent in
+        /// network byte order, doubles in the byte order of the sender (little endian).
+        class PlotProtocol {
+        public:
+            /// \brief the version of the protocol
+            static constexpr uint8_t Version = 2 ;
+
+            /// \brief the size of the packet header
+            static constexpr size_t HeaderSize = 8 ;
+
+            /// \brief the largest packet sent, small enough to never be fragmented on ethernet
+            static constexpr size_t MaxPacketSize = 1400 ;
+
+            /// \brief the kind of a packet
+            enum class PacketKind : uint8_t {
+                Start = 1,          ///< the name and columns of a new plot
+                Data = 2,           ///< one or more rows of plot data
+                End = 3,            ///< the end of a plot
+            } ;
+        } ;
+
+        /// \brief collects plot rows into packets for the plot protocol
+        ///
+        /// Rows are added to a packet in a fixed buffer, and the packet is sent when it is
+        /// full or when flush() is called, once per robot loop.  Nothing is allocated after
+        /// the batcher is created.
+        class PlotBatcher {
+        public:
+            /// \brief the function that sends a packet
+            typedef std::function<bool(const uint8_t *data, size_t size)> SendFunction ;
+
+            /// \brief create a new plot batcher
+            /// \param sender the function that sends a packet
+            PlotBatcher(SendFunction sender) ;
+
+            /// \brief send the start packet for a plot, after any pending rows
+            /// \param id the id of the plot
+            /// \param name the name of the plot
+            /// \param cols the names of the columns
+            void startPlot(uint32_t id, const std::string &name, const std::list<std::string> &cols) ;
+
+            /// \brief add a row of data to the current packet
+            /// \param id the id of the plot
+            /// \param row the index of the row
+            /// \param values the values for the row, one per column
+            /// \param count the number of values
+            void addRow(uint32_t id, uint32_t row, const double *values, size_t count) ;
+
+            /// \brief send the end packet for a plot, after any pending rows
+            /// \param id the id of the plot
+            void endPlot(uint32_t id) ;
+
+            /// \brief send the current packet if it holds any rows
+            void flush() ;
+
+            /// \brief return the sequence number of the next packet
+            /// \returns the sequence number of the next packet
+            uint32_t getSequence() const {
+                return sequence_ ;
+            }
+
+            /// \brief return the number of packets sent
+            /// \returns the number of packets sent, counting both copies of start and end packets
+            uint32_t getPacketCount() const {
+                return packets_ ;
+            }
+
+        private:
+            void startPacket(PlotProtocol::PacketKind kind) ;
+            void sendPacket(int copies) ;
+            void putU8(uint8_t value) ;
+            void putU16(uint16_t value) ;
+            void putU32(uint32_t value) ;
+            void putString(const std::string &value) ;
+
+        private:
+            SendFunction sender_ ;
+            std::vector<uint8_t> packet_ ;
+            size_t length_ ;
+            size_t rows_ ;
+            uint32_t sequence_ ;
+            uint32_t packets_ ;
+        } ;
+    }
+}
@@ -0,0 +1,217 @@
+#include "PlotDecoder.h"
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+namespace xero {
+    namespace misc {
+
+        constexpr size_t PlotDecoder::MaxRowGap ;
+
+        namespace {
+            bool getU8(const uint8_t *&p, const uint8_t *end, uint8_t &value) {
+                if (end - p < 1)
+                    return false ;
+
+                value = *p++ ;
+                return true ;
+            }
+
+            bool getU16(const uint8_t *&p, const uint8_t *end, uint16_t &value) {
+                if (end - p < 2)
+                    return false ;
+
+                value = static_cast<uint16_t>((p[0] << 8) | p[1]) ;
+                p += 2 ;
+                return true ;
+            }
+
+            bool getU32(const uint8_t *&p, const uint8_t *end, uint32_t &value) {
+                uint16_t hi, lo ;
+                if (!getU16(p, end, hi) || !getU16(p, end, lo))
+                    return false ;
+
+                value = (static_cast<uint32_t>(hi) << 16) | lo ;
+                return true ;
+            }
+
+            bool getString(const uint8_t *&p, const uint8_t *end, std::string &value) {
+                uint16_t len ;
+                if (!getU16(p, end, len) || end - p < len)
+                    return false ;
+
+                value.assign(reinterpret_cast<const char *>(p), len) ;
+                p += len ;
+                return true ;
+            }
+        }
+
+        PlotDecoder::PlotDecoder() {
+            have_sequence_ = false ;
+            last_sequence_ = 0 ;
+            packets_ = 0 ;
+            lost_ = 0 ;
+            duplicates_ = 0 ;
+            bad_ = 0 ;
+        }
+
+        PlotData &PlotDecoder::getPlot(uint32_t id) {
+            auto it = plots_.find(id) ;
+            if (it != plots_.end())
+                return it->second ;
+
+            PlotData &plot = plots_[id] ;
+            plot.id_ = id ;
+            plot.name_ = "plot-" + std::to_string(id) ;
+            plot.received_ = 0 ;
+            plot.first_time_ = 0.0 ;
+            plot.last_time_ = 0.0 ;
+            plot.started_ = false ;
+            return plot ;
+        }
+
+        void PlotDecoder::complete(uint32_t id) {
+            auto it = plots_.find(id) ;
+            if (it == plots_.end())
+                return ;
+
+            if (handler_)
+                handler_(it->second) ;
+
+            plots_.erase(it) ;
+        }
+
+        void PlotDecoder::finish() {
+            while (plots_.size() > 0)
+                complete(plots_.begin()->first) ;
+        }
+
+        bool PlotDecoder::decodeStart(const uint8_t *&p, const uint8_t *end) {
+            uint32_t id ;
+            uint8_t count ;
+            std::string name ;
+            std::vector<std::string> columns ;
+
+            if (!getU32(p, end, id) || !getString(p, end, name) || !getU8(p, end, count))
+                return false ;
+
+            columns.resize(count) ;
+            for(uint8_t i = 0 ; i < count ; i++) {
+                if (!getString(p, end, columns[i]))
+                    return false ;
+            }
+
+            PlotData &plot = getPlot(id) ;
+            plot.name_ = name ;
+            plot.columns_ = columns ;
+            plot.started_ = true ;
+            if (plot.data_.size() < columns.size())
+                plot.data_.resize(columns.size(), std::vector<double>(plot.getRowCount(), std::numeric_limits<double>::quiet_NaN())) ;
+
+            return true ;
+        }
+
+        bool PlotDecoder::decodeData(const uint8_t *&p, const uint8_t *end, double now) {
+            uint8_t rows ;
+
+            if (!getU8(p, end, rows))
+                return false ;
+
+            for(uint8_t i = 0 ; i < rows ; i++) {
+                uint32_t id, row ;
+                uint8_t count ;
+
+                if (!getU32(p, end, id) || !getU32(p, end, row) || !getU8(p, end, count))
+                    return false ;
+
+                if (static_cast<size_t>(end - p) < count * sizeof(double))
+                    return false ;
+
+                PlotData &plot = getPlot(id) ;
+                if (row > plot.getRowCount() + MaxRowGap)
+                    return false ;
+
+                //
+                // If the start packet was lost, make up names for the columns
+                //
+                while (plot.columns_.size() < count)
+                    plot.columns_.push_back("col" + std::to_string(plot.columns_.size())) ;
+
+                size_t rowcount = std::max(plot.getRowCount(), static_cast<size_t>(row) + 1) ;
+                if (plot.data_.size() < plot.columns_.size())
+                    plot.data_.resize(plot.columns_.size()) ;
+                for(auto &column : plot.data_)
+                    column.resize(rowcount, std::numeric_limits<double>::quiet_NaN()) ;
+
+                for(uint8_t col = 0 ; col < count ; col++) {
+                    std::memcpy(&plot.data_[col][row], p, sizeof(double)) ;
+                    p += sizeof(double) ;
+                }
+
+                if (plot.received_ == 0)
+                    plot.first_time_ = now ;
+                plot.last_time_ = now ;
+                plot.received_++ ;
+            }
+
+            return true ;
+        }
+
+        bool PlotDecoder::decode(const uint8_t *data, size_t size, double now) {
+            const uint8_t *p = data ;
+            const uint8_t *end = data + size ;
+            uint8_t magic1, magic2, version, kind ;
+            uint32_t seq ;
+
+            if (!getU8(p, end, magic1) || !getU8(p, end, magic2) || !getU8(p, end, version) ||
+                        !getU8(p, end, kind) || !getU32(p, end, seq) ||
+                        magic1 != 'X' || magic2 != 'P' || version != PlotProtocol::Version) {
+                bad_++ ;
+                return false ;
+            }
+
+            //
+            // Start and end packets are sent twice with the same sequence number.  A
+            // sequence number that goes backwards means the robot program restarted.
+            //
+            if (have_sequence_) {
+                if (seq == last_sequence_) {
+                    duplicates_++ ;
+                    return true ;
+                }
+
+                if (seq > last_sequence_)
+                    lost_ += seq - last_sequence_ - 1 ;
+            }
+            have_sequence_ = true ;
+            last_sequence_ = seq ;
+
+            bool ret = false ;
+            switch(static_cast<PlotProtocol::PacketKind>(kind)) {
+            case PlotProtocol::PacketKind::Start:
+                ret = decodeStart(p, end) ;
+                break ;
+
+            case PlotProtocol::PacketKind::Data:
+                ret = decodeData(p, end, now) ;
+                break ;
+
+            case PlotProtocol::PacketKind::End:
+                {
+                    uint32_t id ;
+                    ret = getU32(p, end, id) ;
+                    if (ret)
+                        complete(id) ;
+                }
+                break ;
+            }
+
+            if (ret)
+                packets_++ ;
+            else
+                bad_++ ;
+
+            return ret ;
+        }
+    }
+}
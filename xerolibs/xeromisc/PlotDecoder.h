@@ -0,0 +1,137 @@
+#pragma once
+
+#include "PlotBatcher.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+
+        /// \brief the data for one plot, reassembled from plot protocol packets
+        struct PlotData {
+            /// \brief the id of the plot
+            uint32_t id_ ;
+
+            /// \brief the name of the plot
+            std::string name_ ;
+
+            /// \brief the names of the columns
+            std::vector<std::string> columns_ ;
+
+            /// \brief the data, one vector per column, indexed by row.  Rows that were lost are NaN.
+            std::vector<std::vector<double>> data_ ;
+
+            /// \brief the number of rows received
+            size_t received_ ;
+
+            /// \brief the receive time of the first row, in seconds
+            double first_time_ ;
+
+            /// \brief the receive time of the last row, in seconds
+            double last_time_ ;
+
+            /// \brief true if the start packet was received
+            bool started_ ;
+
+            /// \brief return the number of rows, including lost rows
+            /// \returns the number of rows
+            size_t getRowCount() const {
+                return data_.size() == 0 ? 0 : data_[0].size() ;
+            }
+
+            /// \brief return the rate rows were received at
+            /// \returns the rate in rows per second, or zero if fewer than two rows were received
+            double getRate() const {
+                if (received_ < 2 || last_time_ <= first_time_)
+                    return 0.0 ;
+
+                return static_cast<double>(received_ - 1) / (last_time_ - first_time_) ;
+            }
+        } ;
+
+        /// \brief decodes plot protocol packets (see PlotBatcher.h) back into plots
+        ///
+        /// The decoder counts lost and duplicate packets using the packet sequence numbers.
+        /// When the end packet of a plot arrives the complete handler is called with the
+        /// plot, and the plot is dropped.
+        class PlotDecoder {
+        public:
+            /// \brief the function called when a plot is complete
+            typedef std::function<void(const PlotData &plot)> CompleteFunction ;
+
+            /// \brief create a new plot decoder
+            PlotDecoder() ;
+
+            /// \brief set the function called when a plot is complete
+            /// \param handler the function called when a plot is complete
+            void setCompleteHandler(CompleteFunction handler) {
+                handler_ = handler ;
+            }
+
+            /// \brief decode one packet
+            /// \param data the packet
+            /// \param size the size of the packet
+            /// \param now the time the packet was received, in seconds
+            /// \returns false if the packet is not a valid plot protocol packet
+            bool decode(const uint8_t *data, size_t size, double now) ;
+
+            /// \brief complete all plots that have not seen an end packet
+            void finish() ;
+
+            /// \brief return the plots that are not complete
+            /// \returns the plots that are not complete
+            const std::map<uint32_t, PlotData> &getPlots() const {
+                return plots_ ;
+            }
+
+            /// \brief return the number of valid packets received, not counting duplicates
+            /// \returns the number of valid packets received
+            uint32_t getPacketCount() const {
+                return packets_ ;
+            }
+
+            /// \brief return the number of packets lost, based on the sequence numbers
+            /// \returns the number of packets lost
+            uint32_t getLostCount() const {
+                return lost_ ;
+            }
+
+            /// \brief return the number of duplicate start and end packets dropped
+            /// \returns the number of duplicate packets
+            uint32_t getDuplicateCount() const {
+                return duplicates_ ;
+            }
+
+            /// \brief return the number of packets that were not valid
+            /// \returns the number of packets that were not valid
+            uint32_t getBadCount() const {
+                return bad_ ;
+            }
+
+        private:
+            // Rows further than this past the last row are treated as a bad packet
+            static constexpr size_t MaxRowGap = 100000 ;
+
+        private:
+            PlotData &getPlot(uint32_t id) ;
+            void complete(uint32_t id) ;
+            bool decodeStart(const uint8_t *&p, const uint8_t *end) ;
+            bool decodeData(const uint8_t *&p, const uint8_t *end, double now) ;
+
+        private:
+            CompleteFunction handler_ ;
+            std::map<uint32_t, PlotData> plots_ ;
+            bool have_sequence_ ;
+            uint32_t last_sequence_ ;
+            uint32_t packets_ ;
+            uint32_t lost_ ;
+            uint32_t duplicates_ ;
+            uint32_t bad_ ;
+        } ;
+    }
+}
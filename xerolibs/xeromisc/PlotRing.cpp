@@ -0,0 +1,84 @@
+#include "PlotRing.h"
+#include <algorithm>
+
+namespace xero {
+    namespace misc {
+
+        PlotRing::PlotRing(uint32_t id, const std::string &name, const std::list<std::string> &cols, size_t capacity) {
+            id_ = id ;
+            name_ = name ;
+            columns_ = cols ;
+            width_ = cols.size() ;
+            capacity_ = std::max(capacity, static_cast<size_t>(1)) ;
+
+            rows_.resize(capacity_) ;
+            values_.resize(capacity_ * width_) ;
+
+            head_ = 0 ;
+            count_ = 0 ;
+            dropped_ = 0 ;
+            ended_ = false ;
+            started_ = false ;
+        }
+
+        void PlotRing::addRow(uint32_t row, const double *values, size_t count) {
+            if (count_ == capacity_) {
+                head_ = (head_ + 1) % capacity_ ;
+                count_-- ;
+                dropped_++ ;
+            }
+
+            size_t slot = (head_ + count_) % capacity_ ;
+            rows_[slot] = row ;
+
+            double *dest = &values_[slot * width_] ;
+            count = std::min(count, width_) ;
+            std::copy(values, values + count, dest) ;
+            std::fill(dest + count, dest + width_, 0.0) ;
+            count_++ ;
+        }
+
+        bool PlotRing::send(PlotBatcher &batcher, size_t maxrows) {
+            if (!started_) {
+                batcher.startPlot(id_, name_, columns_) ;
+                started_ = true ;
+            }
+
+            while (count_ > 0 && maxrows-- > 0) {
+                batcher.addRow(id_, rows_[head_], &values_[head_ * width_], width_) ;
+                head_ = (head_ + 1) % capacity_ ;
+                count_-- ;
+            }
+
+            if (count_ > 0 || !ended_)
+                return false ;
+
+            batcher.endPlot(id_) ;
+            return true ;
+        }
+
+        void PlotRing::writeCSV(std::ostream &out) {
+            bool first = true ;
+            for(const std::string &col : columns_) {
+                if (!first)
+                    out << "," ;
+                out << col ;
+                first = false ;
+            }
+            out << '\n' ;
+
+            while (count_ > 0) {
+                const double *values = &values_[head_ * width_] ;
+                for(size_t col = 0 ; col < width_ ; col++) {
+                    if (col != 0)
+                        out << "," ;
+                    out << values[col] ;
+                }
+                out << '\n' ;
+
+                head_ = (head_ + 1) % capacity_ ;
+                count_-- ;
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "PlotBatcher.h"
+#include <string>
+#include <list>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+
+        /// \brief holds the rows of one plot in memory so they can be sent later
+        ///
+        /// All of the memory for the rows is allocated when the ring is created, so adding a
+        /// row is a copy and never allocates or makes a system call.  When the ring is full the
+        /// oldest row is dropped.  The rows are later sent through a PlotBatcher, a few at a
+        /// time, or written to a CSV file.
+        class PlotRing {
+        public:
+            /// \brief create a new plot ring
+            /// \param id the id of the plot
+            /// \param name the name of the plot
+            /// \param cols the names of the columns
+            /// \param capacity the number of rows the ring holds
+            PlotRing(uint32_t id, const std::string &name, const std::list<std::string> &cols, size_t capacity) ;
+
+            /// \brief return the id of the plot
+            /// \returns the id of the plot
+            uint32_t getID() const {
+                return id_ ;
+            }
+
+            /// \brief return the name of the plot
+            /// \returns the name of the plot
+            const std::string &getName() const {
+                return name_ ;
+            }
+
+            /// \brief return the number of rows in the ring
+            /// \returns the number of rows in the ring
+            size_t size() const {
+                return count_ ;
+            }
+
+            /// \brief return the number of rows dropped because the ring was full
+            /// \returns the number of rows dropped
+            size_t getDropped() const {
+                return dropped_ ;
+            }
+
+            /// \brief add a row to the ring, dropping the oldest row if the ring is full
+            /// \param row the index of the row
+            /// \param values the values for the row, one per column
+            /// \param count the number of values, extra values are ignored
+            void addRow(uint32_t row, const double *values, size_t count) ;
+
+            /// \brief mark the plot as ended, no more rows will be added
+            void end() {
+                ended_ = true ;
+            }
+
+            /// \brief return true if the plot has ended
+            /// \returns true if the plot has ended
+            bool isEnded() const {
+                return ended_ ;
+            }
+
+            /// \brief send rows to the batcher, starting with the start packet
+            /// The end packet is sent after the last row once the plot has ended.
+            /// \param batcher the batcher to send the rows with
+            /// \param maxrows the largest number of rows to send
+            /// \returns true once the end packet has been sent
+            bool send(PlotBatcher &batcher, size_t maxrows) ;
+
+            /// \brief write the rows in the ring as CSV, emptying the ring
+            /// \param out the stream to write to
+            void writeCSV(std::ostream &out) ;
+
+        private:
+            uint32_t id_ ;
+            std::string name_ ;
+            std::list<std::string> columns_ ;
+            size_t width_ ;
+            size_t capacity_ ;
+
+            // One row index and width_ values for each slot
+            std::vector<uint32_t> rows_ ;
+            std::vector<double> values_ ;
+
+            size_t head_ ;
+            size_t count_ ;
+            size_t dropped_ ;
+            bool ended_ ;
+            bool started_ ;
+        } ;
+    }
+}
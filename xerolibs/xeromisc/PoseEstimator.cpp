@@ -0,0 +1,166 @@
+#include "PoseEstimator.h"
+#include "xeromath.h"
+#include <cmath>
+
+using namespace xero::math ;
+
+namespace xero {
+    namespace misc {
+
+        constexpr double PoseEstimator::Gate1 ;
+        constexpr double PoseEstimator::Gate2 ;
+
+        PoseEstimator::PoseEstimator(double width, double scrub, const Noise &noise) {
+            width_ = width ;
+            scrub_ = scrub ;
+            noise_ = noise ;
+            reset(0.0, 0.0, 0.0, 0.0, 0.0) ;
+        }
+
+        PoseEstimator::~PoseEstimator() {
+        }
+
+        void PoseEstimator::reset(double x, double y, double angle, double posvar, double anglevar) {
+            state_(0, 0) = x ;
+            state_(1, 0) = y ;
+            state_(2, 0) = deg2rad(angle) ;
+
+            cov_ = FixedMatrix<3, 3>() ;
+            cov_(0, 0) = posvar ;
+            cov_(1, 1) = posvar ;
+            cov_(2, 2) = deg2rad(deg2rad(anglevar)) ;
+
+            rejected_ = 0 ;
+        }
+
+        double PoseEstimator::getAngle() const {
+            return normalizeAngleDegrees(rad2deg(state_(2, 0))) ;
+        }
+
+        void PoseEstimator::predict(double left, double right) {
+            double turn = (right - left) * scrub_ / width_ ;
+            double turnvar = deg2rad(deg2rad(noise_.turn_)) * std::fabs(rad2deg(turn)) ;
+            move((left + right) / 2.0, turn, turnvar) ;
+        }
+
+        void PoseEstimator::predict(double left, double right, double angle) {
+            double turnvar = deg2rad(deg2rad(noise_.gyro_)) * std::fabs(angle) ;
+            move((left + right) / 2.0, deg2rad(angle), turnvar) ;
+        }
+
+        void PoseEstimator::move(double dist, double turn, double turnvar) {
+            //
+            // Move along the heading half way through the turn, which is close to the arc
+            // Kinematics follows for the short steps taken each robot loop
+            //
+            double mid = state_(2, 0) + turn / 2.0 ;
+            double c = std::cos(mid) ;
+            double s = std::sin(mid) ;
+
+            state_(0, 0) += dist * c ;
+            state_(1, 0) += dist * s ;
+            state_(2, 0) = normalizeAngleRadians(state_(2, 0) + turn) ;
+
+            //
+            // F is the change in the new state for a change in the old state, G is the change
+            // in the new state for a change in the distance and the turn
+            //
+            FixedMatrix<3, 3> f = FixedMatrix<3, 3>::identity() ;
+            f(0, 2) = -dist * s ;
+            f(1, 2) = dist * c ;
+
+            FixedMatrix<3, 2> g ;
+            g(0, 0) = c ;
+            g(0, 1) = -dist * s / 2.0 ;
+            g(1, 0) = s ;
+            g(1, 1) = dist * c / 2.0 ;
+            g(2, 1) = 1.0 ;
+
+            FixedMatrix<2, 2> m ;
+            m(0, 0) = noise_.distance_ * std::fabs(dist) ;
+            m(1, 1) = turnvar ;
+
+            cov_ = f * cov_ * f.transpose() + g * m * g.transpose() ;
+            cov_.symmetrize() ;
+        }
+
+        PoseEstimator::Result PoseEstimator::updateTarget(double tx, double ty, double dist, double yaw, double distvar, double yawvar) {
+            double dx = tx - state_(0, 0) ;
+            double dy = ty - state_(1, 0) ;
+            double q = dx * dx + dy * dy ;
+            double r = std::sqrt(q) ;
+
+            if (r < 1e-6)
+                return Result::Invalid ;
+
+            //
+            // The expected sighting and how it changes with the state
+            //
+            FixedMatrix<2, 1> innov ;
+            innov(0, 0) = dist - r ;
+            innov(1, 0) = normalizeAngleRadians(deg2rad(yaw) - normalizeAngleRadians(std::atan2(dy, dx) - state_(2, 0))) ;
+
+            FixedMatrix<2, 3> h ;
+            h(0, 0) = -dx / r ;
+            h(0, 1) = -dy / r ;
+            h(1, 0) = dy / q ;
+            h(1, 1) = -dx / q ;
+            h(1, 2) = -1.0 ;
+
+            FixedMatrix<2, 2> noise ;
+            noise(0, 0) = distvar ;
+            noise(1, 1) = deg2rad(deg2rad(yawvar)) ;
+
+            FixedMatrix<3, 2> ht = h.transpose() ;
+            FixedMatrix<2, 2> sinv, smat = h * cov_ * ht + noise ;
+            if (!invert(smat, sinv))
+                return Result::Invalid ;
+
+            double d2 = (innov.transpose() * sinv * innov)(0, 0) ;
+            if (d2 > Gate2) {
+                rejected_++ ;
+                return Result::Rejected ;
+            }
+
+            FixedMatrix<3, 2> k = cov_ * ht * sinv ;
+            state_ += k * innov ;
+            state_(2, 0) = normalizeAngleRadians(state_(2, 0)) ;
+
+            cov_ = (FixedMatrix<3, 3>::identity() - k * h) * cov_ ;
+            cov_.symmetrize() ;
+            return Result::Accepted ;
+        }
+
+        PoseEstimator::Result PoseEstimator::updateAngle(double angle, double var) {
+            double innov = normalizeAngleRadians(deg2rad(angle) - state_(2, 0)) ;
+            double s = cov_(2, 2) + deg2rad(deg2rad(var)) ;
+            if (s <= 0.0)
+                return Result::Invalid ;
+
+            if (innov * innov / s > Gate1) {
+                rejected_++ ;
+                return Result::Rejected ;
+            }
+
+            //
+            // With H = [0 0 1] the gain is the last column of the covariance
+            //
+            FixedMatrix<3, 1> k ;
+            for(size_t i = 0 ; i < 3 ; i++)
+                k(i, 0) = cov_(i, 2) / s ;
+
+            for(size_t i = 0 ; i < 3 ; i++)
+                state_(i, 0) += k(i, 0) * innov ;
+            state_(2, 0) = normalizeAngleRadians(state_(2, 0)) ;
+
+            FixedMatrix<3, 3> updated = cov_ ;
+            for(size_t r = 0 ; r < 3 ; r++) {
+                for(size_t c = 0 ; c < 3 ; c++)
+                    updated(r, c) -= k(r, 0) * cov_(2, c) ;
+            }
+            cov_ = updated ;
+            cov_.symmetrize() ;
+            return Result::Accepted ;
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "FixedMatrix.h"
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief estimates the position of the robot on the field with an extended Kalman filter
+        ///
+        /// The state is the x and y position of the robot and its angle.  Each step of the
+        /// robot is predicted from the distance travelled by the wheels, with the change in
+        /// angle coming from the wheels or the gyro, and the uncertainty grows with the
+        /// distance travelled and the angle turned.  Sightings of vision targets at known
+        /// field positions, and absolute angles, then correct the estimate.
+        ///
+        /// The filter works in fixed size matrices held in the object, so no update allocates
+        /// memory.  Angles are in degrees and increase in the same direction as the angles
+        /// given to predict(), distances are in the units of the wheel distances.
+        class PoseEstimator {
+        public:
+            /// \brief how much the motion measurements are trusted
+            struct Noise {
+                double distance_ ;      ///< the variance added per unit of distance travelled
+                double turn_ ;          ///< the variance, in degrees squared, added per degree turned by the wheels
+                double gyro_ ;          ///< the variance, in degrees squared, added per degree turned by the gyro
+            } ;
+
+            /// \brief the result of a sighting
+            enum class Result {
+                Accepted,               ///< the sighting was used to correct the estimate
+                Rejected,               ///< the sighting is too far from the estimate to be believed
+                Invalid,                ///< the sighting could not be used, for example a target on top of the robot
+            } ;
+
+            /// \brief create a new estimator at the origin
+            /// \param width the width of the robot
+            /// \param scrub the scrub factor for the robot when turning, see Kinematics
+            /// \param noise how much the motion measurements are trusted
+            PoseEstimator(double width, double scrub, const Noise &noise) ;
+
+            /// \brief destroy the estimator
+            virtual ~PoseEstimator() ;
+
+            /// \brief set the position of the robot
+            /// \param x the x position of the robot
+            /// \param y the y position of the robot
+            /// \param angle the angle of the robot
+            /// \param posvar the variance of the x and y positions
+            /// \param anglevar the variance of the angle in degrees squared
+            void reset(double x, double y, double angle, double posvar, double anglevar) ;
+
+            /// \brief move the robot using only the wheels
+            /// \param left the distance the left wheels moved
+            /// \param right the distance the right wheels moved
+            void predict(double left, double right) ;
+
+            /// \brief move the robot using the wheels for distance and the gyro for the turn
+            /// \param left the distance the left wheels moved
+            /// \param right the distance the right wheels moved
+            /// \param angle the change in the gyro angle
+            void predict(double left, double right, double angle) ;
+
+            /// \brief correct the estimate with a sighting of a target at a known position
+            /// \param tx the x position of the target on the field
+            /// \param ty the y position of the target on the field
+            /// \param dist the distance to the target
+            /// \param yaw the angle to the target relative to the robot
+            /// \param distvar the variance of the distance
+            /// \param yawvar the variance of the angle in degrees squared
+            /// \returns the result of the sighting
+            Result updateTarget(double tx, double ty, double dist, double yaw, double distvar, double yawvar) ;
+
+            /// \brief correct the estimate with an absolute angle
+            /// \param angle the angle of the robot
+            /// \param var the variance of the angle in degrees squared
+            /// \returns the result of the measurement
+            Result updateAngle(double angle, double var) ;
+
+            /// \brief return the estimated x position of the robot
+            /// \returns the estimated x position of the robot
+            double getX() const {
+                return state_(0, 0) ;
+            }
+
+            /// \brief return the estimated y position of the robot
+            /// \returns the estimated y position of the robot
+            double getY() const {
+                return state_(1, 0) ;
+            }
+
+            /// \brief return the estimated angle of the robot
+            /// \returns the estimated angle of the robot
+            double getAngle() const ;
+
+            /// \brief return the covariance of the estimate, x, y and angle in radians
+            /// \returns the covariance of the estimate
+            const xero::math::FixedMatrix<3, 3> &getCovariance() const {
+                return cov_ ;
+            }
+
+            /// \brief return the number of sightings rejected since the estimator was reset
+            /// \returns the number of sightings rejected
+            size_t getRejectedCount() const {
+                return rejected_ ;
+            }
+
+        private:
+            //
+            // The squared Mahalanobis distance beyond which a measurement is rejected, the
+            // 99% points of the chi squared distribution with one and two degrees of freedom
+            //
+            static constexpr double Gate1 = 6.63 ;
+            static constexpr double Gate2 = 9.21 ;
+
+            void move(double dist, double turn, double turnvar) ;
+
+        private:
+            double width_ ;
+            double scrub_ ;
+            Noise noise_ ;
+
+            xero::math::FixedMatrix<3, 1> state_ ;
+            xero::math::FixedMatrix<3, 3> cov_ ;
+            size_t rejected_ ;
+        } ;
+    }
+}
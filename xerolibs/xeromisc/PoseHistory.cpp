@@ -0,0 +1,150 @@
+#include "PoseHistory.h"
+#include "xeromath.h"
+#include <cmath>
+
+namespace xero {
+    namespace misc {
+
+        constexpr size_t PoseHistory::FieldCount ;
+
+        PoseHistory::PoseHistory(size_t size) {
+            size_t actual = 1 ;
+            while (actual < size)
+                actual <<= 1 ;
+
+            slots_ = std::unique_ptr<Slot[]>(new Slot[actual]) ;
+            for(size_t i = 0 ; i < actual ; i++) {
+                slots_[i].seq_.store(0, std::memory_order_relaxed) ;
+                for(size_t f = 0 ; f < FieldCount ; f++)
+                    slots_[i].fields_[f].store(0.0, std::memory_order_relaxed) ;
+            }
+
+            mask_ = actual - 1 ;
+            count_.store(0, std::memory_order_release) ;
+        }
+
+        PoseHistory::~PoseHistory() {
+        }
+
+        void PoseHistory::add(const PoseSample &sample) {
+            uint64_t index = count_.load(std::memory_order_relaxed) ;
+            Slot &slot = slots_[index & mask_] ;
+
+            //
+            // An odd sequence number marks the slot as being written.  Sample N is complete
+            // when the sequence number is 2N + 2, which also tells a reader that the slot
+            // still holds the sample it asked for and not a newer one.
+            //
+            slot.seq_.store(index * 2 + 1, std::memory_order_relaxed) ;
+            std::atomic_thread_fence(std::memory_order_release) ;
+
+            slot.fields_[0].store(sample.time_, std::memory_order_relaxed) ;
+            slot.fields_[1].store(sample.x_, std::memory_order_relaxed) ;
+            slot.fields_[2].store(sample.y_, std::memory_order_relaxed) ;
+            slot.fields_[3].store(sample.angle_, std::memory_order_relaxed) ;
+            slot.fields_[4].store(sample.left_, std::memory_order_relaxed) ;
+            slot.fields_[5].store(sample.right_, std::memory_order_relaxed) ;
+
+            slot.seq_.store(index * 2 + 2, std::memory_order_release) ;
+            count_.store(index + 1, std::memory_order_release) ;
+        }
+
+        bool PoseHistory::read(uint64_t index, PoseSample &sample) const {
+            const Slot &slot = slots_[index & mask_] ;
+            uint64_t expected = index * 2 + 2 ;
+
+            if (slot.seq_.load(std::memory_order_acquire) != expected)
+                return false ;
+
+            sample.time_ = slot.fields_[0].load(std::memory_order_relaxed) ;
+            sample.x_ = slot.fields_[1].load(std::memory_order_relaxed) ;
+            sample.y_ = slot.fields_[2].load(std::memory_order_relaxed) ;
+            sample.angle_ = slot.fields_[3].load(std::memory_order_relaxed) ;
+            sample.left_ = slot.fields_[4].load(std::memory_order_relaxed) ;
+            sample.right_ = slot.fields_[5].load(std::memory_order_relaxed) ;
+
+            std::atomic_thread_fence(std::memory_order_acquire) ;
+            return slot.seq_.load(std::memory_order_relaxed) == expected ;
+        }
+
+        bool PoseHistory::getLatest(PoseSample &sample) const {
+            while (true) {
+                uint64_t count = count_.load(std::memory_order_acquire) ;
+                if (count == 0)
+                    return false ;
+
+                //
+                // This only fails if the writer went all the way around the ring while
+                // the sample was being copied
+                //
+                if (read(count - 1, sample))
+                    return true ;
+            }
+        }
+
+        size_t PoseHistory::getHistory(PoseSample *samples, size_t max) const {
+            uint64_t count = count_.load(std::memory_order_acquire) ;
+            size_t ret = 0 ;
+
+            while (ret < max && ret < count && ret < capacity()) {
+                if (!read(count - 1 - ret, samples[ret]))
+                    break ;
+                ret++ ;
+            }
+
+            return ret ;
+        }
+
+        bool PoseHistory::getPoseAt(double time, PoseSample &sample) const {
+            PoseSample newer, older ;
+
+            if (!getLatest(newer))
+                return false ;
+
+            if (time >= newer.time_) {
+                sample = newer ;
+                return true ;
+            }
+
+            //
+            // Walk back from the newest sample, the times of interest are usually recent
+            //
+            uint64_t count = count_.load(std::memory_order_acquire) ;
+            uint64_t index = count - 1 ;
+            size_t steps = 0 ;
+            while (true) {
+                if (index == 0 || ++steps >= capacity() || !read(index - 1, older))
+                    return false ;
+
+                if (older.time_ <= time)
+                    break ;
+
+                newer = older ;
+                index-- ;
+            }
+
+            double span = newer.time_ - older.time_ ;
+            double pct = (span > 0.0) ? (time - older.time_) / span : 0.0 ;
+
+            sample.time_ = time ;
+            sample.x_ = older.x_ + (newer.x_ - older.x_) * pct ;
+            sample.y_ = older.y_ + (newer.y_ - older.y_) * pct ;
+            sample.angle_ = xero::math::normalizeAngleDegrees(older.angle_ + xero::math::normalizeAngleDegrees(newer.angle_ - older.angle_) * pct) ;
+            sample.left_ = older.left_ + (newer.left_ - older.left_) * pct ;
+            sample.right_ = older.right_ + (newer.right_ - older.right_) * pct ;
+            return true ;
+        }
+
+        void PoseHistory::project(const PoseSample &then, const PoseSample &now, double dist, double yaw,
+                                double &newdist, double &newyaw) {
+            double bearing = xero::math::deg2rad(then.angle_ + yaw) ;
+            double tx = then.x_ + dist * std::cos(bearing) ;
+            double ty = then.y_ + dist * std::sin(bearing) ;
+
+            double dx = tx - now.x_ ;
+            double dy = ty - now.y_ ;
+            newdist = std::sqrt(dx * dx + dy * dy) ;
+            newyaw = xero::math::normalizeAngleDegrees(xero::math::rad2deg(std::atan2(dy, dx)) - now.angle_) ;
+        }
+    }
+}
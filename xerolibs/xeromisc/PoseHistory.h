@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief the position of the robot at a point in time
+        struct PoseSample {
+            double time_ ;          ///< the time of the sample in seconds
+            double x_ ;             ///< the x position of the robot
+            double y_ ;             ///< the y position of the robot
+            double angle_ ;         ///< the angle of the robot in degrees
+            double left_ ;          ///< the distance travelled by the left side
+            double right_ ;         ///< the distance travelled by the right side
+        } ;
+
+        /// \brief a lock free history of robot positions
+        ///
+        /// Exactly one thread adds samples, any number of threads may read them.  The samples
+        /// are kept in a fixed size ring, so adding a sample never allocates and the oldest
+        /// sample is overwritten when the ring is full.  Each slot carries a sequence number
+        /// that changes while the slot is being written, so a reader can tell when a sample
+        /// it copied was changed underneath it and try again.  Neither side takes a lock.
+        class PoseHistory {
+        public:
+            /// \brief create a new history
+            /// \param size the number of samples kept, rounded up to a power of two
+            PoseHistory(size_t size) ;
+
+            /// \brief destroy the history
+            virtual ~PoseHistory() ;
+
+            /// \brief return the number of samples the history can hold
+            /// \returns the number of samples the history can hold
+            size_t capacity() const {
+                return mask_ + 1 ;
+            }
+
+            /// \brief return the number of samples added since the history was created
+            /// \returns the number of samples added since the history was created
+            uint64_t getCount() const {
+                return count_.load(std::memory_order_acquire) ;
+            }
+
+            /// \brief add a sample (writer only)
+            /// \param sample the sample to add
+            void add(const PoseSample &sample) ;
+
+            /// \brief return the newest sample
+            /// \param sample the newest sample
+            /// \returns false if no samples have been added
+            bool getLatest(PoseSample &sample) const ;
+
+            /// \brief copy the newest samples, newest first
+            /// \param samples the array that receives the samples
+            /// \param max the size of the array
+            /// \returns the number of samples copied
+            size_t getHistory(PoseSample *samples, size_t max) const ;
+
+            /// \brief return the position of the robot at a past time
+            /// The position is interpolated between the samples on either side of the time.
+            /// A time after the newest sample returns the newest sample.
+            /// \param time the time of interest
+            /// \param sample the position of the robot at the given time
+            /// \returns false if the time is older than the oldest sample kept
+            bool getPoseAt(double time, PoseSample &sample) const ;
+
+            /// \brief move a target seen from one position so it is relative to another
+            /// The angles are in degrees and increase in the same direction as the robot angle.
+            /// \param then the position of the robot when the target was seen
+            /// \param now the current position of the robot
+            /// \param dist the distance to the target seen from then
+            /// \param yaw the angle to the target, relative to the robot, seen from then
+            /// \param newdist the distance to the target from now
+            /// \param newyaw the angle to the target, relative to the robot, from now
+            static void project(const PoseSample &then, const PoseSample &now, double dist, double yaw,
+                                double &newdist, double &newyaw) ;
+
+        private:
+            static constexpr size_t FieldCount = 6 ;
+
+            struct Slot {
+                std::atomic<uint64_t> seq_ ;
+                std::atomic<double> fields_[FieldCount] ;
+            } ;
+
+            bool read(uint64_t index, PoseSample &sample) const ;
+
+        private:
+            std::unique_ptr<Slot[]> slots_ ;
+            size_t mask_ ;
+            std::atomic<uint64_t> count_ ;
+        } ;
+    }
+}
@@ -0,0 +1,21 @@
+#include "Setting.h"
+#include <unordered_set>
+#include <mutex>
+
+namespace xero {
+    namespace misc {
+
+        const std::string *Setting::intern(const std::string &s) {
+            //
+            // The pool is never cleared and the nodes of an unordered_set do not move
+            // when it grows, so the returned pointers stay valid.  The pool is created on
+            // first use so that settings built during static initialization work.
+            //
+            static std::mutex lock ;
+            static std::unordered_set<std::string> *pool = new std::unordered_set<std::string>() ;
+
+            std::lock_guard<std::mutex> guard(lock) ;
+            return &(*pool->insert(s).first) ;
+        }
+    }
+}
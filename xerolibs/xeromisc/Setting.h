@@ -2,6 +2,8 @@
 
 #include <cassert>
 #include <iostream>
+#include <string>
+#include <cstdint>
 
 
 /// \file
@@ -9,10 +11,14 @@
 namespace xero {
     namespace misc {
         /// \brief A single setting item, capable of holding a boolean, integer, double, or string value
+        ///
+        /// The setting is a small tagged union.  String values are interned in a process wide
+        /// pool, so a setting only holds a pointer to the string and copying a setting never
+        /// allocates.  Interned strings live until the program exits.
         class Setting {
         public:
             /// \brief The type of value held by the setting
-            enum class Type {
+            enum class Type : uint8_t {
                 Invalid,
                 Boolean,
                 Integer,
@@ -23,41 +29,60 @@ namespace xero {
             /// \brief Create a new setting with unset type
             Setting() {
                 type_ = Type::Invalid;
+                value_.double_ = 0.0 ;
             }
 
             /// \brief Create a new setting holding the given boolean value
             /// \param b the boolean value to store
             Setting(bool b) {
                 type_ = Type::Boolean;
-                bool_ = b;
+                value_.bool_ = b;
             }
 
             /// \brief Create a new setting holding the given integer value
             /// \param i the integer value to store
             Setting(int i) {
                 type_ = Type::Integer;
-                int_ = i;
+                value_.int_ = i;
             }
 
             /// \brief Create a new setting holding the given double value
             /// \param d the double value to store
             Setting(double d) {
                 type_ = Type::Double;
-                double_ = d;
+                value_.double_ = d;
             }
 
             /// \brief Create a new setting holding the given string value
             /// \param s the string value to store
-            Setting(std::string s) {
+            Setting(const std::string &s) {
                 type_ = Type::String;
-                string_ = s;
+                value_.string_ = intern(s);
             }
 
             /// \brief Create a new setting holding the given string value
             /// \param s the string value to store
             Setting(const char *s) {
                 type_ = Type::String ;
-                string_ = s ;
+                value_.string_ = intern(s) ;
+            }
+
+            /// \brief return the interned copy of a string
+            /// The same pointer is returned for every string with the same contents.
+            /// \param s the string to intern
+            /// \returns a pointer to the interned string, valid until the program exits
+            static const std::string *intern(const std::string &s) ;
+
+            /// \brief return the type of value held by the setting
+            /// \returns the type of value held by the setting
+            Type getType() const {
+                return type_ ;
+            }
+
+            /// \brief returns true if the setting holds a value
+            /// \returns true if the setting holds a value
+            bool isValid() const {
+                return type_ != Type::Invalid ;
             }
 
             /// \brief returns true if the setting is a boolean
@@ -89,7 +114,7 @@ namespace xero {
             bool getBoolean() const {
                 assert(type_ == Type::Boolean);
 
-                return bool_;
+                return value_.bool_;
             }
 
             /// \brief Return the integer value held by the setting
@@ -97,7 +122,7 @@ namespace xero {
             int getInteger() const {
                 assert(type_ == Type::Integer) ;
 
-                return int_;
+                return value_.int_;
             }
 
             /// \brief Return the double value held by the setting
@@ -106,8 +131,8 @@ namespace xero {
                 assert(type_ == Type::Double || type_ == Type::Integer);
                 
                 if (type_ == Type::Integer)
-                    return static_cast<double>(int_);
-                return double_;
+                    return static_cast<double>(value_.int_);
+                return value_.double_;
             }
 
             /// \brief Return the string value held by the setting
@@ -115,9 +140,15 @@ namespace xero {
             const std::string &getString() const {
                 assert(type_ == Type::String);
 
-                return string_;
+                return *value_.string_;
             }
 
+            /// \brief return the value held by the setting as the given type
+            /// This is used by the typed setting handles, T is bool, int, double or std::string.
+            /// \returns the value held by the setting
+            template <typename T>
+            T get() const ;
+
             /// \brief The == operator for the setting object
             /// \param s the setting to compare to
             /// \returns true if the objects are the same type and value
@@ -129,19 +160,22 @@ namespace xero {
 
                 switch(type_) {
                 case Type::Boolean:
-                    ret = (bool_ == s.bool_) ;
+                    ret = (value_.bool_ == s.value_.bool_) ;
                     break ;
 
                 case Type::Integer:
-                    ret = (int_ == s.int_) ;
+                    ret = (value_.int_ == s.value_.int_) ;
                     break ;
 
                 case Type::Double:
-                    ret = (double_ == s.double_) ;
+                    ret = (value_.double_ == s.value_.double_) ;
                     break ;
 
                 case Type::String:
-                    ret = (string_ == s.string_) ;
+                    //
+                    // Interned strings with the same contents have the same address
+                    //
+                    ret = (value_.string_ == s.value_.string_) ;
                     break ;
 
                 case Type::Invalid:
@@ -151,12 +185,49 @@ namespace xero {
                 return ret ;
             }
 
+            /// \brief The != operator for the setting object
+            /// \param s the setting to compare to
+            /// \returns true if the objects differ in type or value
+            bool operator!=(const Setting &s) const {
+                return !(*this == s) ;
+            }
+
         private:
             Type type_;
-            bool bool_;
-            int int_;
-            double double_;
-            std::string string_;
+            union {
+                bool bool_ ;
+                int int_ ;
+                double double_ ;
+                const std::string *string_ ;
+            } value_ ;
         };
+
+        /// \brief return the boolean value of a setting
+        /// \returns the boolean value of the setting
+        template <>
+        inline bool Setting::get<bool>() const {
+            return getBoolean() ;
+        }
+
+        /// \brief return the integer value of a setting
+        /// \returns the integer value of the setting
+        template <>
+        inline int Setting::get<int>() const {
+            return getInteger() ;
+        }
+
+        /// \brief return the double value of a setting
+        /// \returns the double value of the setting
+        template <>
+        inline double Setting::get<double>() const {
+            return getDouble() ;
+        }
+
+        /// \brief return the string value of a setting
+        /// \returns the string value of the setting
+        template <>
+        inline std::string Setting::get<std::string>() const {
+            return getString() ;
+        }
     }
 }
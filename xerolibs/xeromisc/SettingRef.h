@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Setting.h"
+#include <cassert>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief a typed handle to a value in a SettingsParser
+        ///
+        /// A handle is resolved once from its key with SettingsParser::getRef() and then reads
+        /// the value directly, without building or hashing a key string.  The handle keeps
+        /// pointing at the key, so it sees any later change to the value.  T is bool, int,
+        /// double or std::string.
+        template <typename T>
+        class SettingRef {
+        public:
+            /// \brief create a handle that does not refer to any setting
+            SettingRef() {
+                setting_ = nullptr ;
+            }
+
+            /// \brief create a handle to a stored setting
+            /// \param setting the stored setting
+            explicit SettingRef(const Setting *setting) {
+                setting_ = setting ;
+            }
+
+            /// \brief returns true if the key currently has a value
+            /// \returns true if the key currently has a value
+            bool isDefined() const {
+                return setting_ != nullptr && setting_->isValid() ;
+            }
+
+            /// \brief return the value of the setting; assert if there is no value
+            /// \returns the value of the setting
+            T get() const {
+                assert(isDefined()) ;
+                return setting_->get<T>() ;
+            }
+
+            /// \brief return the value of the setting, or a default if there is no value
+            /// \param default_value the value to return if the key has no value
+            /// \returns the value of the setting or the default
+            T get(const T &default_value) const {
+                return isDefined() ? setting_->get<T>() : default_value ;
+            }
+
+            /// \brief return the value of the setting; assert if there is no value
+            /// \returns the value of the setting
+            operator T() const {
+                return get() ;
+            }
+
+        private:
+            const Setting *setting_ ;
+        } ;
+    }
+}
@@ -0,0 +1,279 @@
+#include "SettingsCache.h"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace xero {
+    namespace misc {
+
+        constexpr uint32_t SettingsCache::Magic ;
+        constexpr uint16_t SettingsCache::Version ;
+        constexpr size_t SettingsCache::HeaderSize ;
+
+        namespace {
+            uint32_t hashBytes(uint32_t h, const void *data, size_t len) {
+                const uint8_t *p = static_cast<const uint8_t *>(data) ;
+                for(size_t i = 0 ; i < len ; i++) {
+                    h ^= p[i] ;
+                    h *= 16777619u ;
+                }
+                return h ;
+            }
+
+            std::string dirOf(const std::string &filename) {
+                size_t index = filename.find_last_of('/') ;
+                return index == std::string::npos ? "." : filename.substr(0, index) ;
+            }
+
+            template <typename T>
+            void put(std::string &out, T value) {
+                out.append(reinterpret_cast<const char *>(&value), sizeof(value)) ;
+            }
+
+            void putString(std::string &out, const std::string &value) {
+                uint16_t len = static_cast<uint16_t>(std::min(value.length(), static_cast<size_t>(UINT16_MAX))) ;
+                put(out, len) ;
+                out.append(value.data(), len) ;
+            }
+
+            template <typename T>
+            bool get(const uint8_t *&data, const uint8_t *end, T &value) {
+                if (static_cast<size_t>(end - data) < sizeof(T))
+                    return false ;
+
+                std::memcpy(&value, data, sizeof(T)) ;
+                data += sizeof(T) ;
+                return true ;
+            }
+
+            bool getString(const uint8_t *&data, const uint8_t *end, std::string &value) {
+                uint16_t len ;
+                if (!get(data, end, len) || static_cast<size_t>(end - data) < len)
+                    return false ;
+
+                value.assign(reinterpret_cast<const char *>(data), len) ;
+                data += len ;
+                return true ;
+            }
+        }
+
+        bool SettingsCache::checksum(const std::vector<std::string> &sources, const std::list<std::string> &defines, uint32_t &checksum) {
+            uint32_t h = 2166136261u ;
+            std::vector<char> buffer(16384) ;
+
+            for(const std::string &define : defines)
+                h = hashBytes(h, define.c_str(), define.length() + 1) ;
+
+            for(const std::string &source : sources) {
+                std::ifstream in(source, std::ios::binary) ;
+                if (in.bad() || in.fail())
+                    return false ;
+
+                while (in) {
+                    in.read(&buffer[0], buffer.size()) ;
+                    h = hashBytes(h, &buffer[0], static_cast<size_t>(in.gcount())) ;
+                }
+            }
+
+            checksum = h ;
+            return true ;
+        }
+
+        bool SettingsCache::write(const std::string &filename, const SettingsTable &table,
+                                const std::vector<std::string> &sources, const std::list<std::string> &defines) {
+            uint32_t sum ;
+            if (!checksum(sources, defines, sum))
+                return false ;
+
+            std::string data ;
+            uint32_t count = 0 ;
+            for(size_t i = 0 ; i < table.getEntryCount() ; i++) {
+                const Setting &value = table.getValue(i) ;
+                if (!value.isValid())
+                    continue ;
+
+                putString(data, table.getKey(i)) ;
+                put(data, static_cast<uint8_t>(value.getType())) ;
+                switch(value.getType()) {
+                case Setting::Type::Boolean:
+                    put(data, static_cast<uint8_t>(value.getBoolean() ? 1 : 0)) ;
+                    break ;
+                case Setting::Type::Integer:
+                    put(data, static_cast<int32_t>(value.getInteger())) ;
+                    break ;
+                case Setting::Type::Double:
+                    put(data, value.getDouble()) ;
+                    break ;
+                case Setting::Type::String:
+                    putString(data, value.getString()) ;
+                    break ;
+                case Setting::Type::Invalid:
+                    break ;
+                }
+                count++ ;
+            }
+
+            std::string out ;
+            put(out, Magic) ;
+            put(out, Version) ;
+            put(out, static_cast<uint16_t>(sources.size())) ;
+            put(out, sum) ;
+            put(out, count) ;
+            put(out, static_cast<uint32_t>(data.size())) ;
+            put(out, hashBytes(2166136261u, data.data(), data.size())) ;
+            //
+            // Sources next to the cache are stored relative to it, so a cache built on a
+            // development machine is still valid once it is deployed with the settings file
+            //
+            std::string prefix = dirOf(filename) + "/" ;
+            for(const std::string &source : sources) {
+                if (source.compare(0, prefix.length(), prefix) == 0)
+                    putString(out, source.substr(prefix.length())) ;
+                else
+                    putString(out, source) ;
+            }
+            out += data ;
+
+            //
+            // Write to a temporary file and rename it so a reader never sees a partial cache,
+            // for instance if the robot loses power while the cache is being written
+            //
+            std::string tmpname = filename + ".tmp" ;
+            {
+                std::ofstream strm(tmpname, std::ios::binary | std::ios::trunc) ;
+                if (strm.bad() || strm.fail())
+                    return false ;
+
+                strm.write(out.data(), out.size()) ;
+                if (!strm)
+                    return false ;
+            }
+
+            return std::rename(tmpname.c_str(), filename.c_str()) == 0 ;
+        }
+
+        bool SettingsCache::read(const std::string &filename, const std::list<std::string> &defines,
+                                SettingsTable &table, std::vector<std::string> &sources, std::string &why) {
+            int fd = ::open(filename.c_str(), O_RDONLY) ;
+            if (fd == -1) {
+                why = "no cache file" ;
+                return false ;
+            }
+
+            struct stat st ;
+            if (::fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < HeaderSize) {
+                ::close(fd) ;
+                why = "cache file too short" ;
+                return false ;
+            }
+
+            size_t size = static_cast<size_t>(st.st_size) ;
+            void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) ;
+            ::close(fd) ;
+            if (addr == MAP_FAILED) {
+                why = "cache file could not be mapped" ;
+                return false ;
+            }
+
+            const uint8_t *p = static_cast<const uint8_t *>(addr) ;
+            const uint8_t *end = p + size ;
+            bool ret = false ;
+
+            uint32_t magic, sum, count, datasize, datasum ;
+            uint16_t version, nsources ;
+            std::vector<std::string> names ;
+
+            get(p, end, magic) ;
+            get(p, end, version) ;
+            get(p, end, nsources) ;
+            get(p, end, sum) ;
+            get(p, end, count) ;
+            get(p, end, datasize) ;
+            get(p, end, datasum) ;
+
+            if (magic != Magic || version != Version) {
+                why = "cache file has the wrong format" ;
+            }
+            else {
+                names.resize(nsources) ;
+                bool ok = true ;
+                std::string dir = dirOf(filename) ;
+                for(uint16_t i = 0 ; i < nsources && ok ; i++) {
+                    ok = getString(p, end, names[i]) ;
+                    if (ok && (names[i].length() == 0 || names[i][0] != '/'))
+                        names[i] = dir + "/" + names[i] ;
+                }
+
+                uint32_t current ;
+                if (!ok || static_cast<size_t>(end - p) != datasize) {
+                    why = "cache file is truncated" ;
+                }
+                else if (hashBytes(2166136261u, p, datasize) != datasum) {
+                    why = "cache file is corrupt" ;
+                }
+                else if (!checksum(names, defines, current) || current != sum) {
+                    why = "settings files or defines have changed" ;
+                }
+                else {
+                    //
+                    // The data checksum has already been checked, so the entries can be
+                    // stored as they are decoded
+                    //
+                    std::string key, str ;
+                    for(uint32_t i = 0 ; i < count && ok ; i++) {
+                        uint8_t type ;
+                        if (!getString(p, end, key) || !get(p, end, type)) {
+                            ok = false ;
+                            break ;
+                        }
+
+                        switch(static_cast<Setting::Type>(type)) {
+                        case Setting::Type::Boolean:
+                            {
+                                uint8_t b ;
+                                ok = get(p, end, b) ;
+                                table.set(key, Setting(b != 0)) ;
+                            }
+                            break ;
+                        case Setting::Type::Integer:
+                            {
+                                int32_t v ;
+                                ok = get(p, end, v) ;
+                                table.set(key, Setting(static_cast<int>(v))) ;
+                            }
+                            break ;
+                        case Setting::Type::Double:
+                            {
+                                double v ;
+                                ok = get(p, end, v) ;
+                                table.set(key, Setting(v)) ;
+                            }
+                            break ;
+                        case Setting::Type::String:
+                            ok = getString(p, end, str) ;
+                            table.set(key, Setting(str)) ;
+                            break ;
+                        default:
+                            ok = false ;
+                            break ;
+                        }
+                    }
+
+                    if (ok) {
+                        sources = names ;
+                        ret = true ;
+                    }
+                    else
+                        why = "cache file has a bad entry" ;
+                }
+            }
+
+            ::munmap(addr, size) ;
+            return ret ;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "SettingsTable.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <cstdint>
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief reads and writes a compiled, binary copy of a settings file
+        ///
+        /// The cache holds the values of a settings file after the if blocks have been
+        /// resolved, so loading it is a single pass over a memory mapped file with no text
+        /// parsing.  The cache records the names of the settings files it was built from and
+        /// a checksum of their contents and of the defines.  A cache is only used if the
+        /// checksum still matches, otherwise the settings files are parsed as text.
+        ///
+        /// All values are stored in the byte order of the machine that wrote the cache.
+        ///
+        /// - Header: uint32 magic, uint16 version, uint16 source count, uint32 source checksum,
+        ///   uint32 entry count, uint32 data size, uint32 data checksum
+        /// - Sources: for each source, a string holding the file name
+        /// - Data: for each entry, a string key, a one byte type, and a one byte bool, an int32,
+        ///   a double, or a string
+        ///
+        /// A string is a uint16 length followed by the characters.
+        class SettingsCache {
+        public:
+            /// \brief the bytes at the start of a cache file
+            static constexpr uint32_t Magic = 0x54455358 ;
+
+            /// \brief the version of the format
+            static constexpr uint16_t Version = 1 ;
+
+            /// \brief the size of the header
+            static constexpr size_t HeaderSize = 24 ;
+
+            /// \brief compute the checksum of a set of settings files and defines
+            /// \param sources the settings files
+            /// \param defines the defines used to read the files
+            /// \param checksum the checksum
+            /// \returns false if one of the files could not be read
+            static bool checksum(const std::vector<std::string> &sources, const std::list<std::string> &defines, uint32_t &checksum) ;
+
+            /// \brief write a cache file
+            /// \param filename the name of the cache file
+            /// \param table the values to store
+            /// \param sources the settings files the values were read from
+            /// \param defines the defines used to read the files
+            /// \returns true if the cache file was written
+            static bool write(const std::string &filename, const SettingsTable &table,
+                                const std::vector<std::string> &sources, const std::list<std::string> &defines) ;
+
+            /// \brief read a cache file if it matches its settings files and the defines
+            /// \param filename the name of the cache file
+            /// \param defines the defines that will be used to read the files
+            /// \param table the table to store the values in
+            /// \param sources the settings files the values were read from, if the cache was used
+            /// \param why the reason the cache was not used, if it was not
+            /// \returns true if the values were read from the cache
+            static bool read(const std::string &filename, const std::list<std::string> &defines,
+                                SettingsTable &table, std::vector<std::string> &sources, std::string &why) ;
+        } ;
+    }
+}
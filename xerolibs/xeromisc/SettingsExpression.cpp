@@ -0,0 +1,192 @@
+#include "SettingsExpression.h"
+#include <cctype>
+#include <cstdlib>
+#include <climits>
+
+namespace xero {
+    namespace misc {
+
+        SettingsExpression::SettingsExpression(const std::string &text, const SettingsTable &table) : text_(text), table_(table) {
+            pos_ = 0 ;
+        }
+
+        bool SettingsExpression::evaluate(const std::string &text, const SettingsTable &table, Setting &result, std::string &error) {
+            SettingsExpression expr(text, table) ;
+            Value v ;
+
+            if (!expr.parseExpr(v)) {
+                error = expr.error_ ;
+                return false ;
+            }
+
+            expr.skipSpace() ;
+            if (expr.pos_ != text.length()) {
+                error = "unexpected '" + text.substr(expr.pos_) + "'" ;
+                return false ;
+            }
+
+            if (v.integer_ && v.int_ >= INT_MIN && v.int_ <= INT_MAX)
+                result = Setting(static_cast<int>(v.int_)) ;
+            else
+                result = Setting(v.get()) ;
+
+            return true ;
+        }
+
+        bool SettingsExpression::fail(const std::string &msg) {
+            if (error_.length() == 0)
+                error_ = msg ;
+            return false ;
+        }
+
+        void SettingsExpression::skipSpace() {
+            while (pos_ < text_.length() && std::isspace(text_[pos_]))
+                pos_++ ;
+        }
+
+        bool SettingsExpression::parseExpr(Value &v) {
+            if (!parseTerm(v))
+                return false ;
+
+            while (true) {
+                skipSpace() ;
+                if (pos_ == text_.length() || (text_[pos_] != '+' && text_[pos_] != '-'))
+                    return true ;
+
+                char op = text_[pos_++] ;
+                Value rhs ;
+                if (!parseTerm(rhs))
+                    return false ;
+
+                if (v.integer_ && rhs.integer_) {
+                    v.int_ = (op == '+') ? v.int_ + rhs.int_ : v.int_ - rhs.int_ ;
+                }
+                else {
+                    v.double_ = (op == '+') ? v.get() + rhs.get() : v.get() - rhs.get() ;
+                    v.integer_ = false ;
+                }
+            }
+        }
+
+        bool SettingsExpression::parseTerm(Value &v) {
+            if (!parseUnary(v))
+                return false ;
+
+            while (true) {
+                skipSpace() ;
+                if (pos_ == text_.length() || (text_[pos_] != '*' && text_[pos_] != '/'))
+                    return true ;
+
+                char op = text_[pos_++] ;
+                Value rhs ;
+                if (!parseUnary(rhs))
+                    return false ;
+
+                if (op == '*') {
+                    if (v.integer_ && rhs.integer_) {
+                        v.int_ *= rhs.int_ ;
+                    }
+                    else {
+                        v.double_ = v.get() * rhs.get() ;
+                        v.integer_ = false ;
+                    }
+                }
+                else {
+                    if (rhs.get() == 0.0)
+                        return fail("division by zero") ;
+
+                    v.double_ = v.get() / rhs.get() ;
+                    v.integer_ = false ;
+                }
+            }
+        }
+
+        bool SettingsExpression::parseUnary(Value &v) {
+            skipSpace() ;
+            if (pos_ < text_.length() && (text_[pos_] == '-' || text_[pos_] == '+')) {
+                char op = text_[pos_++] ;
+                if (!parseUnary(v))
+                    return false ;
+
+                if (op == '-') {
+                    v.int_ = -v.int_ ;
+                    v.double_ = -v.double_ ;
+                }
+                return true ;
+            }
+
+            return parsePrimary(v) ;
+        }
+
+        bool SettingsExpression::parsePrimary(Value &v) {
+            skipSpace() ;
+            if (pos_ == text_.length())
+                return fail("missing value at end of expression") ;
+
+            char ch = text_[pos_] ;
+            if (ch == '(') {
+                pos_++ ;
+                if (!parseExpr(v))
+                    return false ;
+
+                skipSpace() ;
+                if (pos_ == text_.length() || text_[pos_] != ')')
+                    return fail("missing ')'") ;
+
+                pos_++ ;
+                return true ;
+            }
+
+            if (std::isdigit(ch) || ch == '.') {
+                const char *start = text_.c_str() + pos_ ;
+                char *end ;
+
+                v.int_ = 0 ;
+                v.double_ = std::strtod(start, &end) ;
+                size_t len = end - start ;
+                if (len == 0)
+                    return fail("bad number") ;
+
+                //
+                // A number without a fraction or exponent is an integer
+                //
+                std::string num = text_.substr(pos_, len) ;
+                v.integer_ = num.find_first_of(".eE") == std::string::npos ;
+                if (v.integer_)
+                    v.int_ = std::strtol(start, nullptr, 10) ;
+
+                pos_ += len ;
+                return true ;
+            }
+
+            if (std::isalpha(ch) || ch == '_') {
+                size_t start = pos_ ;
+                while (pos_ < text_.length() && (std::isalnum(text_[pos_]) || text_[pos_] == '_' || text_[pos_] == ':'))
+                    pos_++ ;
+
+                std::string key = text_.substr(start, pos_ - start) ;
+                const Setting *s = table_.find(key) ;
+                if (s == nullptr || !s->isValid())
+                    return fail("'" + key + "' is not defined") ;
+
+                if (s->isInteger()) {
+                    v.integer_ = true ;
+                    v.int_ = s->getInteger() ;
+                    v.double_ = 0.0 ;
+                }
+                else if (s->isDouble()) {
+                    v.integer_ = false ;
+                    v.int_ = 0 ;
+                    v.double_ = s->getDouble() ;
+                }
+                else {
+                    return fail("'" + key + "' is not a number") ;
+                }
+
+                return true ;
+            }
+
+            return fail(std::string("unexpected '") + ch + "'") ;
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "SettingsTable.h"
+#include <string>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief evaluates arithmetic expressions in a settings file
+        ///
+        /// An expression is made of numbers, the names of other settings, the operators
+        /// + - * / and parentheses, for instance 'lifter:maxa * 0.8'.  The settings named
+        /// must already have integer or double values.  The result is an integer if every
+        /// value is an integer and there is no division, otherwise it is a double.
+        class SettingsExpression {
+        public:
+            /// \brief evaluate an expression
+            /// \param text the expression
+            /// \param table the settings that the expression can refer to
+            /// \param result the value of the expression
+            /// \param error a description of the problem if the expression is not valid
+            /// \returns true if the expression was evaluated
+            static bool evaluate(const std::string &text, const SettingsTable &table, Setting &result, std::string &error) ;
+
+        private:
+            struct Value {
+                bool integer_ ;
+                long int_ ;
+                double double_ ;
+
+                double get() const {
+                    return integer_ ? static_cast<double>(int_) : double_ ;
+                }
+            } ;
+
+            SettingsExpression(const std::string &text, const SettingsTable &table) ;
+
+            void skipSpace() ;
+            bool parseExpr(Value &v) ;
+            bool parseTerm(Value &v) ;
+            bool parseUnary(Value &v) ;
+            bool parsePrimary(Value &v) ;
+            bool fail(const std::string &msg) ;
+
+        private:
+            const std::string &text_ ;
+            const SettingsTable &table_ ;
+            size_t pos_ ;
+            std::string error_ ;
+        } ;
+    }
+}
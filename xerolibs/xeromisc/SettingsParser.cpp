@@ -1,7 +1,13 @@
 #include "SettingsParser.h"
+#include "SettingsCache.h"
+#include "SettingsExpression.h"
 #include <sstream>
 #include <fstream>
 #include <cctype>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 
 namespace xero {
 namespace misc {
@@ -10,15 +16,15 @@ const std::string SettingsParser::var_prefix_("var:") ;
 
 SettingsParser::SettingsParser(MessageLogger &logger, uint64_t msggroup) : logger_(logger) {
     msggroup_ = msggroup;
-    skipping_ = false ;
+    include_depth_ = 0 ;
+    has_pending_ = false ;
 }
 
 SettingsParser::~SettingsParser() {
-    settings_.clear();
 }
 
 bool SettingsParser::processKeyPair(const std::string &line, std::string &key, std::string &value, bool &is_string, const std::string& filename, int line_num) {
-    std::stringstream buffer;
+    std::string buffer;
     bool in_string = false;
 
     for(unsigned i = 0; i < line.length(); i++) {
@@ -58,16 +64,16 @@ bool SettingsParser::processKeyPair(const std::string &line, std::string &key, s
         // Check for separating space if not in a string
         } else if(!in_string && std::isspace(line[i])) {
             if(key.length() == 0) {
-                key = buffer.str();
-                buffer.str("");
+                key = buffer;
+                buffer.clear();
                 continue;
             } else if (value.length() == 0) {
-                value = buffer.str();
+                value = buffer;
             }
 
         // If the character is none of these, add it to the buffer
         } else {
-            buffer.put(line[i]);
+            buffer.push_back(line[i]);
         }
     }
 
@@ -96,7 +102,7 @@ bool SettingsParser::processKeyPair(const std::string &line, std::string &key, s
     }
 
     // Make the value what was found up to the end of the line
-    value = buffer.str();
+    value = buffer;
 
     // If there was nothing between the key and the end of the line, the line is invalid
     if(value.length() == 0) {
@@ -115,70 +121,358 @@ bool SettingsParser::readFile(const std::string &filename) {
         return false;
     }
 
+    sources_.push_back(filename) ;
+    return readStream(file, filename) ;
+}
+
+bool SettingsParser::readCachedFile(const std::string &filename, const std::string &cachefile) {
+    std::string why ;
+    std::vector<std::string> sources ;
+
+    if (SettingsCache::read(cachefile, defines_, settings_, sources, why)) {
+        //
+        // The cache names every file its values came from, so they are all watched
+        //
+        for(const std::string &source : sources) {
+            if (std::find(sources_.begin(), sources_.end(), source) == sources_.end())
+                sources_.push_back(source);
+        }
+
+        logger_.startMessage(MessageLogger::MessageType::info, msggroup_) ;
+        logger_ << "Settings: read " << settings_.size() << " values from cache '" << cachefile << "'" ;
+        logger_.endMessage() ;
+        return true ;
+    }
+
+    logger_.startMessage(MessageLogger::MessageType::info, msggroup_) ;
+    logger_ << "Settings: cache '" << cachefile << "' not used, " << why ;
+    logger_.endMessage() ;
+
+    if (!readFile(filename))
+        return false ;
+
+    if (!SettingsCache::write(cachefile, settings_, sources_, defines_)) {
+        logger_.startMessage(MessageLogger::MessageType::warning, msggroup_) ;
+        logger_ << "Settings: could not write cache '" << cachefile << "'" ;
+        logger_.endMessage() ;
+    }
+
+    return true ;
+}
+
+bool SettingsParser::readStream(std::istream &file, const std::string &filename) {
     int line_num = 0;
+    bool ret = true ;
 
     bool bool_output;
     int int_output;
     double double_output;
     std::string string_output;
 
-    logger_.startMessage(MessageLogger::MessageType::debug, msggroup_);
-    logger_ << "Settings: defines" ;
-    for(const std::string &define : defines_)
-        logger_ << " '" << define << "'" ;
-    logger_.endMessage();    
+    if (include_depth_ == 0) {
+        logger_.startMessage(MessageLogger::MessageType::debug, msggroup_);
+        logger_ << "Settings: defines" ;
+        for(const std::string &define : defines_)
+            logger_ << " '" << define << "'" ;
+        logger_.endMessage();
+    }
+
+    //
+    // The if blocks that enclose the current line, innermost last
+    //
+    std::vector<Condition> conds ;
 
-    std::string line;
+    std::string line, directive, arg;
     while(std::getline(file, line)) {
         std::string key, value;
         bool is_string = false;
 
         line_num++;
 
-        if (line.length() >= 3 && line.substr(0, 3) == "if ")
-            processIf(filename, line_num, line) ;
-        else if (line.length() >= 5 && line.substr(0, 5) == "endif") {
-            skipping_ = false ;
+        bool active = conds.size() == 0 || conds.back().active_ ;
+
+        splitDirective(line, directive, arg) ;
+        if (directive == "if") {
+            Condition cond ;
+            cond.parent_active_ = active ;
+            cond.active_ = active && evalCondition(filename, line_num, arg) ;
+            cond.taken_ = cond.active_ ;
+            cond.seen_else_ = false ;
+            cond.line_ = line_num ;
+            conds.push_back(cond) ;
+        }
+        else if (directive == "elif") {
+            if (conds.size() == 0 || conds.back().seen_else_) {
+                warning(filename, line_num, "'elif' without a matching 'if'") ;
+                continue ;
+            }
+
+            Condition &cond = conds.back() ;
+            cond.active_ = cond.parent_active_ && !cond.taken_ && evalCondition(filename, line_num, arg) ;
+            cond.taken_ = cond.taken_ || cond.active_ ;
         }
-        else if (!skipping_) {
-            if(processKeyPair(line, key, value, is_string, filename, line_num) && key.length() > 0 && value.length() > 0) {
-                if(parseBoolean(value, bool_output))
-                    set(key, bool_output);
-                else if(parseInteger(value, int_output))
-                    set(key, int_output);
-                else if(parseDouble(value, double_output))
-                    set(key, double_output);
-                else if(is_string && parseString(value, string_output))
-                    set(key, string_output);
-                else {
-                    logger_.startMessage(MessageLogger::MessageType::warning, msggroup_);
-                    logger_ << filename << ": " << line_num << ": Unable to parse value '" << value << "'";
-                    logger_.endMessage();
-                }
+        else if (directive == "else") {
+            if (conds.size() == 0 || conds.back().seen_else_) {
+                warning(filename, line_num, "'else' without a matching 'if'") ;
+                continue ;
+            }
+
+            Condition &cond = conds.back() ;
+            cond.active_ = cond.parent_active_ && !cond.taken_ ;
+            cond.taken_ = true ;
+            cond.seen_else_ = true ;
+        }
+        else if (directive == "endif") {
+            if (conds.size() == 0)
+                warning(filename, line_num, "'endif' without a matching 'if'") ;
+            else
+                conds.pop_back() ;
+        }
+        else if (!active) {
+            continue ;
+        }
+        else if (directive == "include") {
+            if (!processInclude(filename, line_num, arg))
+                ret = false ;
+        }
+        else if (isExpression(line)) {
+            processExpression(filename, line_num, line) ;
+        }
+        else if(processKeyPair(line, key, value, is_string, filename, line_num) && key.length() > 0 && value.length() > 0) {
+            if(parseBoolean(value, bool_output))
+                set(key, bool_output);
+            else if(parseInteger(value, int_output))
+                set(key, int_output);
+            else if(parseDouble(value, double_output))
+                set(key, double_output);
+            else if(is_string && parseString(value, string_output))
+                set(key, string_output);
+            else {
+                logger_.startMessage(MessageLogger::MessageType::warning, msggroup_);
+                logger_ << filename << ": " << line_num << ": Unable to parse value '" << value << "'";
+                logger_.endMessage();
             }
         }
     }
-    return true;
+
+    for(const Condition &cond : conds)
+        warning(filename, cond.line_, "'if' without a matching 'endif'") ;
+
+    return ret ;
 }
 
-void SettingsParser::processIf(const std::string &filename, int line_num, const std::string &line) {
-    std::string keyword ;
-    size_t index = 2 ;
+void SettingsParser::warning(const std::string &filename, int line_num, const std::string &msg) {
+    logger_.startMessage(MessageLogger::MessageType::warning, msggroup_);
+    logger_ << filename << ": " << line_num << ": " << msg ;
+    logger_.endMessage();
+}
+
+void SettingsParser::splitDirective(const std::string &line, std::string &directive, std::string &arg) {
+    size_t index = 0 ;
+
+    directive.clear() ;
+    arg.clear() ;
 
     while (index < line.length() && std::isspace(line[index]))
         index++ ;
 
-    if (index == line.length()) {
-        logger_.startMessage(MessageLogger::MessageType::error);
-        logger_ << filename << ": " << line_num << ": missing token after 'if' keyword" ;
-        logger_.endMessage();        
+    while (index < line.length() && std::isalpha(line[index]))
+        directive += line[index++] ;
+
+    if (index < line.length() && !std::isspace(line[index]) && line[index] != '#') {
+        //
+        // The first word is part of a key, not a directive
+        //
+        directive.clear() ;
+        return ;
     }
 
-    while (index < line.length() && !std::isspace(line[index]))
-        keyword += line[index++] ;
+    while (index < line.length() && std::isspace(line[index]))
+        index++ ;
+
+    while (index < line.length() && line[index] != '#')
+        arg += line[index++] ;
 
-    if (std::find(defines_.begin(), defines_.end(), keyword) == defines_.end())
-        skipping_ = true ;
+    while (arg.length() > 0 && std::isspace(arg.back()))
+        arg.pop_back() ;
+}
+
+bool SettingsParser::evalCondition(const std::string &filename, int line_num, const std::string &arg) {
+    bool negate = false ;
+    size_t index = 0 ;
+
+    if (index < arg.length() && arg[index] == '!') {
+        negate = true ;
+        index++ ;
+        while (index < arg.length() && std::isspace(arg[index]))
+            index++ ;
+    }
+
+    if (index == arg.length()) {
+        warning(filename, line_num, "missing define name in condition") ;
+        return false ;
+    }
+
+    std::string name = arg.substr(index) ;
+    bool defined = std::find(defines_.begin(), defines_.end(), name) != defines_.end() ;
+    return defined != negate ;
+}
+
+bool SettingsParser::processInclude(const std::string &filename, int line_num, const std::string &arg) {
+    std::string name = arg ;
+
+    if (name.length() >= 2 && name.front() == '"' && name.back() == '"')
+        name = name.substr(1, name.length() - 2) ;
+
+    if (name.length() == 0) {
+        warning(filename, line_num, "missing file name after 'include'") ;
+        return false ;
+    }
+
+    if (include_depth_ >= MaxIncludeDepth) {
+        warning(filename, line_num, "includes nested too deeply, is a file including itself?") ;
+        return false ;
+    }
+
+    //
+    // A relative name is relative to the directory of the file doing the including
+    //
+    if (name[0] != '/') {
+        size_t slash = filename.find_last_of('/') ;
+        if (slash != std::string::npos)
+            name = filename.substr(0, slash + 1) + name ;
+    }
+
+    include_depth_++ ;
+    bool ret = readFile(name) ;
+    include_depth_-- ;
+
+    if (!ret)
+        warning(filename, line_num, "cannot read included file '" + name + "'") ;
+
+    return ret ;
+}
+
+bool SettingsParser::isExpression(const std::string &line) {
+    size_t index = 0 ;
+
+    while (index < line.length() && std::isspace(line[index]))
+        index++ ;
+
+    if (index == line.length() || line[index] == '#')
+        return false ;
+
+    while (index < line.length() && !std::isspace(line[index]) && line[index] != '=' && line[index] != '"')
+        index++ ;
+
+    while (index < line.length() && std::isspace(line[index]))
+        index++ ;
+
+    return index < line.length() && line[index] == '=' ;
+}
+
+void SettingsParser::processExpression(const std::string &filename, int line_num, const std::string &line) {
+    size_t eq = line.find('=') ;
+    size_t hash = line.find('#', eq) ;
+
+    std::string key = line.substr(0, eq) ;
+    while (key.length() > 0 && std::isspace(key.back()))
+        key.pop_back() ;
+    key.erase(0, key.find_first_not_of(" \t")) ;
+
+    std::string expr = line.substr(eq + 1, hash == std::string::npos ? std::string::npos : hash - eq - 1) ;
+    while (expr.length() > 0 && std::isspace(expr.back()))
+        expr.pop_back() ;
+
+    if (key.length() == 0) {
+        warning(filename, line_num, "expression without a key") ;
+        return ;
+    }
+
+    Setting result ;
+    std::string error ;
+    if (!SettingsExpression::evaluate(expr, settings_, result, error)) {
+        warning(filename, line_num, "cannot evaluate '" + expr + "' for '" + key + "', " + error) ;
+        return ;
+    }
+
+    if (result.isInteger())
+        set(key, result.getInteger()) ;
+    else
+        set(key, result.getDouble()) ;
+}
+
+void SettingsParser::addChangeListener(const std::string &key, ChangeListener listener) {
+    listeners_.push_back(Listener{ settings_.insert(key), listener }) ;
+}
+
+void SettingsParser::addChangeListener(ChangeListener listener) {
+    listeners_.push_back(Listener{ nullptr, listener }) ;
+}
+
+void SettingsParser::publish(std::shared_ptr<const SettingsTable> table, const std::string &origin, const std::string &errors) {
+    std::lock_guard<std::mutex> lock(pending_lock_) ;
+    pending_.push_back(Pending{ table, origin, errors }) ;
+    has_pending_ = true ;
+}
+
+size_t SettingsParser::applyPending() {
+    //
+    // This is called every robot loop, so check the flag before taking the lock
+    //
+    if (!has_pending_)
+        return 0 ;
+
+    std::list<Pending> pending ;
+    {
+        std::lock_guard<std::mutex> lock(pending_lock_) ;
+        pending.swap(pending_) ;
+        has_pending_ = false ;
+    }
+
+    size_t total = 0 ;
+    for(const Pending &p : pending) {
+        size_t changed = 0 ;
+        const SettingsTable &table = *p.table_ ;
+
+        if (p.errors_.length() > 0) {
+            logger_.startMessage(MessageLogger::MessageType::warning, msggroup_) ;
+            logger_ << "Settings: " << p.origin_ << ": " << p.errors_ ;
+            logger_.endMessage() ;
+        }
+
+        for(size_t i = 0 ; i < table.getEntryCount() ; i++) {
+            const Setting &value = table.getValue(i) ;
+            if (!value.isValid())
+                continue ;
+
+            const std::string &key = table.getKey(i) ;
+            const Setting *current = settings_.find(key) ;
+            if (current != nullptr && *current == value)
+                continue ;
+
+            settings_.set(key, value) ;
+            changed++ ;
+
+            logger_.startMessage(MessageLogger::MessageType::info, msggroup_) ;
+            logger_ << "Settings: " << p.origin_ << ": '" << key << "' changed" ;
+            logger_.endMessage() ;
+
+            const Setting *s = settings_.find(key) ;
+            for(const Listener &listener : listeners_) {
+                if (listener.setting_ == nullptr || listener.setting_ == s)
+                    listener.func_(key, *s) ;
+            }
+        }
+
+        logger_.startMessage(MessageLogger::MessageType::info, msggroup_) ;
+        logger_ << "Settings: applied " << p.origin_ << ", " << changed << " values changed" ;
+        logger_.endMessage() ;
+
+        total += changed ;
+    }
+
+    return total ;
 }
 
 bool SettingsParser::parseBoolean(const std::string &value, bool &result) {
@@ -193,47 +487,52 @@ bool SettingsParser::parseBoolean(const std::string &value, bool &result) {
     return false;
 }
 
+//
+// These use strtol and strtod rather than stoi and stod, which throw an exception for
+// every value that is not a number.  That made reading a settings file slow.
+//
 bool SettingsParser::parseInteger(const std::string &value, int &result) {
-    size_t output;
-
-    try {
-        if (value[0] == '0' && (value[1] == 'X' || value[1] == 'x')) {
-            //
-            // This is a hex value
-            //
-            std::string sub = value.substr(2) ;
-            result = std::stoi(sub, &output, 16) ;
-            if (output != sub.length())
-                return false ;
-        }
-        else {
-            result = std::stoi(value, &output);
-
-            // Check for extra characters in value
-            if(output != value.length())
-                return false;
-        }
+    const char *start = value.c_str() ;
+    int base = 10 ;
+    char *end ;
 
-    } catch(...) {
-        return false;
+    if (value[0] == '0' && (value[1] == 'X' || value[1] == 'x')) {
+        //
+        // This is a hex value
+        //
+        start += 2 ;
+        base = 16 ;
     }
 
+    if (*start == '\0' || std::isspace(*start))
+        return false ;
+
+    errno = 0 ;
+    long v = std::strtol(start, &end, base) ;
+
+    // Check for extra characters in value
+    if (*end != '\0' || errno == ERANGE || v < INT_MIN || v > INT_MAX)
+        return false ;
+
+    result = static_cast<int>(v) ;
     return true;
 }
 
 bool SettingsParser::parseDouble(const std::string &value, double &result) {
-    size_t output;
+    const char *start = value.c_str() ;
+    char *end ;
 
-    try {
-        result = std::stod(value, &output);
+    if (*start == '\0' || std::isspace(*start))
+        return false ;
 
-        // Check for extra characters in value
-        if(output != value.length())
-            return false;
-    } catch(...) {
-        return false;
-    }
+    errno = 0 ;
+    double v = std::strtod(start, &end) ;
 
+    // Check for extra characters in value
+    if (*end != '\0' || errno == ERANGE)
+        return false ;
+
+    result = v ;
     return true;
 }
 
@@ -247,7 +546,8 @@ bool SettingsParser::parseString(const std::string &value, std::string &result)
 }
 
 bool SettingsParser::isDefined(const std::string &key) const {
-    return settings_.find(key) != settings_.end();
+    const Setting *s = settings_.find(key) ;
+    return s != nullptr && s->isValid() ;
 }
 
 bool SettingsParser::isDefinedOnGet(const std::string &key, const std::string &type) const {
@@ -262,51 +562,55 @@ bool SettingsParser::isDefinedOnGet(const std::string &key, const std::string &t
 }
 
 Setting &SettingsParser::get(const std::string &key) {
-    auto it = settings_.find(key) ;
-    assert(it != settings_.end()) ;
+    Setting *s = settings_.find(key) ;
+    assert(s != nullptr && s->isValid()) ;
+
+    return *s ;
+}
 
-    return it->second ; 
+bool SettingsParser::isVariable(const std::string &key) {
+    return key.length() > var_prefix_.length() && key.compare(0, var_prefix_.length(), var_prefix_) == 0 ;
 }
 
 void SettingsParser::set(const std::string &key, bool value) {
-    if (key.length() > var_prefix_.length() && key.substr(0, var_prefix_.length()) == var_prefix_) {
+    if (isVariable(key)) {
         logger_.startMessage(MessageLogger::MessageType::debug, msggroup_) ;
         logger_ << "Variable '" << key << "' set to value " ;
         logger_ << (value ? "true" : "false") ;
         logger_.endMessage() ;
     }
 
-    settings_[key] = Setting(value);
+    settings_.set(key, Setting(value));
 }
 
 void SettingsParser::set(const std::string &key, int value) {
-    if (key.length() > var_prefix_.length() && key.substr(0, var_prefix_.length()) == var_prefix_) {
+    if (isVariable(key)) {
         logger_.startMessage(MessageLogger::MessageType::debug, msggroup_) ;
         logger_ << "Variable '" << key << "' set to value " ;
         logger_ << value ;
         logger_.endMessage() ;
     }   
-    settings_[key] = Setting(value);
+    settings_.set(key, Setting(value));
 }
 
 void SettingsParser::set(const std::string &key, double value) {
-    if (key.length() > var_prefix_.length() && key.substr(0, var_prefix_.length()) == var_prefix_) {
+    if (isVariable(key)) {
         logger_.startMessage(MessageLogger::MessageType::debug, msggroup_) ;
         logger_ << "Variable '" << key << "' set to value " ;
         logger_ << value ;
         logger_.endMessage() ;
     }       
-    settings_[key] = Setting(value);
+    settings_.set(key, Setting(value));
 }
 
 void SettingsParser::set(const std::string &key, const std::string &value) {
-    if (key.length() > var_prefix_.length() && key.substr(0, var_prefix_.length()) == var_prefix_) {
+    if (isVariable(key)) {
         logger_.startMessage(MessageLogger::MessageType::debug, msggroup_) ;
         logger_ << "Variable '" << key << "' set to value " ;
         logger_ << value ;
         logger_.endMessage() ;
     }   
-    settings_[key] = Setting(value);
+    settings_.set(key, Setting(value));
 }
 
 bool SettingsParser::getBoolean(const std::string &key) const {
@@ -346,11 +650,11 @@ const Setting &SettingsParser::getSetting(const std::string &key, const std::str
         std::cerr << "missing parameter: " << key << std::endl ;
         assert(0) ;
     }
-    return settings_.find(key)->second;
+    return *settings_.find(key);
 }
 
 const Setting &SettingsParser::getSetting(const std::string &key, const Setting &default_value, const std::string &type) const {
-    return isDefinedOnGet(key, type) ? settings_.find(key)->second : default_value;
+    return isDefinedOnGet(key, type) ? *settings_.find(key) : default_value;
 }
 
 } // namespace misc
@@ -1,7 +1,15 @@
 #pragma once
 
-#include <map>
+#include <list>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <istream>
 #include "Setting.h"
+#include "SettingRef.h"
+#include "SettingsTable.h"
 #include "MessageLogger.h"
 
 
@@ -34,10 +42,75 @@ namespace xero {
             /// followed by a value.  A '#' character indicates a comment and all characters including and
             /// following the '#' character are ignored.  The values can be boolean, integer, double, or string.
             /// Strings are delimited with double quotes.
+            ///
+            /// A line of the form 'name = expression' sets the name to the value of an arithmetic
+            /// expression.  The expression can use numbers, the names of integer or double values
+            /// defined earlier, the operators + - * / and parentheses (see SettingsExpression).
+            /// The expression is evaluated once when the file is read.
+            ///
+            /// The following directives are also supported, and can be indented
+            /// - 'include file' reads another file, relative to the directory of this file
+            /// - 'if NAME' or 'if !NAME' reads the following lines only if NAME is (or is not) defined
+            /// - 'elif NAME', 'else', and 'endif' continue or end an if block
+            ///
+            /// If blocks can be nested.
             /// \param filename the name of the file to read
             /// \returns true if the file was read successfully, false is an error occurred
             bool readFile(const std::string &filename);
 
+            /// \brief read a file of values, using a compiled cache of the file when it is current
+            ///
+            /// If the cache was built from the same file contents and defines, the values are
+            /// loaded from the cache.  Otherwise the file is read with readFile() and the cache
+            /// is written again.  See SettingsCache.
+            /// \param filename the name of the file to read
+            /// \param cachefile the name of the cache file
+            /// \returns true if the values were read, false is an error occurred
+            bool readCachedFile(const std::string &filename, const std::string &cachefile) ;
+
+            /// \brief return the settings files read so far
+            /// \returns the settings files read so far
+            const std::vector<std::string> &getSources() const {
+                return sources_ ;
+            }
+
+            /// \brief read values from a stream, using the same format as readFile()
+            /// \param strm the stream to read
+            /// \param name the name of the stream for error messages
+            /// \returns true if the stream was read, false if an error occurred
+            bool readStream(std::istream &strm, const std::string &name) ;
+
+            /// \brief the function called when a value changes
+            /// The arguments are the key and the new value.
+            typedef std::function<void(const std::string &, const Setting &)> ChangeListener ;
+
+            /// \brief call a function when the value of the given key is changed by applyPending()
+            /// \param key the key to watch
+            /// \param listener the function to call
+            void addChangeListener(const std::string &key, ChangeListener listener) ;
+
+            /// \brief call a function when any value is changed by applyPending()
+            /// \param listener the function to call
+            void addChangeListener(ChangeListener listener) ;
+
+            /// \brief hand a new set of values to the parser, may be called from any thread
+            ///
+            /// The table must not be changed after it is published.  The values are not
+            /// visible until the thread that owns the parser calls applyPending().
+            /// \param table the new values
+            /// \param origin where the values came from, for the log
+            /// \param errors any errors found reading the values, logged when they are applied
+            void publish(std::shared_ptr<const SettingsTable> table, const std::string &origin, const std::string &errors = "") ;
+
+            /// \brief store the values from any published tables
+            ///
+            /// This is called by the thread that owns the parser between robot loops, so
+            /// everything that runs in a loop sees the same values.  Keys that are not in a
+            /// published table keep their current values.  The change listeners are called
+            /// for each key whose value changed.
+            /// \returns the number of values that changed
+            size_t applyPending() ;
+
             /// \brief this method returns true if a value with the given name is present
             /// \param key the name of the value of interest
             /// \returns true if a value with the given name is found
@@ -54,6 +127,26 @@ namespace xero {
             /// \returns the setting object
             Setting &get(const std::string &key) ;
 
+            /// \brief return a typed handle to the value with the given name
+            ///
+            /// The handle is resolved once and then reads the value without a lookup, so it
+            /// should be obtained when an object is created and kept.  If no value with the
+            /// given name is defined an error is logged, but the handle is still returned and
+            /// sees the value if it is set later.
+            /// \param key the name of the value of interest
+            /// \returns a handle to the value
+            template <typename T>
+            SettingRef<T> getRef(const std::string &key) {
+                isDefinedOnGet(key, "handle") ;
+                return SettingRef<T>(settings_.insert(key)) ;
+            }
+
+            /// \brief return the table that holds the values
+            /// \returns the table that holds the values
+            const SettingsTable &getTable() const {
+                return settings_ ;
+            }
+
             /// \brief associate the given key with the given boolean value
             /// \param key the name to associate with the value
             /// \param value the boolean value to be associated
@@ -122,14 +215,20 @@ namespace xero {
             const Setting &getSetting(const std::string &key, const std::string &type) const;
             const Setting &getSetting(const std::string &key, const Setting &default_value, const std::string &type) const;
 
+            static bool isVariable(const std::string &key) ;
+
             bool parseBoolean(const std::string &value, bool &result);
             bool parseInteger(const std::string &value, int &result);
             bool parseDouble(const std::string &value, double &result);
             bool parseString(const std::string &value, std::string &result);
 
             bool processKeyPair(const std::string &line, std::string &key, std::string &value, bool &is_string, const std::string &filename, int line_num);
-            void processIf(const std::string &filename, int line_num, const std::string &line) ;
-            void processEndif(const std::string &line) ;
+            void warning(const std::string &filename, int line_num, const std::string &msg) ;
+            static void splitDirective(const std::string &line, std::string &directive, std::string &arg) ;
+            bool evalCondition(const std::string &filename, int line_num, const std::string &arg) ;
+            bool processInclude(const std::string &filename, int line_num, const std::string &arg) ;
+            static bool isExpression(const std::string &line) ;
+            void processExpression(const std::string &filename, int line_num, const std::string &line) ;
 
         private:
             static const std::string var_prefix_ ;
@@ -137,10 +236,38 @@ namespace xero {
             MessageLogger &logger_;
             uint64_t msggroup_;
             
-            std::map<std::string, Setting> settings_;
+            SettingsTable settings_;
             std::list<std::string> defines_ ;
+            std::vector<std::string> sources_ ;
+
+            struct Listener {
+                const Setting *setting_ ;
+                ChangeListener func_ ;
+            } ;
+            std::list<Listener> listeners_ ;
+
+            struct Pending {
+                std::shared_ptr<const SettingsTable> table_ ;
+                std::string origin_ ;
+                std::string errors_ ;
+            } ;
+            std::mutex pending_lock_ ;
+            std::list<Pending> pending_ ;
+            std::atomic<bool> has_pending_ ;
+
+            //
+            // An if block being read, see readStream()
+            //
+            struct Condition {
+                bool parent_active_ ;       // lines outside the block are being read
+                bool active_ ;              // lines in the current branch are being read
+                bool taken_ ;               // a branch of the block has been read
+                bool seen_else_ ;           // the else branch has been seen
+                int line_ ;                 // the line of the 'if'
+            } ;
 
-            bool skipping_ ;
+            static constexpr int MaxIncludeDepth = 8 ;
+            int include_depth_ ;
         };
     }
 }
@@ -0,0 +1,91 @@
+#include "SettingsTable.h"
+
+namespace xero {
+    namespace misc {
+
+        constexpr uint32_t SettingsTable::Empty ;
+
+        SettingsTable::SettingsTable(size_t capacity) {
+            size_t actual = 16 ;
+            while (actual < capacity * 2)
+                actual <<= 1 ;
+
+            index_.resize(actual, Empty) ;
+            mask_ = actual - 1 ;
+            defined_ = 0 ;
+        }
+
+        size_t SettingsTable::findSlot(const std::string &key, uint32_t h) const {
+            size_t slot = h & mask_ ;
+
+            while (index_[slot] != Empty) {
+                const Entry &entry = entries_[index_[slot]] ;
+                if (entry.hash_ == h && entry.key_ == key)
+                    break ;
+
+                slot = (slot + 1) & mask_ ;
+            }
+
+            return slot ;
+        }
+
+        const Setting *SettingsTable::find(const std::string &key) const {
+            size_t slot = findSlot(key, hash(key.c_str(), key.length())) ;
+            if (index_[slot] == Empty)
+                return nullptr ;
+
+            return &entries_[index_[slot]].value_ ;
+        }
+
+        Setting *SettingsTable::insert(const std::string &key) {
+            uint32_t h = hash(key.c_str(), key.length()) ;
+            size_t slot = findSlot(key, h) ;
+
+            if (index_[slot] != Empty)
+                return &entries_[index_[slot]].value_ ;
+
+            if ((entries_.size() + 1) * 2 > index_.size()) {
+                grow() ;
+                slot = findSlot(key, h) ;
+            }
+
+            index_[slot] = static_cast<uint32_t>(entries_.size()) ;
+            entries_.push_back(Entry{key, h, Setting()}) ;
+            return &entries_.back().value_ ;
+        }
+
+        void SettingsTable::set(const std::string &key, const Setting &value) {
+            Setting *s = insert(key) ;
+
+            if (!s->isValid() && value.isValid())
+                defined_++ ;
+            else if (s->isValid() && !value.isValid())
+                defined_-- ;
+
+            *s = value ;
+        }
+
+        void SettingsTable::clear() {
+            for(Entry &entry : entries_)
+                entry.value_ = Setting() ;
+
+            defined_ = 0 ;
+        }
+
+        void SettingsTable::grow() {
+            //
+            // The entries do not move, only the index is rebuilt using the stored hashes
+            //
+            index_.assign(index_.size() * 2, Empty) ;
+            mask_ = index_.size() - 1 ;
+
+            for(size_t i = 0 ; i < entries_.size() ; i++) {
+                size_t slot = entries_[i].hash_ & mask_ ;
+                while (index_[slot] != Empty)
+                    slot = (slot + 1) & mask_ ;
+
+                index_[slot] = static_cast<uint32_t>(i) ;
+            }
+        }
+    }
+}
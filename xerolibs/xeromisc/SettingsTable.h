@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Setting.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief a flat, open addressed hash table of settings
+        ///
+        /// Each key is stored once in an entry along with its hash and its value.  The entries
+        /// live in a deque and are never removed, so the address of a value stays the same for
+        /// the life of the table and can be handed out as a handle.  The hash index is a power
+        /// of two sized array of entry numbers searched with linear probing, and is rebuilt
+        /// from the stored hashes when it gets half full.
+        class SettingsTable {
+        public:
+            /// \brief create a new table
+            /// \param capacity the number of keys expected, the table grows past this if needed
+            SettingsTable(size_t capacity = 256) ;
+
+            /// \brief return the hash of a key
+            /// \param key the key
+            /// \param len the length of the key
+            /// \returns the 32 bit FNV-1a hash of the key
+            static uint32_t hash(const char *key, size_t len) {
+                uint32_t h = 2166136261u ;
+                for(size_t i = 0 ; i < len ; i++) {
+                    h ^= static_cast<uint8_t>(key[i]) ;
+                    h *= 16777619u ;
+                }
+                return h ;
+            }
+
+            /// \brief find the value for a key
+            /// \param key the key to find
+            /// \returns the value for the key, or nullptr if the key has never been added.  The
+            /// value may be invalid if the key was added but has not been given a value.
+            const Setting *find(const std::string &key) const ;
+
+            /// \brief find the value for a key
+            /// \param key the key to find
+            /// \returns the value for the key, or nullptr if the key has never been added
+            Setting *find(const std::string &key) {
+                return const_cast<Setting *>(static_cast<const SettingsTable *>(this)->find(key)) ;
+            }
+
+            /// \brief find the value for a key, adding the key with an invalid value if it is missing
+            /// \param key the key to find
+            /// \returns the value for the key, the address is stable for the life of the table
+            Setting *insert(const std::string &key) ;
+
+            /// \brief return the number of keys that have a valid value
+            /// \returns the number of keys that have a valid value
+            size_t size() const {
+                return defined_ ;
+            }
+
+            /// \brief return the number of entries, including keys without a value
+            /// \returns the number of entries
+            size_t getEntryCount() const {
+                return entries_.size() ;
+            }
+
+            /// \brief return the key of an entry
+            /// \param index the index of the entry, from zero to getEntryCount() - 1
+            /// \returns the key of the entry
+            const std::string &getKey(size_t index) const {
+                return entries_[index].key_ ;
+            }
+
+            /// \brief return the value of an entry
+            /// \param index the index of the entry, from zero to getEntryCount() - 1
+            /// \returns the value of the entry
+            const Setting &getValue(size_t index) const {
+                return entries_[index].value_ ;
+            }
+
+            /// \brief store a value for a key
+            /// \param key the key
+            /// \param value the value to store
+            void set(const std::string &key, const Setting &value) ;
+
+            /// \brief remove the values of all keys
+            /// The keys stay in the table so that existing handles remain valid, they just see
+            /// invalid values until the keys are set again.
+            void clear() ;
+
+        private:
+            struct Entry {
+                std::string key_ ;
+                uint32_t hash_ ;
+                Setting value_ ;
+            } ;
+
+            static constexpr uint32_t Empty = 0xffffffff ;
+
+        private:
+            size_t findSlot(const std::string &key, uint32_t h) const ;
+            void grow() ;
+
+        private:
+            std::deque<Entry> entries_ ;
+            std::vector<uint32_t> index_ ;
+            size_t mask_ ;
+            size_t defined_ ;
+        } ;
+    }
+}
@@ -0,0 +1,216 @@
+#include "SettingsWatcher.h"
+#include "MessageDestStream.h"
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cstring>
+#include <cctype>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+namespace xero {
+    namespace misc {
+
+        constexpr int SettingsWatcher::SettleTime ;
+        constexpr int SettingsWatcher::PollTime ;
+
+        SettingsWatcher::SettingsWatcher(SettingsParser &parser, const std::string &filename) : parser_(parser) {
+            filename_ = filename ;
+            defines_ = parser.getDefines() ;
+
+            size_t index = filename.find_last_of('/') ;
+            if (index == std::string::npos) {
+                dir_ = "." ;
+                names_.insert(filename) ;
+            }
+            else {
+                dir_ = filename.substr(0, index) ;
+                names_.insert(filename.substr(index + 1)) ;
+            }
+
+            notify_fd_ = -1 ;
+            socket_ = -1 ;
+            running_ = false ;
+            updates_ = 0 ;
+        }
+
+        SettingsWatcher::~SettingsWatcher() {
+            stop() ;
+        }
+
+        bool SettingsWatcher::start(uint16_t port) {
+            if (running_)
+                return true ;
+
+            //
+            // Watch the directory rather than the file, editors and deploy tools often
+            // replace the file instead of writing it in place
+            //
+            notify_fd_ = inotify_init1(IN_NONBLOCK) ;
+            if (notify_fd_ != -1 && inotify_add_watch(notify_fd_, dir_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+                ::close(notify_fd_) ;
+                notify_fd_ = -1 ;
+            }
+
+            if (port != 0) {
+                socket_ = ::socket(AF_INET, SOCK_DGRAM, 0) ;
+                if (socket_ != -1) {
+                    struct sockaddr_in addr ;
+                    std::memset(&addr, 0, sizeof(addr)) ;
+                    addr.sin_family = AF_INET ;
+                    addr.sin_addr.s_addr = INADDR_ANY ;
+                    addr.sin_port = htons(port) ;
+                    if (::bind(socket_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) == -1) {
+                        ::close(socket_) ;
+                        socket_ = -1 ;
+                    }
+                }
+            }
+
+            if (notify_fd_ == -1 && socket_ == -1)
+                return false ;
+
+            running_ = true ;
+            thread_ = std::thread(&SettingsWatcher::watchThread, this) ;
+            return true ;
+        }
+
+        void SettingsWatcher::stop() {
+            if (running_) {
+                running_ = false ;
+                thread_.join() ;
+            }
+
+            if (notify_fd_ != -1) {
+                ::close(notify_fd_) ;
+                notify_fd_ = -1 ;
+            }
+
+            if (socket_ != -1) {
+                ::close(socket_) ;
+                socket_ = -1 ;
+            }
+        }
+
+        bool SettingsWatcher::parse(std::istream &strm, const std::string &origin) {
+            //
+            // The values are read with a parser of our own so nothing the robot is
+            // using is touched.  Its messages are collected and logged by the robot
+            // thread when the values are applied, since the logger is not thread safe.
+            //
+            std::stringstream errors ;
+            MessageLogger logger ;
+            logger.enableType(MessageLogger::MessageType::warning) ;
+            logger.enableType(MessageLogger::MessageType::error) ;
+            logger.addDestination(std::make_shared<MessageDestStream>(errors)) ;
+
+            SettingsParser parser(logger, 0) ;
+            for(const std::string &define : defines_)
+                parser.addDefine(define) ;
+
+            if (!parser.readStream(strm, origin))
+                return false ;
+
+            std::string text = errors.str() ;
+            while (text.length() > 0 && text.back() == '\n')
+                text.pop_back() ;
+
+            //
+            // Watch any included files that are in the same directory too
+            //
+            {
+                std::lock_guard<std::mutex> lock(names_lock_) ;
+                for(const std::string &source : parser.getSources()) {
+                    size_t index = source.find_last_of('/') ;
+                    std::string dir = (index == std::string::npos) ? "." : source.substr(0, index) ;
+                    if (dir == dir_)
+                        names_.insert(source.substr(index + 1)) ;
+                }
+            }
+
+            parser_.publish(std::make_shared<const SettingsTable>(parser.getTable()), origin, text) ;
+            updates_++ ;
+            return true ;
+        }
+
+        bool SettingsWatcher::reload() {
+            std::ifstream strm(filename_) ;
+            if (strm.bad() || strm.fail())
+                return false ;
+
+            return parse(strm, filename_) ;
+        }
+
+        bool SettingsWatcher::update(const std::string &text, const std::string &origin) {
+            std::istringstream strm(text) ;
+            return parse(strm, origin) ;
+        }
+
+        bool SettingsWatcher::fileChanged() {
+            alignas(struct inotify_event) char buffer[4096] ;
+            bool changed = false ;
+            ssize_t len ;
+
+            while ((len = ::read(notify_fd_, buffer, sizeof(buffer))) > 0) {
+                char *ptr = buffer ;
+                while (ptr < buffer + len) {
+                    const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(ptr) ;
+                    if (event->len > 0) {
+                        std::lock_guard<std::mutex> lock(names_lock_) ;
+                        if (names_.count(event->name) > 0)
+                            changed = true ;
+                    }
+                    ptr += sizeof(struct inotify_event) + event->len ;
+                }
+            }
+
+            return changed ;
+        }
+
+        void SettingsWatcher::readPackets() {
+            std::vector<char> buffer(8192) ;
+            ssize_t len ;
+
+            while ((len = ::recv(socket_, &buffer[0], buffer.size(), MSG_DONTWAIT)) > 0) {
+                std::string text(&buffer[0], len) ;
+                while (text.length() > 0 && std::isspace(text.back()))
+                    text.pop_back() ;
+
+                if (text == "reload")
+                    reload() ;
+                else
+                    update(text + "\n", "udp") ;
+            }
+        }
+
+        void SettingsWatcher::watchThread() {
+            while (running_) {
+                if (notify_fd_ != -1) {
+                    struct pollfd fd ;
+                    fd.fd = notify_fd_ ;
+                    fd.events = POLLIN ;
+                    fd.revents = 0 ;
+
+                    if (::poll(&fd, 1, PollTime) > 0 && fileChanged()) {
+                        //
+                        // Wait for the writer to finish before reading the file
+                        //
+                        while (::poll(&fd, 1, SettleTime) > 0)
+                            fileChanged() ;
+
+                        reload() ;
+                    }
+                }
+                else {
+                    ::usleep(PollTime * 1000) ;
+                }
+
+                if (socket_ != -1)
+                    readPackets() ;
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "SettingsParser.h"
+#include <string>
+#include <list>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief reloads settings while the robot code is running
+        ///
+        /// A background thread watches the settings file with inotify and re-reads it
+        /// whenever it is written or replaced.  Files it includes from the same directory are
+        /// watched as well.  If a UDP port is given the thread also
+        /// accepts packets holding either the word 'reload' or one or more lines in the
+        /// settings file format, such as 'lifter:maxv 40.0'.
+        ///
+        /// The new values are parsed on the background thread into a table that is never
+        /// changed after it is published to the parser.  The values become visible when the
+        /// robot loop calls SettingsParser::applyPending(), so the thread never touches the
+        /// values the robot is using.  Actions that read their settings in start() pick up the
+        /// new values the next time they run.
+        class SettingsWatcher {
+        public:
+            /// \brief create a watcher
+            /// The defines of the parser are copied so that if blocks are resolved the same way.
+            /// \param parser the parser to publish new values to
+            /// \param filename the settings file to watch
+            SettingsWatcher(SettingsParser &parser, const std::string &filename) ;
+
+            /// \brief stop the watcher thread and destroy the watcher
+            virtual ~SettingsWatcher() ;
+
+            /// \brief start the watcher thread
+            /// \param port the UDP port to listen on for updates, zero to only watch the file
+            /// \returns false if neither the file watch nor the UDP port could be set up
+            bool start(uint16_t port = 0) ;
+
+            /// \brief stop the watcher thread
+            void stop() ;
+
+            /// \brief returns true if the watcher thread is running
+            /// \returns true if the watcher thread is running
+            bool isRunning() const {
+                return running_ ;
+            }
+
+            /// \brief return the number of updates published
+            /// \returns the number of updates published
+            size_t getUpdateCount() const {
+                return updates_ ;
+            }
+
+            /// \brief read the settings file and publish its values
+            /// \returns true if the file was read
+            bool reload() ;
+
+            /// \brief parse text in the settings file format and publish its values
+            /// \param text the settings text
+            /// \param origin where the text came from, for the log
+            /// \returns true if the text was read
+            bool update(const std::string &text, const std::string &origin) ;
+
+        private:
+            bool parse(std::istream &strm, const std::string &origin) ;
+            void watchThread() ;
+            bool fileChanged() ;
+            void readPackets() ;
+
+        private:
+            //
+            // The time to wait for more file events before reading the file, editors
+            // often write a file in several steps
+            //
+            static constexpr int SettleTime = 100 ;
+
+            //
+            // How often the thread checks for UDP packets and the stop request
+            //
+            static constexpr int PollTime = 100 ;
+
+        private:
+            SettingsParser &parser_ ;
+            std::string filename_ ;
+            std::string dir_ ;
+
+            //
+            // The names of the settings file and the files it includes, in dir_
+            //
+            std::mutex names_lock_ ;
+            std::set<std::string> names_ ;
+            std::list<std::string> defines_ ;
+
+            int notify_fd_ ;
+            int socket_ ;
+
+            std::thread thread_ ;
+            std::atomic<bool> running_ ;
+            std::atomic<size_t> updates_ ;
+        } ;
+    }
+}
@@ -0,0 +1,104 @@
+#include "SocketWatcher.h"
+#include <cstdint>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+namespace xero {
+    namespace misc {
+
+        constexpr int SocketWatcher::MaxEvents ;
+
+        //
+        // The epoll data for the wake file descriptor, source ids are always smaller
+        //
+        static constexpr uint64_t WakeData = UINT64_MAX ;
+
+        SocketWatcher::SocketWatcher(EventQueue &queue) : queue_(queue) {
+            epoll_fd_ = -1 ;
+            wake_fd_ = -1 ;
+            running_ = false ;
+        }
+
+        SocketWatcher::~SocketWatcher() {
+            stop() ;
+        }
+
+        bool SocketWatcher::add(int fd, size_t id) {
+            std::lock_guard<std::mutex> lock(lock_) ;
+
+            if (epoll_fd_ == -1) {
+                epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC) ;
+                if (epoll_fd_ == -1)
+                    return false ;
+
+                wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) ;
+                if (wake_fd_ != -1) {
+                    struct epoll_event ev ;
+                    ev.events = EPOLLIN ;
+                    ev.data.u64 = WakeData ;
+                    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev) == -1) {
+                        ::close(wake_fd_) ;
+                        wake_fd_ = -1 ;
+                    }
+                }
+
+                if (wake_fd_ == -1) {
+                    ::close(epoll_fd_) ;
+                    epoll_fd_ = -1 ;
+                    return false ;
+                }
+            }
+
+            struct epoll_event ev ;
+            ev.events = EPOLLIN | EPOLLET ;
+            ev.data.u64 = id ;
+            if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == -1)
+                return false ;
+
+            if (!running_) {
+                running_ = true ;
+                thread_ = std::thread(&SocketWatcher::watchThread, this) ;
+            }
+
+            return true ;
+        }
+
+        void SocketWatcher::stop() {
+            if (running_) {
+                running_ = false ;
+
+                //
+                // Wake the thread, it checks running_ each time it wakes up
+                //
+                uint64_t one = 1 ;
+                while (::write(wake_fd_, &one, sizeof(one)) == -1 && errno == EINTR) ;
+                thread_.join() ;
+            }
+
+            std::lock_guard<std::mutex> lock(lock_) ;
+            if (wake_fd_ != -1) {
+                ::close(wake_fd_) ;
+                wake_fd_ = -1 ;
+            }
+
+            if (epoll_fd_ != -1) {
+                ::close(epoll_fd_) ;
+                epoll_fd_ = -1 ;
+            }
+        }
+
+        void SocketWatcher::watchThread() {
+            struct epoll_event events[MaxEvents] ;
+
+            while (running_) {
+                int count = ::epoll_wait(epoll_fd_, events, MaxEvents, -1) ;
+                for(int i = 0 ; i < count ; i++) {
+                    if (events[i].data.u64 != WakeData)
+                        queue_.post(static_cast<size_t>(events[i].data.u64)) ;
+                }
+            }
+        }
+    }
+}
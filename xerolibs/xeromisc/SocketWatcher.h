@@ -0,0 +1,68 @@
+#pragma once
+
+#include "EventQueue.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief posts an event when a socket has data to read
+        ///
+        /// A background thread waits on all of the watched sockets at once with epoll and posts
+        /// to the source of a socket in an EventQueue when data arrives.  The sockets are watched
+        /// for new data (edge triggered), so the owner of a socket must read until the socket
+        /// has no more data each time it sees an event, otherwise it is not told again until
+        /// more data arrives.  The sockets should be non-blocking.
+        class SocketWatcher {
+        public:
+            /// \brief create a watcher
+            /// \param queue the queue to post events to
+            SocketWatcher(EventQueue &queue) ;
+
+            /// \brief stop the watcher thread and destroy the watcher
+            virtual ~SocketWatcher() ;
+
+            /// \brief watch a socket, starting the watcher thread if needed
+            /// The socket must stay open until the watcher is destroyed.
+            /// \param fd the socket to watch
+            /// \param id the source in the event queue to post to when the socket has data
+            /// \returns false if the socket could not be watched
+            bool add(int fd, size_t id) ;
+
+            /// \brief stop the watcher thread
+            void stop() ;
+
+            /// \brief returns true if the watcher thread is running
+            /// \returns true if the watcher thread is running
+            bool isRunning() const {
+                return running_ ;
+            }
+
+        private:
+            void watchThread() ;
+
+        private:
+            //
+            // The most events taken from epoll at once
+            //
+            static constexpr int MaxEvents = 16 ;
+
+        private:
+            EventQueue &queue_ ;
+
+            std::mutex lock_ ;
+            int epoll_fd_ ;
+
+            //
+            // Written to wake the watcher thread when it is stopped
+            //
+            int wake_fd_ ;
+
+            std::thread thread_ ;
+            std::atomic<bool> running_ ;
+        } ;
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief a fixed size, lock free, single producer single consumer ring buffer
+        ///
+        /// Exactly one thread may add entries and exactly one other thread may remove them.
+        /// The slots are allocated once when the ring is created and entries are built in
+        /// place, so neither side allocates memory or takes a lock.  The producer calls
+        /// acquire() to get the next free slot, fills it in, and calls commit() to hand it
+        /// to the consumer.  The consumer calls front() to get the oldest entry and pop() when
+        /// it is done with it.
+        template <typename T>
+        class SpscRing {
+        public:
+            /// \brief create a new ring
+            /// \param size the number of entries, rounded up to a power of two
+            SpscRing(size_t size) {
+                size_t actual = 1 ;
+                while (actual < size)
+                    actual <<= 1 ;
+
+                slots_.resize(actual) ;
+                mask_ = actual - 1 ;
+                head_ = 0 ;
+                tail_ = 0 ;
+            }
+
+            /// \brief return the number of entries the ring can hold
+            /// \returns the number of entries the ring can hold
+            size_t capacity() const {
+                return slots_.size() ;
+            }
+
+            /// \brief return the number of entries currently in the ring
+            /// This is only a snapshot when the other thread is active.
+            /// \returns the number of entries currently in the ring
+            size_t size() const {
+                return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire) ;
+            }
+
+            /// \brief return true if the ring is empty
+            /// \returns true if the ring is empty
+            bool empty() const {
+                return size() == 0 ;
+            }
+
+            /// \brief return the next free slot (producer only)
+            /// \returns the next free slot, or nullptr if the ring is full
+            T *acquire() {
+                size_t tail = tail_.load(std::memory_order_relaxed) ;
+                if (tail - head_.load(std::memory_order_acquire) == slots_.size())
+                    return nullptr ;
+
+                return &slots_[tail & mask_] ;
+            }
+
+            /// \brief pass the slot returned by acquire() to the consumer (producer only)
+            void commit() {
+                tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release) ;
+            }
+
+            /// \brief copy an entry into the ring (producer only)
+            /// \param value the entry to add
+            /// \returns false if the ring is full
+            bool push(const T &value) {
+                T *slot = acquire() ;
+                if (slot == nullptr)
+                    return false ;
+
+                *slot = value ;
+                commit() ;
+                return true ;
+            }
+
+            /// \brief return the oldest entry in the ring (consumer only)
+            /// \returns the oldest entry in the ring, or nullptr if the ring is empty
+            T *front() {
+                size_t head = head_.load(std::memory_order_relaxed) ;
+                if (head == tail_.load(std::memory_order_acquire))
+                    return nullptr ;
+
+                return &slots_[head & mask_] ;
+            }
+
+            /// \brief release the entry returned by front() back to the producer (consumer only)
+            void pop() {
+                head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release) ;
+            }
+
+        private:
+            std::vector<T> slots_ ;
+            size_t mask_ ;
+
+            //
+            // The head and tail only ever increase, the slot index is the value masked
+            // by the size.  The padding keeps them on separate cache lines so the producer
+            // and the consumer do not fight over the same line.
+            //
+            char pad0_[64] ;
+            std::atomic<size_t> head_ ;
+            char pad1_[64] ;
+            std::atomic<size_t> tail_ ;
+        } ;
+    }
+}
@@ -14,7 +14,7 @@ namespace xero {
             threshold_ = threshold;
         }
 
-        void StallMonitor::initFromSettings(SettingsParser parser, std::string prefix) {
+        void StallMonitor::initFromSettings(SettingsParser &parser, std::string prefix) {
             samples_ = parser.getInteger(prefix + ":samples");
             threshold_ = parser.getDouble(prefix + ":threshold");
         }
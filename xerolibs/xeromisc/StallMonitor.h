@@ -29,7 +29,7 @@ namespace xero {
             /// Used settings: integer :samples, double :threshold
             /// \param parser the settings parser to read from
             /// \param prefix the prefix to use when reading stall monitor settings
-            void initFromSettings(SettingsParser parser, std::string prefix);
+            void initFromSettings(SettingsParser &parser, std::string prefix);
 
             /// \brief Add a sample to the history
             /// \param sample the sample to add to the history
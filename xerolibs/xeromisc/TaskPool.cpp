@@ -0,0 +1,107 @@
+#include "TaskPool.h"
+
+namespace xero {
+    namespace misc {
+
+        TaskPool::TaskPool(size_t threads) {
+            task_ = nullptr ;
+            count_ = 0 ;
+            generation_ = 0 ;
+            batches_ = 0 ;
+            next_ = 0 ;
+            remaining_ = 0 ;
+            active_ = 0 ;
+            busy_ = false ;
+            stopping_ = false ;
+
+            for(size_t i = 0 ; i < threads ; i++)
+                threads_.push_back(std::thread(&TaskPool::workerThread, this)) ;
+        }
+
+        TaskPool::~TaskPool() {
+            {
+                std::lock_guard<std::mutex> lock(lock_) ;
+                stopping_ = true ;
+            }
+            start_.notify_all() ;
+
+            for(std::thread &th : threads_)
+                th.join() ;
+        }
+
+        void TaskPool::runPieces(Task &task, size_t count) {
+            size_t index ;
+
+            while ((index = next_.fetch_add(1)) < count) {
+                task.runTask(index) ;
+                remaining_.fetch_sub(1) ;
+            }
+        }
+
+        void TaskPool::run(Task &task, size_t count) {
+            bool expected = false ;
+
+            if (threads_.size() == 0 || count <= 1 || !busy_.compare_exchange_strong(expected, true)) {
+                for(size_t i = 0 ; i < count ; i++)
+                    task.runTask(i) ;
+                return ;
+            }
+
+            {
+                //
+                // A thread that woke up late for the last batch may still be looking at
+                // it, wait for it to notice the batch is over before replacing it
+                //
+                std::unique_lock<std::mutex> lock(lock_) ;
+                done_.wait(lock, [this] { return active_ == 0 ; }) ;
+
+                task_ = &task ;
+                count_ = count ;
+                next_ = 0 ;
+                remaining_ = count ;
+                generation_++ ;
+                batches_++ ;
+            }
+            start_.notify_all() ;
+
+            runPieces(task, count) ;
+
+            {
+                std::unique_lock<std::mutex> lock(lock_) ;
+                done_.wait(lock, [this] { return remaining_ == 0 && active_ == 0 ; }) ;
+                task_ = nullptr ;
+            }
+
+            busy_ = false ;
+        }
+
+        void TaskPool::workerThread() {
+            uint64_t seen = 0 ;
+
+            while (true) {
+                Task *task ;
+                size_t count ;
+
+                {
+                    std::unique_lock<std::mutex> lock(lock_) ;
+                    start_.wait(lock, [this, seen] { return stopping_ || (generation_ != seen && task_ != nullptr) ; }) ;
+                    if (stopping_)
+                        break ;
+
+                    seen = generation_ ;
+                    task = task_ ;
+                    count = count_ ;
+                    active_++ ;
+                }
+
+                runPieces(*task, count) ;
+
+                {
+                    std::lock_guard<std::mutex> lock(lock_) ;
+                    active_-- ;
+                }
+                done_.notify_all() ;
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief a fixed set of threads that run a batch of work and wait for it to finish
+        ///
+        /// The threads are created once, when the pool is created, and wait for work.  A call
+        /// to run() hands out the pieces of a batch by index to the pool threads and to the
+        /// calling thread, and returns once every piece has finished, so the caller can use
+        /// the results as soon as run() returns.  Running a batch does not allocate memory.
+        ///
+        /// The pieces of a batch may run in any order and on any thread.  A task that needs a
+        /// fixed order for its results should store them by index.  A batch started from
+        /// inside a piece of another batch, or while another thread is running a batch, runs
+        /// on the calling thread.
+        class TaskPool {
+        public:
+            /// \brief the work done by a batch
+            class Task {
+            public:
+                virtual ~Task() {
+                }
+
+                /// \brief run one piece of the batch
+                /// \param index the index of the piece, from zero to the count given to run()
+                virtual void runTask(size_t index) = 0 ;
+            } ;
+
+        public:
+            /// \brief create the pool
+            /// \param threads the number of threads to create, the calling thread also works
+            /// so a pool with one thread runs two pieces at once.  With no threads every
+            /// batch runs on the calling thread.
+            TaskPool(size_t threads) ;
+
+            /// \brief stop the threads and destroy the pool
+            virtual ~TaskPool() ;
+
+            /// \brief return the number of threads in the pool
+            /// \returns the number of threads in the pool
+            size_t getThreadCount() const {
+                return threads_.size() ;
+            }
+
+            /// \brief return the number of batches that were shared with the pool threads
+            /// \returns the number of batches that were shared with the pool threads
+            uint64_t getBatchCount() const {
+                return batches_ ;
+            }
+
+            /// \brief returns true while a batch is running
+            /// \returns true while a batch is running
+            bool isBusy() const {
+                return busy_ ;
+            }
+
+            /// \brief run a batch and wait for it to finish
+            /// \param task the task to run
+            /// \param count the number of pieces in the batch
+            void run(Task &task, size_t count) ;
+
+        private:
+            void workerThread() ;
+            void runPieces(Task &task, size_t count) ;
+
+        private:
+            std::vector<std::thread> threads_ ;
+
+            //
+            // Protects the batch description and the number of threads working on it
+            //
+            std::mutex lock_ ;
+            std::condition_variable start_ ;
+            std::condition_variable done_ ;
+
+            //
+            // The batch being run, and a number that changes with each batch so the
+            // threads can tell there is a new one
+            //
+            Task *task_ ;
+            size_t count_ ;
+            uint64_t generation_ ;
+            uint64_t batches_ ;
+
+            //
+            // The next piece to hand out, and the number of pieces not yet finished
+            //
+            std::atomic<size_t> next_ ;
+            std::atomic<size_t> remaining_ ;
+
+            //
+            // The number of pool threads working on the batch
+            //
+            size_t active_ ;
+
+            //
+            // True while a batch is running, a batch started while this is true runs inline
+            //
+            std::atomic<bool> busy_ ;
+
+            bool stopping_ ;
+        } ;
+    }
+}
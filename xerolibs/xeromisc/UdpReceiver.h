@@ -4,6 +4,7 @@
 #include <vector>
 #include <string.h>
 #include <fcntl.h>
+#include <sys/time.h>
 
 
 /// \file
@@ -71,6 +72,26 @@ namespace xero
                 blocking = set_blocking;
             }
 
+            /// \brief set the longest time a blocking read waits for data
+            /// \param seconds the time to wait, zero waits forever
+            /// \returns true if the timeout was set, otherwise false
+            bool setReceiveTimeout(double seconds)
+            {
+                struct timeval tv;
+                tv.tv_sec = static_cast<time_t>(seconds);
+                tv.tv_usec = static_cast<suseconds_t>((seconds - tv.tv_sec) * 1000000.0);
+                return setsockopt(getSocket(), SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0;
+            }
+
+            /// \brief set the size of the kernel buffer for received packets
+            /// A larger buffer keeps bursts of packets from being dropped when the reader is slow.
+            /// \param size the size of the buffer in bytes
+            /// \returns true if the size was set, otherwise false
+            bool setReceiveBufferSize(int size)
+            {
+                return setsockopt(getSocket(), SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) == 0;
+            }
+
             /// \brief receive a package of data from the socket
             /// \param data a vector to store the data, must be sized to the desired receive size
             /// \returns the number of bytes sent, or -1 if there is an error
@@ -94,7 +94,16 @@ namespace xero
             /// \returns true if the data is sent sucessfully, otherwise falsae
             bool send(const std::vector<uint8_t> &data, size_t start, size_t count)
             {
-                ssize_t ret = ::sendto(getSocket(), &data[start], count, 0, (struct sockaddr *)&m_saddr, sizeof(m_saddr));
+                return send(&data[start], count);
+            }
+
+            /// \brief send a block of data
+            /// \param data the data to send
+            /// \param count the number of bytes to send
+            /// \returns true if the data is sent sucessfully, otherwise false
+            bool send(const uint8_t *data, size_t count)
+            {
+                ssize_t ret = ::sendto(getSocket(), data, count, 0, (struct sockaddr *)&m_saddr, sizeof(m_saddr));
                 if (ret == -1 || static_cast<size_t>(ret) != count)
                 {
                     int err = errno;
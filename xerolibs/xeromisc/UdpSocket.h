@@ -41,6 +41,13 @@ namespace xero
                 return m_socket != -1;
             }
 
+            /// \brief return the file descriptor of the socket, for waiting on it with poll or epoll
+            /// \returns the file descriptor of the socket, or -1 if the socket is not open
+            int getDescriptor()
+            {
+                return m_socket;
+            }
+
         protected:
                 
             /// \brief get the underlying socket from the socket object
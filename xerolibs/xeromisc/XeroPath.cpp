@@ -0,0 +1,185 @@
+#include "XeroPath.h"
+#include "xeromath.h"
+#include <cmath>
+
+namespace xero {
+    namespace misc {
+
+        constexpr size_t XeroPath::SideCount ;
+        constexpr size_t XeroPath::ColumnCount ;
+        constexpr double XeroPath::DefaultTimeStep ;
+
+        XeroPath::XeroPath(const std::string &name, CSVData & left, CSVData & right, double dt) : name_(name) {
+            assert(left.size() == right.size()) ;
+
+            size_ = left.size() ;
+            dt_ = dt ;
+            data_.resize(SideCount * ColumnCount * size_) ;
+
+            for(size_t i = 0 ; i < size_ ; i++) {
+                setRow(Side::Left, i, XeroSegment(left.getRow(i))) ;
+                setRow(Side::Right, i, XeroSegment(right.getRow(i))) ;
+            }
+            computeCenter() ;
+        }
+
+        XeroPath::XeroPath(const std::string &name, std::vector<XeroSegment> &&left, std::vector<XeroSegment> &&right,
+                        double dt) : name_(name) {
+            assert(left.size() == right.size()) ;
+
+            size_ = left.size() ;
+            dt_ = dt ;
+            data_.resize(SideCount * ColumnCount * size_) ;
+
+            for(size_t i = 0 ; i < size_ ; i++) {
+                setRow(Side::Left, i, left[i]) ;
+                setRow(Side::Right, i, right[i]) ;
+            }
+            computeCenter() ;
+        }
+
+        XeroPath::XeroPath(const std::string &name, const double *left, const double *right, size_t count, double dt) : name_(name) {
+            size_ = count ;
+            dt_ = dt ;
+            data_.resize(SideCount * ColumnCount * size_) ;
+
+            //
+            // The columns are copied as they are, except that the heading is converted to degrees
+            //
+            const double *src[] = { left, right } ;
+            for(size_t side = 0 ; side < 2 ; side++) {
+                for(size_t col = 0 ; col < ColumnCount ; col++) {
+                    const double *from = src[side] + col * count ;
+                    double *to = column(static_cast<Side>(side), static_cast<Column>(col)) ;
+
+                    if (col == static_cast<size_t>(Column::Heading)) {
+                        for(size_t i = 0 ; i < count ; i++)
+                            to[i] = xero::math::normalizeAngleDegrees(from[i] / xero::math::PI * 180.0) ;
+                    }
+                    else {
+                        for(size_t i = 0 ; i < count ; i++)
+                            to[i] = from[i] ;
+                    }
+                }
+            }
+            computeCenter() ;
+        }
+
+        void XeroPath::setRow(Side side, size_t idx, const XeroSegment &seg) {
+            column(side, Column::X)[idx] = seg.getX() ;
+            column(side, Column::Y)[idx] = seg.getY() ;
+            column(side, Column::Position)[idx] = seg.getPOS() ;
+            column(side, Column::Velocity)[idx] = seg.getVelocity() ;
+            column(side, Column::Acceleration)[idx] = seg.getAccel() ;
+            column(side, Column::Jerk)[idx] = seg.getJerk() ;
+            column(side, Column::Heading)[idx] = seg.getHeading() ;
+        }
+
+        void XeroPath::computeCenter() {
+            for(size_t col = 0 ; col < ColumnCount ; col++) {
+                const double *l = getColumn(Side::Left, static_cast<Column>(col)) ;
+                const double *r = getColumn(Side::Right, static_cast<Column>(col)) ;
+                double *c = column(Side::Center, static_cast<Column>(col)) ;
+
+                //
+                // Both sides of a tank drive path have the same heading
+                //
+                if (col == static_cast<size_t>(Column::Heading)) {
+                    for(size_t i = 0 ; i < size_ ; i++)
+                        c[i] = l[i] ;
+                }
+                else {
+                    for(size_t i = 0 ; i < size_ ; i++)
+                        c[i] = (l[i] + r[i]) * 0.5 ;
+                }
+            }
+        }
+
+        XeroSegment XeroPath::getSegment(Side side, size_t idx) const {
+            assert(idx < size_) ;
+            return XeroSegment::fromDegrees(getColumn(side, Column::X)[idx], getColumn(side, Column::Y)[idx],
+                            getColumn(side, Column::Position)[idx], getColumn(side, Column::Velocity)[idx],
+                            getColumn(side, Column::Acceleration)[idx], getColumn(side, Column::Jerk)[idx],
+                            getColumn(side, Column::Heading)[idx]) ;
+        }
+
+        void XeroPath::locate(double t, size_t &index, double &frac) const {
+            //
+            // Find the row at or before the time, and how far the time is toward the next row
+            //
+            double u = t / dt_ ;
+            double last = static_cast<double>(size_ - 1) ;
+
+            if (!(u > 0.0))
+                u = 0.0 ;
+            else if (u > last)
+                u = last ;
+
+            double whole = std::floor(u) ;
+            index = static_cast<size_t>(whole) ;
+            frac = u - whole ;
+
+            if (index + 1 >= size_) {
+                index = size_ >= 2 ? size_ - 2 : 0 ;
+                frac = size_ >= 2 ? 1.0 : 0.0 ;
+            }
+        }
+
+        XeroPathSample XeroPath::sample(Side side, double t) const {
+            XeroPathSample s ;
+            sample(side, &t, 1, &s) ;
+            return s ;
+        }
+
+        void XeroPath::sample(Side side, const double *times, size_t n, XeroPathSample *out) const {
+            assert(size_ > 0) ;
+
+            const double *x = getColumn(side, Column::X) ;
+            const double *y = getColumn(side, Column::Y) ;
+            const double *pos = getColumn(side, Column::Position) ;
+            const double *vel = getColumn(side, Column::Velocity) ;
+            const double *accel = getColumn(side, Column::Acceleration) ;
+            const double *heading = getColumn(side, Column::Heading) ;
+            size_t next = size_ >= 2 ? 1 : 0 ;
+
+            for(size_t k = 0 ; k < n ; k++) {
+                size_t i ;
+                double f ;
+                locate(times[k], i, f) ;
+
+                XeroPathSample &s = out[k] ;
+                s.x_ = x[i] + (x[i + next] - x[i]) * f ;
+                s.y_ = y[i] + (y[i + next] - y[i]) * f ;
+                s.pos_ = pos[i] + (pos[i + next] - pos[i]) * f ;
+                s.vel_ = vel[i] + (vel[i + next] - vel[i]) * f ;
+                s.accel_ = accel[i] + (accel[i + next] - accel[i]) * f ;
+                s.heading_ = xero::math::normalizeAngleDegrees(heading[i] +
+                                    xero::math::normalizeAngleDegrees(heading[i + next] - heading[i]) * f) ;
+            }
+        }
+
+        void XeroPath::sampleColumn(Side side, Column col, const double *times, size_t n, double *out) const {
+            assert(size_ > 0) ;
+
+            const double *c = getColumn(side, col) ;
+            size_t next = size_ >= 2 ? 1 : 0 ;
+
+            if (col == Column::Heading) {
+                for(size_t k = 0 ; k < n ; k++) {
+                    size_t i ;
+                    double f ;
+                    locate(times[k], i, f) ;
+                    out[k] = xero::math::normalizeAngleDegrees(c[i] + xero::math::normalizeAngleDegrees(c[i + next] - c[i]) * f) ;
+                }
+            }
+            else {
+                for(size_t k = 0 ; k < n ; k++) {
+                    size_t i ;
+                    double f ;
+                    locate(times[k], i, f) ;
+                    out[k] = c[i] + (c[i + next] - c[i]) * f ;
+                }
+            }
+        }
+    }
+}
@@ -2,52 +2,164 @@
 
 #include "CSVData.h"
 #include "XeroSegment.h"
+#include <string>
+#include <vector>
+#include <cstdint>
 #include <cassert>
 
+/// \file
+
 namespace xero {
     namespace misc {
+        /// \brief the values of one side of a path at a point in time
+        struct XeroPathSample {
+            double x_ ;                 ///< the x position
+            double y_ ;                 ///< the y position
+            double pos_ ;               ///< the distance along the path
+            double vel_ ;               ///< the velocity
+            double accel_ ;             ///< the acceleration
+            double heading_ ;           ///< the heading in degrees
+        } ;
+
+        /// \brief a path for a tank drive robot
+        ///
+        /// The path is stored as columns, one contiguous array per value for each of the
+        /// left side, the right side, and the center of the robot, so a pass over one value
+        /// only touches that value's memory.  The rows are a fixed time step apart and the
+        /// path can be sampled at any time between the rows, see sample().
         class XeroPath {
         public:
-            XeroPath(const std::string &name, CSVData & left, CSVData & right) : name_(name) {
-                for (auto elem : left.getAllData()) {
-                    leftPath_.push_back(XeroSegment{elem});
-                }
-                for (auto elem : right.getAllData()) {
-                    rightPath_.push_back(XeroSegment{elem});
-                }
-            }
+            /// \brief a side of the robot
+            enum class Side : uint8_t {
+                Left = 0,               ///< the left wheels
+                Right = 1,              ///< the right wheels
+                Center = 2,             ///< the center of the robot, the average of the two sides
+            } ;
+
+            /// \brief a value stored for each row
+            enum class Column : uint8_t {
+                X = 0,                  ///< the x position
+                Y = 1,                  ///< the y position
+                Position = 2,           ///< the distance along the path
+                Velocity = 3,           ///< the velocity
+                Acceleration = 4,       ///< the acceleration
+                Jerk = 5,               ///< the jerk
+                Heading = 6,            ///< the heading in degrees, between -180 and 180
+            } ;
+
+            /// \brief the number of sides stored
+            static constexpr size_t SideCount = 3 ;
+
+            /// \brief the number of columns stored for each side
+            static constexpr size_t ColumnCount = 7 ;
+
+            /// \brief the time between rows of a PathWeaver path
+            static constexpr double DefaultTimeStep = 0.02 ;
+
+            XeroPath(const std::string &name, CSVData & left, CSVData & right, double dt = DefaultTimeStep) ;
+
+            XeroPath(const std::string &name, std::vector<XeroSegment> &&left, std::vector<XeroSegment> &&right,
+                        double dt = DefaultTimeStep) ;
+
+            /// \brief create a path from columns of values
+            /// Each side holds the columns in Column order, count values each, with the
+            /// heading in radians as PathWeaver writes it.
+            /// \param name the name of the path
+            /// \param left the columns for the left side
+            /// \param right the columns for the right side
+            /// \param count the number of rows
+            /// \param dt the time between rows
+            XeroPath(const std::string &name, const double *left, const double *right, size_t count, double dt) ;
 
             const std::string &getName() const {
                 return name_ ;
             }
 
             size_t size() const {
-                return leftPath_.size() ;
+                return size_ ;
             }
 
-            const XeroSegment &getLeftSegment(size_t idx) {
-                return leftPath_[idx];
+            /// \brief return the time between rows
+            /// \returns the time between rows
+            double getTimeStep() const {
+                return dt_ ;
             }
 
-            const XeroSegment &getRightSegment(size_t idx) {
-                return rightPath_[idx];
+            /// \brief return the time of the last row
+            /// \returns the time of the last row
+            double getDuration() const {
+                return size_ == 0 ? 0.0 : (size_ - 1) * dt_ ;
             }
 
+            /// \brief return the values of one column
+            /// \param side the side of the robot
+            /// \param col the column
+            /// \returns a pointer to size() values
+            const double *getColumn(Side side, Column col) const {
+                return &data_[(static_cast<size_t>(side) * ColumnCount + static_cast<size_t>(col)) * size_] ;
+            }
+
+            XeroSegment getLeftSegment(size_t idx) const {
+                return getSegment(Side::Left, idx) ;
+            }
+
+            XeroSegment getRightSegment(size_t idx) const {
+                return getSegment(Side::Right, idx) ;
+            }
+
+            XeroSegment getSegment(Side side, size_t idx) const ;
+
             double getLeftStartPos() const {
                 assert(size() > 0) ;
-                return leftPath_[0].getPOS() ;
+                return getColumn(Side::Left, Column::Position)[0] ;
             }
 
             double getRightStartPos() const {
                 assert(size() > 0) ;
-                return rightPath_[0].getPOS() ;
-            }        
+                return getColumn(Side::Right, Column::Position)[0] ;
+            }
+
+            /// \brief return the values of the path at a time
+            /// The values are interpolated between the rows on either side of the time, so
+            /// a follower that samples the path at the time it actually runs stays in step
+            /// with the path when a robot loop runs late.  Times outside the path return the
+            /// first or last row.
+            /// \param side the side of the robot
+            /// \param t the time from the start of the path
+            /// \returns the values of the path
+            XeroPathSample sample(Side side, double t) const ;
+
+            /// \brief return the values of the path at many times
+            /// \param side the side of the robot
+            /// \param times the times from the start of the path
+            /// \param n the number of times
+            /// \param out the values of the path at each time
+            void sample(Side side, const double *times, size_t n, XeroPathSample *out) const ;
+
+            /// \brief return one value of the path at many times
+            /// This is the fastest way to evaluate a path offline, the loop only reads the
+            /// one column.
+            /// \param side the side of the robot
+            /// \param col the column
+            /// \param times the times from the start of the path
+            /// \param n the number of times
+            /// \param out the value at each time
+            void sampleColumn(Side side, Column col, const double *times, size_t n, double *out) const ;
+
+        private:
+            double *column(Side side, Column col) {
+                return &data_[(static_cast<size_t>(side) * ColumnCount + static_cast<size_t>(col)) * size_] ;
+            }
+
+            void locate(double t, size_t &index, double &frac) const ;
+            void setRow(Side side, size_t idx, const XeroSegment &seg) ;
+            void computeCenter() ;
 
         private:
             std::string name_ ;
-            std::vector<XeroSegment> leftPath_;
-            std::vector<XeroSegment> rightPath_;
-        };     
+            size_t size_ ;
+            double dt_ ;
+            std::vector<double> data_ ;
+        };
     }
 }
-   
@@ -0,0 +1,233 @@
+#include "XeroPathFile.h"
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace xero {
+    namespace misc {
+
+        constexpr uint32_t XeroPathFile::Magic ;
+        constexpr uint16_t XeroPathFile::Version ;
+        constexpr size_t XeroPathFile::HeaderSize ;
+        constexpr size_t XeroPathFile::IndexEntrySize ;
+
+        namespace {
+            uint32_t hashBytes(const void *data, size_t len) {
+                const uint8_t *p = static_cast<const uint8_t *>(data) ;
+                uint32_t h = 2166136261u ;
+                for(size_t i = 0 ; i < len ; i++) {
+                    h ^= p[i] ;
+                    h *= 16777619u ;
+                }
+                return h ;
+            }
+
+            template <typename T>
+            void put(std::string &out, T value) {
+                out.append(reinterpret_cast<const char *>(&value), sizeof(value)) ;
+            }
+
+            void putColumns(std::string &out, const std::vector<XeroPathFile::Row> &rows) {
+                for(size_t col = 0 ; col < HEADER_COUNT ; col++) {
+                    for(const XeroPathFile::Row &row : rows)
+                        put(out, row[col]) ;
+                }
+            }
+
+            uint32_t getU32(const uint8_t *p) {
+                uint32_t value ;
+                std::memcpy(&value, p, sizeof(value)) ;
+                return value ;
+            }
+        }
+
+        bool XeroPathFile::write(const std::string &filename, const std::vector<PathData> &paths) {
+            std::string names ;
+            for(const PathData &path : paths) {
+                if (path.left_.size() != path.right_.size())
+                    return false ;
+                names += path.name_ ;
+            }
+
+            size_t offset = HeaderSize + paths.size() * IndexEntrySize + names.length() ;
+            offset = (offset + 7) & ~static_cast<size_t>(7) ;
+
+            std::string out, data ;
+            put(out, Magic) ;
+            put(out, Version) ;
+            put(out, static_cast<uint16_t>(HEADER_COUNT)) ;
+            put(out, static_cast<uint32_t>(paths.size())) ;
+            put(out, static_cast<uint32_t>(names.length())) ;
+
+            uint32_t nameoffset = 0 ;
+            for(const PathData &path : paths) {
+                std::string columns ;
+                putColumns(columns, path.left_) ;
+                putColumns(columns, path.right_) ;
+
+                put(out, nameoffset) ;
+                put(out, static_cast<uint32_t>(path.name_.length())) ;
+                put(out, static_cast<uint32_t>(path.left_.size())) ;
+                put(out, static_cast<uint32_t>(offset + data.size())) ;
+                put(out, hashBytes(columns.data(), columns.size())) ;
+                put(out, static_cast<uint32_t>(0)) ;
+                put(out, path.dt_) ;
+
+                nameoffset += static_cast<uint32_t>(path.name_.length()) ;
+                data += columns ;
+            }
+
+            out += names ;
+            out.append(offset - out.length(), '\0') ;
+            out += data ;
+
+            //
+            // Write to a temporary file and rename it so the robot never maps a partial file
+            //
+            std::string tmpname = filename + ".tmp" ;
+            {
+                std::ofstream strm(tmpname, std::ios::binary | std::ios::trunc) ;
+                if (strm.bad() || strm.fail())
+                    return false ;
+
+                strm.write(out.data(), out.size()) ;
+                if (!strm)
+                    return false ;
+            }
+
+            return std::rename(tmpname.c_str(), filename.c_str()) == 0 ;
+        }
+
+        XeroPathFile::XeroPathFile() {
+            addr_ = nullptr ;
+            size_ = 0 ;
+        }
+
+        XeroPathFile::~XeroPathFile() {
+            close() ;
+        }
+
+        void XeroPathFile::close() {
+            if (addr_ != nullptr) {
+                ::munmap(addr_, size_) ;
+                addr_ = nullptr ;
+                size_ = 0 ;
+            }
+            index_.clear() ;
+        }
+
+        bool XeroPathFile::open(const std::string &filename, std::string &why) {
+            close() ;
+
+            int fd = ::open(filename.c_str(), O_RDONLY) ;
+            if (fd == -1) {
+                why = "no path file" ;
+                return false ;
+            }
+
+            struct stat st ;
+            if (::fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < HeaderSize) {
+                ::close(fd) ;
+                why = "path file too short" ;
+                return false ;
+            }
+
+            size_t size = static_cast<size_t>(st.st_size) ;
+            void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) ;
+            ::close(fd) ;
+            if (addr == MAP_FAILED) {
+                why = "path file could not be mapped" ;
+                return false ;
+            }
+
+            const uint8_t *p = static_cast<const uint8_t *>(addr) ;
+            uint32_t magic = getU32(p) ;
+            uint16_t version, columns ;
+            std::memcpy(&version, p + 4, sizeof(version)) ;
+            std::memcpy(&columns, p + 6, sizeof(columns)) ;
+            uint32_t count = getU32(p + 8) ;
+            uint32_t namesize = getU32(p + 12) ;
+
+            if (magic != Magic || version != Version || columns != HEADER_COUNT) {
+                ::munmap(addr, size) ;
+                why = "path file has the wrong format" ;
+                return false ;
+            }
+
+            //
+            // The sizes in the file are checked in 64 bits, so a corrupt count cannot wrap
+            // around on the 32 bit roboRIO and pass the check
+            //
+            uint64_t names = HeaderSize + static_cast<uint64_t>(count) * IndexEntrySize ;
+            if (names + namesize > size) {
+                ::munmap(addr, size) ;
+                why = "path file is truncated" ;
+                return false ;
+            }
+
+            for(uint32_t i = 0 ; i < count ; i++) {
+                const uint8_t *entry = p + HeaderSize + i * IndexEntrySize ;
+                uint32_t nameoffset = getU32(entry) ;
+                uint32_t namelen = getU32(entry + 4) ;
+
+                Entry e ;
+                e.count_ = getU32(entry + 8) ;
+                e.offset_ = getU32(entry + 12) ;
+                e.checksum_ = getU32(entry + 16) ;
+                std::memcpy(&e.dt_, entry + 24, sizeof(e.dt_)) ;
+
+                uint64_t datasize = static_cast<uint64_t>(e.count_) * HEADER_COUNT * 2 * sizeof(double) ;
+                if (static_cast<uint64_t>(nameoffset) + namelen > namesize || e.offset_ % sizeof(double) != 0 ||
+                                        static_cast<uint64_t>(e.offset_) + datasize > size) {
+                    ::munmap(addr, size) ;
+                    index_.clear() ;
+                    why = "path file is truncated" ;
+                    return false ;
+                }
+
+                std::string name(reinterpret_cast<const char *>(p + names + nameoffset), namelen) ;
+                index_[name] = e ;
+            }
+
+            addr_ = addr ;
+            size_ = size ;
+            return true ;
+        }
+
+        std::vector<std::string> XeroPathFile::getPathNames() const {
+            std::vector<std::string> names ;
+            for(const auto &pair : index_)
+                names.push_back(pair.first) ;
+            return names ;
+        }
+
+        std::shared_ptr<XeroPath> XeroPathFile::readPath(const std::string &name) const {
+            auto it = index_.find(name) ;
+            if (it == index_.end())
+                return nullptr ;
+
+            const Entry &e = it->second ;
+            const uint8_t *start = static_cast<const uint8_t *>(addr_) + e.offset_ ;
+            size_t n = e.count_ ;
+
+            //
+            // The data is only checked when a path is used, so opening the file does not
+            // touch the pages of paths that are never driven
+            //
+            if (hashBytes(start, n * HEADER_COUNT * 2 * sizeof(double)) != e.checksum_)
+                return nullptr ;
+
+            //
+            // The offset is eight byte aligned and the columns are in the order XeroPath
+            // keeps them, so they are copied straight from the file
+            //
+            const double *left = reinterpret_cast<const double *>(start) ;
+            const double *right = left + n * HEADER_COUNT ;
+
+            return std::make_shared<XeroPath>(name, left, right, n, e.dt_) ;
+        }
+    }
+}
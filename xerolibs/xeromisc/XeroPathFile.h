@@ -0,0 +1,127 @@
+#pragma once
+
+#include "XeroPath.h"
+#include "XeroPathConsts.h"
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief reads and writes a file holding many compiled paths
+        ///
+        /// The file is built on a development machine from the PathWeaver CSV files (see
+        /// the xeropathc tool) and memory mapped by the robot.  Only the header and index are
+        /// read when the file is opened, the segments of a path are read when the path is
+        /// first used, so keeping every path variant on the robot costs no memory until
+        /// one is driven.
+        ///
+        /// All values are stored in the byte order of the machine that wrote the file.
+        ///
+        /// - Header: uint32 magic, uint16 version, uint16 column count, uint32 path count,
+        ///   uint32 size of the names
+        /// - Index: for each path, uint32 name offset, uint32 name length, uint32 segment count,
+        ///   uint32 data offset, uint32 data checksum, uint32 unused, double time step
+        /// - Names: the path names, with no separators
+        /// - Data: for each path, the left side and then the right side, each as columns of
+        ///   doubles (all the x values, then all the y values, and so on).  The data for each
+        ///   path starts on an eight byte boundary.
+        ///
+        /// The left and right sides are stored as the robot drives them, the swap of the
+        /// PathWeaver sides is done when the file is built.
+        class XeroPathFile {
+        public:
+            /// \brief the bytes at the start of a path file
+            static constexpr uint32_t Magic = 0x48545058 ;
+
+            /// \brief the version of the format
+            static constexpr uint16_t Version = 2 ;
+
+            /// \brief the size of the header
+            static constexpr size_t HeaderSize = 16 ;
+
+            /// \brief the size of an index entry
+            static constexpr size_t IndexEntrySize = 32 ;
+
+            /// \brief one row of a path, x, y, position, velocity, acceleration, jerk, and heading
+            typedef std::array<double, HEADER_COUNT> Row ;
+
+            /// \brief the segments of a path to write to a file
+            struct PathData {
+                /// \brief the name of the path
+                std::string name_ ;
+
+                /// \brief the time between rows
+                double dt_ ;
+
+                /// \brief the rows of the left side
+                std::vector<Row> left_ ;
+
+                /// \brief the rows of the right side
+                std::vector<Row> right_ ;
+            } ;
+
+            /// \brief write a path file
+            /// \param filename the name of the file
+            /// \param paths the paths to store
+            /// \returns true if the file was written
+            static bool write(const std::string &filename, const std::vector<PathData> &paths) ;
+
+            /// \brief create a path file reader, with no file open
+            XeroPathFile() ;
+
+            /// \brief unmap the file and destroy the reader
+            virtual ~XeroPathFile() ;
+
+            /// \brief map a path file and read its index
+            /// \param filename the name of the file
+            /// \param why the reason the file could not be used, if it could not
+            /// \returns true if the file was opened
+            bool open(const std::string &filename, std::string &why) ;
+
+            /// \brief unmap the file
+            void close() ;
+
+            /// \brief return true if a file is open
+            /// \returns true if a file is open
+            bool isOpen() const {
+                return addr_ != nullptr ;
+            }
+
+            /// \brief return the names of the paths in the file
+            /// \returns the names of the paths in the file
+            std::vector<std::string> getPathNames() const ;
+
+            /// \brief return true if the file holds the given path
+            /// \param name the name of the path
+            /// \returns true if the file holds the given path
+            bool hasPath(const std::string &name) const {
+                return index_.find(name) != index_.end() ;
+            }
+
+            /// \brief read a path from the file
+            /// \param name the name of the path
+            /// \returns the path, or nullptr if it is not in the file or its data is corrupt
+            std::shared_ptr<XeroPath> readPath(const std::string &name) const ;
+
+        private:
+            struct Entry {
+                uint32_t count_ ;
+                uint32_t offset_ ;
+                uint32_t checksum_ ;
+                double dt_ ;
+            } ;
+
+        private:
+            void *addr_ ;
+            size_t size_ ;
+            std::map<std::string, Entry> index_ ;
+        } ;
+    }
+}
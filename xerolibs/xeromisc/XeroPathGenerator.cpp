@@ -0,0 +1,286 @@
+#include "XeroPathGenerator.h"
+#include "xeromath.h"
+#include <cmath>
+#include <algorithm>
+
+namespace xero {
+    namespace misc {
+
+        constexpr size_t XeroPathGenerator::MaxCacheSize ;
+
+        namespace {
+            //
+            // The tangent at each waypoint is this times the distance to the next waypoint,
+            // which gives curves that neither cut corners nor overshoot
+            //
+            constexpr double TangentScale = 1.2 ;
+
+            //
+            // The fewest samples taken from one spline
+            //
+            constexpr int MinSplineSamples = 16 ;
+
+            //
+            // One spline between two waypoints, stored as polynomial coefficients in t
+            //
+            struct Spline {
+                double x_[6] ;
+                double y_[6] ;
+
+                static void coefficients(double p0, double d0, double p1, double d1, double *c) {
+                    //
+                    // The quintic Hermite basis with zero second derivative at both ends
+                    //
+                    c[0] = p0 ;
+                    c[1] = d0 ;
+                    c[2] = 0.0 ;
+                    c[3] = -10.0 * p0 - 6.0 * d0 - 4.0 * d1 + 10.0 * p1 ;
+                    c[4] = 15.0 * p0 + 8.0 * d0 + 7.0 * d1 - 15.0 * p1 ;
+                    c[5] = -6.0 * p0 - 3.0 * d0 - 3.0 * d1 + 6.0 * p1 ;
+                }
+
+                Spline(const XeroPathGenerator::Waypoint &a, const XeroPathGenerator::Waypoint &b) {
+                    double scale = TangentScale * std::hypot(b.x_ - a.x_, b.y_ - a.y_) ;
+                    double ha = a.heading_ / 180.0 * xero::math::PI ;
+                    double hb = b.heading_ / 180.0 * xero::math::PI ;
+
+                    coefficients(a.x_, scale * std::cos(ha), b.x_, scale * std::cos(hb), x_) ;
+                    coefficients(a.y_, scale * std::sin(ha), b.y_, scale * std::sin(hb), y_) ;
+                }
+
+                static void eval(const double *c, double t, double &p, double &d, double &dd) {
+                    p = ((((c[5] * t + c[4]) * t + c[3]) * t + c[2]) * t + c[1]) * t + c[0] ;
+                    d = (((5.0 * c[5] * t + 4.0 * c[4]) * t + 3.0 * c[3]) * t + 2.0 * c[2]) * t + c[1] ;
+                    dd = ((20.0 * c[5] * t + 12.0 * c[4]) * t + 6.0 * c[3]) * t + 2.0 * c[2] ;
+                }
+            } ;
+        }
+
+        XeroPathGenerator::XeroPathGenerator(double width, double dt) {
+            width_ = width ;
+            dt_ = dt ;
+
+            //
+            // The spacing of the spline samples is tied to the robot width so the generator
+            // works the same in any unit of length
+            //
+            step_ = width / 40.0 ;
+        }
+
+        XeroPathGenerator::~XeroPathGenerator() {
+        }
+
+        void XeroPathGenerator::sampleSplines(const std::vector<Waypoint> &points, std::vector<Sample> &samples) const {
+            for(size_t i = 0 ; i + 1 < points.size() ; i++) {
+                Spline spline(points[i], points[i + 1]) ;
+
+                double chord = std::hypot(points[i + 1].x_ - points[i].x_, points[i + 1].y_ - points[i].y_) ;
+                int count = std::max(MinSplineSamples, static_cast<int>(std::ceil(chord / step_))) ;
+
+                for(int j = (i == 0) ? 0 : 1 ; j <= count ; j++) {
+                    double t = static_cast<double>(j) / count ;
+                    double x, dx, ddx, y, dy, ddy ;
+                    Spline::eval(spline.x_, t, x, dx, ddx) ;
+                    Spline::eval(spline.y_, t, y, dy, ddy) ;
+
+                    Sample s ;
+                    s.x_ = x ;
+                    s.y_ = y ;
+                    s.heading_ = std::atan2(dy, dx) ;
+
+                    double speed2 = dx * dx + dy * dy ;
+                    s.curvature_ = (speed2 > 0.0) ? (dx * ddy - dy * ddx) / (speed2 * std::sqrt(speed2)) : 0.0 ;
+
+                    if (samples.size() == 0) {
+                        s.pos_ = 0.0 ;
+                        s.left_ = 0.0 ;
+                        s.right_ = 0.0 ;
+                    }
+                    else {
+                        const Sample &prev = samples.back() ;
+                        double ds = std::hypot(x - prev.x_, y - prev.y_) ;
+                        double dh = xero::math::normalizeAngleRadians(s.heading_ - prev.heading_) ;
+
+                        //
+                        // Keep the heading continuous so it can be interpolated.  The left side
+                        // is the outside of a counter clockwise turn, as in the PathWeaver paths.
+                        //
+                        s.heading_ = prev.heading_ + dh ;
+                        s.pos_ = prev.pos_ + ds ;
+                        s.left_ = prev.left_ + ds + dh * width_ / 2.0 ;
+                        s.right_ = prev.right_ + ds - dh * width_ / 2.0 ;
+                    }
+
+                    samples.push_back(s) ;
+                }
+            }
+        }
+
+        void XeroPathGenerator::limitVelocity(std::vector<Sample> &samples, const Constraints &limits) const {
+            //
+            // The fastest each sample can be passed given the curvature there
+            //
+            for(Sample &s : samples) {
+                double k = std::fabs(s.curvature_) ;
+                double v = limits.maxv_ / (1.0 + k * width_ / 2.0) ;
+                if (k > 0.0)
+                    v = std::min(v, std::sqrt(limits.maxcentripetal_ / k)) ;
+                s.vel_ = v ;
+            }
+
+            //
+            // The path starts and ends stopped, and the velocity can only change as fast as
+            // the acceleration allows in either direction
+            //
+            samples.front().vel_ = 0.0 ;
+            samples.back().vel_ = 0.0 ;
+
+            for(size_t i = 1 ; i < samples.size() ; i++) {
+                double ds = samples[i].pos_ - samples[i - 1].pos_ ;
+                double v = std::sqrt(samples[i - 1].vel_ * samples[i - 1].vel_ + 2.0 * limits.maxa_ * ds) ;
+                samples[i].vel_ = std::min(samples[i].vel_, v) ;
+            }
+
+            for(size_t i = samples.size() - 1 ; i > 0 ; i--) {
+                double ds = samples[i].pos_ - samples[i - 1].pos_ ;
+                double v = std::sqrt(samples[i].vel_ * samples[i].vel_ + 2.0 * limits.maxa_ * ds) ;
+                samples[i - 1].vel_ = std::min(samples[i - 1].vel_, v) ;
+            }
+
+            samples.front().time_ = 0.0 ;
+            for(size_t i = 1 ; i < samples.size() ; i++) {
+                double ds = samples[i].pos_ - samples[i - 1].pos_ ;
+                double vsum = samples[i - 1].vel_ + samples[i].vel_ ;
+                samples[i].time_ = samples[i - 1].time_ + ((vsum > 0.0) ? 2.0 * ds / vsum : 0.0) ;
+            }
+        }
+
+        std::shared_ptr<XeroPath> XeroPathGenerator::buildPath(const std::string &name, const std::vector<Sample> &samples) const {
+            double total = samples.back().time_ ;
+            size_t rows = static_cast<size_t>(std::ceil(total / dt_ - 1e-9)) + 1 ;
+
+            //
+            // The columns are in the order XeroPath expects, with the heading in radians
+            //
+            std::vector<double> left(rows * XeroPath::ColumnCount), right(rows * XeroPath::ColumnCount) ;
+            double *lx = &left[0], *ly = lx + rows, *lpos = ly + rows, *lvel = lpos + rows ;
+            double *laccel = lvel + rows, *ljerk = laccel + rows, *lhead = ljerk + rows ;
+            double *rx = &right[0], *ry = rx + rows, *rpos = ry + rows, *rvel = rpos + rows ;
+            double *raccel = rvel + rows, *rjerk = raccel + rows, *rhead = rjerk + rows ;
+
+            size_t i = 1 ;
+            for(size_t k = 0 ; k < rows ; k++) {
+                double t = std::min(k * dt_, total) ;
+                while (i < samples.size() - 1 && samples[i].time_ < t)
+                    i++ ;
+
+                const Sample &a = samples[i - 1] ;
+                const Sample &b = samples[i] ;
+                double ds = b.pos_ - a.pos_ ;
+
+                //
+                // The acceleration is constant between two samples
+                //
+                double accel = (ds > 0.0) ? (b.vel_ * b.vel_ - a.vel_ * a.vel_) / (2.0 * ds) : 0.0 ;
+                double tau = std::max(0.0, t - a.time_) ;
+                double vel = std::max(0.0, a.vel_ + accel * tau) ;
+                double pos = std::min(b.pos_, a.pos_ + a.vel_ * tau + 0.5 * accel * tau * tau) ;
+                double f = (ds > 0.0) ? (pos - a.pos_) / ds : 1.0 ;
+
+                if (k == rows - 1) {
+                    vel = 0.0 ;
+                    accel = 0.0 ;
+                    f = 1.0 ;
+                }
+
+                double x = a.x_ + (b.x_ - a.x_) * f ;
+                double y = a.y_ + (b.y_ - a.y_) * f ;
+                double heading = a.heading_ + (b.heading_ - a.heading_) * f ;
+                double k2 = (a.curvature_ + (b.curvature_ - a.curvature_) * f) * width_ / 2.0 ;
+                double ox = std::sin(heading) * width_ / 2.0 ;
+                double oy = -std::cos(heading) * width_ / 2.0 ;
+
+                lx[k] = x + ox ;
+                ly[k] = y + oy ;
+                lpos[k] = a.left_ + (b.left_ - a.left_) * f ;
+                lvel[k] = vel * (1.0 + k2) ;
+                laccel[k] = accel * (1.0 + k2) ;
+                lhead[k] = std::remainder(heading, 2.0 * xero::math::PI) ;
+
+                rx[k] = x - ox ;
+                ry[k] = y - oy ;
+                rpos[k] = a.right_ + (b.right_ - a.right_) * f ;
+                rvel[k] = vel * (1.0 - k2) ;
+                raccel[k] = accel * (1.0 - k2) ;
+                rhead[k] = lhead[k] ;
+
+                ljerk[k] = (k == 0) ? 0.0 : (laccel[k] - laccel[k - 1]) / dt_ ;
+                rjerk[k] = (k == 0) ? 0.0 : (raccel[k] - raccel[k - 1]) / dt_ ;
+            }
+
+            return std::make_shared<XeroPath>(name, &left[0], &right[0], rows, dt_) ;
+        }
+
+        std::shared_ptr<XeroPath> XeroPathGenerator::generate(const std::string &name, const std::vector<Waypoint> &points, const Constraints &limits) const {
+            if (points.size() < 2 || limits.maxv_ <= 0.0 || limits.maxa_ <= 0.0 || limits.maxcentripetal_ <= 0.0)
+                return nullptr ;
+
+            std::vector<Sample> samples ;
+            sampleSplines(points, samples) ;
+            if (samples.back().pos_ <= 0.0)
+                return nullptr ;
+
+            limitVelocity(samples, limits) ;
+            return buildPath(name, samples) ;
+        }
+
+        std::shared_ptr<XeroPath> XeroPathGenerator::getPath(const std::string &name, const std::vector<Waypoint> &points, const Constraints &limits) {
+            CacheKey key ;
+            key.first = name ;
+            key.second = { limits.maxv_, limits.maxa_, limits.maxcentripetal_ } ;
+            for(const Waypoint &pt : points) {
+                key.second.push_back(pt.x_) ;
+                key.second.push_back(pt.y_) ;
+                key.second.push_back(pt.heading_) ;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(cache_lock_) ;
+                auto it = cache_.find(key) ;
+                if (it != cache_.end())
+                    return it->second ;
+            }
+
+            //
+            // The lock is not held while generating, so another thread may generate the same
+            // path at the same time.  That only costs time, both results are the same.
+            //
+            std::shared_ptr<XeroPath> path = generate(name, points, limits) ;
+            if (path == nullptr)
+                return nullptr ;
+
+            std::lock_guard<std::mutex> lock(cache_lock_) ;
+            if (cache_.find(key) == cache_.end()) {
+                if (cache_order_.size() == MaxCacheSize) {
+                    cache_.erase(cache_order_.front()) ;
+                    cache_order_.pop_front() ;
+                }
+                cache_[key] = path ;
+                cache_order_.push_back(key) ;
+            }
+
+            return path ;
+        }
+
+        size_t XeroPathGenerator::getCacheSize() {
+            std::lock_guard<std::mutex> lock(cache_lock_) ;
+            return cache_.size() ;
+        }
+
+        void XeroPathGenerator::clearCache() {
+            std::lock_guard<std::mutex> lock(cache_lock_) ;
+            cache_.clear() ;
+            cache_order_.clear() ;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "XeroPath.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <list>
+#include <memory>
+#include <mutex>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief generates tank drive paths from waypoints while the robot is running
+        ///
+        /// Each pair of waypoints is joined by a quintic Hermite spline whose end tangents
+        /// follow the waypoint headings.  The splines are sampled at a small fixed spacing,
+        /// each sample is limited to the maximum velocity, to the velocity that keeps the
+        /// outside wheel under the maximum velocity, and to the velocity that keeps the
+        /// centripetal acceleration under its limit.  A forward and a backward pass then limit
+        /// the acceleration and deceleration, and the result is sampled every time step to
+        /// give the rows of the path.
+        ///
+        /// The left and right sides follow the same convention as the paths read from
+        /// PathWeaver files, so generated paths can be driven by the same follower.
+        ///
+        /// Generated paths are kept in a cache keyed by the name, the waypoints and the
+        /// constraints, so an auto mode that asks for the same path again does not pay to
+        /// build it again.  The name is part of the key because it is stored in the path.
+        class XeroPathGenerator {
+        public:
+            /// \brief a point the path must pass through
+            struct Waypoint {
+                double x_ ;             ///< the x position
+                double y_ ;             ///< the y position
+                double heading_ ;       ///< the heading of the robot at the point in degrees
+            } ;
+
+            /// \brief the limits the path must stay within
+            struct Constraints {
+                double maxv_ ;              ///< the maximum velocity of either wheel
+                double maxa_ ;              ///< the maximum acceleration and deceleration
+                double maxcentripetal_ ;    ///< the maximum centripetal acceleration
+            } ;
+
+            /// \brief the number of paths kept in the cache
+            static constexpr size_t MaxCacheSize = 16 ;
+
+            /// \brief create a path generator
+            /// \param width the effective track width of the robot
+            /// \param dt the time between rows of the generated paths
+            XeroPathGenerator(double width, double dt = XeroPath::DefaultTimeStep) ;
+
+            /// \brief destroy the path generator
+            virtual ~XeroPathGenerator() ;
+
+            /// \brief generate a path, or return it from the cache if it was generated before
+            /// This may be called from any thread.
+            /// \param name the name of the path, used only if the path is generated
+            /// \param points the waypoints, at least two
+            /// \param limits the limits for the path
+            /// \returns the path, or nullptr if the waypoints or limits are not valid
+            std::shared_ptr<XeroPath> getPath(const std::string &name, const std::vector<Waypoint> &points, const Constraints &limits) ;
+
+            /// \brief generate a path without using the cache
+            /// \param name the name of the path
+            /// \param points the waypoints, at least two
+            /// \param limits the limits for the path
+            /// \returns the path, or nullptr if the waypoints or limits are not valid
+            std::shared_ptr<XeroPath> generate(const std::string &name, const std::vector<Waypoint> &points, const Constraints &limits) const ;
+
+            /// \brief return the number of paths in the cache
+            /// \returns the number of paths in the cache
+            size_t getCacheSize() ;
+
+            /// \brief remove all paths from the cache
+            void clearCache() ;
+
+        private:
+            //
+            // A point sampled from the splines
+            //
+            struct Sample {
+                double x_ ;
+                double y_ ;
+                double heading_ ;       // radians, unwrapped so it changes smoothly
+                double curvature_ ;
+                double pos_ ;           // distance along the center
+                double left_ ;          // distance along the left side
+                double right_ ;         // distance along the right side
+                double vel_ ;           // velocity of the center
+                double time_ ;          // time the center reaches the sample
+            } ;
+
+            void sampleSplines(const std::vector<Waypoint> &points, std::vector<Sample> &samples) const ;
+            void limitVelocity(std::vector<Sample> &samples, const Constraints &limits) const ;
+            std::shared_ptr<XeroPath> buildPath(const std::string &name, const std::vector<Sample> &samples) const ;
+
+        private:
+            double width_ ;
+            double dt_ ;
+            double step_ ;
+
+            std::mutex cache_lock_ ;
+            typedef std::pair<std::string, std::vector<double>> CacheKey ;
+            std::map<CacheKey, std::shared_ptr<XeroPath>> cache_ ;
+            std::list<CacheKey> cache_order_ ;
+        } ;
+    }
+}
@@ -0,0 +1,91 @@
+#include "XeroPathLoader.h"
+
+namespace xero {
+    namespace misc {
+
+        XeroPathLoader::XeroPathLoader() {
+            running_ = true ;
+            busy_ = false ;
+            thread_ = std::thread(&XeroPathLoader::workerThread, this) ;
+        }
+
+        XeroPathLoader::~XeroPathLoader() {
+            {
+                std::lock_guard<std::mutex> lock(lock_) ;
+                running_ = false ;
+            }
+            cond_.notify_all() ;
+            thread_.join() ;
+
+            for(Request &req : queue_)
+                req.promise_.set_value(nullptr) ;
+        }
+
+        XeroPathLoader::PathFuture XeroPathLoader::submit(const std::string &name, Job job, bool first) {
+            PathFuture result ;
+            {
+                std::lock_guard<std::mutex> lock(lock_) ;
+                auto it = queue_.emplace(first ? queue_.begin() : queue_.end()) ;
+                it->name_ = name ;
+                it->job_ = job ;
+                result = it->promise_.get_future().share() ;
+            }
+            cond_.notify_one() ;
+            return result ;
+        }
+
+        void XeroPathLoader::prioritize(const std::vector<std::string> &names) {
+            std::lock_guard<std::mutex> lock(lock_) ;
+
+            //
+            // Walk the names backward so the first name ends up at the very front
+            //
+            for(auto name = names.rbegin() ; name != names.rend() ; name++) {
+                for(auto it = queue_.begin() ; it != queue_.end() ; it++) {
+                    if (it->name_ == *name) {
+                        queue_.splice(queue_.begin(), queue_, it) ;
+                        break ;
+                    }
+                }
+            }
+        }
+
+        size_t XeroPathLoader::getPendingCount() {
+            std::lock_guard<std::mutex> lock(lock_) ;
+            return queue_.size() + (busy_ ? 1 : 0) ;
+        }
+
+        void XeroPathLoader::workerThread() {
+            std::unique_lock<std::mutex> lock(lock_) ;
+
+            while (true) {
+                cond_.wait(lock, [this] { return !running_ || queue_.size() > 0 ; }) ;
+                if (!running_)
+                    break ;
+
+                Request req = std::move(queue_.front()) ;
+                queue_.pop_front() ;
+                busy_ = true ;
+
+                //
+                // The job runs without the lock so requests can be added while it runs
+                //
+                lock.unlock() ;
+                std::shared_ptr<XeroPath> path ;
+                try {
+                    path = req.job_() ;
+                }
+                catch(...) {
+                    path = nullptr ;
+                }
+
+                //
+                // The job is no longer pending by the time anyone waiting on it wakes up
+                //
+                lock.lock() ;
+                busy_ = false ;
+                req.promise_.set_value(path) ;
+            }
+        }
+    }
+}
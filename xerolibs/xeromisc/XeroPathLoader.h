@@ -0,0 +1,73 @@
+#pragma once
+
+#include "XeroPath.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+/// \file
+
+namespace xero {
+    namespace misc {
+        /// \brief runs path loading and generation on a background thread
+        ///
+        /// Each request is a named job that returns a path.  The jobs run one at a time in
+        /// the order they were submitted, except that prioritize() moves the jobs for the
+        /// named paths to the front of the queue.  The result of a job is returned through
+        /// a future, so the robot loop can check whether a path is ready without waiting.
+        class XeroPathLoader {
+        public:
+            /// \brief the result of a request
+            typedef std::shared_future<std::shared_ptr<XeroPath>> PathFuture ;
+
+            /// \brief the work done for a request
+            typedef std::function<std::shared_ptr<XeroPath>()> Job ;
+
+            /// \brief create the loader and start its thread
+            XeroPathLoader() ;
+
+            /// \brief stop the thread and destroy the loader
+            /// Jobs that have not started are abandoned and their futures return nullptr.
+            virtual ~XeroPathLoader() ;
+
+            /// \brief add a job to the queue
+            /// \param name the name of the path the job produces
+            /// \param job the job
+            /// \param first if true the job goes to the front of the queue
+            /// \returns the future for the result of the job
+            PathFuture submit(const std::string &name, Job job, bool first = false) ;
+
+            /// \brief move the jobs for the given paths to the front of the queue
+            /// The jobs run in the order of the names given.
+            /// \param names the names of the paths
+            void prioritize(const std::vector<std::string> &names) ;
+
+            /// \brief return the number of jobs waiting or running
+            /// \returns the number of jobs waiting or running
+            size_t getPendingCount() ;
+
+        private:
+            struct Request {
+                std::string name_ ;
+                Job job_ ;
+                std::promise<std::shared_ptr<XeroPath>> promise_ ;
+            } ;
+
+            void workerThread() ;
+
+        private:
+            std::mutex lock_ ;
+            std::condition_variable cond_ ;
+            std::list<Request> queue_ ;
+            bool running_ ;
+            bool busy_ ;
+            std::thread thread_ ;
+        } ;
+    }
+}
@@ -1,5 +1,9 @@
 ﻿#include "XeroPathManager.h"
 #include "CSVData.h"
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <unistd.h>
 
 namespace xero {
     namespace misc {
@@ -11,17 +15,25 @@ namespace xero {
         constexpr const char* rightSuffix  = ".right.pf1.csv";
         constexpr const char* leftSuffix = ".left.pf1.csv";
 
+        constexpr const char *XeroPathManager::CompiledFileName ;
+
         XeroPathManager::XeroPathManager(const std::string &basedir) : basedir_(basedir) {
+            file_.open(basedir_ + "/" + CompiledFileName, why_) ;
+            next_id_ = 0 ;
         }
 
-        bool XeroPathManager::loadPath(const std::string & pathName) {
-            std::string filename = basedir_ + "/" + pathName + leftSuffix ;
+        XeroPathManager::~XeroPathManager() {
+            loader_.reset() ;
+        }
+
+        bool XeroPathManager::readCSV(const std::string &basedir, const std::string &pathName, XeroPathFile::PathData &data) {
+            std::string filename = basedir + "/" + pathName + leftSuffix ;
             auto leftData = CSVData(filename);
             if (!leftData.isLoaded()) {
                 return false;
             }
 
-            filename = basedir_ + "/" + pathName + rightSuffix ;
+            filename = basedir + "/" + pathName + rightSuffix ;
             auto rightData = CSVData(filename);
             if (!rightData.isLoaded()) {
                 return false;
@@ -35,22 +47,187 @@ namespace xero {
                 return false ;
 
             // Path weaver has the data wrong, swap the left and right data
-            paths_[pathName] = std::make_shared<XeroPath>(pathName, rightData, leftData);
+            data.name_ = pathName ;
+            data.dt_ = leftData.getTimeStep() > 0.0 ? leftData.getTimeStep() : XeroPath::DefaultTimeStep ;
+            data.left_ = rightData.getAllData() ;
+            data.right_ = leftData.getAllData() ;
+            return true ;
+        }
+
+        std::vector<std::string> XeroPathManager::findCSVPaths(const std::string &basedir) {
+            std::vector<std::string> names ;
+            size_t suffixlen = std::strlen(leftSuffix) ;
+
+            DIR *dir = ::opendir(basedir.c_str()) ;
+            if (dir == nullptr)
+                return names ;
+
+            struct dirent *ent ;
+            while ((ent = ::readdir(dir)) != nullptr) {
+                std::string name = ent->d_name ;
+                if (name.length() > suffixlen && name.compare(name.length() - suffixlen, suffixlen, leftSuffix) == 0)
+                    names.push_back(name.substr(0, name.length() - suffixlen)) ;
+            }
+            ::closedir(dir) ;
+
+            std::sort(names.begin(), names.end()) ;
+            return names ;
+        }
+
+        std::shared_ptr<XeroPath> XeroPathManager::readPath(const std::string &pathName) const {
+            if (file_.hasPath(pathName))
+                return file_.readPath(pathName) ;
+
+            XeroPathFile::PathData data ;
+            if (!readCSV(basedir_, pathName, data))
+                return nullptr ;
+
+            std::vector<XeroSegment> left, right ;
+            for (auto elem : data.left_)
+                left.push_back(XeroSegment{elem}) ;
+            for (auto elem : data.right_)
+                right.push_back(XeroSegment{elem}) ;
 
-            return true;
+            return std::make_shared<XeroPath>(pathName, std::move(left), std::move(right), data.dt_);
+        }
+
+        XeroPathManager::PathFuture XeroPathManager::ready(std::shared_ptr<XeroPath> path) {
+            std::promise<std::shared_ptr<XeroPath>> promise ;
+            promise.set_value(path) ;
+            return promise.get_future().share() ;
+        }
+
+        XeroPathManager::PathFuture XeroPathManager::submit(const std::string &pathName, XeroPathLoader::Job job, bool first) {
+            //
+            // Called with the lock held, so the job cannot finish before it is recorded as pending
+            //
+            if (loader_ == nullptr)
+                loader_ = std::unique_ptr<XeroPathLoader>(new XeroPathLoader()) ;
+
+            uint64_t id = next_id_++ ;
+            PathFuture future = loader_->submit(pathName, [this, pathName, id, job] {
+                std::shared_ptr<XeroPath> path = job() ;
+                finished(pathName, id, path) ;
+                return path ;
+            }, first) ;
+
+            pending_[pathName] = Pending{ id, future } ;
+            return future ;
+        }
+
+        void XeroPathManager::finished(const std::string &pathName, uint64_t id, std::shared_ptr<XeroPath> path) {
+            std::lock_guard<std::mutex> lock(lock_) ;
+
+            auto it = pending_.find(pathName) ;
+            if (it == pending_.end() || it->second.id_ != id) {
+                //
+                // A newer request for the same name is waiting, it provides the path
+                //
+                return ;
+            }
+
+            if (path != nullptr)
+                paths_[pathName] = path ;
+            pending_.erase(it) ;
+        }
+
+        bool XeroPathManager::loadPath(const std::string & pathName) {
+            //
+            // Paths in the compiled file are read when they are first asked for
+            //
+            if (file_.hasPath(pathName))
+                return true ;
+
+            std::string left = basedir_ + "/" + pathName + leftSuffix ;
+            std::string right = basedir_ + "/" + pathName + rightSuffix ;
+            if (::access(left.c_str(), R_OK) != 0 || ::access(right.c_str(), R_OK) != 0)
+                return false ;
+
+            loadPathAsync(pathName) ;
+            return true ;
+        }
+
+        XeroPathManager::PathFuture XeroPathManager::loadPathAsync(const std::string &pathName, bool first) {
+            std::lock_guard<std::mutex> lock(lock_) ;
+
+            auto iter = paths_.find(pathName) ;
+            if (iter != paths_.end())
+                return ready(iter->second) ;
+
+            auto pend = pending_.find(pathName) ;
+            if (pend != pending_.end()) {
+                if (first)
+                    loader_->prioritize({ pathName }) ;
+                return pend->second.future_ ;
+            }
+
+            return submit(pathName, [this, pathName] { return readPath(pathName) ; }, first) ;
+        }
+
+        XeroPathManager::PathFuture XeroPathManager::generatePathAsync(const std::string &pathName, std::shared_ptr<XeroPathGenerator> generator,
+                                const std::vector<XeroPathGenerator::Waypoint> &points,
+                                const XeroPathGenerator::Constraints &limits, bool first) {
+            std::lock_guard<std::mutex> lock(lock_) ;
+            return submit(pathName, [pathName, generator, points, limits] {
+                return generator->getPath(pathName, points, limits) ;
+            }, first) ;
+        }
+
+        void XeroPathManager::prioritize(const std::vector<std::string> &names) {
+            std::lock_guard<std::mutex> lock(lock_) ;
+            if (loader_ != nullptr)
+                loader_->prioritize(names) ;
+        }
+
+        void XeroPathManager::addPath(std::shared_ptr<XeroPath> path) {
+            std::lock_guard<std::mutex> lock(lock_) ;
+            paths_[path->getName()] = path ;
         }
 
         bool XeroPathManager::hasPath(const std::string & pathName) {
-            auto iter = paths_.find(pathName);
-            return iter != std::end(paths_);
+            std::lock_guard<std::mutex> lock(lock_) ;
+            return paths_.find(pathName) != paths_.end() || pending_.find(pathName) != pending_.end() || file_.hasPath(pathName) ;
+        }
+
+        bool XeroPathManager::isPathReady(const std::string &pathName) {
+            std::lock_guard<std::mutex> lock(lock_) ;
+            return paths_.find(pathName) != paths_.end() ;
         }
 
         std::shared_ptr<XeroPath> XeroPathManager::getPath(const std::string &pathName) {
-            if(hasPath(pathName)) {
-                return paths_[pathName];
-            } else {
-                return nullptr;
+            PathFuture future ;
+            {
+                std::lock_guard<std::mutex> lock(lock_) ;
+
+                auto iter = paths_.find(pathName) ;
+                if (iter != paths_.end())
+                    return iter->second ;
+
+                auto pend = pending_.find(pathName) ;
+                if (pend == pending_.end()) {
+                    std::shared_ptr<XeroPath> path = file_.readPath(pathName) ;
+                    if (path != nullptr)
+                        paths_[pathName] = path ;
+                    return path ;
+                }
+
+                future = pend->second.future_ ;
             }
+
+            //
+            // Wait without the lock, the loader thread needs it to finish the request
+            //
+            return future.get() ;
+        }
+
+        size_t XeroPathManager::getLoadedCount() {
+            std::lock_guard<std::mutex> lock(lock_) ;
+            return paths_.size() ;
+        }
+
+        size_t XeroPathManager::getPendingCount() {
+            std::lock_guard<std::mutex> lock(lock_) ;
+            return pending_.size() ;
         }
     }
 }
@@ -1,23 +1,146 @@
 #pragma once
 
 #include "XeroPath.h"
+#include "XeroPathFile.h"
+#include "XeroPathLoader.h"
+#include "XeroPathGenerator.h"
 #include <string>
+#include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
 
 namespace xero {
     namespace misc {
 
+        /// \brief finds the paths the robot can drive
+        ///
+        /// If the path directory holds a compiled path file (see XeroPathFile) it is memory
+        /// mapped when the manager is created.  Paths that are not in the compiled file are
+        /// read from the PathWeaver CSV files.
+        ///
+        /// Paths are read, and generated, on a background thread (see XeroPathLoader) so the
+        /// robot loop does not wait for file I/O or path math.  A request returns a future
+        /// that can be checked from the robot loop.  Requests made with first set, such as
+        /// those made when an auto mode is built, go ahead of the paths loaded at startup.
         class XeroPathManager {
-        public:                
+        public:
+            /// \brief the name of the compiled path file in the path directory
+            static constexpr const char *CompiledFileName = "paths.xpth" ;
+
+            /// \brief the result of a request for a path
+            typedef XeroPathLoader::PathFuture PathFuture ;
+
             XeroPathManager(const std::string &basedir);
+
+            /// \brief stop the background thread and destroy the manager
+            virtual ~XeroPathManager() ;
+
+            /// \brief start reading a path in the background
+            /// Paths in the compiled path file are not read until they are asked for.
+            /// \param pathName the name of the path
+            /// \returns true if the path exists
             bool loadPath(const std::string & pathName) ;
+
+            /// \brief read a path in the background
+            /// If the path is already loaded or being loaded, the existing result is returned.
+            /// \param pathName the name of the path
+            /// \param first if true, read this path before any waiting requests
+            /// \returns the future for the path, which holds nullptr if the path cannot be read
+            PathFuture loadPathAsync(const std::string &pathName, bool first = false) ;
+
+            /// \brief generate a path in the background and add it to the manager
+            /// \param pathName the name of the path
+            /// \param generator the path generator
+            /// \param points the waypoints for the path
+            /// \param limits the limits for the path
+            /// \param first if true, generate this path before any waiting requests
+            /// \returns the future for the path, which holds nullptr if the path cannot be generated
+            PathFuture generatePathAsync(const std::string &pathName, std::shared_ptr<XeroPathGenerator> generator,
+                                const std::vector<XeroPathGenerator::Waypoint> &points,
+                                const XeroPathGenerator::Constraints &limits, bool first = false) ;
+
+            /// \brief read or generate the given paths before any others that are waiting
+            /// \param names the names of the paths, in the order they are needed
+            void prioritize(const std::vector<std::string> &names) ;
+
+            /// \brief add a path that was built while the robot is running
+            /// A path with the same name is replaced.
+            /// \param path the path to add
+            void addPath(std::shared_ptr<XeroPath> path) ;
+
             bool hasPath(const std::string & pathName) ;
+
+            /// \brief return true if a path is loaded and getPath() will not wait
+            /// \param pathName the name of the path
+            /// \returns true if a path is loaded
+            bool isPathReady(const std::string &pathName) ;
+
+            /// \brief return a path
+            /// If the path is still being read in the background this waits for it, use
+            /// isPathReady() or the future from loadPathAsync() to avoid waiting.
+            /// \param pathName the name of the path
+            /// \returns the path, or nullptr if there is no such path
             std::shared_ptr<XeroPath> getPath(const std::string &pathName) ;
 
+            /// \brief return true if a compiled path file is being used
+            /// \returns true if a compiled path file is being used
+            bool hasCompiledFile() const {
+                return file_.isOpen() ;
+            }
+
+            /// \brief return the reason the compiled path file is not used
+            /// \returns the reason the compiled path file is not used
+            const std::string &getCompiledFileError() const {
+                return why_ ;
+            }
+
+            /// \brief return the number of paths read into memory
+            /// \returns the number of paths read into memory
+            size_t getLoadedCount() ;
+
+            /// \brief return the number of paths waiting to be read or generated
+            /// \returns the number of paths waiting to be read or generated
+            size_t getPendingCount() ;
+
+            /// \brief read the PathWeaver CSV files for a path
+            /// The PathWeaver left and right sides are swapped, see XeroPathManager.cpp.
+            /// \param basedir the directory holding the CSV files
+            /// \param pathName the name of the path
+            /// \param data the rows of the path
+            /// \returns true if the files were read
+            static bool readCSV(const std::string &basedir, const std::string &pathName, XeroPathFile::PathData &data) ;
+
+            /// \brief return the names of the paths that have CSV files in a directory
+            /// \param basedir the directory holding the CSV files
+            /// \returns the names of the paths
+            static std::vector<std::string> findCSVPaths(const std::string &basedir) ;
+
+        private:
+            struct Pending {
+                uint64_t id_ ;
+                PathFuture future_ ;
+            } ;
+
+            std::shared_ptr<XeroPath> readPath(const std::string &pathName) const ;
+            PathFuture submit(const std::string &pathName, XeroPathLoader::Job job, bool first) ;
+            void finished(const std::string &pathName, uint64_t id, std::shared_ptr<XeroPath> path) ;
+            static PathFuture ready(std::shared_ptr<XeroPath> path) ;
+
         private:
             std::string basedir_;
-            std::map<std::string, std::shared_ptr<XeroPath>> paths_;      
-        } ;  
+            XeroPathFile file_ ;
+            std::string why_ ;
+
+            std::mutex lock_ ;
+            std::map<std::string, std::shared_ptr<XeroPath>> paths_;
+            std::map<std::string, Pending> pending_ ;
+            uint64_t next_id_ ;
+
+            //
+            // Last so it is destroyed first, its thread uses the members above
+            //
+            std::unique_ptr<XeroPathLoader> loader_ ;
+        } ;
     }
 }
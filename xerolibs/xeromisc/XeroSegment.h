@@ -22,6 +22,14 @@ namespace xero {
                 heading_ = xero::math::normalizeAngleDegrees(data[6] / xero::math::PI * 180.0) ;                        
             }   
 
+            /// \brief create a segment with the heading already in degrees
+            static XeroSegment fromDegrees(double x, double y, double linPos,
+                        double vel, double accel, double jerk, double heading) {
+                XeroSegment seg(x, y, linPos, vel, accel, jerk, 0.0) ;
+                seg.heading_ = heading ;
+                return seg ;
+            }
+
             double getX() const {
                 return x_ ;
             }
@@ -0,0 +1,349 @@
+#include "gtest/gtest.h"
+#include "basecategories.h"
+#include "phaserids.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+//
+// Compares the two ways a subsystem has decided whether it accepts an action: a
+// dynamic_pointer_cast to the base class of its actions, and a test of the action
+// category masks (see Action::getCategories() and Subsystem::acceptCategory() in
+// xerobase).
+//
+// xerobase and the robot code need WPILib, which the test build does not have, so the
+// classes here are stand-ins and not the real actions and subsystems.  They use the
+// real category numbers from basecategories.h and phaserids.h, and each stand-in
+// subsystem accepts the same categories as the real one and makes the same casts as
+// the canAcceptAction() it replaced.  The timings in the benchmark are for the
+// stand-ins, they show the relative cost of the two checks, not the cost in the robot.
+//
+
+namespace {
+    class Action {
+    public:
+        Action() {
+            categories_ = 0 ;
+        }
+
+        virtual ~Action() {
+        }
+
+        uint32_t getCategories() const {
+            return categories_ ;
+        }
+
+    protected:
+        void addCategory(uint32_t category) {
+            categories_ |= category ;
+        }
+
+    private:
+        uint32_t categories_ ;
+    } ;
+
+    typedef std::shared_ptr<Action> ActionPtr ;
+
+    //
+    // The base classes of the subsystem actions, each adds the category its real
+    // counterpart adds
+    //
+    class TankDriveAction : public Action {
+    public:
+        TankDriveAction() {
+            addCategory(ACTION_CATEGORY_TANKDRIVE) ;
+        }
+    } ;
+
+    class LifterAction : public Action {
+    public:
+        LifterAction() {
+            addCategory(ACTION_CATEGORY_LIFTER) ;
+        }
+    } ;
+
+    class SingleMotorSubsystemAction : public Action {
+    public:
+        SingleMotorSubsystemAction() {
+            addCategory(ACTION_CATEGORY_SINGLEMOTOR) ;
+        }
+    } ;
+
+    class CargoIntakeAction : public Action {
+    public:
+        CargoIntakeAction() {
+            addCategory(ACTION_CATEGORY_CARGOINTAKE) ;
+        }
+    } ;
+
+    class ClimberAction : public Action {
+    public:
+        ClimberAction() {
+            addCategory(ACTION_CATEGORY_CLIMBER) ;
+        }
+    } ;
+
+    class ClimbAction : public Action {
+    public:
+        ClimbAction() {
+            addCategory(ACTION_CATEGORY_CLIMB) ;
+        }
+    } ;
+
+    class StrafeAction : public Action {
+    public:
+        StrafeAction() {
+            addCategory(ACTION_CATEGORY_STRAFE) ;
+        }
+    } ;
+
+    class TankDrivePowerAction : public TankDriveAction {
+    } ;
+
+    class TankDriveTimedPowerAction : public TankDrivePowerAction {
+    } ;
+
+    class LifterGoToHeightAction : public LifterAction {
+    } ;
+
+    class SingleMotorPowerAction : public SingleMotorSubsystemAction {
+    } ;
+
+    class CargoIntakeSpinAction : public CargoIntakeAction {
+    } ;
+
+    class ClimberDeployAction : public ClimberAction {
+    } ;
+
+    //
+    // A subsystem as it was before categories, and as it is now
+    //
+    class CastSubsystem {
+    public:
+        virtual ~CastSubsystem() {
+        }
+
+        virtual bool canAcceptAction(ActionPtr action) = 0 ;
+    } ;
+
+    class MaskSubsystem {
+    public:
+        MaskSubsystem() {
+            accepted_ = 0 ;
+        }
+
+        virtual ~MaskSubsystem() {
+        }
+
+        virtual bool canAcceptAction(const ActionPtr &action) {
+            return (action->getCategories() & accepted_) != 0 ;
+        }
+
+    protected:
+        void acceptCategory(uint32_t category) {
+            accepted_ |= category ;
+        }
+
+    private:
+        uint32_t accepted_ ;
+    } ;
+
+    //
+    // The casts are the ones made by the canAcceptAction() overrides that the categories
+    // replaced, and the categories are the ones the real subsystems now accept
+    //
+    class CastTankDrive : public CastSubsystem {
+    public:
+        virtual bool canAcceptAction(ActionPtr action) {
+            auto act = std::dynamic_pointer_cast<TankDriveAction>(action) ;
+            return act != nullptr ;
+        }
+    } ;
+
+    class MaskTankDrive : public MaskSubsystem {
+    public:
+        MaskTankDrive() {
+            acceptCategory(ACTION_CATEGORY_TANKDRIVE) ;
+        }
+    } ;
+
+    class CastSingleMotorSubsystem : public CastSubsystem {
+    public:
+        virtual bool canAcceptAction(ActionPtr action) {
+            auto coll = std::dynamic_pointer_cast<SingleMotorSubsystemAction>(action) ;
+            return coll != nullptr ;
+        }
+    } ;
+
+    class MaskSingleMotorSubsystem : public MaskSubsystem {
+    public:
+        MaskSingleMotorSubsystem() {
+            acceptCategory(ACTION_CATEGORY_SINGLEMOTOR) ;
+        }
+    } ;
+
+    class CastCargoIntake : public CastSingleMotorSubsystem {
+    public:
+        virtual bool canAcceptAction(ActionPtr act) {
+            if (CastSingleMotorSubsystem::canAcceptAction(act))
+                return true ;
+
+            auto cargoact = std::dynamic_pointer_cast<CargoIntakeAction>(act) ;
+            return cargoact != nullptr ;
+        }
+    } ;
+
+    class MaskCargoIntake : public MaskSingleMotorSubsystem {
+    public:
+        MaskCargoIntake() {
+            acceptCategory(ACTION_CATEGORY_CARGOINTAKE) ;
+        }
+    } ;
+
+    class CastClimber : public CastSubsystem {
+    public:
+        virtual bool canAcceptAction(ActionPtr action) {
+            auto action_p = std::dynamic_pointer_cast<ClimberAction>(action) ;
+            return action_p != nullptr ;
+        }
+    } ;
+
+    class MaskClimber : public MaskSubsystem {
+    public:
+        MaskClimber() {
+            acceptCategory(ACTION_CATEGORY_CLIMBER) ;
+        }
+    } ;
+
+    class CastPhaserRobotSubsystem : public CastSubsystem {
+    public:
+        virtual bool canAcceptAction(ActionPtr act) {
+            auto climb = std::dynamic_pointer_cast<ClimbAction>(act) ;
+            if (climb != nullptr)
+                return true ;
+
+            auto strafe = std::dynamic_pointer_cast<StrafeAction>(act) ;
+            return strafe != nullptr ;
+        }
+    } ;
+
+    class MaskPhaserRobotSubsystem : public MaskSubsystem {
+    public:
+        MaskPhaserRobotSubsystem() {
+            acceptCategory(ACTION_CATEGORY_CLIMB | ACTION_CATEGORY_STRAFE) ;
+        }
+    } ;
+
+    std::vector<ActionPtr> makeActions() {
+        std::vector<ActionPtr> actions ;
+        actions.push_back(std::make_shared<TankDrivePowerAction>()) ;
+        actions.push_back(std::make_shared<TankDriveTimedPowerAction>()) ;
+        actions.push_back(std::make_shared<LifterGoToHeightAction>()) ;
+        actions.push_back(std::make_shared<LifterAction>()) ;
+        actions.push_back(std::make_shared<SingleMotorPowerAction>()) ;
+        actions.push_back(std::make_shared<CargoIntakeSpinAction>()) ;
+        actions.push_back(std::make_shared<ClimberDeployAction>()) ;
+        actions.push_back(std::make_shared<ClimbAction>()) ;
+        actions.push_back(std::make_shared<StrafeAction>()) ;
+        return actions ;
+    }
+
+    template <typename S>
+    double timeDispatch(S &sub, const std::vector<ActionPtr> &actions, int reps, size_t &accepted) {
+        accepted = 0 ;
+        auto start = std::chrono::steady_clock::now() ;
+        for(int i = 0 ; i < reps ; i++) {
+            for(const ActionPtr &act : actions) {
+                if (sub.canAcceptAction(act))
+                    accepted++ ;
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() ;
+        return ns / (reps * actions.size()) ;
+    }
+}
+
+TEST(ActionDispatchTests, CategoriesAreDistinct)
+{
+    const uint32_t base[] = {
+        ACTION_CATEGORY_TANKDRIVE, ACTION_CATEGORY_SINGLEMOTOR, ACTION_CATEGORY_LIFTER,
+        ACTION_CATEGORY_CAMERACHANGE, ACTION_CATEGORY_RUMBLE
+    } ;
+    const uint32_t phaser[] = {
+        ACTION_CATEGORY_TURNTABLE, ACTION_CATEGORY_GAMEPIECE, ACTION_CATEGORY_CARLOSHATCH,
+        ACTION_CATEGORY_CARGOINTAKE, ACTION_CATEGORY_CLIMBER, ACTION_CATEGORY_CLIMB,
+        ACTION_CATEGORY_STRAFE, ACTION_CATEGORY_SETTHRESHOLD
+    } ;
+    uint32_t seen = 0 ;
+
+    //
+    // Each category is a single bit, the base library uses the lower 16 bits and
+    // the robot the upper 16 bits
+    //
+    for(uint32_t cat : base) {
+        EXPECT_EQ(0u, cat & (cat - 1)) ;
+        EXPECT_EQ(0u, cat & 0xffff0000u) ;
+        EXPECT_EQ(0u, seen & cat) ;
+        seen |= cat ;
+    }
+
+    for(uint32_t cat : phaser) {
+        EXPECT_EQ(0u, cat & (cat - 1)) ;
+        EXPECT_EQ(0u, cat & 0x0000ffffu) ;
+        EXPECT_EQ(0u, seen & cat) ;
+        seen |= cat ;
+    }
+}
+
+TEST(ActionDispatchTests, SameAnswer)
+{
+    CastTankDrive casttank ;
+    MaskTankDrive masktank ;
+    CastSingleMotorSubsystem castmotor ;
+    MaskSingleMotorSubsystem maskmotor ;
+    CastCargoIntake castcargo ;
+    MaskCargoIntake maskcargo ;
+    CastClimber castclimber ;
+    MaskClimber maskclimber ;
+    CastPhaserRobotSubsystem castrobot ;
+    MaskPhaserRobotSubsystem maskrobot ;
+
+    std::vector<std::pair<CastSubsystem *, MaskSubsystem *>> subs = {
+        { &casttank, &masktank }, { &castmotor, &maskmotor }, { &castcargo, &maskcargo },
+        { &castclimber, &maskclimber }, { &castrobot, &maskrobot }
+    } ;
+
+    for(auto &pair : subs) {
+        for(const ActionPtr &act : makeActions())
+            EXPECT_EQ(pair.first->canAcceptAction(act), pair.second->canAcceptAction(act)) ;
+    }
+
+    //
+    // The cargo intake is a single motor subsystem, so it takes the actions of both
+    //
+    EXPECT_TRUE(maskcargo.canAcceptAction(std::make_shared<SingleMotorPowerAction>())) ;
+    EXPECT_TRUE(maskcargo.canAcceptAction(std::make_shared<CargoIntakeSpinAction>())) ;
+    EXPECT_FALSE(maskmotor.canAcceptAction(std::make_shared<CargoIntakeSpinAction>())) ;
+}
+
+TEST(ActionDispatchTests, Benchmark)
+{
+    const int reps = 1000000 ;
+    std::vector<ActionPtr> actions = makeActions() ;
+    CastTankDrive cast ;
+    MaskTankDrive mask ;
+    size_t castcount, maskcount ;
+
+    double castns = timeDispatch(cast, actions, reps, castcount) ;
+    double maskns = timeDispatch(mask, actions, reps, maskcount) ;
+
+    std::cout << "    stand-in classes, not the xerobase code" << std::endl ;
+    std::cout << "    dynamic_pointer_cast: " << castns << " ns per action" << std::endl ;
+    std::cout << "    category mask: " << maskns << " ns per action" << std::endl ;
+
+    EXPECT_EQ(castcount, maskcount) ;
+    EXPECT_EQ(reps * 2u, maskcount) ;
+    EXPECT_LT(maskns, castns) ;
+}
@@ -0,0 +1,40 @@
+#include "gtest/gtest.h"
+#include "AllocationCounter.h"
+#include <thread>
+#include <memory>
+
+using namespace xero::misc ;
+
+TEST(AllocationCounterTests, CountsPerThread)
+{
+    size_t total = AllocationCounter::getTotalCount() ;
+    std::thread other([] {
+        for(int i = 0 ; i < 10 ; i++)
+            std::unique_ptr<int> value(new int(i)) ;
+    }) ;
+
+    //
+    // Creating the thread may allocate on this thread, so only read this thread's
+    // count once it has been created
+    //
+    size_t before = AllocationCounter::getCount() ;
+    other.join() ;
+    EXPECT_EQ(before, AllocationCounter::getCount()) ;
+    EXPECT_GE(AllocationCounter::getTotalCount(), total + 10) ;
+
+    std::unique_ptr<int> value(new int(1)) ;
+    EXPECT_EQ(before + 1, AllocationCounter::getCount()) ;
+}
+
+TEST(AllocationCounterTests, SizedDelete)
+{
+    //
+    // Memory from the counting operator new can be freed with the sized forms of delete
+    //
+    size_t before = AllocationCounter::getCount() ;
+    void *single = ::operator new(24) ;
+    ::operator delete(single, 24) ;
+    void *array = ::operator new[](48) ;
+    ::operator delete[](array, 48) ;
+    EXPECT_EQ(before + 2, AllocationCounter::getCount()) ;
+}
@@ -0,0 +1,206 @@
+#include "gtest/gtest.h"
+#include "BinaryLog.h"
+#include "MessageLogger.h"
+#include "MessageDestStream.h"
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <map>
+
+using namespace xero::misc ;
+
+namespace {
+    class CaptureDest : public MessageLoggerDest {
+    public:
+        virtual void displayMessage(const MessageLogger::MessageType &type, uint64_t subs, const std::string &msg) {
+        }
+
+        virtual bool isBinary() const {
+            return true ;
+        }
+
+        virtual void displayRecord(const uint8_t *data, size_t length) {
+            bytes_.insert(bytes_.end(), data, data + length) ;
+        }
+
+        std::vector<uint8_t> bytes_ ;
+    } ;
+
+    //
+    // Holds the writer thread in the first record until it is opened, so the ring
+    // buffer fills up behind it
+    //
+    class GateDest : public CaptureDest {
+    public:
+        GateDest() : open_(false) {
+        }
+
+        virtual void displayRecord(const uint8_t *data, size_t length) {
+            while (!open_)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1)) ;
+
+            CaptureDest::displayRecord(data, length) ;
+        }
+
+        std::atomic<bool> open_ ;
+    } ;
+}
+
+TEST(BinaryLogTests, RoundTrip)
+{
+    uint8_t buffer[256] ;
+    std::vector<uint8_t> log ;
+    BinaryLogEncoder encoder(buffer, sizeof(buffer)) ;
+
+    auto append = [&]() {
+        EXPECT_FALSE(encoder.isOverflow()) ;
+        log.insert(log.end(), encoder.getData(), encoder.getData() + encoder.getLength()) ;
+        encoder.reset() ;
+    } ;
+
+    encoder.header() ;
+    append() ;
+    encoder.schema(7, "follow", { "x", "count", "done", "mode" }) ;
+    append() ;
+    encoder.string(0, "fast") ;
+    append() ;
+    encoder.startData(1.5, 2, 4, 7) ;
+    encoder.field(2.25) ;
+    encoder.field(static_cast<int32_t>(-3)) ;
+    encoder.field(true) ;
+    encoder.stringField(0) ;
+    append() ;
+    encoder.text(1, 0, "hello") ;
+    append() ;
+
+    const uint8_t *p = &log[0] ;
+    const uint8_t *end = p + log.size() ;
+    BinaryLogDecoder decoder ;
+    BinaryLogEntry entry ;
+
+    ASSERT_TRUE(BinaryLogDecoder::header(p, end)) ;
+    ASSERT_TRUE(decoder.decode(p, end, entry)) ;
+    EXPECT_EQ(BinaryLogFormat::RecordKind::Schema, entry.kind_) ;
+    EXPECT_EQ("follow", decoder.getName(7)) ;
+    ASSERT_TRUE(decoder.decode(p, end, entry)) ;
+    EXPECT_EQ(BinaryLogFormat::RecordKind::String, entry.kind_) ;
+
+    ASSERT_TRUE(decoder.decode(p, end, entry)) ;
+    EXPECT_EQ(BinaryLogFormat::RecordKind::Data, entry.kind_) ;
+    EXPECT_DOUBLE_EQ(1.5, entry.time_) ;
+    EXPECT_EQ(4u, entry.group_) ;
+    ASSERT_EQ(4u, entry.fields_.size()) ;
+    EXPECT_DOUBLE_EQ(2.25, entry.fields_[0].number_) ;
+    EXPECT_DOUBLE_EQ(-3.0, entry.fields_[1].number_) ;
+    EXPECT_EQ("follow: x=2.250000, count=-3, done=true, mode=fast", BinaryLogDecoder::toText(entry)) ;
+
+    ASSERT_TRUE(decoder.decode(p, end, entry)) ;
+    EXPECT_EQ(BinaryLogFormat::RecordKind::Text, entry.kind_) ;
+    EXPECT_EQ("hello", entry.text_) ;
+    EXPECT_EQ(end, p) ;
+    EXPECT_FALSE(decoder.decode(p, end, entry)) ;
+}
+
+TEST(BinaryLogTests, Truncated)
+{
+    uint8_t buffer[64] ;
+    BinaryLogEncoder encoder(buffer, sizeof(buffer)) ;
+    encoder.startData(0.0, 0, 0, 1) ;
+    encoder.field(1.0) ;
+
+    const uint8_t *p = encoder.getData() ;
+    BinaryLogDecoder decoder ;
+    BinaryLogEntry entry ;
+    EXPECT_FALSE(decoder.decode(p, p + encoder.getLength() - 1, entry)) ;
+    EXPECT_EQ(encoder.getData(), p) ;
+
+    BinaryLogEncoder small(buffer, 8) ;
+    small.startData(0.0, 0, 0, 1) ;
+    EXPECT_TRUE(small.isOverflow()) ;
+}
+
+TEST(BinaryLogTests, LoggerRecords)
+{
+    std::stringstream strm ;
+    auto capture = std::make_shared<CaptureDest>() ;
+    MessageLogger logger ;
+
+    logger.enableType(MessageLogger::MessageType::debug) ;
+    logger.enableSubsystem(2) ;
+    logger.addDestination(std::make_shared<MessageDestStream>(strm)) ;
+    logger.addDestination(capture) ;
+
+    logger.defineRecord(1, "lift", { "height", "out" }) ;
+    logger.defineRecord(1, "lift", { "height", "out" }) ;
+
+    logger.startRecord(MessageLogger::MessageType::debug, 2, 1) ;
+    logger.addField(12.5).addField(0.5) ;
+    logger.endRecord() ;
+
+    logger.startRecord(MessageLogger::MessageType::debug, 8, 1) ;
+    logger.addField(1.0).addField(1.0) ;
+    logger.endRecord() ;
+
+    EXPECT_EQ("lift: height=12.500000, out=0.500000\n", strm.str()) ;
+
+    const uint8_t *p = &capture->bytes_[0] ;
+    const uint8_t *end = p + capture->bytes_.size() ;
+    BinaryLogDecoder decoder ;
+    BinaryLogEntry entry ;
+    int count = 0 ;
+    while (decoder.decode(p, end, entry))
+        count++ ;
+
+    EXPECT_EQ(2, count) ;
+    EXPECT_EQ(end, p) ;
+}
+
+TEST(BinaryLogTests, DroppedDefinitionsResent)
+{
+    auto gate = std::make_shared<GateDest>() ;
+    MessageLogger logger ;
+
+    logger.addDestination(gate) ;
+    logger.startAsync(4, 0.01) ;
+
+    for(uint16_t id = 1 ; id <= 16 ; id++)
+        logger.defineRecord(id, "rec" + std::to_string(id), { "value" }) ;
+    EXPECT_EQ(0, logger.internString("drive")) ;
+    EXPECT_GT(logger.getDroppedCount(), 0u) ;
+
+    gate->open_ = true ;
+    logger.stopAsync() ;
+
+    //
+    // The dropped definitions are sent again, the ones that were queued are not
+    //
+    for(uint16_t id = 1 ; id <= 16 ; id++)
+        logger.defineRecord(id, "rec" + std::to_string(id), { "value" }) ;
+    EXPECT_EQ(0, logger.internString("drive")) ;
+    EXPECT_EQ(1, logger.internString("lift")) ;
+    EXPECT_EQ(0, logger.internString("drive")) ;
+
+    const uint8_t *p = &gate->bytes_[0] ;
+    const uint8_t *end = p + gate->bytes_.size() ;
+    BinaryLogDecoder decoder ;
+    BinaryLogEntry entry ;
+    std::map<uint16_t, int> schemas ;
+    std::map<uint16_t, std::string> strings ;
+    while (decoder.decode(p, end, entry)) {
+        if (entry.kind_ == BinaryLogFormat::RecordKind::Schema)
+            schemas[entry.id_]++ ;
+        else if (entry.kind_ == BinaryLogFormat::RecordKind::String) {
+            EXPECT_EQ(0u, strings.count(entry.id_)) ;
+            strings[entry.id_] = entry.text_ ;
+        }
+    }
+
+    EXPECT_EQ(end, p) ;
+    ASSERT_EQ(16u, schemas.size()) ;
+    for(auto &pair : schemas)
+        EXPECT_EQ(1, pair.second) ;
+
+    ASSERT_EQ(2u, strings.size()) ;
+    EXPECT_EQ("drive", strings[0]) ;
+    EXPECT_EQ("lift", strings[1]) ;
+}
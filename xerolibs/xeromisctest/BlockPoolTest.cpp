@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+#include "BlockPool.h"
+#include "AllocationCounter.h"
+#include <vector>
+
+using namespace xero::misc ;
+
+namespace {
+    class Thing {
+    public:
+        Thing(int value) : value_(value) {
+        }
+
+        int value_ ;
+        double pad_[4] ;
+    } ;
+
+    std::shared_ptr<Thing> makeThing(BlockPool &pool, int value) {
+        return std::allocate_shared<Thing>(PoolAllocator<Thing>(&pool), value) ;
+    }
+}
+
+TEST(BlockPoolTests, CountsLiveAndPeak)
+{
+    PoolCounters totals ;
+    BlockPool pool(4, &totals) ;
+
+    {
+        std::vector<std::shared_ptr<Thing>> things ;
+        for(int i = 0 ; i < 3 ; i++)
+            things.push_back(makeThing(pool, i)) ;
+
+        EXPECT_EQ(3u, pool.getCounters().getLive()) ;
+        EXPECT_EQ(3u, totals.getLive()) ;
+        EXPECT_EQ(1, things[1]->value_) ;
+
+        things.pop_back() ;
+        EXPECT_EQ(2u, pool.getCounters().getLive()) ;
+        EXPECT_EQ(3u, pool.getCounters().getPeak()) ;
+    }
+
+    EXPECT_EQ(0u, pool.getCounters().getLive()) ;
+    EXPECT_EQ(3u, pool.getCounters().getPeak()) ;
+    EXPECT_EQ(3u, totals.getAllocations()) ;
+    EXPECT_EQ(0u, totals.getHeapAllocations()) ;
+}
+
+TEST(BlockPoolTests, FullPoolUsesHeap)
+{
+    BlockPool pool(2) ;
+
+    std::vector<std::shared_ptr<Thing>> things ;
+    for(int i = 0 ; i < 3 ; i++)
+        things.push_back(makeThing(pool, i)) ;
+
+    EXPECT_EQ(3u, pool.getCounters().getLive()) ;
+    EXPECT_EQ(1u, pool.getCounters().getHeapAllocations()) ;
+    EXPECT_EQ(2, things[2]->value_) ;
+
+    //
+    // A block returned to the pool is used before the heap again
+    //
+    things.erase(things.begin()) ;
+    things.push_back(makeThing(pool, 3)) ;
+    EXPECT_EQ(1u, pool.getCounters().getHeapAllocations()) ;
+
+    things.clear() ;
+    EXPECT_EQ(0u, pool.getCounters().getLive()) ;
+}
+
+TEST(BlockPoolTests, NoAllocationsOnceUsed)
+{
+    BlockPool pool(8) ;
+    makeThing(pool, 0) ;
+
+    size_t before = AllocationCounter::getCount() ;
+    for(int i = 0 ; i < 1000 ; i++) {
+        auto a = makeThing(pool, i) ;
+        auto b = makeThing(pool, i + 1) ;
+        EXPECT_EQ(a->value_ + 1, b->value_) ;
+    }
+    EXPECT_EQ(before, AllocationCounter::getCount()) ;
+    EXPECT_EQ(2u, pool.getCounters().getPeak()) ;
+}
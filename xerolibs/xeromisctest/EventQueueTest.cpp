@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "EventQueue.h"
+#include <thread>
+
+using namespace xero::misc ;
+
+TEST(EventQueueTests, NewSourceStartsWithEvent)
+{
+    EventQueue queue ;
+    size_t id = queue.addSource("first") ;
+
+    EXPECT_EQ(0u, id) ;
+    EXPECT_EQ("first", queue.getSourceName(id)) ;
+
+    queue.collect() ;
+    EXPECT_TRUE(queue.hasEvent(id)) ;
+
+    queue.collect() ;
+    EXPECT_FALSE(queue.hasEvent(id)) ;
+    EXPECT_EQ(1u, queue.getActiveLoops(id)) ;
+    EXPECT_EQ(2u, queue.getLoopCount()) ;
+}
+
+TEST(EventQueueTests, EventsBelongToOneLoop)
+{
+    EventQueue queue ;
+    size_t a = queue.addSource("a") ;
+    size_t b = queue.addSource("b") ;
+    queue.collect() ;
+    queue.collect() ;
+
+    queue.post(b) ;
+    queue.post(b) ;
+    EXPECT_FALSE(queue.hasEvent(b)) ;
+
+    queue.collect() ;
+    EXPECT_FALSE(queue.hasEvent(a)) ;
+    EXPECT_TRUE(queue.hasEvent(b)) ;
+    EXPECT_EQ(2u, queue.getEventCount(b)) ;
+
+    queue.collect() ;
+    EXPECT_FALSE(queue.hasEvent(b)) ;
+}
+
+TEST(EventQueueTests, PollingAndFullQueue)
+{
+    EventQueue queue ;
+    for(size_t i = 0 ; i < EventQueue::MaxSources ; i++)
+        queue.addSource("source") ;
+
+    size_t extra = queue.addSource("extra") ;
+    EXPECT_EQ(EventQueue::AlwaysSource, extra) ;
+
+    queue.collect() ;
+    queue.collect() ;
+    EXPECT_FALSE(queue.hasEvent(0)) ;
+    EXPECT_TRUE(queue.hasEvent(extra)) ;
+
+    queue.setPolling(true) ;
+    EXPECT_TRUE(queue.hasEvent(0)) ;
+}
+
+TEST(EventQueueTests, PostFromOtherThreads)
+{
+    EventQueue queue ;
+    size_t id = queue.addSource("threads") ;
+    queue.collect() ;
+
+    std::thread th([&queue, id]() {
+        for(int i = 0 ; i < 1000 ; i++)
+            queue.post(id) ;
+    }) ;
+
+    uint32_t total = 0 ;
+    while (total < 1000) {
+        queue.collect() ;
+        total += queue.getEventCount(id) ;
+    }
+    th.join() ;
+
+    EXPECT_EQ(1000u, total) ;
+}
@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+#include "Histogram.h"
+
+using namespace xero::misc ;
+
+TEST(HistogramTests, EmptyTest)
+{
+    Histogram hist(0.0, 10.0, 10) ;
+
+    EXPECT_EQ(0u, hist.getCount()) ;
+    EXPECT_DOUBLE_EQ(0.0, hist.getMean()) ;
+    EXPECT_DOUBLE_EQ(0.0, hist.getPercentile(99.0)) ;
+}
+
+TEST(HistogramTests, BasicTest)
+{
+    Histogram hist(0.0, 10.0, 10) ;
+
+    for(int i = 0 ; i < 10 ; i++)
+        hist.add(i + 0.5) ;
+
+    EXPECT_EQ(10u, hist.getCount()) ;
+    EXPECT_DOUBLE_EQ(0.5, hist.getMinimum()) ;
+    EXPECT_DOUBLE_EQ(9.5, hist.getMaximum()) ;
+    EXPECT_DOUBLE_EQ(5.0, hist.getMean()) ;
+    EXPECT_DOUBLE_EQ(5.0, hist.getPercentile(50.0)) ;
+    EXPECT_DOUBLE_EQ(9.5, hist.getPercentile(99.0)) ;
+
+    for(size_t i = 0 ; i < hist.getBucketCount() ; i++)
+        EXPECT_EQ(1u, hist.getBucket(i)) ;
+}
+
+TEST(HistogramTests, OutOfRangeTest)
+{
+    Histogram hist(0.0, 10.0, 10) ;
+
+    hist.add(-5.0) ;
+    hist.add(25.0) ;
+
+    EXPECT_EQ(1u, hist.getBucket(0)) ;
+    EXPECT_EQ(1u, hist.getBucket(9)) ;
+    EXPECT_DOUBLE_EQ(-5.0, hist.getMinimum()) ;
+    EXPECT_DOUBLE_EQ(25.0, hist.getMaximum()) ;
+
+    hist.clear() ;
+    EXPECT_EQ(0u, hist.getCount()) ;
+    EXPECT_EQ(0u, hist.getBucket(0)) ;
+}
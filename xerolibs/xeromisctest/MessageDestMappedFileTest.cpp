@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "MessageLogger.h"
+#include "MessageDestMappedFile.h"
+#include "FileUtils.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+using namespace xero::misc ;
+
+namespace {
+    std::string readFile(const std::string &name) {
+        std::ifstream in(name) ;
+        std::stringstream strm ;
+        strm << in.rdbuf() ;
+        return strm.str() ;
+    }
+}
+
+TEST(MessageDestMappedFileTests, Rotate)
+{
+    char dirname[] = "/tmp/mappedtestXXXXXX" ;
+    ASSERT_NE(nullptr, mkdtemp(dirname)) ;
+    std::string dir = std::string(dirname) + "/" ;
+
+    {
+        std::ofstream existing(dir + "log_4") ;
+    }
+
+    std::string expected1, expected2 ;
+    {
+        auto dest = std::make_shared<MessageDestMappedFile>(dir, "log_", 4096, 0.0) ;
+        EXPECT_EQ(dir + "log_5", dest->getFileName()) ;
+
+        MessageLogger logger ;
+        logger.enableType(MessageLogger::MessageType::info) ;
+        logger.addDestination(dest) ;
+
+        //
+        // Each message is 100 bytes with the newline, so 40 fit in the first file
+        //
+        std::string msg(99, 'x') ;
+        for(int i = 0 ; i < 50 ; i++) {
+            std::string text = std::to_string(i % 10) + msg.substr(1) ;
+            logger.startMessage(MessageLogger::MessageType::info) ;
+            logger << text ;
+            logger.endMessage() ;
+
+            if (i < 40)
+                expected1 += text + "\n" ;
+            else
+                expected2 += text + "\n" ;
+        }
+
+        EXPECT_EQ(2, dest->getFileCount()) ;
+        EXPECT_EQ(dir + "log_6", dest->getFileName()) ;
+        EXPECT_TRUE(xero::file::is_a_symlink(dir + "/latest")) ;
+        logger.clear() ;
+    }
+
+    EXPECT_EQ(expected1, readFile(dir + "log_5")) ;
+    EXPECT_EQ(expected2, readFile(dir + "log_6")) ;
+    EXPECT_EQ(expected2, readFile(dir + "latest")) ;
+
+    std::string cmd = std::string("rm -rf ") + dirname ;
+    EXPECT_EQ(0, system(cmd.c_str())) ;
+}
+
+TEST(MessageDestMappedFileTests, RotateAsync)
+{
+    char dirname[] = "/tmp/mappedtestXXXXXX" ;
+    ASSERT_NE(nullptr, mkdtemp(dirname)) ;
+    std::string dir = dirname ;
+
+    //
+    // The directory does not need the trailing separator, and the files are
+    // written by the logger's writer thread
+    //
+    std::string expected2 ;
+    {
+        auto dest = std::make_shared<MessageDestMappedFile>(dir, "log_", 4096, 0.0) ;
+        EXPECT_EQ(dir + "/log_1", dest->getFileName()) ;
+
+        MessageLogger logger ;
+        logger.enableType(MessageLogger::MessageType::info) ;
+        logger.addDestination(dest) ;
+        logger.startAsync(64, 0.01) ;
+
+        std::string msg(99, 'y') ;
+        for(int i = 0 ; i < 50 ; i++) {
+            logger.startMessage(MessageLogger::MessageType::info) ;
+            logger << msg ;
+            logger.endMessage() ;
+
+            if (i >= 40)
+                expected2 += msg + "\n" ;
+        }
+
+        logger.stopAsync() ;
+        EXPECT_EQ(0u, logger.getDroppedCount()) ;
+        EXPECT_EQ(2, dest->getFileCount()) ;
+        EXPECT_EQ(dir + "/log_2", dest->getFileName()) ;
+        logger.clear() ;
+    }
+
+    EXPECT_TRUE(xero::file::is_a_symlink(dir + "/latest")) ;
+    EXPECT_EQ(expected2, readFile(dir + "/latest")) ;
+
+    std::string cmd = std::string("rm -rf ") + dirname ;
+    EXPECT_EQ(0, system(cmd.c_str())) ;
+}
@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+#include "MessageLogger.h"
+#include "MessageDestStream.h"
+#include <sstream>
+#include <thread>
+
+using namespace xero::misc ;
+
+TEST(MessageLoggerTests, AsyncTest)
+{
+    std::stringstream strm ;
+    MessageLogger logger ;
+
+    logger.enableType(MessageLogger::MessageType::info) ;
+    logger.addDestination(std::make_shared<MessageDestStream>(strm)) ;
+    logger.startAsync(16, 0.01) ;
+    EXPECT_TRUE(logger.isAsync()) ;
+
+    for(int i = 0 ; i < 10 ; i++) {
+        logger.startMessage(MessageLogger::MessageType::info) ;
+        logger << "message " << i ;
+        logger.endMessage() ;
+    }
+
+    logger.stopAsync() ;
+    EXPECT_FALSE(logger.isAsync()) ;
+
+    std::string expected ;
+    for(int i = 0 ; i < 10 ; i++)
+        expected += "message " + std::to_string(i) + "\n" ;
+
+    EXPECT_EQ(expected, strm.str()) ;
+    EXPECT_EQ(0u, logger.getDroppedCount()) ;
+}
+
+TEST(MessageLoggerTests, DroppedTest)
+{
+    std::stringstream strm ;
+    MessageLogger logger ;
+
+    //
+    // The writer thread only looks at the ring every 100 ms, so a burst of
+    // messages overflows a small ring
+    //
+    logger.enableType(MessageLogger::MessageType::info) ;
+    logger.addDestination(std::make_shared<MessageDestStream>(strm)) ;
+    logger.startAsync(4, 1.0) ;
+
+    for(int i = 0 ; i < 100 ; i++) {
+        logger.startMessage(MessageLogger::MessageType::info) ;
+        logger << "message " << i ;
+        logger.endMessage() ;
+    }
+
+    logger.stopAsync() ;
+
+    EXPECT_GT(logger.getDroppedCount(), 0u) ;
+    EXPECT_NE(std::string::npos, strm.str().find("messages dropped")) ;
+}
+
+TEST(MessageLoggerTests, GatingTest)
+{
+    std::stringstream strm ;
+    MessageLogger logger ;
+    int evaluated = 0 ;
+    auto arg = [&evaluated]() { evaluated++ ; return std::string("value") ; } ;
+
+    logger.enableType(MessageLogger::MessageType::info) ;
+    logger.enableSubsystem(1ull << 3) ;
+    logger.addDestination(std::make_shared<MessageDestStream>(strm)) ;
+
+    EXPECT_TRUE(logger.isEnabled(MessageLogger::MessageType::info, 1ull << 3)) ;
+    EXPECT_FALSE(logger.isEnabled(MessageLogger::MessageType::info, 1ull << 4)) ;
+    EXPECT_FALSE(logger.isEnabled(MessageLogger::MessageType::debug, 1ull << 3)) ;
+
+    XERO_LOG(logger, MessageLogger::MessageType::info, 1ull << 4, "skipped " << arg()) ;
+    XERO_LOG(logger, MessageLogger::MessageType::debug, 1ull << 3, "skipped " << arg()) ;
+    EXPECT_EQ(0, evaluated) ;
+
+    XERO_LOG(logger, MessageLogger::MessageType::info, 1ull << 3, "logged " << arg()) ;
+    EXPECT_EQ(1, evaluated) ;
+
+    logger.disableType(MessageLogger::MessageType::info) ;
+    logger.startMessage(MessageLogger::MessageType::info, 1ull << 3) ;
+    logger << "not logged" ;
+    logger.endMessage() ;
+
+    EXPECT_EQ("logged value\n", strm.str()) ;
+}
+
+TEST(MessageLoggerTests, CaptureTest)
+{
+    std::stringstream strm ;
+    MessageLogger logger ;
+    MessageLogger::Capture first, second ;
+
+    logger.enableType(MessageLogger::MessageType::info) ;
+    logger.addDestination(std::make_shared<MessageDestStream>(strm)) ;
+
+    //
+    // Each thread keeps its own messages, the log gets them in the order the
+    // captures are written no matter which thread finished first
+    //
+    auto work = [&logger](MessageLogger::Capture &cap, const char *name) {
+        logger.beginCapture(cap) ;
+        for(int i = 0 ; i < 3 ; i++) {
+            logger.startMessage(MessageLogger::MessageType::info) ;
+            logger << name << " " << i ;
+            logger.endMessage() ;
+        }
+        logger.endCapture() ;
+    } ;
+
+    std::thread th(work, std::ref(second), "second") ;
+    work(first, "first") ;
+    th.join() ;
+
+    EXPECT_EQ(3u, first.size()) ;
+    EXPECT_EQ(3u, second.size()) ;
+    EXPECT_EQ("", strm.str()) ;
+
+    logger.writeCapture(first) ;
+    logger.writeCapture(second) ;
+    EXPECT_EQ(0u, first.size()) ;
+    EXPECT_EQ("first 0\nfirst 1\nfirst 2\nsecond 0\nsecond 1\nsecond 2\n", strm.str()) ;
+
+    logger.startMessage(MessageLogger::MessageType::info) ;
+    logger << "direct" ;
+    logger.endMessage() ;
+    EXPECT_NE(std::string::npos, strm.str().find("second 2\ndirect\n")) ;
+}
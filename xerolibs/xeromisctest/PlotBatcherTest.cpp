@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+#include "PlotBatcher.h"
+#include <cstring>
+
+using namespace xero::misc ;
+
+namespace {
+    uint32_t getU32(const std::vector<uint8_t> &packet, size_t pos) {
+        return (static_cast<uint32_t>(packet[pos]) << 24) | (static_cast<uint32_t>(packet[pos + 1]) << 16) |
+                (static_cast<uint32_t>(packet[pos + 2]) << 8) | packet[pos + 3] ;
+    }
+}
+
+TEST(PlotBatcherTests, Batching)
+{
+    std::vector<std::vector<uint8_t>> packets ;
+    PlotBatcher batcher([&packets](const uint8_t *data, size_t size) {
+        packets.push_back(std::vector<uint8_t>(data, data + size)) ;
+        return true ;
+    }) ;
+
+    batcher.startPlot(42, "test", { "time", "value" }) ;
+    ASSERT_EQ(2u, packets.size()) ;
+    EXPECT_EQ(packets[0], packets[1]) ;
+    EXPECT_EQ('X', packets[0][0]) ;
+    EXPECT_EQ('P', packets[0][1]) ;
+    EXPECT_EQ(static_cast<uint8_t>(PlotProtocol::PacketKind::Start), packets[0][3]) ;
+    EXPECT_EQ(0u, getU32(packets[0], 4)) ;
+    EXPECT_EQ(42u, getU32(packets[0], 8)) ;
+
+    //
+    // Rows are held until the flush, then sent as one packet
+    //
+    for(uint32_t row = 0 ; row < 10 ; row++) {
+        double data[] = { row * 0.02, row * 1.5 } ;
+        batcher.addRow(42, row, data, 2) ;
+    }
+    EXPECT_EQ(2u, packets.size()) ;
+    batcher.flush() ;
+    batcher.flush() ;
+    ASSERT_EQ(3u, packets.size()) ;
+
+    const std::vector<uint8_t> &data = packets[2] ;
+    EXPECT_EQ(static_cast<uint8_t>(PlotProtocol::PacketKind::Data), data[3]) ;
+    EXPECT_EQ(1u, getU32(data, 4)) ;
+    EXPECT_EQ(10u, data[PlotProtocol::HeaderSize]) ;
+    EXPECT_EQ(PlotProtocol::HeaderSize + 1 + 10 * (9 + 2 * sizeof(double)), data.size()) ;
+
+    double value ;
+    size_t row9 = PlotProtocol::HeaderSize + 1 + 9 * (9 + 2 * sizeof(double)) ;
+    EXPECT_EQ(42u, getU32(data, row9)) ;
+    EXPECT_EQ(9u, getU32(data, row9 + 4)) ;
+    EXPECT_EQ(2u, data[row9 + 8]) ;
+    memcpy(&value, &data[row9 + 9 + sizeof(double)], sizeof(value)) ;
+    EXPECT_DOUBLE_EQ(13.5, value) ;
+
+    batcher.endPlot(42) ;
+    ASSERT_EQ(5u, packets.size()) ;
+    EXPECT_EQ(2u, getU32(packets[4], 4)) ;
+    EXPECT_EQ(3u, batcher.getSequence()) ;
+}
+
+TEST(PlotBatcherTests, FullPacket)
+{
+    std::vector<size_t> sizes ;
+    PlotBatcher batcher([&sizes](const uint8_t *data, size_t size) {
+        sizes.push_back(size) ;
+        return true ;
+    }) ;
+
+    //
+    // A 17 column row is 145 bytes, so 9 rows fit in a packet
+    //
+    double data[17] = { 0.0 } ;
+    for(uint32_t row = 0 ; row < 20 ; row++)
+        batcher.addRow(1, row, data, 17) ;
+    batcher.flush() ;
+
+    ASSERT_EQ(3u, sizes.size()) ;
+    for(size_t size : sizes)
+        EXPECT_LE(size, PlotProtocol::MaxPacketSize) ;
+    EXPECT_EQ(PlotProtocol::HeaderSize + 1 + 9 * 145, sizes[0]) ;
+    EXPECT_EQ(PlotProtocol::HeaderSize + 1 + 2 * 145, sizes[2]) ;
+}
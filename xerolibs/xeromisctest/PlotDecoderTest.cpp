@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "PlotBatcher.h"
+#include "PlotDecoder.h"
+#include <cmath>
+
+using namespace xero::misc ;
+
+TEST(PlotDecoderTests, RoundTrip)
+{
+    std::vector<std::vector<uint8_t>> packets ;
+    PlotBatcher batcher([&packets](const uint8_t *data, size_t size) {
+        packets.push_back(std::vector<uint8_t>(data, data + size)) ;
+        return true ;
+    }) ;
+
+    batcher.startPlot(7, "path", { "time", "pos", "vel" }) ;
+    for(uint32_t row = 0 ; row < 100 ; row++) {
+        double data[] = { row * 0.02, row * 2.0, 3.0 } ;
+        batcher.addRow(7, row, data, 3) ;
+        if (row % 10 == 9)
+            batcher.flush() ;
+    }
+    batcher.endPlot(7) ;
+
+    std::vector<PlotData> complete ;
+    PlotDecoder decoder ;
+    decoder.setCompleteHandler([&complete](const PlotData &plot) {
+        complete.push_back(plot) ;
+    }) ;
+
+    //
+    // Drop the third data packet, rows 20 to 29
+    //
+    for(size_t i = 0 ; i < packets.size() ; i++) {
+        if (i != 4) {
+            EXPECT_TRUE(decoder.decode(&packets[i][0], packets[i].size(), i * 0.2)) ;
+        }
+    }
+
+    EXPECT_EQ(1u, decoder.getLostCount()) ;
+    EXPECT_EQ(2u, decoder.getDuplicateCount()) ;
+    EXPECT_EQ(0u, decoder.getBadCount()) ;
+    EXPECT_EQ(0u, decoder.getPlots().size()) ;
+
+    ASSERT_EQ(1u, complete.size()) ;
+    const PlotData &plot = complete[0] ;
+    EXPECT_EQ("path", plot.name_) ;
+    EXPECT_TRUE(plot.started_) ;
+    ASSERT_EQ(3u, plot.columns_.size()) ;
+    EXPECT_EQ("vel", plot.columns_[2]) ;
+    EXPECT_EQ(100u, plot.getRowCount()) ;
+    EXPECT_EQ(90u, plot.received_) ;
+    EXPECT_DOUBLE_EQ(198.0, plot.data_[1][99]) ;
+    EXPECT_TRUE(std::isnan(plot.data_[1][25])) ;
+    EXPECT_GT(plot.getRate(), 0.0) ;
+}
+
+TEST(PlotDecoderTests, LostStart)
+{
+    std::vector<std::vector<uint8_t>> packets ;
+    PlotBatcher batcher([&packets](const uint8_t *data, size_t size) {
+        packets.push_back(std::vector<uint8_t>(data, data + size)) ;
+        return true ;
+    }) ;
+
+    batcher.startPlot(3, "lost", { "a", "b" }) ;
+    double data[] = { 1.0, 2.0 } ;
+    batcher.addRow(3, 0, data, 2) ;
+    batcher.flush() ;
+
+    PlotDecoder decoder ;
+    EXPECT_TRUE(decoder.decode(&packets[2][0], packets[2].size(), 0.0)) ;
+    ASSERT_EQ(1u, decoder.getPlots().size()) ;
+
+    const PlotData &plot = decoder.getPlots().begin()->second ;
+    EXPECT_FALSE(plot.started_) ;
+    EXPECT_EQ("col1", plot.columns_[1]) ;
+
+    uint8_t bad[] = { 'X', 'Q', 2, 2, 0, 0, 0, 9 } ;
+    EXPECT_FALSE(decoder.decode(bad, sizeof(bad), 0.0)) ;
+    EXPECT_EQ(1u, decoder.getBadCount()) ;
+}
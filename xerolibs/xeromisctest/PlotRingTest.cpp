@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+#include "PlotRing.h"
+#include "PlotDecoder.h"
+#include "AllocationCounter.h"
+#include <sstream>
+
+using namespace xero::misc ;
+
+TEST(PlotRingTests, SendLater)
+{
+    PlotRing ring(5, "deferred", { "time", "value" }, 8) ;
+
+    //
+    // Adding rows never allocates, and the oldest rows are dropped once the ring is full
+    //
+    size_t before = AllocationCounter::getCount() ;
+    for(uint32_t row = 0 ; row < 10 ; row++) {
+        double data[] = { row * 0.02, row * 1.0 } ;
+        ring.addRow(row, data, 2) ;
+    }
+    EXPECT_EQ(before, AllocationCounter::getCount()) ;
+    EXPECT_EQ(8u, ring.size()) ;
+    EXPECT_EQ(2u, ring.getDropped()) ;
+    ring.end() ;
+
+    std::vector<PlotData> complete ;
+    PlotDecoder decoder ;
+    decoder.setCompleteHandler([&complete](const PlotData &plot) {
+        complete.push_back(plot) ;
+    }) ;
+
+    PlotBatcher batcher([&decoder](const uint8_t *data, size_t size) {
+        return decoder.decode(data, size, 0.0) ;
+    }) ;
+
+    EXPECT_FALSE(ring.send(batcher, 3)) ;
+    batcher.flush() ;
+    EXPECT_FALSE(ring.send(batcher, 3)) ;
+    batcher.flush() ;
+    EXPECT_TRUE(ring.send(batcher, 3)) ;
+
+    ASSERT_EQ(1u, complete.size()) ;
+    EXPECT_EQ("deferred", complete[0].name_) ;
+    EXPECT_EQ(8u, complete[0].received_) ;
+    EXPECT_EQ(10u, complete[0].getRowCount()) ;
+    EXPECT_DOUBLE_EQ(9.0, complete[0].data_[1][9]) ;
+    EXPECT_EQ(0u, decoder.getLostCount()) ;
+}
+
+TEST(PlotRingTests, WriteCSV)
+{
+    PlotRing ring(1, "csv", { "a", "b" }, 4) ;
+    double data[] = { 1.0, 2.0 } ;
+    ring.addRow(0, data, 2) ;
+    ring.addRow(1, data, 1) ;
+
+    std::stringstream strm ;
+    ring.writeCSV(strm) ;
+    EXPECT_EQ("a,b\n1,2\n1,0\n", strm.str()) ;
+    EXPECT_EQ(0u, ring.size()) ;
+}
@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "PoseEstimator.h"
+#include "xeromath.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace xero::misc ;
+
+namespace {
+    const double width = 22.0 ;
+    const PoseEstimator::Noise noise = { 0.01, 0.5, 0.01 } ;
+
+    //
+    // The distance and angle to a target from a robot position
+    //
+    void sight(double x, double y, double angle, double tx, double ty, double &dist, double &yaw) {
+        dist = std::hypot(tx - x, ty - y) ;
+        yaw = xero::math::normalizeAngleDegrees(xero::math::rad2deg(std::atan2(ty - y, tx - x)) - angle) ;
+    }
+}
+
+TEST(PoseEstimatorTests, FollowsWheels)
+{
+    PoseEstimator est(width, 1.0, noise) ;
+
+    //
+    // An arc driven with the wheels alone follows the circle the wheels describe
+    //
+    for(int i = 0 ; i < 100 ; i++)
+        est.predict(1.0, 1.2) ;
+
+    double turn = 100 * 0.2 / width ;
+    double radius = 1.1 / (0.2 / width) ;
+    EXPECT_NEAR(radius * std::sin(turn), est.getX(), 0.01) ;
+    EXPECT_NEAR(radius * (1.0 - std::cos(turn)), est.getY(), 0.01) ;
+    EXPECT_NEAR(xero::math::rad2deg(turn), est.getAngle(), 0.01) ;
+
+    //
+    // The uncertainty grows as the robot moves
+    //
+    double before = est.getCovariance()(0, 0) + est.getCovariance()(1, 1) ;
+    est.predict(10.0, 10.0, 0.0) ;
+    EXPECT_GT(est.getCovariance()(0, 0) + est.getCovariance()(1, 1), before) ;
+}
+
+TEST(PoseEstimatorTests, VisionCorrectsPosition)
+{
+    PoseEstimator est(width, 1.0, noise) ;
+
+    //
+    // The estimate starts 12 inches off in x and 5 degrees off in angle
+    //
+    est.reset(12.0, 0.0, 5.0, 400.0, 100.0) ;
+
+    const double tx = 200.0, ty = 30.0 ;
+    double x = 0.0, y = 0.0, angle = 0.0 ;
+    for(int i = 0 ; i < 50 ; i++) {
+        est.predict(1.0, 1.0, 0.0) ;
+        x += 1.0 ;
+
+        double dist, yaw ;
+        sight(x, y, angle, tx, ty, dist, yaw) ;
+        EXPECT_EQ(PoseEstimator::Result::Accepted, est.updateTarget(tx, ty, dist, yaw, 1.0, 1.0)) ;
+        est.updateAngle(angle, 1.0) ;
+    }
+
+    EXPECT_NEAR(x, est.getX(), 1.0) ;
+    EXPECT_NEAR(y, est.getY(), 1.0) ;
+    EXPECT_NEAR(angle, est.getAngle(), 0.5) ;
+    EXPECT_LT(est.getCovariance()(0, 0), 400.0) ;
+
+    //
+    // A sighting of the wrong target is not believed
+    //
+    double dist, yaw ;
+    sight(x, y, angle, tx, ty + 100.0, dist, yaw) ;
+    EXPECT_EQ(PoseEstimator::Result::Rejected, est.updateTarget(tx, ty, dist, yaw, 1.0, 1.0)) ;
+    EXPECT_EQ(1u, est.getRejectedCount()) ;
+    EXPECT_NEAR(x, est.getX(), 1.0) ;
+
+    EXPECT_EQ(PoseEstimator::Result::Invalid, est.updateTarget(est.getX(), est.getY(), 0.0, 0.0, 1.0, 1.0)) ;
+}
+
+TEST(PoseEstimatorTests, Benchmark)
+{
+    PoseEstimator est(width, 1.0, noise) ;
+    est.reset(0.0, 0.0, 0.0, 100.0, 10.0) ;
+
+    //
+    // One robot loop at 200 Hz odometry: four predictions, a gyro angle and a sighting
+    //
+    const int reps = 100000 ;
+    double dist, yaw ;
+    auto start = std::chrono::steady_clock::now() ;
+    for(int i = 0 ; i < reps ; i++) {
+        for(int j = 0 ; j < 4 ; j++)
+            est.predict(0.25, 0.26, 0.05) ;
+        est.updateAngle(est.getAngle(), 1.0) ;
+        sight(est.getX(), est.getY(), est.getAngle(), 1000.0, 500.0, dist, yaw) ;
+        est.updateTarget(1000.0, 500.0, dist, yaw, 1.0, 1.0) ;
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / reps ;
+
+    std::cout << "    one loop of filter updates: " << us << " us" << std::endl ;
+    EXPECT_LT(us, 100.0) ;
+}
@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+#include "PoseHistory.h"
+#include "xeromath.h"
+#include <thread>
+#include <vector>
+
+using namespace xero::misc ;
+
+namespace {
+    PoseSample makeSample(uint64_t i) {
+        double v = static_cast<double>(i) ;
+        return PoseSample{ v * 0.005, v, v * 2.0, v * 3.0, v * 4.0, v * 5.0 } ;
+    }
+
+    bool consistent(const PoseSample &s) {
+        double v = s.x_ ;
+        return s.time_ == v * 0.005 && s.y_ == v * 2.0 && s.angle_ == v * 3.0 && s.left_ == v * 4.0 && s.right_ == v * 5.0 ;
+    }
+}
+
+TEST(PoseHistoryTests, BasicTest)
+{
+    PoseHistory history(6) ;
+    PoseSample sample ;
+
+    EXPECT_EQ(8u, history.capacity()) ;
+    EXPECT_FALSE(history.getLatest(sample)) ;
+
+    for(uint64_t i = 0 ; i < 3 ; i++)
+        history.add(makeSample(i)) ;
+
+    ASSERT_TRUE(history.getLatest(sample)) ;
+    EXPECT_DOUBLE_EQ(2.0, sample.x_) ;
+    EXPECT_TRUE(consistent(sample)) ;
+
+    PoseSample samples[16] ;
+    ASSERT_EQ(3u, history.getHistory(samples, 16)) ;
+    EXPECT_DOUBLE_EQ(2.0, samples[0].x_) ;
+    EXPECT_DOUBLE_EQ(0.0, samples[2].x_) ;
+
+    //
+    // Once the ring is full the oldest samples are lost
+    //
+    for(uint64_t i = 3 ; i < 20 ; i++)
+        history.add(makeSample(i)) ;
+
+    EXPECT_EQ(20u, history.getCount()) ;
+    ASSERT_EQ(8u, history.getHistory(samples, 16)) ;
+    for(size_t i = 0 ; i < 8 ; i++) {
+        EXPECT_DOUBLE_EQ(19.0 - i, samples[i].x_) ;
+        EXPECT_TRUE(consistent(samples[i])) ;
+    }
+
+    EXPECT_EQ(2u, history.getHistory(samples, 2)) ;
+}
+
+TEST(PoseHistoryTests, ThreadTest)
+{
+    const uint64_t count = 200000 ;
+    PoseHistory history(4) ;
+
+    std::thread writer([&history, count]() {
+        for(uint64_t i = 0 ; i < count ; i++)
+            history.add(makeSample(i)) ;
+    }) ;
+
+    //
+    // The reader never sees a sample made of fields from two different writes, and
+    // never sees time go backwards
+    //
+    double last = -1.0 ;
+    PoseSample samples[4] ;
+    while (history.getCount() < count) {
+        PoseSample sample ;
+        if (history.getLatest(sample)) {
+            ASSERT_TRUE(consistent(sample)) ;
+            ASSERT_GE(sample.x_, last) ;
+            last = sample.x_ ;
+        }
+
+        size_t n = history.getHistory(samples, 4) ;
+        for(size_t i = 0 ; i < n ; i++) {
+            ASSERT_TRUE(consistent(samples[i])) ;
+            if (i > 0) {
+                ASSERT_EQ(samples[i - 1].x_ - 1.0, samples[i].x_) ;
+            }
+        }
+    }
+
+    writer.join() ;
+
+    PoseSample sample ;
+    ASSERT_TRUE(history.getLatest(sample)) ;
+    EXPECT_DOUBLE_EQ(count - 1.0, sample.x_) ;
+}
+
+TEST(PoseHistoryTests, PoseAtTime)
+{
+    PoseHistory history(8) ;
+    PoseSample sample ;
+
+    EXPECT_FALSE(history.getPoseAt(1.0, sample)) ;
+
+    //
+    // Driving along x at 100 inches per second while turning from 170 to -170 degrees
+    //
+    for(int i = 0 ; i < 12 ; i++) {
+        double t = i * 0.005 ;
+        double angle = xero::math::normalizeAngleDegrees(170.0 + i * 2.0) ;
+        history.add(PoseSample{ t, t * 100.0, 1.0, angle, t * 100.0, t * 100.0 }) ;
+    }
+
+    ASSERT_TRUE(history.getPoseAt(0.0525, sample)) ;
+    EXPECT_NEAR(5.25, sample.x_, 1e-9) ;
+    EXPECT_NEAR(1.0, sample.y_, 1e-9) ;
+    EXPECT_NEAR(-169.0, sample.angle_, 1e-9) ;
+    EXPECT_NEAR(0.0525, sample.time_, 1e-12) ;
+
+    ASSERT_TRUE(history.getPoseAt(0.0375, sample)) ;
+    EXPECT_NEAR(3.75, sample.x_, 1e-9) ;
+    EXPECT_NEAR(-175.0, sample.angle_, 1e-9) ;
+
+    //
+    // Newer than the newest sample, and older than the oldest one kept
+    //
+    ASSERT_TRUE(history.getPoseAt(1.0, sample)) ;
+    EXPECT_NEAR(5.5, sample.x_, 1e-9) ;
+    EXPECT_FALSE(history.getPoseAt(0.01, sample)) ;
+}
+
+TEST(PoseHistoryTests, Project)
+{
+    double dist, yaw ;
+
+    //
+    // A target straight ahead, seen before the robot drove 30 inches toward it
+    //
+    PoseSample then{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } ;
+    PoseSample now{ 0.1, 30.0, 0.0, 0.0, 30.0, 30.0 } ;
+    PoseHistory::project(then, now, 100.0, 0.0, dist, yaw) ;
+    EXPECT_NEAR(70.0, dist, 1e-9) ;
+    EXPECT_NEAR(0.0, yaw, 1e-9) ;
+
+    //
+    // The robot turned 10 degrees toward a target that was 10 degrees off
+    //
+    now = PoseSample{ 0.1, 0.0, 0.0, 10.0, 0.0, 0.0 } ;
+    PoseHistory::project(then, now, 50.0, 10.0, dist, yaw) ;
+    EXPECT_NEAR(50.0, dist, 1e-9) ;
+    EXPECT_NEAR(0.0, yaw, 1e-9) ;
+
+    //
+    // Nothing moved
+    //
+    PoseHistory::project(now, now, 40.0, -25.0, dist, yaw) ;
+    EXPECT_NEAR(40.0, dist, 1e-9) ;
+    EXPECT_NEAR(-25.0, yaw, 1e-9) ;
+}
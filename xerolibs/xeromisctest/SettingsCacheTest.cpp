@@ -0,0 +1,177 @@
+#include "gtest/gtest.h"
+#include "SettingsParser.h"
+#include "SettingsCache.h"
+#include "MessageDestStream.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <unistd.h>
+
+using namespace xero::misc ;
+
+namespace {
+    void writeSettings(const std::string &filename, int count) {
+        std::ofstream out(filename) ;
+        out << "robot:name \"phaser\"\n" ;
+        out << "lifter:count " << count << "\n" ;
+        out << "lifter:enabled false\n" ;
+        out << "if COMPETITION\n" ;
+        out << "lifter:maxv 40.5\n" ;
+        out << "endif\n" ;
+        out << "if PRACTICE\n" ;
+        out << "lifter:maxv 30.5\n" ;
+        out << "endif\n" ;
+    }
+
+    bool readCached(const std::string &dat, const std::string &cache, const std::string &define,
+                        SettingsParser &parser) {
+        parser.addDefine(define) ;
+        return parser.readCachedFile(dat, cache) ;
+    }
+}
+
+TEST(SettingsCacheTests, UseAndFallback)
+{
+    char dir[] = "/tmp/settingscacheXXXXXX" ;
+    ASSERT_NE(nullptr, mkdtemp(dir)) ;
+    std::string dat = std::string(dir) + "/robot.dat" ;
+    std::string cache = std::string(dir) + "/robot.datc" ;
+    writeSettings(dat, 3) ;
+
+    std::stringstream log ;
+    MessageLogger logger ;
+    logger.enableType(MessageLogger::MessageType::info) ;
+    logger.addDestination(std::make_shared<MessageDestStream>(log)) ;
+
+    //
+    // The first read parses the text and writes the cache
+    //
+    {
+        SettingsParser parser(logger, 0) ;
+        ASSERT_TRUE(readCached(dat, cache, "COMPETITION", parser)) ;
+        EXPECT_NE(std::string::npos, log.str().find("no cache file")) ;
+        EXPECT_EQ(0, access(cache.c_str(), R_OK)) ;
+    }
+
+    //
+    // The second read uses the cache
+    //
+    {
+        log.str("") ;
+        SettingsParser parser(logger, 0) ;
+        ASSERT_TRUE(readCached(dat, cache, "COMPETITION", parser)) ;
+        EXPECT_NE(std::string::npos, log.str().find("values from cache")) ;
+        EXPECT_EQ("phaser", parser.getString("robot:name")) ;
+        EXPECT_EQ(3, parser.getInteger("lifter:count")) ;
+        EXPECT_FALSE(parser.getBoolean("lifter:enabled")) ;
+        EXPECT_DOUBLE_EQ(40.5, parser.getDouble("lifter:maxv")) ;
+        EXPECT_EQ(4u, parser.getTable().size()) ;
+    }
+
+    //
+    // A different define does not match the cache
+    //
+    {
+        log.str("") ;
+        SettingsParser parser(logger, 0) ;
+        ASSERT_TRUE(readCached(dat, cache, "PRACTICE", parser)) ;
+        EXPECT_NE(std::string::npos, log.str().find("have changed")) ;
+        EXPECT_DOUBLE_EQ(30.5, parser.getDouble("lifter:maxv")) ;
+    }
+
+    //
+    // Neither does a changed settings file
+    //
+    {
+        writeSettings(dat, 4) ;
+        log.str("") ;
+        SettingsParser parser(logger, 0) ;
+        ASSERT_TRUE(readCached(dat, cache, "PRACTICE", parser)) ;
+        EXPECT_NE(std::string::npos, log.str().find("have changed")) ;
+        EXPECT_EQ(4, parser.getInteger("lifter:count")) ;
+    }
+
+    //
+    // A damaged cache is detected by the data checksum
+    //
+    {
+        std::fstream strm(cache, std::ios::in | std::ios::out | std::ios::binary) ;
+        strm.seekp(-2, std::ios::end) ;
+        strm.put('X') ;
+        strm.close() ;
+
+        SettingsTable table ;
+        std::vector<std::string> sources ;
+        std::string why ;
+        EXPECT_FALSE(SettingsCache::read(cache, { "PRACTICE" }, table, sources, why)) ;
+        EXPECT_EQ("cache file is corrupt", why) ;
+        EXPECT_EQ(0u, table.size()) ;
+        EXPECT_TRUE(sources.empty()) ;
+    }
+
+    std::remove(dat.c_str()) ;
+    std::remove(cache.c_str()) ;
+    rmdir(dir) ;
+}
+
+TEST(SettingsCacheTests, ParseNumbers)
+{
+    std::stringstream strm ;
+    strm << "a 12\n" ;
+    strm << "b 0x1F\n" ;
+    strm << "c -3.5e2\n" ;
+    strm << "d 12abc\n" ;
+    strm << "e 99999999999\n" ;
+    strm << "f 1.\n" ;
+
+    MessageLogger logger ;
+    SettingsParser parser(logger, 0) ;
+    ASSERT_TRUE(parser.readStream(strm, "test")) ;
+
+    EXPECT_EQ(12, parser.getInteger("a")) ;
+    EXPECT_EQ(31, parser.getInteger("b")) ;
+    EXPECT_DOUBLE_EQ(-350.0, parser.getDouble("c")) ;
+    EXPECT_FALSE(parser.isDefined("d")) ;
+    EXPECT_TRUE(parser.get("e").isDouble()) ;
+    EXPECT_DOUBLE_EQ(1.0, parser.getDouble("f")) ;
+}
+
+TEST(SettingsCacheTests, SourcesFromCache)
+{
+    char dir[] = "/tmp/settingscacheXXXXXX" ;
+    ASSERT_NE(nullptr, mkdtemp(dir)) ;
+    std::string common = std::string(dir) + "/common.dat" ;
+    std::string dat = std::string(dir) + "/robot.dat" ;
+    std::string cache = std::string(dir) + "/robot.datc" ;
+    writeSettings(dat, 3) ;
+    {
+        std::ofstream out(common) ;
+        out << "common:value 7\n" ;
+    }
+
+    MessageLogger logger ;
+
+    //
+    // The cache is built from both files, and a parser that reads the cache
+    // knows about both of them so they can be watched
+    //
+    {
+        SettingsParser parser(logger, 0) ;
+        ASSERT_TRUE(parser.readFile(common)) ;
+        ASSERT_TRUE(readCached(dat, cache, "COMPETITION", parser)) ;
+    }
+
+    {
+        SettingsParser parser(logger, 0) ;
+        ASSERT_TRUE(readCached(dat, cache, "COMPETITION", parser)) ;
+        EXPECT_EQ(7, parser.getInteger("common:value")) ;
+        ASSERT_EQ(2u, parser.getSources().size()) ;
+        EXPECT_EQ(common, parser.getSources()[0]) ;
+        EXPECT_EQ(dat, parser.getSources()[1]) ;
+    }
+
+    std::remove(common.c_str()) ;
+    std::remove(dat.c_str()) ;
+    std::remove(cache.c_str()) ;
+    rmdir(dir) ;
+}
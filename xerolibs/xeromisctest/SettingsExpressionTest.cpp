@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+#include "SettingsParser.h"
+#include "SettingsExpression.h"
+#include "MessageDestStream.h"
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+using namespace xero::misc ;
+
+TEST(SettingsExpressionTests, Evaluate)
+{
+    SettingsTable table ;
+    table.set("lifter:maxa", Setting(60)) ;
+    table.set("lifter:maxv", Setting(40.0)) ;
+    table.set("lifter:name", Setting(std::string("phaser"))) ;
+
+    Setting result ;
+    std::string error ;
+
+    ASSERT_TRUE(SettingsExpression::evaluate("-lifter:maxa", table, result, error)) ;
+    ASSERT_TRUE(result.isInteger()) ;
+    EXPECT_EQ(-60, result.getInteger()) ;
+
+    ASSERT_TRUE(SettingsExpression::evaluate("(lifter:maxa + 4) * 2 - 3", table, result, error)) ;
+    ASSERT_TRUE(result.isInteger()) ;
+    EXPECT_EQ(125, result.getInteger()) ;
+
+    ASSERT_TRUE(SettingsExpression::evaluate("lifter:maxa * 0.8", table, result, error)) ;
+    ASSERT_TRUE(result.isDouble()) ;
+    EXPECT_DOUBLE_EQ(48.0, result.getDouble()) ;
+
+    ASSERT_TRUE(SettingsExpression::evaluate("lifter:maxa / 8", table, result, error)) ;
+    ASSERT_TRUE(result.isDouble()) ;
+    EXPECT_DOUBLE_EQ(7.5, result.getDouble()) ;
+
+    ASSERT_TRUE(SettingsExpression::evaluate("lifter:maxv / 2 + 1e1", table, result, error)) ;
+    EXPECT_DOUBLE_EQ(30.0, result.getDouble()) ;
+
+    EXPECT_FALSE(SettingsExpression::evaluate("lifter:missing * 2", table, result, error)) ;
+    EXPECT_NE(std::string::npos, error.find("lifter:missing")) ;
+    EXPECT_FALSE(SettingsExpression::evaluate("lifter:name * 2", table, result, error)) ;
+    EXPECT_FALSE(SettingsExpression::evaluate("(1 + 2", table, result, error)) ;
+    EXPECT_FALSE(SettingsExpression::evaluate("1 / 0", table, result, error)) ;
+    EXPECT_FALSE(SettingsExpression::evaluate("1 2", table, result, error)) ;
+    EXPECT_FALSE(SettingsExpression::evaluate("", table, result, error)) ;
+}
+
+TEST(SettingsExpressionTests, NestedConditions)
+{
+    std::stringstream errors ;
+    MessageLogger logger ;
+    logger.enableType(MessageLogger::MessageType::warning) ;
+    logger.addDestination(std::make_shared<MessageDestStream>(errors)) ;
+
+    SettingsParser parser(logger, 0) ;
+    parser.addDefine("COMPETITION") ;
+    parser.addDefine("CAMERA") ;
+
+    std::istringstream strm(
+        "if PRACTICE\n"
+        "robot:id 1\n"
+        "  if CAMERA\n"
+        "  robot:camera 1\n"
+        "  endif\n"
+        "elif COMPETITION\n"
+        "robot:id 2\n"
+        "  if !CAMERA\n"
+        "  robot:camera 0\n"
+        "  else\n"
+        "  robot:camera 2\n"
+        "  endif\n"
+        "robot:after 2\n"
+        "else\n"
+        "robot:id 3\n"
+        "endif\n"
+        "robot:always 4\n") ;
+
+    ASSERT_TRUE(parser.readStream(strm, "test")) ;
+    EXPECT_EQ(2, parser.getInteger("robot:id")) ;
+    EXPECT_EQ(2, parser.getInteger("robot:camera")) ;
+    EXPECT_EQ(2, parser.getInteger("robot:after")) ;
+    EXPECT_EQ(4, parser.getInteger("robot:always")) ;
+    EXPECT_EQ("", errors.str()) ;
+
+    //
+    // An endif without an if is reported and does not change what is read
+    //
+    std::istringstream bad(
+        "if PRACTICE\n"
+        "endif\n"
+        "endif\n"
+        "if PRACTICE\n"
+        "robot:skipped 1\n") ;
+    ASSERT_TRUE(parser.readStream(bad, "bad")) ;
+    EXPECT_FALSE(parser.isDefined("robot:skipped")) ;
+    EXPECT_NE(std::string::npos, errors.str().find("bad: 3: 'endif' without")) ;
+    EXPECT_NE(std::string::npos, errors.str().find("bad: 4: 'if' without")) ;
+}
+
+TEST(SettingsExpressionTests, IncludeAndExpressions)
+{
+    {
+        std::ofstream out("settings_expr_common.dat") ;
+        out << "lifter:maxa 60\n" ;
+        out << "if PRACTICE\n" ;
+        out << "lifter:maxv 30.0\n" ;
+        out << "else\n" ;
+        out << "lifter:maxv 40.0\n" ;
+        out << "endif\n" ;
+    }
+    {
+        std::ofstream out("settings_expr_main.dat") ;
+        out << "include \"settings_expr_common.dat\"\n" ;
+        out << "lifter:maxd = -lifter:maxa              # same as the acceleration\n" ;
+        out << "lifter:slow = lifter:maxv * 0.8\n" ;
+        out << "lifter:bad = lifter:nothere * 2\n" ;
+    }
+
+    std::stringstream errors ;
+    MessageLogger logger ;
+    logger.enableType(MessageLogger::MessageType::warning) ;
+    logger.addDestination(std::make_shared<MessageDestStream>(errors)) ;
+
+    SettingsParser parser(logger, 0) ;
+    ASSERT_TRUE(parser.readFile("settings_expr_main.dat")) ;
+
+    EXPECT_EQ(-60, parser.getInteger("lifter:maxd")) ;
+    EXPECT_DOUBLE_EQ(32.0, parser.getDouble("lifter:slow")) ;
+    EXPECT_FALSE(parser.isDefined("lifter:bad")) ;
+    EXPECT_NE(std::string::npos, errors.str().find("'lifter:nothere' is not defined")) ;
+
+    //
+    // The included file is a source of the settings so the cache checks it too
+    //
+    ASSERT_EQ(2u, parser.getSources().size()) ;
+    EXPECT_EQ("settings_expr_common.dat", parser.getSources()[1]) ;
+
+    //
+    // A file that includes itself is stopped
+    //
+    {
+        std::ofstream out("settings_expr_main.dat") ;
+        out << "include settings_expr_main.dat\n" ;
+    }
+    SettingsParser loop(logger, 0) ;
+    EXPECT_FALSE(loop.readFile("settings_expr_main.dat")) ;
+
+    std::remove("settings_expr_common.dat") ;
+    std::remove("settings_expr_main.dat") ;
+}
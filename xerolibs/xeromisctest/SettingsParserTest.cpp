@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "SettingsParser.h"
+#include "PIDCtrl.h"
+#include "AllocationCounter.h"
+#include <fstream>
+#include <cstdio>
+
+using namespace xero::misc ;
+
+TEST(SettingsParserTests, ReadAndHandles)
+{
+    std::string filename = "settings_parser_test.dat" ;
+    {
+        std::ofstream out(filename) ;
+        out << "lifter:maxv 40.5\n" ;
+        out << "lifter:count 3\n" ;
+        out << "lifter:enabled true    # a comment\n" ;
+        out << "lifter:name \"phaser\"\n" ;
+        out << "lifter:hold:p 0.1\n" ;
+        out << "lifter:hold:i 0.0\n" ;
+        out << "lifter:hold:d 0.02\n" ;
+        out << "lifter:hold:f 0\n" ;
+    }
+
+    MessageLogger logger ;
+    SettingsParser parser(logger, 0) ;
+    ASSERT_TRUE(parser.readFile(filename)) ;
+    std::remove(filename.c_str()) ;
+
+    EXPECT_DOUBLE_EQ(40.5, parser.getDouble("lifter:maxv")) ;
+    EXPECT_EQ(3, parser.getInteger("lifter:count")) ;
+    EXPECT_DOUBLE_EQ(3.0, parser.getDouble("lifter:count")) ;
+    EXPECT_TRUE(parser.getBoolean("lifter:enabled")) ;
+    EXPECT_EQ("phaser", parser.getString("lifter:name")) ;
+    EXPECT_EQ("fallback", parser.getString("lifter:missing", "fallback")) ;
+    EXPECT_FALSE(parser.isDefined("lifter:missing")) ;
+
+    //
+    // Handles are resolved once and then read without any lookup or allocation
+    //
+    SettingRef<double> maxv = parser.getRef<double>("lifter:maxv") ;
+    SettingRef<int> count = parser.getRef<int>("lifter:count") ;
+    size_t before = AllocationCounter::getCount() ;
+    double total = 0.0 ;
+    for(int i = 0 ; i < 100 ; i++)
+        total += maxv.get() + count.get() ;
+    EXPECT_EQ(before, AllocationCounter::getCount()) ;
+    EXPECT_DOUBLE_EQ(4350.0, total) ;
+
+    //
+    // A handle sees later changes, including keys that did not exist when it was resolved
+    //
+    SettingRef<double> later = parser.getRef<double>("lifter:later") ;
+    EXPECT_FALSE(later.isDefined()) ;
+    EXPECT_DOUBLE_EQ(2.0, later.get(2.0)) ;
+    EXPECT_FALSE(parser.isDefined("lifter:later")) ;
+    parser.set("lifter:later", 7.5) ;
+    parser.set("lifter:maxv", 12.0) ;
+    EXPECT_TRUE(later.isDefined()) ;
+    EXPECT_DOUBLE_EQ(7.5, later) ;
+    EXPECT_DOUBLE_EQ(12.0, maxv) ;
+
+    PIDCtrl::SettingRefs refs(parser, "lifter:hold") ;
+    EXPECT_DOUBLE_EQ(0.1, refs.p.get()) ;
+    EXPECT_DOUBLE_EQ(0.02, refs.d.get()) ;
+    EXPECT_DOUBLE_EQ(0.0, refs.f.get()) ;
+}
+
+TEST(SettingsParserTests, TableGrows)
+{
+    SettingsTable table(4) ;
+    std::vector<const Setting *> values ;
+
+    for(int i = 0 ; i < 1000 ; i++) {
+        std::string key = "key:" + std::to_string(i) ;
+        table.set(key, Setting(i)) ;
+        values.push_back(table.find(key)) ;
+    }
+
+    EXPECT_EQ(1000u, table.size()) ;
+    for(int i = 0 ; i < 1000 ; i++) {
+        const Setting *s = table.find("key:" + std::to_string(i)) ;
+        ASSERT_NE(nullptr, s) ;
+        EXPECT_EQ(values[i], s) ;
+        EXPECT_EQ(i, s->getInteger()) ;
+    }
+    EXPECT_EQ(nullptr, table.find("key:1000")) ;
+
+    table.clear() ;
+    EXPECT_EQ(0u, table.size()) ;
+    EXPECT_FALSE(values[0]->isValid()) ;
+    EXPECT_EQ(values[0], table.find("key:0")) ;
+}
+
+TEST(SettingsParserTests, InternedStrings)
+{
+    Setting a(std::string("hello")) ;
+    Setting b("hello") ;
+    Setting c("world") ;
+
+    EXPECT_TRUE(a == b) ;
+    EXPECT_TRUE(a != c) ;
+    EXPECT_EQ(&a.getString(), &b.getString()) ;
+    EXPECT_LE(sizeof(Setting), 16u) ;
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "SettingsWatcher.h"
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace xero::misc ;
+
+namespace {
+    void writeSettings(const std::string &filename, double maxv) {
+        std::ofstream out(filename) ;
+        out << "lifter:maxv " << maxv << "\n" ;
+        out << "if PRACTICE\n" ;
+        out << "lifter:maxa 100.0\n" ;
+        out << "endif\n" ;
+        out << "if COMPETITION\n" ;
+        out << "lifter:maxa 200.0\n" ;
+        out << "endif\n" ;
+    }
+
+    size_t waitForChanges(SettingsParser &parser, double seconds) {
+        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<int>(seconds * 1000)) ;
+        while (std::chrono::steady_clock::now() < end) {
+            size_t changed = parser.applyPending() ;
+            if (changed > 0)
+                return changed ;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10)) ;
+        }
+        return 0 ;
+    }
+}
+
+TEST(SettingsWatcherTests, FileReload)
+{
+    char dir[] = "/tmp/settingswatchXXXXXX" ;
+    ASSERT_NE(nullptr, mkdtemp(dir)) ;
+    std::string filename = std::string(dir) + "/robot.dat" ;
+    writeSettings(filename, 40.0) ;
+
+    MessageLogger logger ;
+    SettingsParser parser(logger, 0) ;
+    parser.addDefine("COMPETITION") ;
+    ASSERT_TRUE(parser.readFile(filename)) ;
+
+    SettingRef<double> maxv = parser.getRef<double>("lifter:maxv") ;
+    int notified = 0 ;
+    parser.addChangeListener("lifter:maxv", [&notified](const std::string &key, const Setting &value) {
+        EXPECT_EQ("lifter:maxv", key) ;
+        EXPECT_DOUBLE_EQ(55.0, value.getDouble()) ;
+        notified++ ;
+    }) ;
+
+    SettingsWatcher watcher(parser, filename) ;
+    ASSERT_TRUE(watcher.start()) ;
+
+    //
+    // Nothing changes until the owner of the parser applies the new values
+    //
+    writeSettings(filename, 55.0) ;
+    EXPECT_DOUBLE_EQ(40.0, maxv.get()) ;
+    EXPECT_EQ(1u, waitForChanges(parser, 5.0)) ;
+    EXPECT_DOUBLE_EQ(55.0, maxv.get()) ;
+    EXPECT_DOUBLE_EQ(200.0, parser.getDouble("lifter:maxa")) ;
+    EXPECT_EQ(1, notified) ;
+
+    watcher.stop() ;
+    EXPECT_FALSE(watcher.isRunning()) ;
+
+    std::remove(filename.c_str()) ;
+    rmdir(dir) ;
+}
+
+TEST(SettingsWatcherTests, TextUpdate)
+{
+    MessageLogger logger ;
+    SettingsParser parser(logger, 0) ;
+    parser.set("drivebyvision:yaw_p", 0.01) ;
+    parser.set("drivebyvision:yaw_base_power", 0.3) ;
+
+    std::vector<std::string> changed ;
+    parser.addChangeListener([&changed](const std::string &key, const Setting &value) {
+        changed.push_back(key) ;
+    }) ;
+
+    SettingsWatcher watcher(parser, "unused.dat") ;
+    EXPECT_TRUE(watcher.update("drivebyvision:yaw_p 0.02\ndrivebyvision:yaw_base_power 0.3\n", "test")) ;
+    EXPECT_EQ(1u, watcher.getUpdateCount()) ;
+    EXPECT_DOUBLE_EQ(0.01, parser.getDouble("drivebyvision:yaw_p")) ;
+
+    EXPECT_EQ(1u, parser.applyPending()) ;
+    EXPECT_DOUBLE_EQ(0.02, parser.getDouble("drivebyvision:yaw_p")) ;
+    ASSERT_EQ(1u, changed.size()) ;
+    EXPECT_EQ("drivebyvision:yaw_p", changed[0]) ;
+    EXPECT_EQ(0u, parser.applyPending()) ;
+}
@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+#include "SocketWatcher.h"
+#include "UdpReceiver.h"
+#include "UdpSender.h"
+#include <chrono>
+#include <thread>
+
+using namespace xero::misc ;
+
+namespace {
+    //
+    // Run robot loops until the source has an event, or a second goes by
+    //
+    bool waitForEvent(EventQueue &queue, size_t id) {
+        for(int i = 0 ; i < 100 ; i++) {
+            queue.collect() ;
+            if (queue.hasEvent(id))
+                return true ;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10)) ;
+        }
+        return false ;
+    }
+}
+
+TEST(SocketWatcherTests, PostsWhenDataArrives)
+{
+    const uint16_t port = 5817 ;
+    EventQueue queue ;
+    SocketWatcher watcher(queue) ;
+    UdpReceiver receiver ;
+    UdpSender sender ;
+
+    receiver.setBlocking(false) ;
+    ASSERT_TRUE(receiver.open("127.0.0.1", port)) ;
+    ASSERT_TRUE(sender.open("127.0.0.1", port)) ;
+
+    size_t id = queue.addSource("socket") ;
+    ASSERT_TRUE(watcher.add(receiver.getDescriptor(), id)) ;
+    EXPECT_TRUE(watcher.isRunning()) ;
+
+    //
+    // Only the event every new source starts with, nothing arrived yet
+    //
+    queue.collect() ;
+    EXPECT_TRUE(queue.hasEvent(id)) ;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)) ;
+    queue.collect() ;
+    EXPECT_FALSE(queue.hasEvent(id)) ;
+
+    ASSERT_TRUE(sender.send(std::string("one"))) ;
+    ASSERT_TRUE(sender.send(std::string("two"))) ;
+    ASSERT_TRUE(waitForEvent(queue, id)) ;
+
+    std::vector<uint8_t> data(128) ;
+    int packets = 0 ;
+    while (packets < 2 && receiver.receive(data) != -1)
+        packets++ ;
+    EXPECT_EQ(2, packets) ;
+
+    ASSERT_TRUE(sender.send(std::string("three"))) ;
+    EXPECT_TRUE(waitForEvent(queue, id)) ;
+
+    watcher.stop() ;
+    EXPECT_FALSE(watcher.isRunning()) ;
+}
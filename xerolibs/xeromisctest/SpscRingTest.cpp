@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include "SpscRing.h"
+#include <thread>
+
+using namespace xero::misc ;
+
+TEST(SpscRingTests, BasicTest)
+{
+    SpscRing<int> ring(3) ;
+
+    EXPECT_EQ(4u, ring.capacity()) ;
+    EXPECT_TRUE(ring.empty()) ;
+    EXPECT_EQ(nullptr, ring.front()) ;
+
+    for(int i = 0 ; i < 4 ; i++)
+        EXPECT_TRUE(ring.push(i)) ;
+
+    EXPECT_FALSE(ring.push(4)) ;
+    EXPECT_EQ(4u, ring.size()) ;
+
+    for(int i = 0 ; i < 4 ; i++) {
+        ASSERT_NE(nullptr, ring.front()) ;
+        EXPECT_EQ(i, *ring.front()) ;
+        ring.pop() ;
+    }
+
+    EXPECT_TRUE(ring.empty()) ;
+}
+
+TEST(SpscRingTests, ThreadTest)
+{
+    const int count = 100000 ;
+    SpscRing<int> ring(64) ;
+
+    std::thread producer([&ring, count]() {
+        for(int i = 0 ; i < count ; i++) {
+            while (!ring.push(i))
+                std::this_thread::yield() ;
+        }
+    }) ;
+
+    int expected = 0 ;
+    while (expected < count) {
+        int *value_p = ring.front() ;
+        if (value_p == nullptr) {
+            std::this_thread::yield() ;
+            continue ;
+        }
+
+        ASSERT_EQ(expected, *value_p) ;
+        ring.pop() ;
+        expected++ ;
+    }
+
+    producer.join() ;
+    EXPECT_TRUE(ring.empty()) ;
+}
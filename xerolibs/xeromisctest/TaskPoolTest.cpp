@@ -0,0 +1,154 @@
+#include "gtest/gtest.h"
+#include "TaskPool.h"
+#include "MessageLogger.h"
+#include "MessageDestStream.h"
+#include "AllocationCounter.h"
+#include <sstream>
+#include <chrono>
+#include <vector>
+
+using namespace xero::misc ;
+
+namespace {
+    class CountTask : public TaskPool::Task {
+    public:
+        CountTask(size_t count) : counts_(count) {
+            for(auto &c : counts_)
+                c = 0 ;
+        }
+
+        virtual void runTask(size_t index) {
+            counts_[index]++ ;
+        }
+
+        std::vector<std::atomic<int>> counts_ ;
+    } ;
+
+    class NestedTask : public TaskPool::Task {
+    public:
+        NestedTask(TaskPool &pool) : pool_(pool), inner_(4) {
+        }
+
+        virtual void runTask(size_t index) {
+            pool_.run(inner_, inner_.counts_.size()) ;
+        }
+
+        TaskPool &pool_ ;
+        CountTask inner_ ;
+    } ;
+
+    //
+    // Stands in for a set of subsystems whose computeState() blocks on a hardware
+    // read and then logs what it read
+    //
+    class SensorTask : public TaskPool::Task {
+    public:
+        SensorTask(MessageLogger &logger, size_t count) : logger_(logger), captures_(count), values_(count) {
+        }
+
+        virtual void runTask(size_t index) {
+            logger_.beginCapture(captures_[index]) ;
+            std::this_thread::sleep_for(std::chrono::milliseconds(2)) ;
+            values_[index] = static_cast<int>(index * 10 + loop_) ;
+            logger_.startMessage(MessageLogger::MessageType::info) ;
+            logger_ << "sensor " << static_cast<uint32_t>(index) << " read " << values_[index] ;
+            logger_.endMessage() ;
+            logger_.endCapture() ;
+        }
+
+        void loop(TaskPool &pool, int loop) {
+            loop_ = loop ;
+            pool.run(*this, captures_.size()) ;
+            for(auto &cap : captures_)
+                logger_.writeCapture(cap) ;
+        }
+
+        MessageLogger &logger_ ;
+        std::vector<MessageLogger::Capture> captures_ ;
+        std::vector<int> values_ ;
+        int loop_ ;
+    } ;
+
+    double runLoops(TaskPool &pool, std::string &log) {
+        std::stringstream strm ;
+        MessageLogger logger ;
+        logger.enableType(MessageLogger::MessageType::info) ;
+        logger.addDestination(std::make_shared<MessageDestStream>(strm)) ;
+
+        SensorTask task(logger, 4) ;
+        auto start = std::chrono::steady_clock::now() ;
+        for(int i = 0 ; i < 20 ; i++)
+            task.loop(pool, i) ;
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() ;
+
+        log = strm.str() ;
+        return elapsed ;
+    }
+}
+
+TEST(TaskPoolTests, RunsEachPieceOnce)
+{
+    TaskPool pool(3) ;
+    CountTask task(100) ;
+
+    for(int i = 0 ; i < 50 ; i++)
+        pool.run(task, task.counts_.size()) ;
+
+    for(auto &c : task.counts_)
+        EXPECT_EQ(50, c.load()) ;
+    EXPECT_EQ(50u, pool.getBatchCount()) ;
+}
+
+TEST(TaskPoolTests, NoThreadsRunsInline)
+{
+    TaskPool pool(0) ;
+    CountTask task(5) ;
+
+    pool.run(task, task.counts_.size()) ;
+    for(auto &c : task.counts_)
+        EXPECT_EQ(1, c.load()) ;
+    EXPECT_EQ(0u, pool.getBatchCount()) ;
+}
+
+TEST(TaskPoolTests, NestedRunsInline)
+{
+    TaskPool pool(2) ;
+    NestedTask task(pool) ;
+
+    pool.run(task, 3) ;
+    for(auto &c : task.inner_.counts_)
+        EXPECT_EQ(3, c.load()) ;
+    EXPECT_EQ(1u, pool.getBatchCount()) ;
+}
+
+TEST(TaskPoolTests, NoAllocationsPerBatch)
+{
+    TaskPool pool(2) ;
+    CountTask task(8) ;
+    pool.run(task, task.counts_.size()) ;
+
+    //
+    // The pieces run on the pool threads as well, so check the count for all threads
+    //
+    size_t before = AllocationCounter::getTotalCount() ;
+    for(int i = 0 ; i < 100 ; i++)
+        pool.run(task, task.counts_.size()) ;
+    EXPECT_EQ(before, AllocationCounter::getTotalCount()) ;
+}
+
+TEST(TaskPoolTests, SimulatedSensorsSameLog)
+{
+    TaskPool serial(0) ;
+    TaskPool parallel(3) ;
+    std::string serial_log, parallel_log ;
+
+    double serial_time = runLoops(serial, serial_log) ;
+    double parallel_time = runLoops(parallel, parallel_log) ;
+
+    std::cout << "    serial: " << serial_time * 1000.0 / 20 << " ms per loop" << std::endl ;
+    std::cout << "    parallel: " << parallel_time * 1000.0 / 20 << " ms per loop" << std::endl ;
+
+    EXPECT_EQ(serial_log, parallel_log) ;
+    EXPECT_NE(std::string::npos, parallel_log.find("sensor 3 read 49\n")) ;
+    EXPECT_LT(parallel_time, serial_time) ;
+}
@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include "XeroPathFile.h"
+#include "XeroPathManager.h"
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace xero::misc ;
+
+namespace {
+    const char *dir = "xero_path_file_test" ;
+
+    void writeCSV(const std::string &filename, double offset, size_t rows) {
+        std::ofstream out(filename) ;
+        out << "dt,x,y,position,velocity,acceleration,jerk,heading\n" ;
+        for(size_t i = 0 ; i < rows ; i++) {
+            out << "0.02," << offset + i << "," << offset + 2 * i << "," << i * 0.5 << ",";
+            out << 10.0 + offset << ",1.5,-2.5," << 0.01 * i << "\n" ;
+        }
+    }
+}
+
+TEST(XeroPathFileTests, CompileAndLoadLazily)
+{
+    ::mkdir(dir, 0755) ;
+    std::string base = dir ;
+    writeCSV(base + "/First.left.pf1.csv", 100.0, 20) ;
+    writeCSV(base + "/First.right.pf1.csv", 200.0, 20) ;
+    writeCSV(base + "/Second.left.pf1.csv", 300.0, 7) ;
+    writeCSV(base + "/Second.right.pf1.csv", 400.0, 7) ;
+
+    std::vector<std::string> names = XeroPathManager::findCSVPaths(base) ;
+    ASSERT_EQ(2u, names.size()) ;
+    EXPECT_EQ("First", names[0]) ;
+    EXPECT_EQ("Second", names[1]) ;
+
+    //
+    // The paths read from the CSV files are the reference
+    //
+    XeroPathManager csv(base) ;
+    EXPECT_FALSE(csv.hasCompiledFile()) ;
+    ASSERT_TRUE(csv.loadPath("First")) ;
+    ASSERT_TRUE(csv.loadPath("Second")) ;
+    EXPECT_FALSE(csv.loadPath("Missing")) ;
+
+    std::vector<XeroPathFile::PathData> paths ;
+    for(const std::string &name : names) {
+        XeroPathFile::PathData data ;
+        ASSERT_TRUE(XeroPathManager::readCSV(base, name, data)) ;
+        paths.push_back(data) ;
+    }
+    std::string compiled = base + "/" + XeroPathManager::CompiledFileName ;
+    ASSERT_TRUE(XeroPathFile::write(compiled, paths)) ;
+
+    XeroPathManager mgr(base) ;
+    ASSERT_TRUE(mgr.hasCompiledFile()) ;
+    EXPECT_TRUE(mgr.loadPath("First")) ;
+    EXPECT_TRUE(mgr.hasPath("Second")) ;
+    EXPECT_FALSE(mgr.hasPath("Missing")) ;
+    EXPECT_EQ(0u, mgr.getLoadedCount()) ;
+
+    for(const std::string &name : names) {
+        auto expected = csv.getPath(name) ;
+        auto path = mgr.getPath(name) ;
+        ASSERT_NE(nullptr, path) ;
+        ASSERT_EQ(expected->size(), path->size()) ;
+        EXPECT_EQ(name, path->getName()) ;
+
+        for(size_t i = 0 ; i < path->size() ; i++) {
+            const XeroSegment &a = expected->getLeftSegment(i) ;
+            const XeroSegment &b = path->getLeftSegment(i) ;
+            EXPECT_EQ(a.getX(), b.getX()) ;
+            EXPECT_EQ(a.getY(), b.getY()) ;
+            EXPECT_EQ(a.getPOS(), b.getPOS()) ;
+            EXPECT_EQ(a.getVelocity(), b.getVelocity()) ;
+            EXPECT_EQ(a.getAccel(), b.getAccel()) ;
+            EXPECT_EQ(a.getJerk(), b.getJerk()) ;
+            EXPECT_EQ(a.getHeading(), b.getHeading()) ;
+
+            EXPECT_EQ(expected->getRightSegment(i).getX(), path->getRightSegment(i).getX()) ;
+            EXPECT_EQ(expected->getRightSegment(i).getHeading(), path->getRightSegment(i).getHeading()) ;
+        }
+    }
+    EXPECT_EQ(2u, mgr.getLoadedCount()) ;
+    EXPECT_EQ(mgr.getPath("First"), mgr.getPath("First")) ;
+
+    //
+    // The PathWeaver sides are swapped
+    //
+    EXPECT_DOUBLE_EQ(200.0, mgr.getPath("First")->getLeftSegment(0).getX()) ;
+
+    //
+    // A file with a different format is not used
+    //
+    {
+        std::ofstream out(compiled, std::ios::binary | std::ios::trunc) ;
+        out << "not a path file, just some text" ;
+    }
+    XeroPathManager bad(base) ;
+    EXPECT_FALSE(bad.hasCompiledFile()) ;
+    EXPECT_EQ("path file has the wrong format", bad.getCompiledFileError()) ;
+
+    std::remove(compiled.c_str()) ;
+    for(const std::string &name : names) {
+        std::remove((base + "/" + name + ".left.pf1.csv").c_str()) ;
+        std::remove((base + "/" + name + ".right.pf1.csv").c_str()) ;
+    }
+    ::rmdir(dir) ;
+}
+
+TEST(XeroPathFileTests, CorruptCounts)
+{
+    const char *filename = "xero_path_file_corrupt.bin" ;
+    XeroPathFile::PathData data ;
+    data.name_ = "Short" ;
+    data.dt_ = 0.02 ;
+    for(int i = 0 ; i < 4 ; i++) {
+        XeroPathFile::Row row ;
+        row.fill(i * 1.0) ;
+        data.left_.push_back(row) ;
+        data.right_.push_back(row) ;
+    }
+    ASSERT_TRUE(XeroPathFile::write(filename, { data })) ;
+
+    std::string good ;
+    {
+        std::ifstream in(filename, std::ios::binary) ;
+        good.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()) ;
+    }
+
+    auto patch = [&](size_t offset, uint32_t value) {
+        std::string bytes = good ;
+        std::memcpy(&bytes[offset], &value, sizeof(value)) ;
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc) ;
+        out << bytes ;
+    } ;
+
+    XeroPathFile file ;
+    std::string why ;
+
+    //
+    // Counts whose sizes wrap around to a small number in 32 bits must still be
+    // seen as past the end of the file
+    //
+    patch(8, 0x08000000u) ;
+    EXPECT_FALSE(file.open(filename, why)) ;
+    EXPECT_EQ("path file is truncated", why) ;
+
+    patch(XeroPathFile::HeaderSize + 8, 38347923u) ;
+    EXPECT_FALSE(file.open(filename, why)) ;
+    EXPECT_EQ("path file is truncated", why) ;
+    EXPECT_TRUE(file.getPathNames().empty()) ;
+
+    patch(XeroPathFile::HeaderSize + 8, 4u) ;
+    EXPECT_TRUE(file.open(filename, why)) ;
+    EXPECT_TRUE(file.hasPath("Short")) ;
+
+    file.close() ;
+    std::remove(filename) ;
+}
@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+#include "XeroPathGenerator.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace xero::misc ;
+
+namespace {
+    const double width = 22.0 ;
+    const XeroPathGenerator::Constraints limits = { 60.0, 60.0, 80.0 } ;
+
+    //
+    // Check the limits and continuity of a path
+    //
+    void checkPath(const XeroPath &path, const XeroPathGenerator::Constraints &c) {
+        //
+        // The wheel velocities can be a little over the limit between the spline samples
+        //
+        const double *lvel = path.getColumn(XeroPath::Side::Left, XeroPath::Column::Velocity) ;
+        const double *rvel = path.getColumn(XeroPath::Side::Right, XeroPath::Column::Velocity) ;
+        const double *cvel = path.getColumn(XeroPath::Side::Center, XeroPath::Column::Velocity) ;
+        const double *caccel = path.getColumn(XeroPath::Side::Center, XeroPath::Column::Acceleration) ;
+        const double *lpos = path.getColumn(XeroPath::Side::Left, XeroPath::Column::Position) ;
+        const double *rpos = path.getColumn(XeroPath::Side::Right, XeroPath::Column::Position) ;
+
+        EXPECT_DOUBLE_EQ(0.0, cvel[0]) ;
+        EXPECT_DOUBLE_EQ(0.0, cvel[path.size() - 1]) ;
+
+        for(size_t i = 0 ; i < path.size() ; i++) {
+            EXPECT_LE(lvel[i], c.maxv_ * 1.001) ;
+            EXPECT_LE(rvel[i], c.maxv_ * 1.001) ;
+            EXPECT_LE(std::fabs(caccel[i]), c.maxa_ + 1e-6) ;
+
+            if (i > 0) {
+                //
+                // Each side moves about as far in a step as its velocity says
+                //
+                double dt = path.getTimeStep() ;
+                EXPECT_NEAR((lvel[i] + lvel[i - 1]) * dt / 2.0, lpos[i] - lpos[i - 1], 0.05) ;
+                EXPECT_NEAR((rvel[i] + rvel[i - 1]) * dt / 2.0, rpos[i] - rpos[i - 1], 0.05) ;
+            }
+        }
+    }
+}
+
+TEST(XeroPathGeneratorTests, Straight)
+{
+    XeroPathGenerator gen(width) ;
+    auto path = gen.generate("straight", { { 0.0, 0.0, 0.0 }, { 120.0, 0.0, 0.0 } }, limits) ;
+    ASSERT_NE(nullptr, path) ;
+    checkPath(*path, limits) ;
+
+    //
+    // A straight line is a trapezoid, accelerate for one second, cruise for one, and decelerate
+    //
+    EXPECT_NEAR(3.0, path->getDuration(), 0.05) ;
+
+    size_t last = path->size() - 1 ;
+    EXPECT_NEAR(120.0, path->getColumn(XeroPath::Side::Center, XeroPath::Column::Position)[last], 1e-6) ;
+    EXPECT_NEAR(120.0, path->getColumn(XeroPath::Side::Left, XeroPath::Column::Position)[last], 1e-6) ;
+    EXPECT_NEAR(-11.0, path->getColumn(XeroPath::Side::Left, XeroPath::Column::Y)[0], 1e-9) ;
+    EXPECT_NEAR(11.0, path->getColumn(XeroPath::Side::Right, XeroPath::Column::Y)[0], 1e-9) ;
+    EXPECT_NEAR(60.0, path->sample(XeroPath::Side::Center, 1.5).vel_, 1e-6) ;
+}
+
+TEST(XeroPathGeneratorTests, Turn)
+{
+    XeroPathGenerator gen(width) ;
+    std::vector<XeroPathGenerator::Waypoint> points = {
+        { 0.0, 0.0, 0.0 }, { 100.0, 50.0, 90.0 }, { 60.0, 140.0, 180.0 }
+    } ;
+    auto path = gen.generate("turn", points, limits) ;
+    ASSERT_NE(nullptr, path) ;
+    checkPath(*path, limits) ;
+
+    size_t last = path->size() - 1 ;
+    EXPECT_NEAR(60.0, path->getColumn(XeroPath::Side::Center, XeroPath::Column::X)[last], 1e-6) ;
+    EXPECT_NEAR(140.0, path->getColumn(XeroPath::Side::Center, XeroPath::Column::Y)[last], 1e-6) ;
+    EXPECT_NEAR(180.0, std::fabs(path->getColumn(XeroPath::Side::Center, XeroPath::Column::Heading)[last]), 1e-6) ;
+
+    //
+    // The left side is on the outside of a counter clockwise turn, and the centripetal
+    // acceleration stays under its limit
+    //
+    const double *lpos = path->getColumn(XeroPath::Side::Left, XeroPath::Column::Position) ;
+    const double *rpos = path->getColumn(XeroPath::Side::Right, XeroPath::Column::Position) ;
+    EXPECT_NEAR(width * xero::math::PI / 2.0 * 2.0, lpos[last] - rpos[last], 1e-3) ;
+
+    const double *lvel = path->getColumn(XeroPath::Side::Left, XeroPath::Column::Velocity) ;
+    const double *rvel = path->getColumn(XeroPath::Side::Right, XeroPath::Column::Velocity) ;
+    const double *cvel = path->getColumn(XeroPath::Side::Center, XeroPath::Column::Velocity) ;
+    for(size_t i = 0 ; i < path->size() ; i++) {
+        double curvature = (lvel[i] - rvel[i]) / width / std::max(cvel[i], 1e-9) ;
+        EXPECT_LE(cvel[i] * cvel[i] * std::fabs(curvature), limits.maxcentripetal_ * 1.05) ;
+    }
+
+    EXPECT_EQ(nullptr, gen.generate("bad", { { 0.0, 0.0, 0.0 } }, limits)) ;
+    EXPECT_EQ(nullptr, gen.generate("bad", { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } }, limits)) ;
+}
+
+TEST(XeroPathGeneratorTests, Cache)
+{
+    XeroPathGenerator gen(width) ;
+    std::vector<XeroPathGenerator::Waypoint> points = { { 0.0, 0.0, 0.0 }, { 100.0, 30.0, 0.0 } } ;
+
+    auto first = gen.getPath("first", points, limits) ;
+    EXPECT_EQ(first, gen.getPath("first", points, limits)) ;
+    EXPECT_EQ("first", first->getName()) ;
+    EXPECT_EQ(1u, gen.getCacheSize()) ;
+
+    //
+    // The name is stored in the path, so the same points under another name are a new path
+    //
+    auto again = gen.getPath("again", points, limits) ;
+    EXPECT_NE(first, again) ;
+    EXPECT_EQ("again", again->getName()) ;
+    EXPECT_EQ(first->size(), again->size()) ;
+    EXPECT_EQ(2u, gen.getCacheSize()) ;
+
+    XeroPathGenerator::Constraints slower = { 30.0, 60.0, 80.0 } ;
+    EXPECT_NE(first, gen.getPath("first", points, slower)) ;
+    EXPECT_EQ(3u, gen.getCacheSize()) ;
+
+    for(size_t i = 0 ; i < XeroPathGenerator::MaxCacheSize + 4 ; i++)
+        gen.getPath("many", { { 0.0, 0.0, 0.0 }, { 50.0 + i, 0.0, 0.0 } }, limits) ;
+    EXPECT_EQ(XeroPathGenerator::MaxCacheSize, gen.getCacheSize()) ;
+
+    gen.clearCache() ;
+    EXPECT_EQ(0u, gen.getCacheSize()) ;
+}
+
+TEST(XeroPathGeneratorTests, Benchmark)
+{
+    //
+    // Generation time against path length, in inches, for an S shaped path
+    //
+    XeroPathGenerator gen(width) ;
+    const int reps = 20 ;
+    double time5m = 0.0 ;
+
+    for(double meters = 1.0 ; meters <= 8.0 ; meters += 1.0) {
+        double len = meters * 39.37 ;
+        std::vector<XeroPathGenerator::Waypoint> points = {
+            { 0.0, 0.0, 0.0 }, { len / 2.0, len / 8.0, 30.0 }, { len, 0.0, 0.0 }
+        } ;
+
+        size_t rows = 0 ;
+        auto start = std::chrono::steady_clock::now() ;
+        for(int i = 0 ; i < reps ; i++)
+            rows = gen.generate("bench", points, limits)->size() ;
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / reps ;
+
+        std::cout << "    " << meters << " m: " << rows << " rows, " << us << " us" << std::endl ;
+        if (meters == 5.0)
+            time5m = us ;
+    }
+
+    EXPECT_LT(time5m, 5000.0) ;
+}
@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "XeroPathLoader.h"
+#include "XeroPathManager.h"
+#include <fstream>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace xero::misc ;
+
+namespace {
+    const char *dir = "xero_path_loader_test" ;
+
+    void writeCSV(const std::string &filename, double offset, size_t rows) {
+        std::ofstream out(filename) ;
+        out << "dt,x,y,position,velocity,acceleration,jerk,heading\n" ;
+        for(size_t i = 0 ; i < rows ; i++) {
+            out << "0.02," << offset + i << "," << offset + 2 * i << "," << i * 0.5 << ",";
+            out << 10.0 + offset << ",1.5,-2.5," << 0.01 * i << "\n" ;
+        }
+    }
+
+    std::shared_ptr<XeroPath> makePath(const std::string &name) {
+        std::vector<XeroSegment> left, right ;
+        left.push_back(XeroSegment(0, 0, 0, 0, 0, 0, 0)) ;
+        right.push_back(XeroSegment(0, 0, 0, 0, 0, 0, 0)) ;
+        return std::make_shared<XeroPath>(name, std::move(left), std::move(right), 0.02) ;
+    }
+}
+
+TEST(XeroPathLoaderTests, PrioritizedJobsRunFirst)
+{
+    XeroPathLoader loader ;
+    std::promise<void> gate ;
+    std::shared_future<void> open = gate.get_future().share() ;
+
+    std::mutex lock ;
+    std::vector<std::string> order ;
+    auto job = [&lock, &order](const std::string &name) {
+        return [&lock, &order, name] {
+            std::lock_guard<std::mutex> guard(lock) ;
+            order.push_back(name) ;
+            return makePath(name) ;
+        } ;
+    } ;
+
+    //
+    // The first job holds the thread until the others are queued
+    //
+    auto blocked = loader.submit("gate", [open] { open.wait() ; return makePath("gate") ; }) ;
+    auto a = loader.submit("a", job("a")) ;
+    auto b = loader.submit("b", job("b")) ;
+    auto c = loader.submit("c", job("c")) ;
+    auto d = loader.submit("d", job("d"), true) ;
+    loader.prioritize({ "c", "b" }) ;
+    EXPECT_EQ(5u, loader.getPendingCount()) ;
+
+    EXPECT_EQ(std::future_status::timeout, a.wait_for(std::chrono::milliseconds(0))) ;
+    gate.set_value() ;
+
+    ASSERT_NE(nullptr, a.get()) ;
+    EXPECT_EQ("a", a.get()->getName()) ;
+    EXPECT_EQ("gate", blocked.get()->getName()) ;
+    b.get() ;
+    c.get() ;
+    d.get() ;
+
+    std::vector<std::string> expected = { "c", "b", "d", "a" } ;
+    EXPECT_EQ(expected, order) ;
+}
+
+TEST(XeroPathLoaderTests, FailedJobsReturnNull)
+{
+    XeroPathLoader loader ;
+    auto bad = loader.submit("bad", []() -> std::shared_ptr<XeroPath> { throw std::runtime_error("bad path") ; }) ;
+    EXPECT_EQ(nullptr, bad.get()) ;
+
+    auto good = loader.submit("good", [] { return makePath("good") ; }) ;
+    ASSERT_NE(nullptr, good.get()) ;
+    EXPECT_EQ(0u, loader.getPendingCount()) ;
+}
+
+TEST(XeroPathLoaderTests, ManagerLoadsInBackground)
+{
+    ::mkdir(dir, 0755) ;
+    std::string base = dir ;
+    writeCSV(base + "/First.left.pf1.csv", 100.0, 20) ;
+    writeCSV(base + "/First.right.pf1.csv", 200.0, 20) ;
+
+    XeroPathManager mgr(base) ;
+    EXPECT_TRUE(mgr.loadPath("First")) ;
+    EXPECT_FALSE(mgr.loadPath("Missing")) ;
+    EXPECT_TRUE(mgr.hasPath("First")) ;
+
+    auto future = mgr.loadPathAsync("First", true) ;
+    auto path = future.get() ;
+    ASSERT_NE(nullptr, path) ;
+    EXPECT_EQ(20u, path->size()) ;
+    EXPECT_DOUBLE_EQ(200.0, path->getLeftSegment(0).getX()) ;
+    EXPECT_TRUE(mgr.isPathReady("First")) ;
+    EXPECT_EQ(path, mgr.getPath("First")) ;
+    EXPECT_EQ(0u, mgr.getPendingCount()) ;
+
+    //
+    // A path that is already loaded returns a future that is ready
+    //
+    auto again = mgr.loadPathAsync("First") ;
+    EXPECT_EQ(std::future_status::ready, again.wait_for(std::chrono::milliseconds(0))) ;
+    EXPECT_EQ(path, again.get()) ;
+
+    EXPECT_EQ(nullptr, mgr.loadPathAsync("Missing").get()) ;
+    EXPECT_FALSE(mgr.isPathReady("Missing")) ;
+
+    //
+    // Generated paths are added to the manager
+    //
+    auto generator = std::make_shared<XeroPathGenerator>(22.0, 0.02) ;
+    std::vector<XeroPathGenerator::Waypoint> points = { { 0.0, 0.0, 0.0 }, { 100.0, 0.0, 0.0 } } ;
+    XeroPathGenerator::Constraints limits = { 60.0, 60.0, 80.0 } ;
+    auto generated = mgr.generatePathAsync("Straight", generator, points, limits).get() ;
+    ASSERT_NE(nullptr, generated) ;
+    EXPECT_EQ(generated, mgr.getPath("Straight")) ;
+
+    std::remove((base + "/First.left.pf1.csv").c_str()) ;
+    std::remove((base + "/First.right.pf1.csv").c_str()) ;
+    ::rmdir(dir) ;
+}
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include "XeroPath.h"
+#include "xeromath.h"
+#include <vector>
+
+using namespace xero::misc ;
+
+namespace {
+    //
+    // A straight path along x with a constant acceleration, the right side one unit
+    // ahead of the left, and the heading turning through 180 degrees
+    //
+    std::shared_ptr<XeroPath> makePath(size_t n, double dt) {
+        std::vector<XeroSegment> left, right ;
+        for(size_t i = 0 ; i < n ; i++) {
+            double t = i * dt ;
+            double heading = (170.0 + 4.0 * i) / 180.0 * xero::math::PI ;
+            left.push_back(XeroSegment(t * t, 0.0, t * t, 2.0 * t, 2.0, 0.0, heading)) ;
+            right.push_back(XeroSegment(t * t + 1.0, 2.0, t * t + 1.0, 2.0 * t, 2.0, 0.0, heading)) ;
+        }
+        return std::make_shared<XeroPath>("test", std::move(left), std::move(right), dt) ;
+    }
+}
+
+TEST(XeroPathTests, Columns)
+{
+    auto path = makePath(11, 0.1) ;
+
+    ASSERT_EQ(11u, path->size()) ;
+    EXPECT_DOUBLE_EQ(0.1, path->getTimeStep()) ;
+    EXPECT_DOUBLE_EQ(1.0, path->getDuration()) ;
+
+    const double *pos = path->getColumn(XeroPath::Side::Left, XeroPath::Column::Position) ;
+    const double *cpos = path->getColumn(XeroPath::Side::Center, XeroPath::Column::Position) ;
+    const double *cy = path->getColumn(XeroPath::Side::Center, XeroPath::Column::Y) ;
+    for(size_t i = 0 ; i < path->size() ; i++) {
+        EXPECT_DOUBLE_EQ(path->getLeftSegment(i).getPOS(), pos[i]) ;
+        EXPECT_DOUBLE_EQ(pos[i] + 0.5, cpos[i]) ;
+        EXPECT_DOUBLE_EQ(1.0, cy[i]) ;
+    }
+
+    EXPECT_DOUBLE_EQ(170.0, path->getLeftSegment(0).getHeading()) ;
+    EXPECT_DOUBLE_EQ(-170.0, path->getRightSegment(5).getHeading()) ;
+    EXPECT_DOUBLE_EQ(1.0, path->getRightStartPos()) ;
+}
+
+TEST(XeroPathTests, SampleByTime)
+{
+    auto path = makePath(11, 0.1) ;
+
+    //
+    // On a row the sample is the row
+    //
+    XeroPathSample s = path->sample(XeroPath::Side::Left, 0.3) ;
+    EXPECT_NEAR(0.09, s.pos_, 1e-12) ;
+    EXPECT_NEAR(0.6, s.vel_, 1e-12) ;
+
+    //
+    // Between rows the values are interpolated
+    //
+    s = path->sample(XeroPath::Side::Right, 0.35) ;
+    EXPECT_NEAR(1.0 + (0.09 + 0.16) / 2.0, s.pos_, 1e-12) ;
+    EXPECT_NEAR(0.7, s.vel_, 1e-12) ;
+    EXPECT_NEAR(2.0, s.accel_, 1e-12) ;
+    EXPECT_NEAR(2.0, s.y_, 1e-12) ;
+
+    //
+    // The heading is interpolated the short way across +/- 180 degrees
+    //
+    s = path->sample(XeroPath::Side::Left, 0.25) ;
+    EXPECT_NEAR(180.0, s.heading_, 1e-9) ;
+    s = path->sample(XeroPath::Side::Center, 0.275) ;
+    EXPECT_NEAR(-179.0, s.heading_, 1e-9) ;
+
+    //
+    // Times before and after the path give the first and last rows
+    //
+    s = path->sample(XeroPath::Side::Left, -1.0) ;
+    EXPECT_DOUBLE_EQ(0.0, s.pos_) ;
+    s = path->sample(XeroPath::Side::Left, 5.0) ;
+    EXPECT_NEAR(1.0, s.pos_, 1e-12) ;
+    EXPECT_NEAR(2.0, s.vel_, 1e-12) ;
+}
+
+TEST(XeroPathTests, Batch)
+{
+    auto path = makePath(200, 0.02) ;
+
+    std::vector<double> times ;
+    for(double t = -0.05 ; t < path->getDuration() + 0.1 ; t += 0.0137)
+        times.push_back(t) ;
+
+    std::vector<XeroPathSample> samples(times.size()) ;
+    std::vector<double> vel(times.size()), heading(times.size()) ;
+    path->sample(XeroPath::Side::Center, &times[0], times.size(), &samples[0]) ;
+    path->sampleColumn(XeroPath::Side::Center, XeroPath::Column::Velocity, &times[0], times.size(), &vel[0]) ;
+    path->sampleColumn(XeroPath::Side::Center, XeroPath::Column::Heading, &times[0], times.size(), &heading[0]) ;
+
+    for(size_t i = 0 ; i < times.size() ; i++) {
+        XeroPathSample s = path->sample(XeroPath::Side::Center, times[i]) ;
+        EXPECT_DOUBLE_EQ(s.pos_, samples[i].pos_) ;
+        EXPECT_DOUBLE_EQ(s.vel_, vel[i]) ;
+        EXPECT_DOUBLE_EQ(s.heading_, heading[i]) ;
+    }
+
+    //
+    // A path with a single row always gives that row
+    //
+    auto one = makePath(1, 0.02) ;
+    XeroPathSample s = one->sample(XeroPath::Side::Left, 0.5) ;
+    EXPECT_DOUBLE_EQ(0.0, s.pos_) ;
+    EXPECT_DOUBLE_EQ(2.0, s.accel_) ;
+}
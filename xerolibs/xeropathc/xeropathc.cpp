@@ -0,0 +1,49 @@
+//
+// xeropathc - compile the PathWeaver CSV files for a robot into the path file read at startup
+//
+// usage: xeropathc PATHDIR [PATHFILE]
+//
+// Every path with a .left.pf1.csv and .right.pf1.csv file in the directory is stored.  The
+// path file defaults to paths.xpth in the same directory and should be deployed with the
+// CSV files.  The robot reads a path from the CSV files if it is not in the path file, so the
+// path file must be rebuilt whenever a path is changed.
+//
+
+#include <XeroPathManager.h>
+#include <XeroPathFile.h>
+#include <iostream>
+#include <string>
+
+using namespace xero::misc ;
+
+int main(int ac, char **av)
+{
+    if (ac < 2 || ac > 3) {
+        std::cerr << "usage: xeropathc PATHDIR [PATHFILE]" << std::endl ;
+        return 1 ;
+    }
+
+    std::string dir = av[1] ;
+    std::string output = (ac == 3) ? av[2] : dir + "/" + XeroPathManager::CompiledFileName ;
+
+    std::vector<XeroPathFile::PathData> paths ;
+    size_t rows = 0 ;
+    for(const std::string &name : XeroPathManager::findCSVPaths(dir)) {
+        XeroPathFile::PathData data ;
+        if (!XeroPathManager::readCSV(dir, name, data)) {
+            std::cerr << "xeropathc: could not read path '" << name << "'" << std::endl ;
+            return 1 ;
+        }
+
+        rows += data.left_.size() ;
+        paths.push_back(data) ;
+    }
+
+    if (!XeroPathFile::write(output, paths)) {
+        std::cerr << "xeropathc: could not write path file '" << output << "'" << std::endl ;
+        return 1 ;
+    }
+
+    std::cout << output << ": " << paths.size() << " paths, " << rows << " segments" << std::endl ;
+    return 0 ;
+}
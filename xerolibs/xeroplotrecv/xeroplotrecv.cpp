@@ -0,0 +1,255 @@
+//
+// xeroplotrecv - receive plots sent by the robot and record them to files
+//
+// usage: xeroplotrecv [--port PORT] [--dir DIR] [--csv] [--columnar] [--duration SECONDS]
+//        xeroplotrecv --loopback ROWS [--port PORT]
+//
+// Each plot is written when its end packet arrives, or when the receiver stops.  The files
+// are named after the plot and its id.  CSV files have a header row and one row per sample,
+// with lost samples left empty.  Columnar files (.xplt) hold the column names followed by
+// the values of each column in turn, as doubles (see writeColumnar below).  Without --csv
+// or --columnar, plots are written as CSV.
+//
+// For each plot the receiver reports the rows received and lost, and the rate rows arrived
+// at.  It also reports the packets received and lost over the whole run.
+//
+// With --loopback, the receiver sends a plot of the given number of rows to itself over
+// the loopback interface, batched the same way as the robot, and reports the throughput.
+//
+
+#include <PlotBatcher.h>
+#include <PlotDecoder.h>
+#include <UdpReceiver.h>
+#include <UdpSender.h>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+using namespace xero::misc ;
+
+static volatile sig_atomic_t stop = 0 ;
+
+static void handleSignal(int sig)
+{
+    stop = 1 ;
+}
+
+static void usage()
+{
+    std::cerr << "usage: xeroplotrecv [--port PORT] [--dir DIR] [--csv] [--columnar] [--duration SECONDS]" << std::endl ;
+    std::cerr << "       xeroplotrecv --loopback ROWS [--port PORT]" << std::endl ;
+}
+
+static double now()
+{
+    auto t = std::chrono::steady_clock::now().time_since_epoch() ;
+    return std::chrono::duration<double>(t).count() ;
+}
+
+static std::string fileName(const std::string &dir, const PlotData &plot, const char *ext)
+{
+    std::string name = plot.name_ ;
+    for(char &ch : name) {
+        if (ch == '/' || ch == ' ')
+            ch = '_' ;
+    }
+
+    return dir + "/" + name + "-" + std::to_string(plot.id_) + ext ;
+}
+
+static bool writeCSV(const std::string &filename, const PlotData &plot)
+{
+    std::ofstream out(filename) ;
+    if (!out.is_open())
+        return false ;
+
+    for(size_t col = 0 ; col < plot.columns_.size() ; col++) {
+        if (col != 0)
+            out << "," ;
+        out << plot.columns_[col] ;
+    }
+    out << '\n' ;
+
+    out.precision(10) ;
+    for(size_t row = 0 ; row < plot.getRowCount() ; row++) {
+        for(size_t col = 0 ; col < plot.data_.size() ; col++) {
+            if (col != 0)
+                out << "," ;
+            if (!std::isnan(plot.data_[col][row]))
+                out << plot.data_[col][row] ;
+        }
+        out << '\n' ;
+    }
+
+    return true ;
+}
+
+//
+// The columnar file is the bytes "XPLT", a uint32 column count and a uint32 row count,
+// then each column name as a uint32 length and the characters, then the rows of each
+// column as doubles.  All values are in the byte order of the machine that wrote it.
+//
+static bool writeColumnar(const std::string &filename, const PlotData &plot)
+{
+    std::ofstream out(filename, std::ios::out | std::ios::binary) ;
+    if (!out.is_open())
+        return false ;
+
+    uint32_t cols = static_cast<uint32_t>(plot.data_.size()) ;
+    uint32_t rows = static_cast<uint32_t>(plot.getRowCount()) ;
+
+    out.write("XPLT", 4) ;
+    out.write(reinterpret_cast<const char *>(&cols), sizeof(cols)) ;
+    out.write(reinterpret_cast<const char *>(&rows), sizeof(rows)) ;
+    for(uint32_t col = 0 ; col < cols ; col++) {
+        uint32_t len = static_cast<uint32_t>(plot.columns_[col].length()) ;
+        out.write(reinterpret_cast<const char *>(&len), sizeof(len)) ;
+        out.write(plot.columns_[col].data(), len) ;
+    }
+
+    for(const std::vector<double> &column : plot.data_)
+        out.write(reinterpret_cast<const char *>(column.data()), column.size() * sizeof(double)) ;
+
+    return true ;
+}
+
+static void report(const PlotData &plot)
+{
+    size_t rows = plot.getRowCount() ;
+    std::cout << "plot '" << plot.name_ << "' (" << plot.id_ << "): " ;
+    std::cout << plot.received_ << " rows received" ;
+    std::cout << ", " << rows - plot.received_ << " rows lost" ;
+    std::cout << ", " << plot.getRate() << " rows/sec" ;
+    if (!plot.started_)
+        std::cout << ", start packet lost" ;
+    std::cout << std::endl ;
+}
+
+static void sendLoopback(uint16_t port, uint32_t rows)
+{
+    UdpSender sender ;
+    if (!sender.open("127.0.0.1", port)) {
+        std::cerr << "xeroplotrecv: cannot open loopback sender" << std::endl ;
+        return ;
+    }
+
+    PlotBatcher batcher([&sender](const uint8_t *data, size_t size) {
+        return sender.send(data, size) ;
+    }) ;
+
+    //
+    // Send a row per "robot loop", the same shape as a path following plot, and flush
+    // once per loop like the robot does.  A loop takes no time here, so this is the
+    // fastest the receiver can keep up with.
+    //
+    std::list<std::string> cols ;
+    for(int i = 0 ; i < 17 ; i++)
+        cols.push_back("col" + std::to_string(i)) ;
+
+    batcher.startPlot(1, "loopback", cols) ;
+    double data[17] ;
+    for(uint32_t row = 0 ; row < rows ; row++) {
+        for(int i = 0 ; i < 17 ; i++)
+            data[i] = row + i ;
+        batcher.addRow(1, row, data, 17) ;
+        batcher.flush() ;
+    }
+    batcher.endPlot(1) ;
+}
+
+int main(int ac, char **av)
+{
+    uint16_t port = 5800 ;
+    std::string dir = "." ;
+    bool csv = false, columnar = false ;
+    double duration = 0.0 ;
+    uint32_t loopback = 0 ;
+
+    ac-- ;
+    av++ ;
+    while (ac > 0) {
+        std::string arg = *av ;
+        ac-- ;
+        av++ ;
+
+        if (arg == "--csv") {
+            csv = true ;
+        }
+        else if (arg == "--columnar") {
+            columnar = true ;
+        }
+        else if ((arg == "--port" || arg == "--dir" || arg == "--duration" || arg == "--loopback") && ac > 0) {
+            if (arg == "--port")
+                port = static_cast<uint16_t>(std::stoi(*av)) ;
+            else if (arg == "--dir")
+                dir = *av ;
+            else if (arg == "--duration")
+                duration = std::stod(*av) ;
+            else
+                loopback = static_cast<uint32_t>(std::stoul(*av)) ;
+            ac-- ;
+            av++ ;
+        }
+        else {
+            usage() ;
+            return 1 ;
+        }
+    }
+
+    if (!csv && !columnar)
+        csv = true ;
+
+    UdpReceiver receiver ;
+    if (!receiver.open(port, true)) {
+        std::cerr << "xeroplotrecv: cannot open port " << port << std::endl ;
+        return 1 ;
+    }
+    receiver.setReceiveTimeout(0.1) ;
+    receiver.setReceiveBufferSize(4 * 1024 * 1024) ;
+
+    PlotDecoder decoder ;
+    size_t plots = 0 ;
+    decoder.setCompleteHandler([&](const PlotData &plot) {
+        report(plot) ;
+        plots++ ;
+        if (loopback)
+            stop = 1 ;
+        else if (csv && !writeCSV(fileName(dir, plot, ".csv"), plot))
+            std::cerr << "xeroplotrecv: cannot write CSV file for plot '" << plot.name_ << "'" << std::endl ;
+        if (!loopback && columnar && !writeColumnar(fileName(dir, plot, ".xplt"), plot))
+            std::cerr << "xeroplotrecv: cannot write columnar file for plot '" << plot.name_ << "'" << std::endl ;
+    }) ;
+
+    signal(SIGINT, handleSignal) ;
+    signal(SIGTERM, handleSignal) ;
+
+    std::thread sender ;
+    if (loopback)
+        sender = std::thread(sendLoopback, port, loopback) ;
+
+    std::vector<uint8_t> packet(PlotProtocol::MaxPacketSize) ;
+    double start = now() ;
+    while (!stop) {
+        if (duration > 0.0 && now() - start > duration)
+            break ;
+
+        int count = receiver.receive(packet) ;
+        if (count > 0)
+            decoder.decode(&packet[0], static_cast<size_t>(count), now()) ;
+    }
+
+    if (sender.joinable())
+        sender.join() ;
+
+    decoder.finish() ;
+
+    std::cout << plots << " plots, " << decoder.getPacketCount() << " packets received" ;
+    std::cout << ", " << decoder.getLostCount() << " packets lost" ;
+    std::cout << ", " << decoder.getBadCount() << " bad packets" << std::endl ;
+
+    return 0 ;
+}
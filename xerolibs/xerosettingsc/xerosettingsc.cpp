@@ -0,0 +1,87 @@
+//
+// xerosettingsc - compile a robot settings file into the binary cache read at startup
+//
+// usage: xerosettingsc [--define NAME]... SETTINGSFILE [CACHEFILE]
+//
+// The if blocks in the settings file are resolved using the given defines, which must
+// match the defines the robot uses (COMPETITION or PRACTICE).  The cache file defaults to
+// the settings file name with a .datc extension and should be deployed next to the settings
+// file.  The robot builds the cache itself on first boot if it is missing or out of date.
+//
+
+#include <SettingsParser.h>
+#include <SettingsCache.h>
+#include <MessageDestStream.h>
+#include <iostream>
+#include <string>
+
+using namespace xero::misc ;
+
+static void usage()
+{
+    std::cerr << "usage: xerosettingsc [--define NAME]... SETTINGSFILE [CACHEFILE]" << std::endl ;
+}
+
+int main(int ac, char **av)
+{
+    std::list<std::string> defines ;
+    std::string input, output ;
+
+    ac-- ;
+    av++ ;
+    while (ac > 0) {
+        std::string arg = *av ;
+        ac-- ;
+        av++ ;
+
+        if (arg == "--define") {
+            if (ac == 0) {
+                usage() ;
+                return 1 ;
+            }
+            defines.push_back(*av) ;
+            ac-- ;
+            av++ ;
+        }
+        else if (input.length() == 0) {
+            input = arg ;
+        }
+        else if (output.length() == 0) {
+            output = arg ;
+        }
+        else {
+            usage() ;
+            return 1 ;
+        }
+    }
+
+    if (input.length() == 0) {
+        usage() ;
+        return 1 ;
+    }
+
+    if (output.length() == 0)
+        output = input.substr(0, input.find_last_of('.')) + ".datc" ;
+
+    MessageLogger logger ;
+    logger.enableType(MessageLogger::MessageType::warning) ;
+    logger.enableType(MessageLogger::MessageType::error) ;
+    logger.addDestination(std::make_shared<MessageDestStream>(std::cerr)) ;
+
+    SettingsParser parser(logger, 0) ;
+    for(const std::string &define : defines)
+        parser.addDefine(define) ;
+
+    if (!parser.readFile(input)) {
+        std::cerr << "xerosettingsc: could not read settings file '" << input << "'" << std::endl ;
+        return 1 ;
+    }
+
+    if (!SettingsCache::write(output, parser.getTable(), parser.getSources(), parser.getDefines())) {
+        std::cerr << "xerosettingsc: could not write cache file '" << output << "'" << std::endl ;
+        return 1 ;
+    }
+
+    std::cout << output << ": " << parser.getTable().size() << " values" << std::endl ;
+    return 0 ;
+}